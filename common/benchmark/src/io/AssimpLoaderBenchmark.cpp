@@ -0,0 +1,153 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Logger.h"
+#include "Uuid.h"
+#include "io/AssimpLoader.h"
+#include "io/DiskFileSystem.h"
+#include "mdl/EntityModel.h"
+
+#include "kdl/result.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <fmt/format.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <tuple>
+
+namespace tb::io
+{
+namespace
+{
+
+/**
+ * Generates an OBJ model with the given number of meshes. Every mesh is a grid of
+ * gridSize * gridSize quads, and all meshes share a single textured material.
+ */
+std::string makeObjModel(const size_t meshCount, const size_t gridSize)
+{
+  auto str = std::stringstream{};
+  str << "mtllib model.mtl\n";
+
+  size_t vertexOffset = 1;
+  for (size_t m = 0; m < meshCount; ++m)
+  {
+    str << "o mesh_" << m << "\n";
+    str << "usemtl shared\n";
+
+    for (size_t y = 0; y <= gridSize; ++y)
+    {
+      for (size_t x = 0; x <= gridSize; ++x)
+      {
+        str << "v " << x << " " << y << " " << m << "\n";
+        str << "vt " << double(x) / double(gridSize) << " "
+            << double(y) / double(gridSize) << "\n";
+      }
+    }
+
+    const auto rowLength = gridSize + 1;
+    for (size_t y = 0; y < gridSize; ++y)
+    {
+      for (size_t x = 0; x < gridSize; ++x)
+      {
+        const auto i1 = vertexOffset + y * rowLength + x;
+        const auto i2 = i1 + 1;
+        const auto i3 = i2 + rowLength;
+        const auto i4 = i1 + rowLength;
+        str << fmt::format("f {0}/{0} {1}/{1} {2}/{2} {3}/{3}\n", i1, i2, i3, i4);
+      }
+    }
+
+    vertexOffset += rowLength * rowLength;
+  }
+
+  return str.str();
+}
+
+/**
+ * Prints the memory held by the Assimp scene of the given model. The loader keeps the
+ * scene until the model data is complete, so this is the bulk of its peak memory use.
+ */
+void printSceneMemory(const std::filesystem::path& path, const std::string& message)
+{
+  auto importer = Assimp::Importer{};
+  if (importer.ReadFile(path.string(), AssimpLoader::ImportFlags))
+  {
+    auto memoryInfo = aiMemoryInfo{};
+    importer.GetMemoryRequirements(memoryInfo);
+    printf(
+      "Scene memory for '%s': %u KiB (%u KiB of meshes)\n",
+      message.c_str(),
+      memoryInfo.total / 1024,
+      memoryInfo.meshes / 1024);
+  }
+}
+
+void writeFile(const std::filesystem::path& path, const std::string& contents)
+{
+  auto stream = std::ofstream{path};
+  stream << contents;
+}
+
+} // namespace
+
+TEST_CASE("AssimpLoaderBenchmark.loadProceduralModel")
+{
+  auto logger = NullLogger{};
+
+  const auto dir = std::filesystem::temp_directory_path() / generateUuid();
+  std::filesystem::create_directories(dir);
+
+  writeFile(dir / "model.mtl", "newmtl shared\nmap_Kd texture.png\n");
+  std::filesystem::copy_file(
+    std::filesystem::current_path() / "fixture/benchmark/io/AssimpLoader/texture.png",
+    dir / "texture.png");
+
+  const auto [meshCount, gridSize] = GENERATE(
+    std::tuple{size_t(1), size_t(512)},
+    std::tuple{size_t(64), size_t(64)},
+    std::tuple{size_t(1024), size_t(16)});
+
+  writeFile(dir / "model.obj", makeObjModel(meshCount, gridSize));
+
+  auto fs = DiskFileSystem{dir};
+  auto loader = AssimpLoader{"model.obj", fs};
+
+  const auto message = fmt::format(
+    "load model with {} meshes of {}x{} quads", meshCount, gridSize, gridSize);
+
+  auto success = false;
+  timeLambda([&]() { success = loader.load(logger).is_success(); }, message);
+  printSceneMemory(dir / "model.obj", message);
+
+  CHECK(success);
+
+  auto error = std::error_code{};
+  std::filesystem::remove_all(dir, error);
+}
+
+} // namespace tb::io
@@ -0,0 +1,82 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+
+#include "kdl/glob_matcher.h"
+#include "kdl/string_compare.h"
+
+#include <fmt/format.h>
+
+#include <string>
+#include <vector>
+
+namespace tb
+{
+namespace
+{
+
+constexpr size_t NumNames = 100'000;
+
+auto makeNames()
+{
+  auto result = std::vector<std::string>{};
+  result.reserve(NumNames);
+  for (size_t i = 0; i < NumNames; ++i)
+  {
+    result.push_back(fmt::format("textures/base_wall/metal_panel_{}_trim", i));
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("GlobMatcherBenchmark.benchMatch")
+{
+  const auto names = makeNames();
+
+  const auto pattern = GENERATE(
+    as<std::string>{}, "*clip*", "*_%*_trim", "*a*e*i*o*u*x", "textures/*/metal_*");
+
+  auto interpretedMatches = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& name : names)
+      {
+        interpretedMatches += kdl::ci::str_matches_glob(name, pattern) ? 1u : 0u;
+      }
+    },
+    fmt::format("match '{}' with str_matches_glob", pattern));
+
+  auto compiledMatches = size_t(0);
+  timeLambda(
+    [&]() {
+      const auto matcher = kdl::ci::make_glob_matcher(pattern);
+      for (const auto& name : names)
+      {
+        compiledMatches += matcher.matches(name) ? 1u : 0u;
+      }
+    },
+    fmt::format("match '{}' with glob_matcher", pattern));
+
+  CHECK(compiledMatches == interpretedMatches);
+}
+
+} // namespace tb
@@ -0,0 +1,146 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushFace.h"
+#include "mdl/MapFormat.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/mat_ext.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr size_t NumBrushes = 64'000;
+
+auto makeBrushes(const MapFormat mapFormat)
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  auto builder = BrushBuilder{mapFormat, worldBounds};
+
+  auto result = std::vector<Brush>{};
+  result.reserve(NumBrushes);
+  for (size_t i = 0; i < NumBrushes; ++i)
+  {
+    result.push_back(builder.createCube(64.0, "material") | kdl::value());
+  }
+  return result;
+}
+
+constexpr size_t NumDraggedBrushes = 1'000;
+constexpr size_t NumDragSteps = 8;
+
+auto makeDraggedBrushes()
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  auto builder = BrushBuilder{MapFormat::Valve, worldBounds};
+
+  auto result = std::vector<Brush>{};
+  result.reserve(NumDraggedBrushes);
+  for (size_t i = 0; i < NumDraggedBrushes; i += 2)
+  {
+    result.push_back(builder.createCube(64.0, "material") | kdl::value());
+    result.push_back(
+      builder.createCylinder(
+        vm::bbox3d{32.0}, EdgeAlignedCircle{16}, vm::axis::z, "material")
+      | kdl::value());
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("BrushBenchmark.copyBrushes")
+{
+  const auto mapFormat = GENERATE(MapFormat::Standard, MapFormat::Valve);
+  const auto brushes = makeBrushes(mapFormat);
+
+  auto faces = std::vector<std::vector<BrushFace>>{};
+  timeLambda(
+    [&]() {
+      faces.reserve(brushes.size());
+      for (const auto& brush : brushes)
+      {
+        faces.push_back(brush.faces());
+      }
+    },
+    fmt::format(
+      "copy faces of {} brushes ({})", brushes.size(), formatName(mapFormat)));
+
+  auto copies = std::vector<Brush>{};
+  timeLambda(
+    [&]() { copies = brushes; },
+    fmt::format("copy {} brushes ({})", brushes.size(), formatName(mapFormat)));
+
+  CHECK(faces.size() == brushes.size());
+  CHECK(copies == brushes);
+}
+
+TEST_CASE("BrushBenchmark.dragVertices")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto uvLock = GENERATE(false, true);
+
+  auto brushes = makeDraggedBrushes();
+  const auto delta = vm::translation_matrix(vm::vec3d{0, 0, 1});
+
+  // drag the topmost vertex of every brush upwards step by step
+  auto draggedVertices = std::vector<vm::vec3d>{};
+  draggedVertices.reserve(brushes.size());
+  for (const auto& brush : brushes)
+  {
+    draggedVertices.push_back(std::ranges::max(brush.vertexPositions()));
+  }
+
+  auto failedSteps = size_t(0);
+  timeLambda(
+    [&]() {
+      for (size_t step = 0; step < NumDragSteps; ++step)
+      {
+        for (size_t i = 0; i < brushes.size(); ++i)
+        {
+          brushes[i].transformVertices(worldBounds, {draggedVertices[i]}, delta, uvLock)
+            | kdl::transform([&]() { draggedVertices[i] = delta * draggedVertices[i]; })
+            | kdl::transform_error([&](auto) { ++failedSteps; });
+        }
+      }
+    },
+    fmt::format(
+      "drag vertices of {} brushes by {} steps (uv lock {})",
+      brushes.size(),
+      NumDragSteps,
+      uvLock ? "on" : "off"));
+
+  CHECK(failedSteps == 0u);
+}
+
+} // namespace tb::mdl
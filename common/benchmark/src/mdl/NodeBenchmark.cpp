@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+
+#include "mdl/Entity.h"
+#include "mdl/EntityNode.h"
+#include "mdl/EntityProperties.h"
+#include "mdl/LayerNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/WorldNode.h"
+
+#include <fmt/format.h>
+
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr size_t NumChildren = 200'000;
+constexpr size_t GridSize = 64;
+
+auto makeEntityNodes()
+{
+  auto result = std::vector<Node*>{};
+  result.reserve(NumChildren);
+  for (size_t i = 0; i < NumChildren; ++i)
+  {
+    const auto x = int(i % GridSize) * 32;
+    const auto y = int(i / GridSize % GridSize) * 32;
+    const auto z = int(i / GridSize / GridSize) * 32 - 4096;
+    result.push_back(new EntityNode{Entity{{
+      {EntityPropertyKeys::Classname, "light"},
+      {EntityPropertyKeys::Origin, fmt::format("{} {} {}", x, y, z)},
+    }}});
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("NodeBenchmark.addRemoveChildren")
+{
+  const auto stride = GENERATE(as<size_t>{}, 4, 1);
+
+  auto world = WorldNode{{}, {}, MapFormat::Standard};
+  auto& layer = *world.defaultLayer();
+
+  const auto children = makeEntityNodes();
+  layer.addChildren(children);
+
+  auto removedChildren = std::vector<Node*>{};
+  for (size_t i = 0; i < children.size(); i += stride)
+  {
+    removedChildren.push_back(children[i]);
+  }
+
+  timeLambda(
+    [&]() { layer.removeChildren(removedChildren.begin(), removedChildren.end()); },
+    fmt::format("remove {} of {} children", removedChildren.size(), children.size()));
+
+  CHECK(layer.childCount() == children.size() - removedChildren.size());
+
+  timeLambda(
+    [&]() { layer.addChildren(removedChildren); },
+    fmt::format(
+      "add {} children to {} children",
+      removedChildren.size(),
+      children.size() - removedChildren.size()));
+
+  CHECK(layer.childCount() == children.size());
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,143 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushNode.h"
+#include "mdl/EditorContext.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityProperties.h"
+#include "mdl/HitFilter.h"
+#include "mdl/LayerNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/PickResult.h"
+#include "mdl/WorldNode.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <memory>
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr size_t NumColumns = 4;
+constexpr double BrushSize = 6.0;
+constexpr double BrushSpacing = 8.0;
+
+/**
+ * Creates a world with NumColumns x NumColumns columns of brushes that are stacked along
+ * the Z axis, so that a ray along the Z axis through a column hits every brush in it.
+ */
+auto makeWorld(const size_t columnHeight)
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto world =
+    std::make_unique<WorldNode>(EntityPropertyConfig{}, Entity{}, MapFormat::Standard);
+
+  auto brushNodes = std::vector<Node*>{};
+  brushNodes.reserve(NumColumns * NumColumns * columnHeight);
+  for (size_t x = 0; x < NumColumns; ++x)
+  {
+    for (size_t y = 0; y < NumColumns; ++y)
+    {
+      for (size_t z = 0; z < columnHeight; ++z)
+      {
+        const auto min = vm::vec3d{double(x), double(y), double(z)} * BrushSpacing
+                         - vm::vec3d{0, 0, 4000};
+        const auto bounds = vm::bbox3d{min, min + vm::vec3d::fill(BrushSize)};
+        brushNodes.push_back(
+          new BrushNode{builder.createCuboid(bounds, "material") | kdl::value()});
+      }
+    }
+  }
+  world->defaultLayer()->addChildren(std::move(brushNodes));
+  return world;
+}
+
+auto makePickRays()
+{
+  auto result = std::vector<vm::ray3d>{};
+  for (size_t x = 0; x < NumColumns; ++x)
+  {
+    for (size_t y = 0; y < NumColumns; ++y)
+    {
+      const auto center = vm::vec3d{double(x), double(y), 0} * BrushSpacing
+                          + vm::vec3d{BrushSize / 2.0, BrushSize / 2.0, 0};
+      result.emplace_back(center + vm::vec3d{0, 0, 4096}, vm::vec3d{0, 0, -1});
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("PickResultBenchmark.pickDenseMap")
+{
+  using namespace HitFilters;
+
+  const auto columnHeight = GENERATE(as<size_t>{}, 100, 1'000);
+  const auto world = makeWorld(columnHeight);
+  const auto rays = makePickRays();
+  const auto editorContext = EditorContext{};
+
+  constexpr auto NumRepetitions = 10;
+
+  auto hitCount = size_t(0);
+  auto selectedCount = size_t(0);
+  timeLambda(
+    [&]() {
+      for (auto i = 0; i < NumRepetitions; ++i)
+      {
+        for (const auto& ray : rays)
+        {
+          auto pickResult = PickResult::byDistance();
+          world->pick(editorContext, ray, pickResult);
+
+          hitCount += pickResult.first(type(BrushNode::BrushHitType)).isMatch() ? 1 : 0;
+          const auto filter = type(BrushNode::BrushHitType) && selected();
+          for (const auto& hit : pickResult.view(filter))
+          {
+            selectedCount += hit.isMatch() ? 1 : 0;
+          }
+        }
+      }
+    },
+    fmt::format(
+      "pick {} rays through {} brushes each",
+      NumRepetitions * rays.size(),
+      columnHeight));
+
+  CHECK(hitCount == NumRepetitions * rays.size());
+  CHECK(selectedCount == 0);
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,152 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+
+#include "mdl/GJK.h"
+#include "mdl/Polyhedron.h"
+#include "mdl/Polyhedron3.h"
+
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+auto makeRandomPoints(const size_t count)
+{
+  auto rng = std::mt19937{count};
+  auto dist = std::uniform_real_distribution<double>{-1024.0, 1024.0};
+
+  auto result = std::vector<vm::vec3d>{};
+  result.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    result.emplace_back(dist(rng), dist(rng), dist(rng));
+  }
+  return result;
+}
+
+auto makeRandomPolyhedronPairs(const size_t vertexCount, const size_t pairCount)
+{
+  auto rng = std::mt19937{vertexCount};
+  auto pointDist = std::uniform_real_distribution<double>{-64.0, 64.0};
+  auto offsetDist = std::uniform_real_distribution<double>{-160.0, 160.0};
+
+  const auto makePolyhedron = [&](const vm::vec3d& offset) {
+    auto points = std::vector<vm::vec3d>{};
+    points.reserve(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+      points.push_back(
+        offset + vm::vec3d(pointDist(rng), pointDist(rng), pointDist(rng)));
+    }
+    return Polyhedron3{std::move(points)};
+  };
+
+  auto result = std::vector<std::pair<Polyhedron3, Polyhedron3>>{};
+  result.reserve(pairCount);
+  for (size_t i = 0; i < pairCount; ++i)
+  {
+    const auto offset = vm::vec3d(offsetDist(rng), offsetDist(rng), offsetDist(rng));
+    result.emplace_back(makePolyhedron({0, 0, 0}), makePolyhedron(offset));
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("PolyhedronBenchmark.convexHull")
+{
+  const auto count = GENERATE(as<size_t>{}, 100, 500, 2'000);
+  const auto points = makeRandomPoints(count);
+
+  auto incremental = Polyhedron3{};
+  timeLambda(
+    [&]() { incremental = Polyhedron3{points, ConvexHullAlgorithm::Incremental}; },
+    fmt::format("incremental hull of {} points", count));
+
+  auto quickHull = Polyhedron3{};
+  timeLambda(
+    [&]() { quickHull = Polyhedron3{points, ConvexHullAlgorithm::QuickHull}; },
+    fmt::format("quickhull of {} points", count));
+
+  CHECK(quickHull.vertexCount() == incremental.vertexCount());
+  CHECK(quickHull.faceCount() == incremental.faceCount());
+}
+
+TEST_CASE("PolyhedronBenchmark.intersects")
+{
+  const auto vertexCount = GENERATE(as<size_t>{}, 8, 32, 128);
+  const auto pairs = makeRandomPolyhedronPairs(vertexCount, 1'000);
+
+  auto satCount = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& [lhs, rhs] : pairs)
+      {
+        satCount += lhs.intersects(rhs) ? 1 : 0;
+      }
+    },
+    fmt::format(
+      "separating axis test of {} hulls of {} points", pairs.size(), vertexCount));
+
+  auto gjkCount = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& [lhs, rhs] : pairs)
+      {
+        gjkCount += gjkIntersects(lhs, rhs) ? 1 : 0;
+      }
+    },
+    fmt::format("GJK test of {} hulls of {} points", pairs.size(), vertexCount));
+
+  auto searchDirections = std::vector<vm::vec3d>(pairs.size());
+  for (size_t i = 0; i < pairs.size(); ++i)
+  {
+    gjkIntersects(pairs[i].first, pairs[i].second, searchDirections[i]);
+  }
+
+  auto cachedGjkCount = size_t(0);
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < pairs.size(); ++i)
+      {
+        const auto& [lhs, rhs] = pairs[i];
+        cachedGjkCount += gjkIntersects(lhs, rhs, searchDirections[i]) ? 1 : 0;
+      }
+    },
+    fmt::format(
+      "GJK test of {} hulls of {} points with cached directions",
+      pairs.size(),
+      vertexCount));
+
+  CHECK(gjkCount == satCount);
+  CHECK(cachedGjkCount == satCount);
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,129 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+
+#include "../../test/src/render/FontTestUtils.h"
+#include "render/AttrString.h"
+#include "render/FontDescriptor.h"
+#include "render/FontManager.h"
+#include "render/TextureFont.h"
+
+#include <fmt/format.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tb::render
+{
+namespace
+{
+
+constexpr size_t NumLabels = 4'000;
+constexpr size_t NumFrames = 10;
+
+auto makeLabels()
+{
+  auto result = std::vector<std::string>{};
+  result.reserve(NumLabels);
+  for (size_t i = 0; i < NumLabels; ++i)
+  {
+    result.push_back(fmt::format("monster_entity_with_a_long_name_{}", i));
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("FontBenchmark.layoutLabels")
+{
+  const auto font = makeTestFont(16);
+  const auto labels = makeLabels();
+
+  auto vertexCount = size_t(0);
+  timeLambda(
+    [&]() {
+      for (size_t frame = 0; frame < NumFrames; ++frame)
+      {
+        for (size_t i = 0; i < labels.size(); ++i)
+        {
+          const auto offset = vm::vec2f{float(i % 100), float(i / 100)};
+          vertexCount += font->quads(labels[i], true, offset).size();
+          vertexCount += size_t(font->measure(labels[i]).x());
+        }
+      }
+    },
+    fmt::format("lay out {} labels in {} frames", labels.size(), NumFrames));
+
+  CHECK(vertexCount > 0);
+}
+
+TEST_CASE("FontBenchmark.layoutAttrStrings")
+{
+  const auto font = makeTestFont(16);
+
+  auto strings = std::vector<AttrString>{};
+  for (const auto& label : makeLabels())
+  {
+    auto string = AttrString{};
+    string.appendCentered(label);
+    string.appendCentered("info_player_start");
+    strings.push_back(std::move(string));
+  }
+
+  auto vertexCount = size_t(0);
+  timeLambda(
+    [&]() {
+      for (size_t frame = 0; frame < NumFrames; ++frame)
+      {
+        for (const auto& string : strings)
+        {
+          vertexCount += font->quads(string, true).size();
+          vertexCount += size_t(font->measure(string).x());
+        }
+      }
+    },
+    fmt::format(
+      "lay out {} attributed strings in {} frames", strings.size(), NumFrames));
+
+  CHECK(vertexCount > 0);
+}
+
+TEST_CASE("FontBenchmark.selectFontSize")
+{
+  auto fontManager = FontManager{std::make_unique<TestFontFactory>()};
+  const auto labels = makeLabels();
+  const auto defaultFont = FontDescriptor{"font.ttf", 48};
+
+  auto totalSize = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& label : labels)
+      {
+        totalSize += fontManager.selectFontSize(defaultFont, label, 200.0f, 5).size();
+      }
+    },
+    fmt::format("select font sizes for {} labels", labels.size()));
+
+  CHECK(totalSize > 0);
+}
+
+} // namespace tb::render
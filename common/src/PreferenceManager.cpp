@@ -57,11 +57,41 @@ PreferenceManager& PreferenceManager::instance()
   if (!m_initialized)
   {
     m_instance->initialize();
+    m_instance->publishSnapshot();
     m_initialized = true;
   }
   return *m_instance;
 }
 
+std::shared_ptr<const PreferenceSnapshot> PreferenceManager::snapshot() const
+{
+  auto snapshot = m_snapshot.load();
+  ensure(snapshot != nullptr, "Preference snapshot is published");
+  return snapshot;
+}
+
+void PreferenceManager::publishSnapshot()
+{
+  // only the main thread replaces the snapshot, so it cannot change while this runs
+  const auto current = m_snapshot.load();
+
+  auto snapshot = std::make_shared<PreferenceSnapshot>(PreferenceSnapshot{
+    current ? current->version : 0,
+    get(Preferences::Brightness),
+    get(Preferences::GridAlpha),
+    get(Preferences::GridColor2D),
+    get(Preferences::SoftMapBoundsColor),
+  });
+
+  if (current && *current == *snapshot)
+  {
+    return;
+  }
+
+  ++snapshot->version;
+  m_snapshot.store(std::move(snapshot));
+}
+
 namespace
 {
 bool shouldSaveInstantly()
@@ -145,6 +175,7 @@ void AppPreferenceManager::discardChanges()
   }
   m_unsavedPreferences.clear();
   invalidatePreferences();
+  publishSnapshot();
 }
 
 void AppPreferenceManager::saveChangesImmediately()
@@ -275,6 +306,7 @@ void AppPreferenceManager::loadCacheFromDisk()
       [&](const PreferenceErrors::NoFilePresent&) { m_cache = {}; }));
 
   invalidatePreferences();
+  publishSnapshot();
 
   // Emit preferenceDidChangeNotifier for any changed preferences
   const auto changedKeys = changedKeysForMapDiff(oldPrefs, m_cache);
@@ -387,6 +419,11 @@ void togglePref(Preference<bool>& preference)
   prefs.saveChanges();
 }
 
+std::shared_ptr<const PreferenceSnapshot> prefSnapshot()
+{
+  return PreferenceManager::instance().snapshot();
+}
+
 std::filesystem::path preferenceFilePath()
 {
   return io::SystemPaths::userDataDirectory() / "Preferences.json";
@@ -30,6 +30,7 @@
 #include "Macros.h"
 #include "Notifier.h"
 #include "Preference.h"
+#include "PreferenceSnapshot.h"
 #include "Result.h"
 
 #include "kdl/vector_set.h"
@@ -37,6 +38,7 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <atomic>
 #include <filesystem>
 #include <map>
 #include <memory>
@@ -59,6 +61,11 @@ private:
 protected:
   std::map<std::filesystem::path, std::unique_ptr<PreferenceBase>> m_dynamicPreferences;
 
+private:
+  // readers share ownership of the snapshot they obtained, so a replaced snapshot is
+  // freed when its last reader releases it
+  std::atomic<std::shared_ptr<const PreferenceSnapshot>> m_snapshot;
+
 public:
   Notifier<const std::filesystem::path&> preferenceDidChangeNotifier;
 
@@ -124,6 +131,7 @@ public:
 
     preference.setValue(value);
     preference.setValid(true);
+    publishSnapshot();
 
     savePreference(preference);
     if (saveInstantly())
@@ -140,12 +148,25 @@ public:
     set(preference, preference.defaultValue());
   }
 
+  /**
+   * Returns the most recently published preference snapshot. This can be called from any
+   * thread.
+   */
+  std::shared_ptr<const PreferenceSnapshot> snapshot() const;
+
   virtual void initialize() = 0;
 
   virtual bool saveInstantly() const = 0;
   virtual void saveChanges() = 0;
   virtual void discardChanges() = 0;
 
+protected:
+  /**
+   * Publishes a new snapshot if any of the preferences it contains has changed. Must be
+   * called on the main thread whenever preference values may have changed.
+   */
+  void publishSnapshot();
+
 private:
   virtual void validatePreference(PreferenceBase&) = 0;
   virtual void savePreference(PreferenceBase&) = 0;
@@ -213,6 +234,13 @@ const T& pref(Preference<T>& preference)
   return prefs.get(preference);
 }
 
+/**
+ * Returns the current preference snapshot. Unlike pref(), this can be called from any
+ * thread. Each call loads the shared pointer atomically, so a renderer should fetch the
+ * snapshot once per frame and read all values from it.
+ */
+std::shared_ptr<const PreferenceSnapshot> prefSnapshot();
+
 /**
  * Sets a preference, and saves the change immediately.
  */
@@ -0,0 +1,50 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Color.h"
+
+#include "kdl/reflection_decl.h"
+
+namespace tb
+{
+
+/**
+ * An immutable copy of the preferences that are read while rendering.
+ *
+ * The preference manager publishes a new snapshot whenever one of these preferences
+ * changes. Published snapshots are never modified, so unlike pref(), a snapshot can be
+ * read from any thread while its shared pointer is held. The version increases with every
+ * published snapshot, so callers can compare versions to detect changes.
+ */
+struct PreferenceSnapshot
+{
+  size_t version = 0;
+
+  float brightness = 0.0f;
+  float gridAlpha = 0.0f;
+  Color gridColor2D;
+  Color softMapBoundsColor;
+
+  kdl_reflect_decl(
+    PreferenceSnapshot, version, brightness, gridAlpha, gridColor2D, softMapBoundsColor);
+};
+
+} // namespace tb
@@ -34,6 +34,7 @@
 #include "mdl/EntityModel.h"
 #include "mdl/Material.h"
 #include "mdl/Texture.h"
+#include "mdl/TextureResource.h"
 #include "render/IndexRangeMapBuilder.h"
 #include "render/PrimType.h"
 
@@ -45,15 +46,19 @@
 #include <assimp/IOStream.hpp>
 #include <assimp/IOSystem.hpp>
 #include <assimp/Importer.hpp>
+#include <assimp/ProgressHandler.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <assimp/types.h>
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <functional>
+#include <memory>
 #include <optional>
 #include <ranges>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
 
 
@@ -166,6 +171,24 @@ public:
   }
 };
 
+/**
+ * Asks Assimp to abort the import once the loader is cancelled. Assimp polls this
+ * between the steps of reading and post-processing a scene.
+ */
+class AssimpProgressHandler : public Assimp::ProgressHandler
+{
+private:
+  std::function<bool()> m_isCancelled;
+
+public:
+  explicit AssimpProgressHandler(std::function<bool()> isCancelled)
+    : m_isCancelled{std::move(isCancelled)}
+  {
+  }
+
+  bool Update(const float /* percentage */) override { return !m_isCancelled(); }
+};
+
 std::optional<mdl::Texture> loadFallbackTexture(const FileSystem& fs)
 {
   static const auto NoTextureName = mdl::BrushFaceAttributes::NoMaterialName;
@@ -586,7 +609,7 @@ Result<std::vector<mdl::EntityModelVertex>> computeMeshVertices(
     // Bone indices and weights
     if (mesh.HasBones() && !boneTransforms.empty() && !weightsPerVertex[i].empty())
     {
-      const auto vertWeights = weightsPerVertex[i];
+      const auto& vertWeights = weightsPerVertex[i];
       auto vertPos = aiVector3D{};
 
       for (const auto& vertWeight : vertWeights)
@@ -646,7 +669,7 @@ AssimpComputedMeshData computeMeshData(
     }
   }
 
-  return {meshIndex, builder.vertices(), builder.indices()};
+  return {meshIndex, std::move(builder.vertices()), std::move(builder.indices())};
 }
 
 bool useQuakeCoordinateSystem(const aiScene& scene)
@@ -769,7 +792,7 @@ Result<void> loadSceneFrame(
                         return computeMeshData(mesh, meshIndex, vertices);
                       });
            })
-         | kdl::fold | kdl::and_then([&](const auto& meshData) -> Result<void> {
+         | kdl::fold | kdl::and_then([&](auto meshData) -> Result<void> {
              if (!bounds.initialized())
              {
                // passing empty bounds as bbox crashes the program, don't let it happen
@@ -779,10 +802,11 @@ Result<void> loadSceneFrame(
              const auto frameBounds = bounds.bounds();
              auto& frame = model.addFrame(name, frameBounds);
 
-             for (const auto& data : meshData)
+             for (auto& data : meshData)
              {
                auto& surface = model.surface(data.m_meshIndex);
-               surface.addMesh(frame, data.m_vertices, data.m_indices);
+               surface.addMesh(
+                 frame, std::move(data.m_vertices), std::move(data.m_indices));
              }
 
              return Result<void>{};
@@ -791,9 +815,20 @@ Result<void> loadSceneFrame(
 
 } // namespace
 
+const unsigned int AssimpLoader::ImportFlags =
+  aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_FlipWindingOrder
+  | aiProcess_SortByPType | aiProcess_FlipUVs;
+
 AssimpLoader::AssimpLoader(std::filesystem::path path, const FileSystem& fs)
+  : AssimpLoader{std::move(path), fs, []() { return false; }}
+{
+}
+
+AssimpLoader::AssimpLoader(
+  std::filesystem::path path, const FileSystem& fs, std::function<bool()> isCancelled)
   : m_path{std::move(path)}
   , m_fs{fs}
+  , m_isCancelled{std::move(isCancelled)}
 {
 }
 
@@ -822,23 +857,35 @@ Result<mdl::EntityModelData> AssimpLoader::load(tb::Logger& logger)
 {
   try
   {
-    constexpr auto assimpFlags = aiProcess_Triangulate | aiProcess_JoinIdenticalVertices
-                                 | aiProcess_FlipWindingOrder | aiProcess_SortByPType
-                                 | aiProcess_FlipUVs;
-
     const auto modelPath = m_path.string();
 
     // Import the file as an Assimp scene and populate our vectors.
     auto importer = Assimp::Importer{};
     importer.SetIOHandler(new AssimpIOSystem{m_fs});
+    importer.SetProgressHandler(new AssimpProgressHandler{m_isCancelled});
 
-    const auto* scene = importer.ReadFile(modelPath, assimpFlags);
+    const auto* scene = importer.ReadFile(modelPath, ImportFlags);
+    if (m_isCancelled())
+    {
+      return Error{"Loading cancelled"};
+    }
     if (!scene)
     {
       return Error{fmt::format(
         "Assimp couldn't import model from '{}': {}", m_path, importer.GetErrorString())};
     }
 
+    // the imported scene is kept until the model data is complete, so it determines the
+    // peak memory use of the import
+    auto memoryInfo = aiMemoryInfo{};
+    importer.GetMemoryRequirements(memoryInfo);
+    logger.debug(fmt::format(
+      "Imported '{}' with {} KiB of scene data ({} KiB of meshes, {} KiB of textures)",
+      m_path,
+      memoryInfo.total / 1024,
+      memoryInfo.meshes / 1024,
+      memoryInfo.textures / 1024));
+
     // Create model data.
     auto data = mdl::EntityModelData{mdl::PitchType::Normal, mdl::Orientation::Oriented};
 
@@ -846,10 +893,21 @@ Result<mdl::EntityModelData> AssimpLoader::load(tb::Logger& logger)
     // if we have no animations, always load 1 frame for the reference model
     const auto numSequences = std::max(scene->mNumAnimations, 1u);
 
+    // the textures of each material are only loaded once and shared by all meshes that
+    // use the material
+    auto textureResourcesByMaterial = std::unordered_map<
+      unsigned int,
+      std::vector<std::shared_ptr<mdl::TextureResource>>>{};
+
     // create a surface for each mesh in the scene and assign the skins/materials to it
     const auto numMeshes = scene->mNumMeshes;
     for (size_t i = 0; i < numMeshes; ++i)
     {
+      if (m_isCancelled())
+      {
+        return Error{"Loading cancelled"};
+      }
+
       const auto& mesh = scene->mMeshes[i];
 
       auto& surface = data.addSurface(scene->mMeshes[i]->mName.data, numSequences);
@@ -858,17 +916,28 @@ Result<mdl::EntityModelData> AssimpLoader::load(tb::Logger& logger)
       // multiple alternatives (this is how assimp handles skins)
 
       // load skins for this surface
-      auto textures =
-        loadTexturesForMaterial(*scene, mesh->mMaterialIndex, m_path, m_fs, logger);
-      auto materials = kdl::vec_transform(std::move(textures), [](auto texture) {
-        auto textureResource = createTextureResource(std::move(texture));
+      auto it = textureResourcesByMaterial.find(mesh->mMaterialIndex);
+      if (it == textureResourcesByMaterial.end())
+      {
+        auto textures =
+          loadTexturesForMaterial(*scene, mesh->mMaterialIndex, m_path, m_fs, logger);
+        auto textureResources = kdl::vec_transform(
+          std::move(textures),
+          [](auto texture) { return createTextureResource(std::move(texture)); });
+        it = textureResourcesByMaterial
+               .emplace(mesh->mMaterialIndex, std::move(textureResources))
+               .first;
+      }
+
+      auto materials = kdl::vec_transform(it->second, [](auto textureResource) {
         return mdl::Material{"", std::move(textureResource)};
       });
       surface.setSkins(std::move(materials));
     }
 
     return std::views::iota(0u, numSequences) | std::views::transform([&](const auto i) {
-             return loadSceneFrame(*scene, i, data, modelPath);
+             return m_isCancelled() ? Result<void>{Error{"Loading cancelled"}}
+                                    : loadSceneFrame(*scene, i, data, modelPath);
            })
            | kdl::fold | kdl::transform([&]() { return std::move(data); });
   }
@@ -26,6 +26,7 @@
 #include <assimp/matrix4x4.h>
 
 #include <filesystem>
+#include <functional>
 
 struct aiNode;
 struct aiScene;
@@ -52,10 +53,23 @@ class AssimpLoader : public EntityModelLoader
 private:
   std::filesystem::path m_path;
   const FileSystem& m_fs;
+  std::function<bool()> m_isCancelled;
 
 public:
+  /**
+   * The post-processing steps that are applied to every imported scene.
+   */
+  static const unsigned int ImportFlags;
+
   AssimpLoader(std::filesystem::path path, const FileSystem& fs);
 
+  /**
+   * Creates a loader whose import is aborted with an error once the given function
+   * returns true. The function is called on the loading thread.
+   */
+  AssimpLoader(
+    std::filesystem::path path, const FileSystem& fs, std::function<bool()> isCancelled);
+
   static bool canParse(const std::filesystem::path& path);
 
   Result<mdl::EntityModelData> load(Logger& logger) override;
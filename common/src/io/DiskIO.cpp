@@ -31,6 +31,11 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
 namespace tb::io::Disk
 {
 namespace
@@ -94,6 +99,63 @@ PathInfo pathInfoForFixedPath(const std::filesystem::path& fixedPath)
            : PathInfo::Unknown;
 }
 
+bool contentsAreEqual(
+  const std::filesystem::path& fixedPath1, const std::filesystem::path& fixedPath2)
+{
+  constexpr auto BufferSize = std::streamsize(64 * 1024);
+
+  auto stream1 = std::ifstream{fixedPath1, std::ios::binary};
+  auto stream2 = std::ifstream{fixedPath2, std::ios::binary};
+  if (!stream1 || !stream2)
+  {
+    return false;
+  }
+
+  auto buffer1 = std::vector<char>(size_t(BufferSize));
+  auto buffer2 = std::vector<char>(size_t(BufferSize));
+  while (stream1 && stream2)
+  {
+    stream1.read(buffer1.data(), BufferSize);
+    stream2.read(buffer2.data(), BufferSize);
+
+    const auto count = stream1.gcount();
+    if (
+      count != stream2.gcount()
+      || !std::equal(buffer1.begin(), buffer1.begin() + count, buffer2.begin()))
+    {
+      return false;
+    }
+  }
+
+  return stream1.eof() && stream2.eof();
+}
+
+/**
+ * Files are considered equal if they have the same size and either the same modification
+ * time or the same contents.
+ */
+bool filesAreEqual(
+  const std::filesystem::path& fixedPath1, const std::filesystem::path& fixedPath2)
+{
+  auto error1 = std::error_code{};
+  auto error2 = std::error_code{};
+  const auto size1 = std::filesystem::file_size(fixedPath1, error1);
+  const auto size2 = std::filesystem::file_size(fixedPath2, error2);
+  if (error1 || error2 || size1 != size2)
+  {
+    return false;
+  }
+
+  const auto time1 = std::filesystem::last_write_time(fixedPath1, error1);
+  const auto time2 = std::filesystem::last_write_time(fixedPath2, error2);
+  if (!error1 && !error2 && time1 == time2)
+  {
+    return true;
+  }
+
+  return contentsAreEqual(fixedPath1, fixedPath2);
+}
+
 } // namespace
 
 bool isCaseSensitive()
@@ -247,6 +309,65 @@ Result<void> copyFile(
   return kdl::void_success;
 }
 
+Result<bool> copyFileIfChanged(
+  const std::filesystem::path& sourcePath, const std::filesystem::path& destPath)
+{
+  const auto fixedSourcePath = fixPath(sourcePath);
+  if (pathInfoForFixedPath(fixedSourcePath) != PathInfo::File)
+  {
+    return Error{
+      fmt::format("Failed to copy {}: path does not denote a file", sourcePath)};
+  }
+
+  auto fixedDestPath = fixPath(destPath);
+  if (pathInfoForFixedPath(fixedDestPath) == PathInfo::Directory)
+  {
+    fixedDestPath = fixedDestPath / sourcePath.filename();
+  }
+
+  if (
+    pathInfoForFixedPath(fixedDestPath) == PathInfo::File
+    && filesAreEqual(fixedSourcePath, fixedDestPath))
+  {
+    return false;
+  }
+
+  return copyFile(sourcePath, destPath) | kdl::transform([&]() {
+           auto error = std::error_code{};
+           const auto modificationTime =
+             std::filesystem::last_write_time(fixedSourcePath, error);
+           if (!error)
+           {
+             // failing to set the time only means that the next copy can't be skipped
+             std::filesystem::last_write_time(fixedDestPath, modificationTime, error);
+           }
+           return true;
+         });
+}
+
+Result<bool> writeFileIfChanged(
+  const std::filesystem::path& path, const std::string& contents)
+{
+  const auto fixedPath = fixPath(path);
+  if (pathInfoForFixedPath(fixedPath) == PathInfo::File)
+  {
+    const auto unchanged = withInputStream(fixedPath, [&](auto& stream) {
+      return std::equal(
+        std::istreambuf_iterator<char>{stream},
+        std::istreambuf_iterator<char>{},
+        contents.begin(),
+        contents.end());
+    });
+    if (unchanged == Result<bool>{true})
+    {
+      return false;
+    }
+  }
+
+  return withOutputStream(fixedPath, [&](auto& stream) { stream << contents; })
+         | kdl::transform([]() { return true; });
+}
+
 Result<void> moveFile(
   const std::filesystem::path& sourcePath, const std::filesystem::path& destPath)
 {
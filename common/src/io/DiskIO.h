@@ -92,6 +92,25 @@ Result<bool> deleteFile(const std::filesystem::path& path);
 Result<void> copyFile(
   const std::filesystem::path& sourcePath, const std::filesystem::path& destPath);
 
+/**
+ * Copies the given file unless the destination already has the same size and either the
+ * same modification time or the same contents. A copied file gets the modification time
+ * of its source so that it can be skipped cheaply the next time.
+ *
+ * Returns true if the file was copied and false if it was skipped.
+ */
+Result<bool> copyFileIfChanged(
+  const std::filesystem::path& sourcePath, const std::filesystem::path& destPath);
+
+/**
+ * Writes the given contents to the given file unless the file already has these
+ * contents. An unchanged file keeps its modification time.
+ *
+ * Returns true if the file was written and false if it was skipped.
+ */
+Result<bool> writeFileIfChanged(
+  const std::filesystem::path& path, const std::string& contents);
+
 Result<void> moveFile(
   const std::filesystem::path& sourcePath, const std::filesystem::path& destPath);
 
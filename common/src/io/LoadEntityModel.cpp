@@ -58,6 +58,7 @@ Result<mdl::EntityModelData> loadEntityModelData(
   const mdl::MaterialConfig& materialConfig,
   const std::filesystem::path& path,
   const LoadMaterialFunc& loadMaterial,
+  const IsCancelledFunc& isCancelled,
   Logger& logger)
 {
   const auto modelName = path.filename().string();
@@ -120,7 +121,7 @@ Result<mdl::EntityModelData> loadEntityModelData(
              }
              if (io::AssimpLoader::canParse(path))
              {
-               auto loader = io::AssimpLoader{path, fs};
+               auto loader = io::AssimpLoader{path, fs, isCancelled};
                return loader.load(logger);
              }
              return Error{fmt::format("Unknown model format: {}", path)};
@@ -136,10 +137,12 @@ mdl::ResourceLoader<mdl::EntityModelData> makeEntityModelDataResourceLoader(
   const mdl::MaterialConfig& materialConfig,
   const std::filesystem::path& path,
   const LoadMaterialFunc& loadMaterial,
+  const IsCancelledFunc& isCancelled,
   Logger& logger)
 {
-  return [&fs, materialConfig, path, loadMaterial, &logger]() {
-    return loadEntityModelData(fs, materialConfig, path, loadMaterial, logger);
+  return [&fs, materialConfig, path, loadMaterial, isCancelled, &logger]() {
+    return loadEntityModelData(
+      fs, materialConfig, path, loadMaterial, isCancelled, logger);
   };
 }
 
@@ -152,7 +155,8 @@ Result<mdl::EntityModel> loadEntityModelSync(
   const LoadMaterialFunc& loadMaterial,
   Logger& logger)
 {
-  return loadEntityModelData(fs, materialConfig, path, loadMaterial, logger)
+  const auto isCancelled = []() { return false; };
+  return loadEntityModelData(fs, materialConfig, path, loadMaterial, isCancelled, logger)
          | kdl::transform([&](auto modelData) {
              auto modelName = path.filename().string();
              auto modelResource =
@@ -167,11 +171,12 @@ mdl::EntityModel loadEntityModelAsync(
   const std::filesystem::path& path,
   const LoadMaterialFunc& loadMaterial,
   const mdl::CreateEntityModelDataResource& createResource,
+  const IsCancelledFunc& isCancelled,
   Logger& logger)
 {
   auto name = path.filename().string();
-  auto loader =
-    makeEntityModelDataResourceLoader(fs, materialConfig, path, loadMaterial, logger);
+  auto loader = makeEntityModelDataResourceLoader(
+    fs, materialConfig, path, loadMaterial, isCancelled, logger);
   auto resource = createResource(std::move(loader));
   return mdl::EntityModel{std::move(name), std::move(resource)};
 }
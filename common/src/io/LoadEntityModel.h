@@ -42,6 +42,7 @@ namespace tb::io
 class FileSystem;
 
 using LoadMaterialFunc = std::function<mdl::Material(const std::filesystem::path&)>;
+using IsCancelledFunc = std::function<bool()>;
 
 Result<mdl::EntityModel> loadEntityModelSync(
   const FileSystem& fs,
@@ -50,12 +51,17 @@ Result<mdl::EntityModel> loadEntityModelSync(
   const LoadMaterialFunc& loadMaterial,
   Logger& logger);
 
+/**
+ * Creates an entity model whose data is loaded by the resource that createResource
+ * returns. Loaders that support it stop loading once isCancelled returns true.
+ */
 mdl::EntityModel loadEntityModelAsync(
   const FileSystem& fs,
   const mdl::MaterialConfig& materialConfig,
   const std::filesystem::path& path,
   const LoadMaterialFunc& loadMaterial,
   const mdl::CreateEntityModelDataResource& createResource,
+  const IsCancelledFunc& isCancelled,
   Logger& logger);
 
 } // namespace tb::io
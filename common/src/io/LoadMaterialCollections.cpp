@@ -40,13 +40,13 @@
 #include "mdl/TextureResource.h"
 
 #include "kdl/functional.h"
+#include "kdl/glob_matcher.h"
 #include "kdl/grouped_range.h"
 #include "kdl/map_utils.h"
 #include "kdl/path_hash.h"
 #include "kdl/path_utils.h"
 #include "kdl/result.h"
 #include "kdl/result_fold.h"
-#include "kdl/string_compare.h"
 #include "kdl/string_format.h"
 #include "kdl/vector_utils.h"
 
@@ -75,10 +75,10 @@ std::optional<Result<mdl::Palette>> loadPalette(
 }
 
 bool shouldExclude(
-  const std::string& materialName, const std::vector<std::string>& patterns)
+  const std::string& materialName, const std::vector<kdl::glob_matcher>& excludes)
 {
-  return std::any_of(patterns.begin(), patterns.end(), [&](const auto& pattern) {
-    return kdl::ci::str_matches_glob(materialName, pattern);
+  return std::any_of(excludes.begin(), excludes.end(), [&](const auto& exclude) {
+    return exclude.matches(materialName);
   });
 }
 
@@ -90,8 +90,11 @@ Result<std::vector<std::filesystem::path>> findTexturePaths(
            TraversalMode::Recursive,
            makeExtensionPathMatcher(materialConfig.extensions))
          | kdl::transform([&](auto paths) {
+             const auto excludes = kdl::vec_transform(
+               materialConfig.excludes,
+               [](const auto& pattern) { return kdl::ci::make_glob_matcher(pattern); });
              return kdl::vec_filter(std::move(paths), [&](const auto& path) {
-               return !shouldExclude(path.stem().string(), materialConfig.excludes);
+               return !shouldExclude(path.stem().string(), excludes);
              });
            });
 }
@@ -23,6 +23,7 @@
 #include "FileLocation.h"
 #include "Uuid.h"
 #include "io/ParserStatus.h"
+#include "io/SimpleParserStatus.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
 #include "mdl/Entity.h"
@@ -46,7 +47,9 @@
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
+#include <algorithm>
 #include <cassert>
+#include <memory>
 #include <optional>
 #include <ostream>
 #include <string>
@@ -80,6 +83,11 @@ MapReader::MapReader(
 {
 }
 
+void MapReader::setDeferHiddenLayers(const bool deferHiddenLayers)
+{
+  m_deferHiddenLayers = deferHiddenLayers;
+}
+
 Result<void> MapReader::readEntities(
   const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager)
 {
@@ -903,6 +911,426 @@ std::unordered_map<mdl::Node*, mdl::Node*> buildNodeToParentMap(
   }
   return nodeToParentMap;
 }
+
+/**
+ * The object infos of a hidden layer whose nodes are created on demand.
+ */
+struct DeferredLayerInfo
+{
+  std::vector<MapReader::ObjectInfo> objectInfos;
+  std::optional<mdl::IdType> maxGroupId;
+  size_t objectCount = 0;
+};
+
+/**
+ * Returns the ID of the layer or group that would be created for the given entity
+ * properties, or an empty optional if no layer or group would be created.
+ */
+std::optional<mdl::IdType> parseLayerOrGroupId(
+  const std::vector<mdl::EntityProperty>& properties,
+  const std::string& nameKey,
+  const std::string& idKey)
+{
+  if (kdl::str_is_blank(findEntityPropertyOrDefault(properties, nameKey)))
+  {
+    return std::nullopt;
+  }
+
+  const auto rawId = kdl::str_to_size(findEntityPropertyOrDefault(properties, idKey));
+  return rawId && *rawId > 0u ? std::optional{static_cast<mdl::IdType>(*rawId)}
+                              : std::nullopt;
+}
+
+/**
+ * Returns the names that the given entity properties link to or are linked by, i.e., the
+ * values of the targetname, target and killtarget properties.
+ */
+std::vector<std::string> collectLinkNames(
+  const std::vector<mdl::EntityProperty>& properties)
+{
+  auto result = std::vector<std::string>{};
+  for (const auto& property : properties)
+  {
+    const auto& key = property.key();
+    if (
+      !property.value().empty()
+      && (key == mdl::EntityPropertyKeys::Targetname
+          || mdl::isNumberedProperty(mdl::EntityPropertyKeys::Target, key)
+          || mdl::isNumberedProperty(mdl::EntityPropertyKeys::Killtarget, key)))
+    {
+      result.push_back(property.value());
+    }
+  }
+  return result;
+}
+
+std::optional<size_t>* getParentIndex(MapReader::ObjectInfo& objectInfo)
+{
+  return std::visit(
+    kdl::overload(
+      [](MapReader::EntityInfo&) -> std::optional<size_t>* { return nullptr; },
+      [](MapReader::BrushInfo& brushInfo) { return &brushInfo.parentIndex; },
+      [](MapReader::PatchInfo& patchInfo) { return &patchInfo.parentIndex; }),
+    objectInfo);
+}
+
+/**
+ * Moves the object infos that belong to hidden custom layers out of the given vector and
+ * returns them by layer ID. The object infos keep their file order, and their parent
+ * indices are adjusted to their new positions. Brushes and patches that belong directly
+ * to a deferred layer lose their parent index.
+ *
+ * Creating a layer's nodes later must yield the same nodes as creating them now, so
+ * nothing is deferred if layer or group IDs are not unique, and a layer is not deferred
+ * if it contains a group that is linked to another group. Since the links between
+ * entities are resolved by name, a layer is also not deferred if it contains an entity
+ * that links to or is linked by an entity in another layer.
+ */
+std::unordered_map<mdl::IdType, DeferredLayerInfo> takeDeferredObjectInfos(
+  std::vector<MapReader::ObjectInfo>& objectInfos)
+{
+  auto layerIds = std::unordered_set<mdl::IdType>{};
+  auto hiddenLayerIds = std::unordered_set<mdl::IdType>{};
+  auto groupContainers = std::unordered_map<mdl::IdType, std::optional<ContainerInfo>>{};
+  auto linkIdCounts = std::unordered_map<std::string, size_t>{};
+
+  // the container of every entity info that would become an entity or group node, and
+  // the ID of every entity info that would become a layer or group node
+  auto containers = std::vector<std::optional<ContainerInfo>>(objectInfos.size());
+  auto ownContainers = std::vector<std::optional<ContainerInfo>>(objectInfos.size());
+  auto linkIds = std::vector<std::string>(objectInfos.size());
+  auto linkNames = std::vector<std::vector<std::string>>(objectInfos.size());
+
+  for (size_t i = 0; i < objectInfos.size(); ++i)
+  {
+    const auto* entityInfo = std::get_if<MapReader::EntityInfo>(&objectInfos[i]);
+    if (!entityInfo)
+    {
+      continue;
+    }
+
+    const auto& properties = entityInfo->properties;
+    const auto& classname =
+      findEntityPropertyOrDefault(properties, mdl::EntityPropertyKeys::Classname);
+    if (mdl::isWorldspawn(classname))
+    {
+      linkNames[i] = collectLinkNames(properties);
+      continue;
+    }
+
+    if (isLayer(classname, properties))
+    {
+      if (const auto layerId = parseLayerOrGroupId(
+            properties,
+            mdl::EntityPropertyKeys::LayerName,
+            mdl::EntityPropertyKeys::LayerId))
+      {
+        if (!layerIds.insert(*layerId).second)
+        {
+          return {};
+        }
+        if (
+          findEntityPropertyOrDefault(properties, mdl::EntityPropertyKeys::LayerHidden)
+          == mdl::EntityPropertyValues::LayerHiddenValue)
+        {
+          hiddenLayerIds.insert(*layerId);
+        }
+        ownContainers[i] = ContainerInfo{ContainerType::Layer, *layerId};
+      }
+      continue;
+    }
+
+    auto nodeIssues = std::vector<NodeIssue>{};
+    if (isGroup(classname, properties))
+    {
+      if (const auto groupId = parseLayerOrGroupId(
+            properties,
+            mdl::EntityPropertyKeys::GroupName,
+            mdl::EntityPropertyKeys::GroupId))
+      {
+        containers[i] = extractContainerInfo(properties, nodeIssues);
+        if (!groupContainers.emplace(*groupId, containers[i]).second)
+        {
+          return {};
+        }
+        ownContainers[i] = ContainerInfo{ContainerType::Group, *groupId};
+
+        linkIds[i] =
+          findEntityPropertyOrDefault(properties, mdl::EntityPropertyKeys::LinkId);
+        if (!linkIds[i].empty())
+        {
+          ++linkIdCounts[linkIds[i]];
+        }
+      }
+      continue;
+    }
+
+    containers[i] = extractContainerInfo(properties, nodeIssues);
+    ownContainers[i] = containers[i];
+    linkNames[i] = collectLinkNames(properties);
+  }
+
+  if (hiddenLayerIds.empty())
+  {
+    return {};
+  }
+
+  // finds the layer that a node with the given container ends up in, or returns an empty
+  // optional if the node ends up in the default layer
+  const auto findLayerId =
+    [&](std::optional<ContainerInfo> containerInfo) -> std::optional<mdl::IdType> {
+    // a cycle of groups cannot be longer than the number of groups
+    for (size_t i = 0; containerInfo && i <= groupContainers.size(); ++i)
+    {
+      if (containerInfo->type == ContainerType::Layer)
+      {
+        return layerIds.contains(containerInfo->id) ? std::optional{containerInfo->id}
+                                                    : std::nullopt;
+      }
+
+      const auto groupIt = groupContainers.find(containerInfo->id);
+      if (groupIt == groupContainers.end())
+      {
+        return std::nullopt;
+      }
+      containerInfo = groupIt->second;
+    }
+    return std::nullopt;
+  };
+
+  auto deferredLayerIds = std::move(hiddenLayerIds);
+  for (size_t i = 0; i < objectInfos.size(); ++i)
+  {
+    if (!linkIds[i].empty() && linkIdCounts[linkIds[i]] > 1u)
+    {
+      if (const auto layerId = findLayerId(containers[i]))
+      {
+        deferredLayerIds.erase(*layerId);
+      }
+    }
+  }
+
+  // the layers of the entities that use each link name, where an empty optional stands
+  // for the default layer
+  auto linkNameLayerIds =
+    std::unordered_map<std::string, std::unordered_set<std::optional<mdl::IdType>>>{};
+  for (size_t i = 0; i < objectInfos.size(); ++i)
+  {
+    for (const auto& linkName : linkNames[i])
+    {
+      linkNameLayerIds[linkName].insert(findLayerId(containers[i]));
+    }
+  }
+
+  for (const auto& [linkName, layerIds] : linkNameLayerIds)
+  {
+    if (layerIds.size() > 1u)
+    {
+      for (const auto& layerId : layerIds)
+      {
+        if (layerId)
+        {
+          deferredLayerIds.erase(*layerId);
+        }
+      }
+    }
+  }
+
+  if (deferredLayerIds.empty())
+  {
+    return {};
+  }
+
+  // the deferred layer that each object info belongs to, and that the children of each
+  // entity info belong to
+  auto objectLayerIds = std::vector<std::optional<mdl::IdType>>(objectInfos.size());
+  auto childLayerIds = std::vector<std::optional<mdl::IdType>>(objectInfos.size());
+  const auto isDeferred = [&](const auto& layerId) {
+    return layerId && deferredLayerIds.contains(*layerId);
+  };
+
+  for (size_t i = 0; i < objectInfos.size(); ++i)
+  {
+    if (auto* parentIndex = getParentIndex(objectInfos[i]))
+    {
+      if (*parentIndex)
+      {
+        objectLayerIds[i] = childLayerIds[**parentIndex];
+      }
+    }
+    else if (const auto& ownContainer = ownContainers[i])
+    {
+      if (const auto layerId = findLayerId(containers[i]); isDeferred(layerId))
+      {
+        objectLayerIds[i] = layerId;
+      }
+      if (const auto layerId = findLayerId(ownContainer); isDeferred(layerId))
+      {
+        childLayerIds[i] = layerId;
+      }
+    }
+  }
+
+  auto result = std::unordered_map<mdl::IdType, DeferredLayerInfo>{};
+  auto remainingObjectInfos = std::vector<MapReader::ObjectInfo>{};
+  auto newIndices = std::vector<size_t>(objectInfos.size());
+
+  for (size_t i = 0; i < objectInfos.size(); ++i)
+  {
+    auto& objectInfo = objectInfos[i];
+    auto* parentIndex = getParentIndex(objectInfo);
+
+    if (const auto layerId = objectLayerIds[i])
+    {
+      auto& deferredLayerInfo = result[*layerId];
+      if (parentIndex && *parentIndex)
+      {
+        *parentIndex = objectLayerIds[**parentIndex]
+                         ? std::optional{newIndices[**parentIndex]}
+                         : std::nullopt;
+      }
+
+      // brushes and patches of the layer entity itself lose their parent index, and
+      // entities and groups name the layer as their container
+      if (
+        parentIndex ? !*parentIndex
+                    : containers[i] && containers[i]->type == ContainerType::Layer)
+      {
+        ++deferredLayerInfo.objectCount;
+      }
+      if (const auto& ownContainer = ownContainers[i];
+          ownContainer && ownContainer->type == ContainerType::Group)
+      {
+        deferredLayerInfo.maxGroupId =
+          std::max(deferredLayerInfo.maxGroupId.value_or(0u), ownContainer->id);
+      }
+
+      newIndices[i] = deferredLayerInfo.objectInfos.size();
+      deferredLayerInfo.objectInfos.push_back(std::move(objectInfo));
+    }
+    else
+    {
+      if (parentIndex && *parentIndex)
+      {
+        *parentIndex = newIndices[**parentIndex];
+      }
+
+      newIndices[i] = remainingObjectInfos.size();
+      remainingObjectInfos.push_back(std::move(objectInfo));
+    }
+  }
+
+  objectInfos = std::move(remainingObjectInfos);
+  return result;
+}
+
+/**
+ * Creates the nodes of a deferred layer in the same way as MapReader::createNodes does
+ * and returns the nodes that belong directly to the layer.
+ */
+std::vector<std::unique_ptr<mdl::Node>> createDeferredNodes(
+  std::vector<MapReader::ObjectInfo> objectInfos,
+  const mdl::IdType layerId,
+  const mdl::EntityPropertyConfig& entityPropertyConfig,
+  const vm::bbox3d& worldBounds,
+  const mdl::MapFormat mapFormat,
+  ParserStatus& status,
+  kdl::task_manager& taskManager)
+{
+  auto nodeInfos = createNodesFromObjectInfos(
+    entityPropertyConfig,
+    std::move(objectInfos),
+    worldBounds,
+    mapFormat,
+    status,
+    taskManager);
+
+  // the layer node is not among the object infos, so a placeholder stands in for it when
+  // the parents of the nodes are resolved
+  auto layerPlaceholder = std::make_unique<mdl::LayerNode>(mdl::Layer{"placeholder"});
+  layerPlaceholder->setPersistentId(layerId);
+
+  const auto* layerNode = layerPlaceholder.get();
+  nodeInfos.emplace_back(NodeInfo{std::move(layerPlaceholder), {}, {}});
+
+  const auto nodeToParentMap = buildNodeToParentMap(nodeInfos, status);
+  validateRecursiveLinkedGroups(nodeInfos, nodeToParentMap, status);
+  logValidationIssues(nodeInfos, status);
+
+  auto result = std::vector<std::unique_ptr<mdl::Node>>{};
+  for (auto& nodeInfo : nodeInfos)
+  {
+    if (nodeInfo && nodeInfo->node.get() != layerNode)
+    {
+      auto& node = nodeInfo->node;
+      const auto parentNodeIt = nodeToParentMap.find(node.get());
+      if (parentNodeIt != nodeToParentMap.end() && parentNodeIt->second != layerNode)
+      {
+        parentNodeIt->second->addChild(node.release());
+      }
+      else
+      {
+        result.push_back(std::move(node));
+      }
+    }
+  }
+  return result;
+}
+
+std::unordered_map<std::string, size_t> countMaterialUsages(
+  const std::vector<MapReader::ObjectInfo>& objectInfos)
+{
+  auto result = std::unordered_map<std::string, size_t>{};
+  for (const auto& objectInfo : objectInfos)
+  {
+    std::visit(
+      kdl::overload(
+        [](const MapReader::EntityInfo&) {},
+        [&](const MapReader::BrushInfo& brushInfo) {
+          for (const auto& face : brushInfo.faces)
+          {
+            ++result[kdl::str_to_lower(face.attributes().materialName())];
+          }
+        },
+        [&](const MapReader::PatchInfo& patchInfo) {
+          ++result[kdl::str_to_lower(patchInfo.materialName)];
+        }),
+      objectInfo);
+  }
+  return result;
+}
+
+mdl::DeferredLayerContents createDeferredLayerContents(
+  DeferredLayerInfo deferredLayerInfo,
+  const mdl::IdType layerId,
+  const mdl::EntityPropertyConfig& entityPropertyConfig,
+  const vm::bbox3d& worldBounds,
+  const mdl::MapFormat mapFormat)
+{
+  auto materialUsageCounts = countMaterialUsages(deferredLayerInfo.objectInfos);
+
+  // the contents can be created more than once if the layer is cloned
+  auto objectInfos = std::make_shared<const std::vector<MapReader::ObjectInfo>>(
+    std::move(deferredLayerInfo.objectInfos));
+
+  return {
+    [=](Logger& logger, kdl::task_manager& taskManager) {
+      auto status = SimpleParserStatus{logger};
+      return createDeferredNodes(
+        *objectInfos,
+        layerId,
+        entityPropertyConfig,
+        worldBounds,
+        mapFormat,
+        status,
+        taskManager);
+    },
+    deferredLayerInfo.maxGroupId,
+    std::move(materialUsageCounts),
+    deferredLayerInfo.objectCount,
+  };
+}
+
 } // namespace
 
 /**
@@ -924,6 +1352,11 @@ std::unordered_map<mdl::Node*, mdl::Node*> buildNodeToParentMap(
  */
 void MapReader::createNodes(ParserStatus& status, kdl::task_manager& taskManager)
 {
+  // set aside the contents of hidden layers, their nodes are created on demand
+  auto deferredLayerInfos = m_deferHiddenLayers
+                              ? takeDeferredObjectInfos(m_objectInfos)
+                              : std::unordered_map<mdl::IdType, DeferredLayerInfo>{};
+
   // create nodes from the recorded object infos
   auto nodeInfos = createNodesFromObjectInfos(
     m_entityPropertyConfig,
@@ -979,7 +1412,20 @@ void MapReader::createNodes(ParserStatus& status, kdl::task_manager& taskManager
         [&](mdl::WorldNode*) {
           // this should not happen since we already cleared out any world nodes
         },
-        [&](mdl::LayerNode*) { onLayerNode(std::move(node), status); },
+        [&](mdl::LayerNode* layerNode) {
+          const auto layerId = *layerNode->persistentId();
+          if (const auto it = deferredLayerInfos.find(layerId);
+              it != deferredLayerInfos.end())
+          {
+            layerNode->setDeferredContents(createDeferredLayerContents(
+              std::move(it->second),
+              layerId,
+              m_entityPropertyConfig,
+              m_worldBounds,
+              m_targetMapFormat));
+          }
+          onLayerNode(std::move(node), status);
+        },
         [&](mdl::GroupNode*) { onNode(parentNode, std::move(node), status); },
         [&](mdl::EntityNode*) { onNode(parentNode, std::move(node), status); },
         [&](mdl::BrushNode*) { onNode(parentNode, std::move(node), status); },
@@ -108,6 +108,7 @@ public: // only public so that helper methods can see these declarations
 private:
   mdl::EntityPropertyConfig m_entityPropertyConfig;
   vm::bbox3d m_worldBounds;
+  bool m_deferHiddenLayers = false;
 
 private: // data populated in response to MapParser callbacks
   std::vector<ObjectInfo> m_objectInfos;
@@ -130,6 +131,12 @@ protected:
     mdl::MapFormat targetMapFormat,
     mdl::EntityPropertyConfig entityPropertyConfig);
 
+  /**
+   * If enabled, the contents of hidden custom layers are not turned into nodes. Instead,
+   * they are attached to their layer nodes as deferred contents (see LayerNode).
+   */
+  void setDeferHiddenLayers(bool deferHiddenLayers);
+
   /**
    * Attempts to parse as one or more entities.
    */
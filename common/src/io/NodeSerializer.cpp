@@ -139,11 +139,15 @@ void NodeSerializer::defaultLayer(const mdl::WorldNode& world)
   }
 }
 
-void NodeSerializer::customLayer(const mdl::LayerNode* layer)
+void NodeSerializer::customLayer(
+  const mdl::LayerNode* layer, const std::vector<mdl::Node*>& additionalNodes)
 {
   if (!(m_exporting && layer->layer().omitFromExport()))
   {
-    entity(layer, layerProperties(layer), {}, layer);
+    beginEntity(layer, layerProperties(layer), {});
+    brushesAndPatches(layer->children());
+    brushesAndPatches(additionalNodes);
+    endEntity(layer);
   }
 }
 
@@ -160,15 +164,7 @@ void NodeSerializer::entity(
   const mdl::Node* brushParent)
 {
   beginEntity(node, properties, extraProperties);
-
-  brushParent->visitChildren(kdl::overload(
-    [](const mdl::WorldNode*) {},
-    [](const mdl::LayerNode*) {},
-    [](const mdl::GroupNode*) {},
-    [](const mdl::EntityNode*) {},
-    [&](const mdl::BrushNode* b) { brush(b); },
-    [&](const mdl::PatchNode* p) { patch(p); }));
-
+  brushesAndPatches(brushParent->children());
   endEntity(node);
 }
 
@@ -218,6 +214,19 @@ void NodeSerializer::entityProperty(const mdl::EntityProperty& property)
   doEntityProperty(property);
 }
 
+void NodeSerializer::brushesAndPatches(const std::vector<mdl::Node*>& nodes)
+{
+  mdl::Node::visitAll(
+    nodes,
+    kdl::overload(
+      [](const mdl::WorldNode*) {},
+      [](const mdl::LayerNode*) {},
+      [](const mdl::GroupNode*) {},
+      [](const mdl::EntityNode*) {},
+      [&](const mdl::BrushNode* b) { brush(b); },
+      [&](const mdl::PatchNode* p) { patch(p); }));
+}
+
 void NodeSerializer::brushes(const std::vector<mdl::BrushNode*>& brushNodes)
 {
   for (auto* brush : brushNodes)
@@ -96,7 +96,8 @@ public:
 
 public:
   void defaultLayer(const mdl::WorldNode& world);
-  void customLayer(const mdl::LayerNode* layer);
+  void customLayer(
+    const mdl::LayerNode* layer, const std::vector<mdl::Node*>& additionalNodes = {});
   void group(
     const mdl::GroupNode* group,
     const std::vector<mdl::EntityProperty>& parentProperties);
@@ -123,6 +124,7 @@ private:
   void entityProperties(const std::vector<mdl::EntityProperty>& properties);
   void entityProperty(const mdl::EntityProperty& property);
 
+  void brushesAndPatches(const std::vector<mdl::Node*>& nodes);
   void brushes(const std::vector<mdl::BrushNode*>& brushNodes);
   void brush(const mdl::BrushNode* brushNode);
 
@@ -30,6 +30,7 @@
 #include "mdl/PatchNode.h"
 #include "mdl/WorldNode.h"
 
+#include "kdl/map_utils.h"
 #include "kdl/overload.h"
 #include "kdl/string_format.h"
 #include "kdl/string_utils.h"
@@ -106,9 +107,20 @@ void NodeWriter::setExporting(const bool exporting)
   m_serializer->setExporting(exporting);
 }
 
+void NodeWriter::setAdditionalLayerNodes(LayerNodesMap additionalLayerNodes)
+{
+  m_additionalLayerNodes = std::move(additionalLayerNodes);
+}
+
 void NodeWriter::writeMap(kdl::task_manager& taskManager)
 {
-  m_serializer->beginFile({&m_world}, taskManager);
+  auto rootNodes = std::vector<const mdl::Node*>{&m_world};
+  for (const auto& [layerNode, nodes] : m_additionalLayerNodes)
+  {
+    rootNodes.insert(rootNodes.end(), nodes.begin(), nodes.end());
+  }
+
+  m_serializer->beginFile(rootNodes, taskManager);
   writeDefaultLayer();
   writeCustomLayers();
   m_serializer->endFile();
@@ -137,8 +149,12 @@ void NodeWriter::writeCustomLayer(const mdl::LayerNode* layerNode)
 {
   if (!(m_serializer->exporting() && layerNode->layer().omitFromExport()))
   {
-    m_serializer->customLayer(layerNode);
+    const auto additionalNodes = kdl::map_find_or_default(
+      m_additionalLayerNodes, layerNode, std::vector<mdl::Node*>{});
+
+    m_serializer->customLayer(layerNode, additionalNodes);
     doWriteNodes(*m_serializer, layerNode->children(), layerNode);
+    doWriteNodes(*m_serializer, additionalNodes, layerNode);
   }
 }
 
@@ -44,11 +44,15 @@ class NodeSerializer;
 
 class NodeWriter
 {
+public:
+  using LayerNodesMap = std::map<const mdl::LayerNode*, std::vector<mdl::Node*>>;
+
 private:
   using EntityBrushesMap = std::map<mdl::EntityNode*, std::vector<mdl::BrushNode*>>;
 
   const mdl::WorldNode& m_world;
   std::unique_ptr<NodeSerializer> m_serializer;
+  LayerNodesMap m_additionalLayerNodes;
 
 public:
   NodeWriter(const mdl::WorldNode& world, std::ostream& stream);
@@ -56,6 +60,13 @@ public:
   ~NodeWriter();
 
   void setExporting(bool exporting);
+
+  /**
+   * Sets nodes that writeMap() writes as contents of the given layers after their
+   * children. The nodes must not belong to the world. This allows writing the deferred
+   * contents of a hidden layer without adding them to the layer.
+   */
+  void setAdditionalLayerNodes(LayerNodesMap additionalLayerNodes);
   void writeMap(kdl::task_manager& taskManager);
 
 private:
@@ -19,8 +19,8 @@
 
 #include "PathMatcher.h"
 
+#include "kdl/glob_matcher.h"
 #include "kdl/path_utils.h"
-#include "kdl/string_compare.h"
 #include "kdl/vector_utils.h"
 
 namespace tb::io
@@ -37,11 +37,11 @@ PathMatcher makeExtensionPathMatcher(std::vector<std::filesystem::path> extensio
   };
 }
 
-PathMatcher makeFilenamePathMatcher(std::string pattern_)
+PathMatcher makeFilenamePathMatcher(std::string pattern)
 {
-  return [pattern = std::move(pattern_)](
+  return [matcher = kdl::ci::make_glob_matcher(pattern)](
            const std::filesystem::path& path, const GetPathInfo&) {
-    return kdl::ci::str_matches_glob(path.filename().string(), pattern);
+    return matcher.matches(path.filename().string());
   };
 }
 
@@ -71,6 +71,7 @@ Result<std::unique_ptr<mdl::WorldNode>> WorldReader::tryRead(
   const std::vector<mdl::MapFormat>& mapFormatsToTry,
   const vm::bbox3d& worldBounds,
   const mdl::EntityPropertyConfig& entityPropertyConfig,
+  const bool deferHiddenLayers,
   ParserStatus& status,
   kdl::task_manager& taskManager)
 {
@@ -84,6 +85,7 @@ Result<std::unique_ptr<mdl::WorldNode>> WorldReader::tryRead(
     }
 
     auto reader = WorldReader{str, mapFormat, entityPropertyConfig};
+    reader.setDeferHiddenLayers(deferHiddenLayers);
     if (auto result = reader.read(worldBounds, status, taskManager); result.is_success())
     {
       return result;
@@ -53,6 +53,8 @@ public:
     mdl::MapFormat sourceAndTargetMapFormat,
     const mdl::EntityPropertyConfig& entityPropertyConfig);
 
+  using MapReader::setDeferHiddenLayers;
+
   Result<std::unique_ptr<mdl::WorldNode>> read(
     const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager);
 
@@ -63,6 +65,8 @@ public:
    * @param str the string to parse
    * @param mapFormatsToTry formats to try, in order
    * @param worldBounds world bounds
+   * @param entityPropertyConfig the entity property config
+   * @param deferHiddenLayers whether to defer the contents of hidden layers
    * @param status status
    * @param taskManager the task manager to use for parallel tasks
    * @return the world node or an error if `str` can't be parsed by any of the given
@@ -73,6 +77,7 @@ public:
     const std::vector<mdl::MapFormat>& mapFormatsToTry,
     const vm::bbox3d& worldBounds,
     const mdl::EntityPropertyConfig& entityPropertyConfig,
+    bool deferHiddenLayers,
     ParserStatus& status,
     kdl::task_manager& taskManager);
 
@@ -152,7 +152,7 @@ void BezierPatch::setMaterialName(std::string materialName)
 
 const Material* BezierPatch::material() const
 {
-  return m_materialReference.get();
+  return m_material;
 }
 
 bool BezierPatch::setMaterial(Material* material)
@@ -162,7 +162,7 @@ bool BezierPatch::setMaterial(Material* material)
     return false;
   }
 
-  m_materialReference = AssetReference{material};
+  m_material = material;
   return true;
 }
 
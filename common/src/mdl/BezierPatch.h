@@ -19,8 +19,6 @@
 
 #pragma once
 
-#include "mdl/AssetReference.h"
-
 #include "kdl/reflection_decl.h"
 
 #include "vm/bbox.h"
@@ -45,7 +43,7 @@ private:
   vm::bbox3d m_bounds;
 
   std::string m_materialName;
-  AssetReference<Material> m_materialReference;
+  const Material* m_material = nullptr;
 
   kdl_reflect_decl(
     BezierPatch,
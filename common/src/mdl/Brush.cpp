@@ -23,6 +23,7 @@
 #include "Polyhedron_Matcher.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushGeometry.h"
+#include "mdl/GJK.h"
 #include "mdl/MapFormat.h"
 #include "mdl/UVCoordSystem.h"
 
@@ -38,6 +39,7 @@
 #include "vm/segment.h"
 #include "vm/util.h"
 
+#include <algorithm>
 #include <iterator>
 #include <set>
 #include <string>
@@ -655,14 +657,15 @@ Result<void> Brush::snapVertices(
 
   const BrushGeometry newGeometry = snappedGeometry(*m_geometry, snapToF);
 
-  std::map<vm::vec3d, vm::vec3d> vertexMapping;
+  auto vertexMapping = PolyhedronMatcher<BrushGeometry>::VertexMapping{};
+  vertexMapping.reserve(m_geometry->vertexCount());
   for (const auto* vertex : m_geometry->vertices())
   {
     const auto& origin = vertex->position();
     const auto destination = snapToF * round(origin / snapToF);
     if (newGeometry.hasVertex(destination))
     {
-      vertexMapping.insert(std::make_pair(origin, destination));
+      vertexMapping.emplace_back(origin, destination);
     }
   }
 
@@ -956,13 +959,15 @@ Result<void> Brush::doTransformVertices(
   ensure(!vertexPositions.empty(), "no vertex positions");
   assert(canTransformVertices(worldBounds, vertexPositions, transform));
 
+  const auto sortedVertexPositions = kdl::vec_sort(vertexPositions);
+
   std::vector<vm::vec3d> newVertices;
   newVertices.reserve(vertexCount());
 
   for (const auto* vertex : m_geometry->vertices())
   {
     const auto& position = vertex->position();
-    if (kdl::vec_contains(vertexPositions, position))
+    if (std::ranges::binary_search(sortedVertexPositions, position))
     {
       newVertices.push_back(transform * position);
     }
@@ -974,18 +979,17 @@ Result<void> Brush::doTransformVertices(
 
   BrushGeometry newGeometry(newVertices);
 
-  using VecMap = std::map<vm::vec3d, vm::vec3d>;
-  VecMap vertexMapping;
-  for (auto* oldVertex : m_geometry->vertices())
+  auto vertexMapping = PolyhedronMatcher<BrushGeometry>::VertexMapping{};
+  vertexMapping.reserve(newVertices.size());
+
+  auto newPosition = newVertices.begin();
+  for (const auto* oldVertex : m_geometry->vertices())
   {
-    const auto& oldPosition = oldVertex->position();
-    const auto transformed = kdl::vec_contains(vertexPositions, oldPosition);
-    const auto newPosition = transformed ? transform * oldPosition : oldPosition;
     const auto* newVertex =
-      newGeometry.findClosestVertex(newPosition, CloseVertexEpsilon);
+      newGeometry.findClosestVertex(*newPosition++, CloseVertexEpsilon);
     if (newVertex != nullptr)
     {
-      vertexMapping.insert(std::make_pair(oldPosition, newVertex->position()));
+      vertexMapping.emplace_back(oldVertex->position(), newVertex->position());
     }
   }
 
@@ -1224,7 +1228,7 @@ bool Brush::intersects(const vm::bbox3d& bounds) const
 
 bool Brush::intersects(const Brush& brush) const
 {
-  return m_geometry->intersects(*brush.m_geometry);
+  return gjkIntersects(*m_geometry, *brush.m_geometry);
 }
 
 Result<Brush> Brush::createBrush(
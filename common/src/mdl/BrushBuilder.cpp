@@ -728,7 +728,7 @@ Result<Brush> BrushBuilder::createIcoSphere(
 Result<Brush> BrushBuilder::createBrush(
   const std::vector<vm::vec3d>& points, const std::string& materialName) const
 {
-  return createBrush(Polyhedron3{points}, materialName);
+  return createBrush(Polyhedron3{points, ConvexHullAlgorithm::QuickHull}, materialName);
 }
 
 Result<Brush> BrushBuilder::createBrush(
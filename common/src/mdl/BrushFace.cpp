@@ -43,6 +43,7 @@
 
 #include <string>
 #include <utility>
+#include <variant>
 
 namespace tb::mdl
 {
@@ -63,8 +64,8 @@ BrushFace::BrushFace(const BrushFace& other)
   , m_points{other.m_points}
   , m_boundary{other.m_boundary}
   , m_attributes{other.m_attributes}
-  , m_materialReference{other.m_materialReference}
-  , m_uvCoordSystem{other.m_uvCoordSystem ? other.m_uvCoordSystem->clone() : nullptr}
+  , m_material{other.m_material}
+  , m_uvCoordSystem{other.m_uvCoordSystem}
   , m_lineNumber{other.m_lineNumber}
   , m_lineCount{other.m_lineCount}
   , m_selected{other.m_selected}
@@ -78,7 +79,7 @@ BrushFace::BrushFace(BrushFace&& other) noexcept
   , m_points{std::move(other.m_points)}
   , m_boundary{std::move(other.m_boundary)}
   , m_attributes{std::move(other.m_attributes)}
-  , m_materialReference{std::move(other.m_materialReference)}
+  , m_material{other.m_material}
   , m_uvCoordSystem{std::move(other.m_uvCoordSystem)}
   , m_geometry{other.m_geometry}
   , m_lineNumber{other.m_lineNumber}
@@ -102,7 +103,7 @@ void swap(BrushFace& lhs, BrushFace& rhs) noexcept
   swap(lhs.m_points, rhs.m_points);
   swap(lhs.m_boundary, rhs.m_boundary);
   swap(lhs.m_attributes, rhs.m_attributes);
-  swap(lhs.m_materialReference, rhs.m_materialReference);
+  swap(lhs.m_material, rhs.m_material);
   swap(lhs.m_uvCoordSystem, rhs.m_uvCoordSystem);
   swap(lhs.m_geometry, rhs.m_geometry);
   swap(lhs.m_lineNumber, rhs.m_lineNumber);
@@ -128,15 +129,13 @@ Result<BrushFace> BrushFace::create(
                point1,
                point2,
                attributes,
-               std::make_unique<ParallelUVCoordSystem>(
-                 point0, point1, point2, attributes))
+               ParallelUVCoordSystem{point0, point1, point2, attributes})
            : BrushFace::create(
                point0,
                point1,
                point2,
                attributes,
-               std::make_unique<ParaxialUVCoordSystem>(
-                 point0, point1, point2, attributes));
+               ParaxialUVCoordSystem{point0, point1, point2, attributes});
 }
 
 Result<BrushFace> BrushFace::createFromStandard(
@@ -148,24 +147,21 @@ Result<BrushFace> BrushFace::createFromStandard(
 {
   assert(mapFormat != MapFormat::Unknown);
 
-  auto uvCoordSystem = std::unique_ptr<UVCoordSystem>{};
-  auto attribs = BrushFaceAttributes{""};
-
   if (mdl::isParallelUVCoordSystem(mapFormat))
   {
     // Convert paraxial to parallel
-    std::tie(uvCoordSystem, attribs) =
+    auto [uvCoordSystem, attribs] =
       ParallelUVCoordSystem::fromParaxial(point0, point1, point2, inputAttribs);
-  }
-  else
-  {
-    // Pass through paraxial
-    uvCoordSystem =
-      std::make_unique<ParaxialUVCoordSystem>(point0, point1, point2, inputAttribs);
-    attribs = inputAttribs;
+    return BrushFace::create(point0, point1, point2, attribs, std::move(uvCoordSystem));
   }
 
-  return BrushFace::create(point0, point1, point2, attribs, std::move(uvCoordSystem));
+  // Pass through paraxial
+  return BrushFace::create(
+    point0,
+    point1,
+    point2,
+    inputAttribs,
+    ParaxialUVCoordSystem{point0, point1, point2, inputAttribs});
 }
 
 Result<BrushFace> BrushFace::createFromValve(
@@ -179,22 +175,16 @@ Result<BrushFace> BrushFace::createFromValve(
 {
   assert(mapFormat != MapFormat::Unknown);
 
-  auto uvCoordSystem = std::unique_ptr<UVCoordSystem>{};
-  auto attribs = BrushFaceAttributes{""};
-
   if (mdl::isParallelUVCoordSystem(mapFormat))
   {
     // Pass through parallel
-    uvCoordSystem = std::make_unique<ParallelUVCoordSystem>(uAxis, vAxis);
-    attribs = inputAttribs;
-  }
-  else
-  {
-    // Convert parallel to paraxial
-    std::tie(uvCoordSystem, attribs) = ParaxialUVCoordSystem::fromParallel(
-      point1, point2, point3, inputAttribs, uAxis, vAxis);
+    return BrushFace::create(
+      point1, point2, point3, inputAttribs, ParallelUVCoordSystem{uAxis, vAxis});
   }
 
+  // Convert parallel to paraxial
+  auto [uvCoordSystem, attribs] = ParaxialUVCoordSystem::fromParallel(
+    point1, point2, point3, inputAttribs, uAxis, vAxis);
   return BrushFace::create(point1, point2, point3, attribs, std::move(uvCoordSystem));
 }
 
@@ -203,7 +193,7 @@ Result<BrushFace> BrushFace::create(
   const vm::vec3d& point1,
   const vm::vec3d& point2,
   const BrushFaceAttributes& attributes,
-  std::unique_ptr<UVCoordSystem> uvCoordSystem)
+  BrushFaceUVCoordSystem uvCoordSystem)
 {
   auto points = Points{{vm::correct(point0), vm::correct(point1), vm::correct(point2)}};
   if (const auto plane = vm::from_points(points[0], points[1], points[2]))
@@ -217,13 +207,12 @@ BrushFace::BrushFace(
   const BrushFace::Points& points,
   const vm::plane3d& boundary,
   BrushFaceAttributes attributes,
-  std::unique_ptr<UVCoordSystem> uvCoordSystem)
+  BrushFaceUVCoordSystem uvCoordSystem)
   : m_points{points}
   , m_boundary{boundary}
   , m_attributes{std::move(attributes)}
   , m_uvCoordSystem{std::move(uvCoordSystem)}
 {
-  ensure(m_uvCoordSystem != nullptr, "uvCoordSystem is null");
 }
 
 void BrushFace::sortFaces(std::vector<BrushFace>& faces)
@@ -244,13 +233,13 @@ void BrushFace::sortFaces(std::vector<BrushFace>& faces)
 
 std::unique_ptr<UVCoordSystemSnapshot> BrushFace::takeUVCoordSystemSnapshot() const
 {
-  return m_uvCoordSystem->takeSnapshot();
+  return uvCoordSystem().takeSnapshot();
 }
 
 void BrushFace::restoreUVCoordSystemSnapshot(
   const UVCoordSystemSnapshot& coordSystemSnapshot)
 {
-  coordSystemSnapshot.restore(*m_uvCoordSystem);
+  coordSystemSnapshot.restore(mutableUVCoordSystem());
 }
 
 void BrushFace::copyUVCoordSystemFromFace(
@@ -265,14 +254,14 @@ void BrushFace::copyUVCoordSystemFromFace(
     vm::intersect_plane_plane(sourceFacePlane, m_boundary).value_or(vm::line3d{});
   const auto refPoint = vm::project_point(seam, center());
 
-  coordSystemSnapshot.restore(*m_uvCoordSystem);
+  coordSystemSnapshot.restore(mutableUVCoordSystem());
 
   // Get the UV coords at the refPoint using the source face's attributes and tex coord
   // system
   const auto desriedCoords =
-    m_uvCoordSystem->uvCoords(refPoint, attributes, vm::vec2f{1, 1});
+    uvCoordSystem().uvCoords(refPoint, attributes, vm::vec2f{1, 1});
 
-  m_uvCoordSystem->setNormal(
+  mutableUVCoordSystem().setNormal(
     sourceFacePlane.normal, m_boundary.normal, m_attributes, wrapStyle);
 
   // Adjust the offset on this face so that the UV coordinates at the refPoint stay
@@ -280,7 +269,7 @@ void BrushFace::copyUVCoordSystemFromFace(
   if (!vm::is_zero(seam.direction, vm::Cd::almost_zero()))
   {
     const auto currentCoords =
-      m_uvCoordSystem->uvCoords(refPoint, m_attributes, vm::vec2f::one());
+      uvCoordSystem().uvCoords(refPoint, m_attributes, vm::vec2f::one());
     const auto offsetChange = desriedCoords - currentCoords;
     m_attributes.setOffset(correct(modOffset(m_attributes.offset() + offsetChange), 4));
   }
@@ -395,7 +384,8 @@ void BrushFace::setAttributes(const BrushFaceAttributes& attributes)
 {
   const auto oldRotation = m_attributes.rotation();
   m_attributes = attributes;
-  m_uvCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attributes.rotation());
+  mutableUVCoordSystem().setRotation(
+    m_boundary.normal, oldRotation, m_attributes.rotation());
 }
 
 bool BrushFace::setAttributes(const BrushFace& other)
@@ -474,20 +464,19 @@ Color BrushFace::resolvedColor() const
 
 void BrushFace::resetUVCoordSystemCache()
 {
-  if (m_uvCoordSystem)
-  {
-    m_uvCoordSystem->resetCache(m_points[0], m_points[1], m_points[2], m_attributes);
-  }
+  mutableUVCoordSystem().resetCache(m_points[0], m_points[1], m_points[2], m_attributes);
 }
 
 const UVCoordSystem& BrushFace::uvCoordSystem() const
 {
-  return *m_uvCoordSystem;
+  return std::visit(
+    [](const auto& uvCoordSystem) -> const UVCoordSystem& { return uvCoordSystem; },
+    m_uvCoordSystem);
 }
 
 const Material* BrushFace::material() const
 {
-  return m_materialReference.get();
+  return m_material;
 }
 
 vm::vec2f BrushFace::textureSize() const
@@ -511,64 +500,76 @@ bool BrushFace::setMaterial(Material* material)
     return false;
   }
 
-  m_materialReference = AssetReference(material);
+  m_material = material;
   return true;
 }
 
 vm::vec3d BrushFace::uAxis() const
 {
-  return m_uvCoordSystem->uAxis();
+  return uvCoordSystem().uAxis();
 }
 
 vm::vec3d BrushFace::vAxis() const
 {
-  return m_uvCoordSystem->vAxis();
+  return uvCoordSystem().vAxis();
 }
 
 void BrushFace::resetUVAxes()
 {
-  m_uvCoordSystem->reset(m_boundary.normal);
+  mutableUVCoordSystem().reset(m_boundary.normal);
 }
 
 void BrushFace::resetUVAxesToParaxial()
 {
-  m_uvCoordSystem->resetToParaxial(m_boundary.normal, 0.0f);
+  mutableUVCoordSystem().resetToParaxial(m_boundary.normal, 0.0f);
 }
 
 void BrushFace::convertToParaxial()
 {
-  auto [newUVCoordSystem, newAttributes] =
-    m_uvCoordSystem->toParaxial(m_points[0], m_points[1], m_points[2], m_attributes);
-
-  m_attributes = newAttributes;
-  m_uvCoordSystem = std::move(newUVCoordSystem);
+  if (const auto* parallel = std::get_if<ParallelUVCoordSystem>(&m_uvCoordSystem))
+  {
+    auto [newUVCoordSystem, newAttributes] = ParaxialUVCoordSystem::fromParallel(
+      m_points[0],
+      m_points[1],
+      m_points[2],
+      m_attributes,
+      parallel->uAxis(),
+      parallel->vAxis());
+
+    m_attributes = newAttributes;
+    m_uvCoordSystem = std::move(newUVCoordSystem);
+  }
 }
 
 void BrushFace::convertToParallel()
 {
-  auto [newUVCoordSystem, newAttributes] =
-    m_uvCoordSystem->toParallel(m_points[0], m_points[1], m_points[2], m_attributes);
+  if (std::holds_alternative<ParaxialUVCoordSystem>(m_uvCoordSystem))
+  {
+    auto [newUVCoordSystem, newAttributes] = ParallelUVCoordSystem::fromParaxial(
+      m_points[0], m_points[1], m_points[2], m_attributes);
 
-  m_attributes = newAttributes;
-  m_uvCoordSystem = std::move(newUVCoordSystem);
+    m_attributes = newAttributes;
+    m_uvCoordSystem = std::move(newUVCoordSystem);
+  }
 }
 
 void BrushFace::moveUV(
   const vm::vec3d& up, const vm::vec3d& right, const vm::vec2f& offset)
 {
-  m_uvCoordSystem->translate(m_boundary.normal, up, right, offset, m_attributes);
+  uvCoordSystem().translate(m_boundary.normal, up, right, offset, m_attributes);
 }
 
 void BrushFace::rotateUV(const float angle)
 {
   const auto oldRotation = m_attributes.rotation();
-  m_uvCoordSystem->rotate(m_boundary.normal, angle, m_attributes);
-  m_uvCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attributes.rotation());
+  uvCoordSystem().rotate(m_boundary.normal, angle, m_attributes);
+  mutableUVCoordSystem().setRotation(
+    m_boundary.normal, oldRotation, m_attributes.rotation());
 }
 
 void BrushFace::shearUV(const vm::vec2f& factors)
 {
-  m_uvCoordSystem->shear(m_boundary.normal, factors);
+  mutableUVCoordSystem().shear(m_boundary.normal, factors);
 }
 
 void BrushFace::flipUV(
@@ -576,7 +577,7 @@ void BrushFace::flipUV(
   const vm::vec3d& cameraRight,
   const vm::direction cameraRelativeFlipDirection)
 {
-  const auto texToWorld = m_uvCoordSystem->fromMatrix(vm::vec2f{0, 0}, vm::vec2f{1, 1});
+  const auto texToWorld = uvCoordSystem().fromMatrix(vm::vec2f{0, 0}, vm::vec2f{1, 1});
 
   const auto texUAxisInWorld = vm::normalize((texToWorld * vm::vec4d(1, 0, 0, 0)).xyz());
   const auto texVAxisInWorld = vm::normalize((texToWorld * vm::vec4d(0, 1, 0, 0)).xyz());
@@ -636,7 +637,7 @@ Result<void> BrushFace::transform(const vm::mat4x4d& transform, const bool lockA
   }
 
   return setPoints(m_points[0], m_points[1], m_points[2]) | kdl::transform([&]() {
-           m_uvCoordSystem->transform(
+           mutableUVCoordSystem().transform(
              oldBoundary,
              m_boundary,
              transform,
@@ -675,15 +676,15 @@ Result<void> BrushFace::updatePointsFromVertices()
                // Get the UV coordinates at the refPoint using the old face's attribs
                // and UV coordinage system
                const auto desriedCoords =
-                 m_uvCoordSystem->uvCoords(refPoint, m_attributes, vm::vec2f{1, 1});
+                 uvCoordSystem().uvCoords(refPoint, m_attributes, vm::vec2f{1, 1});
 
-               m_uvCoordSystem->setNormal(
+               mutableUVCoordSystem().setNormal(
                  oldPlane.normal, m_boundary.normal, m_attributes, WrapStyle::Projection);
 
                // Adjust the offset on this face so that the UV coordinates at the
                // refPoint stay the same
                const auto currentCoords =
-                 m_uvCoordSystem->uvCoords(refPoint, m_attributes, vm::vec2f{1, 1});
+                 uvCoordSystem().uvCoords(refPoint, m_attributes, vm::vec2f{1, 1});
                const auto offsetChange = desriedCoords - currentCoords;
                m_attributes.setOffset(
                  correct(modOffset(m_attributes.offset() + offsetChange), 4));
@@ -694,7 +695,7 @@ Result<void> BrushFace::updatePointsFromVertices()
 vm::mat4x4d BrushFace::projectToBoundaryMatrix() const
 {
   const auto texZAxis =
-    m_uvCoordSystem->fromMatrix(vm::vec2f{0, 0}, vm::vec2f{1, 1}) * vm::vec3d{0, 0, 1};
+    uvCoordSystem().fromMatrix(vm::vec2f{0, 0}, vm::vec2f{1, 1}) * vm::vec3d{0, 0, 1};
   const auto worldToPlaneMatrix =
     vm::plane_projection_matrix(m_boundary.distance, m_boundary.normal, texZAxis);
   const auto planeToWorldMatrix = vm::invert(worldToPlaneMatrix);
@@ -704,20 +705,20 @@ vm::mat4x4d BrushFace::projectToBoundaryMatrix() const
 vm::mat4x4d BrushFace::toUVCoordSystemMatrix(
   const vm::vec2f& offset, const vm::vec2f& scale, const bool project) const
 {
-  return project ? vm::mat4x4d::zero_out<2>() * m_uvCoordSystem->toMatrix(offset, scale)
-                 : m_uvCoordSystem->toMatrix(offset, scale);
+  return project ? vm::mat4x4d::zero_out<2>() * uvCoordSystem().toMatrix(offset, scale)
+                 : uvCoordSystem().toMatrix(offset, scale);
 }
 
 vm::mat4x4d BrushFace::fromUVCoordSystemMatrix(
   const vm::vec2f& offset, const vm::vec2f& scale, const bool project) const
 {
-  return project ? projectToBoundaryMatrix() * m_uvCoordSystem->fromMatrix(offset, scale)
-                 : m_uvCoordSystem->fromMatrix(offset, scale);
+  return project ? projectToBoundaryMatrix() * uvCoordSystem().fromMatrix(offset, scale)
+                 : uvCoordSystem().fromMatrix(offset, scale);
 }
 
 float BrushFace::measureUVAngle(const vm::vec2f& center, const vm::vec2f& point) const
 {
-  return m_uvCoordSystem->measureAngle(m_attributes.rotation(), center, point);
+  return uvCoordSystem().measureAngle(m_attributes.rotation(), center, point);
 }
 
 size_t BrushFace::vertexCount() const
@@ -784,7 +785,7 @@ void BrushFace::deselect()
 
 vm::vec2f BrushFace::uvCoords(const vm::vec3d& point) const
 {
-  return m_uvCoordSystem->uvCoords(point, m_attributes, textureSize());
+  return uvCoordSystem().uvCoords(point, m_attributes, textureSize());
 }
 
 std::optional<double> BrushFace::intersectWithRay(const vm::ray3d& ray) const
@@ -825,6 +826,13 @@ void BrushFace::correctPoints()
   }
 }
 
+UVCoordSystem& BrushFace::mutableUVCoordSystem()
+{
+  return std::visit(
+    [](auto& uvCoordSystem) -> UVCoordSystem& { return uvCoordSystem; },
+    m_uvCoordSystem);
+}
+
 void BrushFace::setMarked(const bool marked) const
 {
   m_markedToRenderFace = marked;
@@ -20,9 +20,10 @@
 #pragma once
 
 #include "Result.h"
-#include "mdl/AssetReference.h"
 #include "mdl/BrushFaceAttributes.h"
 #include "mdl/BrushGeometry.h"
+#include "mdl/ParallelUVCoordSystem.h"
+#include "mdl/ParaxialUVCoordSystem.h"
 #include "mdl/Tag.h"
 
 #include "kdl/reflection_decl.h"
@@ -37,16 +38,20 @@
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <variant>
 #include <vector>
 
 namespace tb::mdl
 {
 class Material;
-class UVCoordSystem;
-class UVCoordSystemSnapshot;
-enum class WrapStyle;
 enum class MapFormat;
 
+/**
+ * The UV coordinate system of a brush face, stored by value so that copying a face does
+ * not allocate.
+ */
+using BrushFaceUVCoordSystem = std::variant<ParaxialUVCoordSystem, ParallelUVCoordSystem>;
+
 class BrushFace : public Taggable
 {
 public:
@@ -85,8 +90,8 @@ private:
   vm::plane3d m_boundary;
   BrushFaceAttributes m_attributes;
 
-  AssetReference<Material> m_materialReference;
-  std::unique_ptr<UVCoordSystem> m_uvCoordSystem;
+  const Material* m_material = nullptr;
+  BrushFaceUVCoordSystem m_uvCoordSystem;
   BrushFaceGeometry* m_geometry = nullptr;
 
   mutable size_t m_lineNumber = 0;
@@ -105,7 +110,7 @@ public:
 
   ~BrushFace() override;
 
-  kdl_reflect_decl(BrushFace, m_points, m_boundary, m_attributes, m_materialReference);
+  kdl_reflect_decl(BrushFace, m_points, m_boundary, m_attributes);
 
   /**
    * Creates a face using TB's default UV projection for the given map format and the
@@ -162,13 +167,13 @@ public:
     const vm::vec3d& point1,
     const vm::vec3d& point2,
     const BrushFaceAttributes& attributes,
-    std::unique_ptr<UVCoordSystem> uvCoordSystem);
+    BrushFaceUVCoordSystem uvCoordSystem);
 
   BrushFace(
     const BrushFace::Points& points,
     const vm::plane3d& boundary,
     BrushFaceAttributes attributes,
-    std::unique_ptr<UVCoordSystem> uvCoordSystem);
+    BrushFaceUVCoordSystem uvCoordSystem);
 
   static void sortFaces(std::vector<BrushFace>& faces);
 
@@ -272,6 +277,7 @@ private:
   Result<void> setPoints(
     const vm::vec3d& point0, const vm::vec3d& point1, const vm::vec3d& point2);
   void correctPoints();
+  UVCoordSystem& mutableUVCoordSystem();
 
 public: // brush renderer
   /**
@@ -94,9 +94,13 @@ Brush BrushNode::setBrush(Brush brush)
   const auto nodeChange = NotifyNodeChange{*this};
   const auto boundsChange = NotifyPhysicalBoundsChange{*this};
 
+  removeMaterialsFromIndex();
+
   using std::swap;
   swap(m_brush, brush);
 
+  addMaterialsToIndex();
+
   updateSelectedFaceCount();
   invalidateIssues();
   invalidateVertexCache();
@@ -128,7 +132,13 @@ void BrushNode::updateFaceTags(const size_t faceIndex, TagManager& tagManager)
 
 void BrushNode::setFaceMaterial(const size_t faceIndex, Material* material)
 {
-  m_brush.face(faceIndex).setMaterial(material);
+  auto& face = m_brush.face(faceIndex);
+  const auto* previousMaterial = face.material();
+  if (face.setMaterial(material))
+  {
+    removeFromIndex(this, previousMaterial);
+    addToIndex(this, material);
+  }
 
   invalidateIssues();
   invalidateVertexCache();
@@ -261,6 +271,28 @@ void BrushNode::updateSelectedFaceCount()
   }
 }
 
+void BrushNode::addMaterialsToIndex()
+{
+  for (const auto& face : m_brush.faces())
+  {
+    if (const auto* material = face.material())
+    {
+      addToIndex(this, material);
+    }
+  }
+}
+
+void BrushNode::removeMaterialsFromIndex()
+{
+  for (const auto& face : m_brush.faces())
+  {
+    if (const auto* material = face.material())
+    {
+      removeFromIndex(this, material);
+    }
+  }
+}
+
 const std::string& BrushNode::doGetName() const
 {
   static const std::string name("brush");
@@ -88,6 +88,9 @@ private:
   void clearSelectedFaces();
   void updateSelectedFaceCount();
 
+  void addMaterialsToIndex();
+  void removeMaterialsFromIndex();
+
 private: // implement Node interface
   const std::string& doGetName() const override;
   const vm::bbox3d& doGetLogicalBounds() const override;
@@ -167,6 +167,12 @@ void Entity::setModel(const EntityModel* model)
   m_cachedModelTransformation = std::nullopt;
 }
 
+void Entity::modelDidLoad()
+{
+  m_cachedRotation = std::nullopt;
+  m_cachedModelTransformation = std::nullopt;
+}
+
 const EntityModelFrame* Entity::modelFrame() const
 {
   if (!m_model || !m_model->data())
@@ -144,6 +144,12 @@ public: // property management
   const EntityModel* model() const;
   void setModel(const EntityModel* model);
 
+  /**
+   * Must be called when the data of this entity's model has finished loading because the
+   * cached rotation depends on the model data.
+   */
+  void modelDidLoad();
+
   const EntityModelFrame* modelFrame() const;
   Result<ModelSpecification> modelSpecification() const;
   const vm::mat4x4d& modelTransformation(
@@ -87,7 +87,6 @@ EntityModelFrame::EntityModelFrame(
   : m_index{index}
   , m_name{std::move(name)}
   , m_bounds{bounds}
-  , m_spacialTree{16.0f}
 {
 }
 
@@ -120,7 +119,7 @@ std::optional<float> EntityModelFrame::intersect(const vm::ray3f& ray) const
 {
   auto closestDistance = std::optional<float>{};
 
-  const auto candidates = m_spacialTree.find_intersectors(ray);
+  const auto candidates = spacialTree().find_intersectors(ray);
   for (const auto triNum : candidates)
   {
     const auto& p1 = m_tris[triNum * 3 + 0];
@@ -133,12 +132,14 @@ std::optional<float> EntityModelFrame::intersect(const vm::ray3f& ray) const
   return closestDistance;
 }
 
-void EntityModelFrame::addToSpacialTree(
+void EntityModelFrame::addHitTestPrimitives(
   const std::vector<EntityModelVertex>& vertices,
   const render::PrimType primType,
   const size_t index,
   const size_t count)
 {
+  m_spacialTree.reset();
+
   switch (primType)
   {
   case render::PrimType::Points:
@@ -151,19 +152,9 @@ void EntityModelFrame::addToSpacialTree(
     m_tris.reserve(m_tris.size() + count);
     for (size_t i = 0; i < count; i += 3)
     {
-      auto bounds = vm::bbox3f::builder{};
-      const auto& p1 = render::getVertexComponent<0>(vertices[index + i + 0]);
-      const auto& p2 = render::getVertexComponent<0>(vertices[index + i + 1]);
-      const auto& p3 = render::getVertexComponent<0>(vertices[index + i + 2]);
-      bounds.add(p1);
-      bounds.add(p2);
-      bounds.add(p3);
-
-      const auto triIndex = m_tris.size() / 3u;
-      m_tris.push_back(p1);
-      m_tris.push_back(p2);
-      m_tris.push_back(p3);
-      m_spacialTree.insert(bounds.bounds(), triIndex);
+      m_tris.push_back(render::getVertexComponent<0>(vertices[index + i + 0]));
+      m_tris.push_back(render::getVertexComponent<0>(vertices[index + i + 1]));
+      m_tris.push_back(render::getVertexComponent<0>(vertices[index + i + 2]));
     }
     break;
   }
@@ -175,18 +166,9 @@ void EntityModelFrame::addToSpacialTree(
     const auto& p1 = render::getVertexComponent<0>(vertices[index]);
     for (size_t i = 1; i < count - 1; ++i)
     {
-      auto bounds = vm::bbox3f::builder{};
-      const auto& p2 = render::getVertexComponent<0>(vertices[index + i]);
-      const auto& p3 = render::getVertexComponent<0>(vertices[index + i + 1]);
-      bounds.add(p1);
-      bounds.add(p2);
-      bounds.add(p3);
-
-      const auto triIndex = m_tris.size() / 3u;
       m_tris.push_back(p1);
-      m_tris.push_back(p2);
-      m_tris.push_back(p3);
-      m_spacialTree.insert(bounds.bounds(), triIndex);
+      m_tris.push_back(render::getVertexComponent<0>(vertices[index + i]));
+      m_tris.push_back(render::getVertexComponent<0>(vertices[index + i + 1]));
     }
     break;
   }
@@ -197,15 +179,10 @@ void EntityModelFrame::addToSpacialTree(
     m_tris.reserve(m_tris.size() + (count - 2) * 3);
     for (size_t i = 0; i < count - 2; ++i)
     {
-      auto bounds = vm::bbox3f::builder{};
       const auto& p1 = render::getVertexComponent<0>(vertices[index + i + 0]);
       const auto& p2 = render::getVertexComponent<0>(vertices[index + i + 1]);
       const auto& p3 = render::getVertexComponent<0>(vertices[index + i + 2]);
-      bounds.add(p1);
-      bounds.add(p2);
-      bounds.add(p3);
 
-      const auto triIndex = m_tris.size() / 3u;
       if (i % 2 == 0)
       {
         m_tris.push_back(p1);
@@ -218,7 +195,6 @@ void EntityModelFrame::addToSpacialTree(
         m_tris.push_back(p3);
         m_tris.push_back(p2);
       }
-      m_spacialTree.insert(bounds.bounds(), triIndex);
     }
     break;
   }
@@ -226,6 +202,23 @@ void EntityModelFrame::addToSpacialTree(
   }
 }
 
+const EntityModelFrame::SpacialTree& EntityModelFrame::spacialTree() const
+{
+  if (!m_spacialTree)
+  {
+    m_spacialTree = SpacialTree{16.0f};
+    for (size_t triNum = 0; triNum < m_tris.size() / 3u; ++triNum)
+    {
+      auto bounds = vm::bbox3f::builder{};
+      bounds.add(m_tris[triNum * 3 + 0]);
+      bounds.add(m_tris[triNum * 3 + 1]);
+      bounds.add(m_tris[triNum * 3 + 2]);
+      m_spacialTree->insert(bounds.bounds(), triNum);
+    }
+  }
+  return *m_spacialTree;
+}
+
 // EntityModelData::Mesh
 
 /**
@@ -309,7 +302,7 @@ public:
   {
     m_indices.forEachPrimitive(
       [&](const render::PrimType primType, const size_t index, const size_t count) {
-        frame.addToSpacialTree(m_vertices, primType, index, count);
+        frame.addHitTestPrimitives(m_vertices, primType, index, count);
       });
   }
 
@@ -355,7 +348,7 @@ public:
                                  const render::PrimType primType,
                                  const size_t index,
                                  const size_t count) {
-      frame.addToSpacialTree(m_vertices, primType, index, count);
+      frame.addHitTestPrimitives(m_vertices, primType, index, count);
     });
   }
 
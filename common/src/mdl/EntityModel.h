@@ -94,11 +94,12 @@ private:
   vm::bbox3f m_bounds;
   size_t m_skinOffset = 0;
 
-  // For hit testing
+  // For hit testing, the spacial tree is built on demand because most frames are never
+  // picked
   std::vector<vm::vec3f> m_tris;
   using TriNum = size_t;
   using SpacialTree = octree<float, TriNum>;
-  SpacialTree m_spacialTree;
+  mutable std::optional<SpacialTree> m_spacialTree;
 
   kdl_reflect_decl(EntityModelFrame, m_index, m_name, m_bounds, m_skinOffset);
 
@@ -151,7 +152,8 @@ public:
   std::optional<float> intersect(const vm::ray3f& ray) const;
 
   /**
-   * Adds the given primitives to the spacial tree for this frame.
+   * Adds the given primitives to the hit testing data of this frame. The spacial tree is
+   * built from these primitives when this frame is intersected for the next time.
    *
    * @param vertices the vertices
    * @param primType the primitive type
@@ -159,11 +161,14 @@ public:
    * array
    * @param count the number of vertices that make up the primitive(s)
    */
-  void addToSpacialTree(
+  void addHitTestPrimitives(
     const std::vector<EntityModelVertex>& vertices,
     render::PrimType primType,
     size_t index,
     size_t count);
+
+private:
+  const SpacialTree& spacialTree() const;
 };
 
 class EntityModelMesh;
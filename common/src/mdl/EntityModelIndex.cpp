@@ -0,0 +1,96 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EntityModelIndex.h"
+
+#include "mdl/BrushNode.h"
+#include "mdl/EntityNode.h"
+#include "mdl/GroupNode.h"
+#include "mdl/LayerNode.h"
+#include "mdl/PatchNode.h"
+#include "mdl/WorldNode.h"
+
+#include "kdl/overload.h"
+
+namespace tb::mdl
+{
+
+void EntityModelIndex::addNode(Node* node)
+{
+  node->accept(kdl::overload(
+    [](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
+    [](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
+    [](auto&& thisLambda, GroupNode* group) { group->visitChildren(thisLambda); },
+    [&](EntityNode* entityNode) {
+      addEntityNode(entityNode, entityNode->entity().model());
+    },
+    [](BrushNode*) {},
+    [](PatchNode*) {}));
+}
+
+void EntityModelIndex::removeNode(Node* node)
+{
+  node->accept(kdl::overload(
+    [](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
+    [](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
+    [](auto&& thisLambda, GroupNode* group) { group->visitChildren(thisLambda); },
+    [&](EntityNode* entityNode) {
+      removeEntityNode(entityNode, entityNode->entity().model());
+    },
+    [](BrushNode*) {},
+    [](PatchNode*) {}));
+}
+
+void EntityModelIndex::addEntityNode(
+  EntityNodeBase* entityNode, const EntityModel* model)
+{
+  if (model)
+  {
+    m_entityNodes[model].insert(entityNode);
+  }
+}
+
+void EntityModelIndex::removeEntityNode(
+  EntityNodeBase* entityNode, const EntityModel* model)
+{
+  if (const auto it = m_entityNodes.find(model); it != m_entityNodes.end())
+  {
+    it->second.erase(entityNode);
+    if (it->second.empty())
+    {
+      m_entityNodes.erase(it);
+    }
+  }
+}
+
+std::vector<EntityNodeBase*> EntityModelIndex::findEntityNodes(
+  const std::vector<const EntityModel*>& models) const
+{
+  auto result = std::vector<EntityNodeBase*>{};
+  for (const auto* model : models)
+  {
+    if (const auto it = m_entityNodes.find(model); it != m_entityNodes.end())
+    {
+      result.insert(result.end(), it->second.begin(), it->second.end());
+    }
+  }
+  return result;
+}
+
+} // namespace tb::mdl
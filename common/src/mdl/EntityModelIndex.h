@@ -0,0 +1,63 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace tb::mdl
+{
+class EntityModel;
+class EntityNodeBase;
+class Node;
+
+/**
+ * Maps entity models to the entity nodes that use them, so that the entities whose model
+ * has finished loading can be found without visiting every node of the map.
+ */
+class EntityModelIndex
+{
+private:
+  std::unordered_map<const EntityModel*, std::unordered_set<EntityNodeBase*>>
+    m_entityNodes;
+
+public:
+  /**
+   * Adds the given node and its descendants if they use an entity model.
+   */
+  void addNode(Node* node);
+
+  /**
+   * Removes the given node and its descendants.
+   */
+  void removeNode(Node* node);
+
+  void addEntityNode(EntityNodeBase* entityNode, const EntityModel* model);
+  void removeEntityNode(EntityNodeBase* entityNode, const EntityModel* model);
+
+  /**
+   * Returns the entity nodes that use any of the given models.
+   */
+  std::vector<EntityNodeBase*> findEntityNodes(
+    const std::vector<const EntityModel*>& models) const;
+};
+
+} // namespace tb::mdl
@@ -41,6 +41,7 @@ EntityModelManager::EntityModelManager(
   CreateEntityModelDataResource createResource, Logger& logger)
   : m_createResource{std::move(createResource)}
   , m_logger{logger}
+  , m_loadsCancelled{std::make_shared<std::atomic<bool>>(false)}
 {
 }
 
@@ -51,6 +52,8 @@ EntityModelManager::~EntityModelManager()
 
 void EntityModelManager::clear()
 {
+  cancelPendingLoads();
+
   m_renderers.clear();
   m_models.clear();
   m_rendererMismatches.clear();
@@ -199,23 +202,48 @@ Result<EntityModel> EntityModelManager::loadModel(
     const auto& fs = m_game->gameFileSystem();
     const auto& materialConfig = m_game->config().materialConfig;
 
-    const auto createResource = [](auto resourceLoader) {
-      return createResourceSync(std::move(resourceLoader));
-    };
+    // The model data is loaded by a task, so the material loader must not refer to any
+    // locals of this function.
+    const auto loadMaterial = [&fs, &materialConfig, this](const auto& materialPath) {
+      const auto createResource = [](auto resourceLoader) {
+        return createResourceSync(std::move(resourceLoader));
+      };
 
-    const auto loadMaterial = [&](const auto& materialPath) {
       return io::loadMaterial(
                fs, materialConfig, materialPath, createResource, m_shaders, std::nullopt)
              | kdl::or_else(io::makeReadMaterialErrorHandler(fs, m_logger))
              | kdl::value();
     };
 
+    // Loaders that have not started yet when the models are cleared, e.g. because the
+    // game or the mods changed, must not access the file system anymore.
+    const auto createResource = [&, loadsCancelled = m_loadsCancelled](
+                                  ResourceLoader<EntityModelData> resourceLoader) {
+      return m_createResource(
+        [loadsCancelled, resourceLoader = std::move(resourceLoader)]() {
+          return *loadsCancelled ? Result<EntityModelData>{Error{"Loading cancelled"}}
+                                 : resourceLoader();
+        });
+    };
+
+    // Loaders that are already running when the models are cleared stop early if they
+    // support it.
+    const auto isCancelled = [loadsCancelled = m_loadsCancelled]() {
+      return bool(*loadsCancelled);
+    };
+
     return io::loadEntityModelAsync(
-      fs, materialConfig, modelPath, loadMaterial, m_createResource, m_logger);
+      fs, materialConfig, modelPath, loadMaterial, createResource, isCancelled, m_logger);
   }
   return Error{"Game is not set"};
 }
 
+void EntityModelManager::cancelPendingLoads()
+{
+  *m_loadsCancelled = true;
+  m_loadsCancelled = std::make_shared<std::atomic<bool>>(false);
+}
+
 void EntityModelManager::prepare(render::VboManager& vboManager)
 {
   prepareRenderers(vboManager);
@@ -25,6 +25,7 @@
 
 #include "kdl/path_hash.h"
 
+#include <atomic>
 #include <filesystem>
 #include <memory>
 #include <unordered_map>
@@ -74,6 +75,11 @@ private:
 
   mutable std::vector<render::MaterialRenderer*> m_unpreparedRenderers;
 
+  // Shared with the loaders of all models that were requested since the last call to
+  // clear(). Set when the models are cleared so that pending loads are skipped and
+  // running loads stop early if their loader supports it.
+  std::shared_ptr<std::atomic<bool>> m_loadsCancelled;
+
 public:
   EntityModelManager(CreateEntityModelDataResource createResource, Logger& logger);
   ~EntityModelManager();
@@ -94,6 +100,7 @@ public:
 private:
   const EntityModel* safeGetModel(const std::filesystem::path& path) const;
   Result<EntityModel> loadModel(const std::filesystem::path& path) const;
+  void cancelPendingLoads();
 
 public:
   void prepare(render::VboManager& vboManager);
@@ -60,7 +60,16 @@ const vm::bbox3d& EntityNode::modelBounds() const
 
 void EntityNode::setModel(const EntityModel* model)
 {
+  removeFromIndex(this, m_entity.model());
   m_entity.setModel(model);
+  addToIndex(this, m_entity.model());
+
+  nodePhysicalBoundsDidChange();
+}
+
+void EntityNode::modelDidLoad()
+{
+  m_entity.modelDidLoad();
   nodePhysicalBoundsDidChange();
 }
 
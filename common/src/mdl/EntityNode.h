@@ -59,6 +59,12 @@ public: // entity model
   const vm::bbox3d& modelBounds() const;
   void setModel(const EntityModel* model);
 
+  /**
+   * Updates the bounds of this node after the data of its model has been loaded. Until
+   * then, the node uses the default bounds as a placeholder.
+   */
+  void modelDidLoad();
+
 private: // implement Node interface
   const vm::bbox3d& doGetLogicalBounds() const override;
   const vm::bbox3d& doGetPhysicalBounds() const override;
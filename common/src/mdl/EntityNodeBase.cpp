@@ -106,6 +106,12 @@ Entity EntityNodeBase::setEntity(Entity entity)
 
   auto oldEntity = std::exchange(m_entity, std::move(entity));
   updateIndexAndLinks(oldEntity.properties());
+
+  if (oldEntity.model() != m_entity.model())
+  {
+    removeFromIndex(this, oldEntity.model());
+    addToIndex(this, m_entity.model());
+  }
   return oldEntity;
 }
 
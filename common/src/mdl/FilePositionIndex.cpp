@@ -0,0 +1,176 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FilePositionIndex.h"
+
+#include "mdl/BrushNode.h" // IWYU pragma: keep
+#include "mdl/EntityNode.h" // IWYU pragma: keep
+#include "mdl/GroupNode.h" // IWYU pragma: keep
+#include "mdl/LayerNode.h" // IWYU pragma: keep
+#include "mdl/Node.h"
+#include "mdl/PatchNode.h" // IWYU pragma: keep
+#include "mdl/WorldNode.h" // IWYU pragma: keep
+
+#include "kdl/vector_utils.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace tb::mdl
+{
+
+FilePositionIndex::FilePositionIndex(Node& root)
+  : m_root{root}
+{
+}
+
+void FilePositionIndex::addNode(Node* node)
+{
+  if (m_valid)
+  {
+    auto hasFilePosition = false;
+    node->accept([&](auto&& thisLambda, Node* descendant) {
+      hasFilePosition = hasFilePosition || descendant->lineCount() > 0;
+      descendant->visitChildren(thisLambda);
+    });
+
+    if (hasFilePosition)
+    {
+      invalidate();
+    }
+  }
+}
+
+void FilePositionIndex::removeNode(Node* node)
+{
+  if (m_valid)
+  {
+    node->accept([&](auto&& thisLambda, Node* descendant) {
+      if (const auto it = m_entryIndices.find(descendant); it != m_entryIndices.end())
+      {
+        m_entries[it->second].node = nullptr;
+        m_entryIndices.erase(it);
+      }
+      descendant->visitChildren(thisLambda);
+    });
+  }
+}
+
+void FilePositionIndex::invalidate()
+{
+  m_valid = false;
+  m_entries.clear();
+  m_entryIndices.clear();
+}
+
+std::vector<Node*> FilePositionIndex::findNodes(
+  const std::vector<size_t>& lineNumbers) const
+{
+  if (!m_valid)
+  {
+    rebuild();
+  }
+
+  auto entryIndices = std::vector<size_t>{};
+  for (const auto lineNumber : lineNumbers)
+  {
+    findEntries(0, m_entries.size(), lineNumber, entryIndices);
+  }
+
+  return kdl::vec_transform(
+    kdl::vec_sort_and_remove_duplicates(std::move(entryIndices)),
+    [&](const auto i) { return m_entries[i].node; });
+}
+
+void FilePositionIndex::rebuild() const
+{
+  m_entries.clear();
+  m_entryIndices.clear();
+
+  m_root.accept([&](auto&& thisLambda, Node* node) {
+    if (node->lineCount() > 0)
+    {
+      const auto firstLine = node->lineNumber();
+      const auto endLine = firstLine + node->lineCount();
+      m_entries.push_back({firstLine, endLine, endLine, node});
+    }
+    node->visitChildren(thisLambda);
+  });
+
+  // the entries are visited in preorder, so a parent stays before its children
+  std::ranges::stable_sort(m_entries, std::less<>{}, &Entry::firstLine);
+  for (size_t i = 0; i < m_entries.size(); ++i)
+  {
+    m_entryIndices[m_entries[i].node] = i;
+  }
+
+  updateMaxEndLines(0, m_entries.size());
+  m_valid = true;
+}
+
+/**
+ * The sorted entries form an implicit balanced binary search tree where the root of the
+ * subtree spanning the entries in [first, last) is the entry in the middle. Each entry
+ * stores the maximum end line of its subtree so that queries can skip every subtree
+ * whose entries all end before the given line.
+ */
+size_t FilePositionIndex::updateMaxEndLines(const size_t first, const size_t last) const
+{
+  if (first >= last)
+  {
+    return 0;
+  }
+
+  const auto mid = first + (last - first) / 2;
+  auto& entry = m_entries[mid];
+  entry.maxEndLine = std::max(
+    {entry.endLine, updateMaxEndLines(first, mid), updateMaxEndLines(mid + 1, last)});
+  return entry.maxEndLine;
+}
+
+void FilePositionIndex::findEntries(
+  const size_t first,
+  const size_t last,
+  const size_t lineNumber,
+  std::vector<size_t>& result) const
+{
+  if (first >= last)
+  {
+    return;
+  }
+
+  const auto mid = first + (last - first) / 2;
+  const auto& entry = m_entries[mid];
+  if (entry.maxEndLine <= lineNumber)
+  {
+    return;
+  }
+
+  findEntries(first, mid, lineNumber, result);
+  if (entry.firstLine <= lineNumber)
+  {
+    if (lineNumber < entry.endLine && entry.node)
+    {
+      result.push_back(mid);
+    }
+    findEntries(mid + 1, last, lineNumber, result);
+  }
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,75 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace tb::mdl
+{
+class Node;
+
+/**
+ * Indexes the file line ranges of a node and its descendants to find the nodes that
+ * contain given line numbers.
+ *
+ * The index is rebuilt lazily on the first query after it was invalidated. Adding
+ * nodes that have a file position invalidates the index, while removing nodes only
+ * removes their stale entries. Since the file positions are updated when the map is
+ * saved, the index must be invalidated afterwards.
+ */
+class FilePositionIndex
+{
+private:
+  struct Entry
+  {
+    size_t firstLine;
+    size_t endLine;
+    size_t maxEndLine;
+    Node* node;
+  };
+
+  Node& m_root;
+  mutable std::vector<Entry> m_entries;
+  mutable std::unordered_map<const Node*, size_t> m_entryIndices;
+  mutable bool m_valid = false;
+
+public:
+  explicit FilePositionIndex(Node& root);
+
+  void addNode(Node* node);
+  void removeNode(Node* node);
+  void invalidate();
+
+  /**
+   * Returns the nodes whose file line ranges contain any of the given line numbers,
+   * ordered by their first line.
+   */
+  std::vector<Node*> findNodes(const std::vector<size_t>& lineNumbers) const;
+
+private:
+  void rebuild() const;
+  size_t updateMaxEndLines(size_t first, size_t last) const;
+  void findEntries(
+    size_t first, size_t last, size_t lineNumber, std::vector<size_t>& result) const;
+};
+
+} // namespace tb::mdl
@@ -0,0 +1,384 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "mdl/Polyhedron.h"
+
+#include "vm/bbox.h"
+#include "vm/constants.h"
+#include "vm/vec.h"
+
+#include <array>
+#include <cstddef>
+#include <limits>
+
+namespace tb::mdl
+{
+namespace detail
+{
+
+template <typename T>
+struct GJKSimplex
+{
+  std::array<vm::vec<T, 3>, 4> points;
+  size_t size = 0;
+
+  void push(const vm::vec<T, 3>& point) { points[size++] = point; }
+
+  bool contains(const vm::vec<T, 3>& point) const
+  {
+    for (size_t i = 0; i < size; ++i)
+    {
+      if (points[i] == point)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <typename... I>
+  void keep(const I... indices)
+  {
+    const auto kept = std::array<vm::vec<T, 3>, sizeof...(I)>{points[indices]...};
+    for (size_t i = 0; i < kept.size(); ++i)
+    {
+      points[i] = kept[i];
+    }
+    size = kept.size();
+  }
+};
+
+/**
+ * Returns the point of the given segment that is closest to the origin and reduces the
+ * simplex to the vertices of the segment's feature that contains it.
+ */
+template <typename T>
+vm::vec<T, 3> closestPointOfSegment(GJKSimplex<T>& simplex)
+{
+  const auto& a = simplex.points[0];
+  const auto& b = simplex.points[1];
+  const auto ab = b - a;
+
+  const auto t = vm::dot(-a, ab);
+  if (t <= T(0))
+  {
+    simplex.keep(0);
+    return a;
+  }
+
+  const auto denom = vm::dot(ab, ab);
+  if (t >= denom)
+  {
+    simplex.keep(1);
+    return b;
+  }
+
+  return a + ab * (t / denom);
+}
+
+/**
+ * Returns the point of the given triangle that is closest to the origin and reduces the
+ * simplex to the vertices of the triangle's feature that contains it.
+ *
+ * See Ericson, Real-Time Collision Detection, section 5.1.5.
+ */
+template <typename T>
+vm::vec<T, 3> closestPointOfTriangle(GJKSimplex<T>& simplex)
+{
+  const auto a = simplex.points[0];
+  const auto b = simplex.points[1];
+  const auto c = simplex.points[2];
+
+  const auto ab = b - a;
+  const auto ac = c - a;
+
+  const auto d1 = vm::dot(ab, -a);
+  const auto d2 = vm::dot(ac, -a);
+  if (d1 <= T(0) && d2 <= T(0))
+  {
+    simplex.keep(0);
+    return a;
+  }
+
+  const auto d3 = vm::dot(ab, -b);
+  const auto d4 = vm::dot(ac, -b);
+  if (d3 >= T(0) && d4 <= d3)
+  {
+    simplex.keep(1);
+    return b;
+  }
+
+  const auto vc = d1 * d4 - d3 * d2;
+  if (vc <= T(0) && d1 >= T(0) && d3 <= T(0))
+  {
+    simplex.keep(0, 1);
+    return a + ab * (d1 / (d1 - d3));
+  }
+
+  const auto d5 = vm::dot(ab, -c);
+  const auto d6 = vm::dot(ac, -c);
+  if (d6 >= T(0) && d5 <= d6)
+  {
+    simplex.keep(2);
+    return c;
+  }
+
+  const auto vb = d5 * d2 - d1 * d6;
+  if (vb <= T(0) && d2 >= T(0) && d6 <= T(0))
+  {
+    simplex.keep(0, 2);
+    return a + ac * (d2 / (d2 - d6));
+  }
+
+  const auto va = d3 * d6 - d5 * d4;
+  if (va <= T(0) && (d4 - d3) >= T(0) && (d5 - d6) >= T(0))
+  {
+    simplex.keep(1, 2);
+    return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+  }
+
+  const auto denom = T(1) / (va + vb + vc);
+  return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+/**
+ * Returns the point of the given tetrahedron that is closest to the origin and reduces
+ * the simplex to the vertices of the tetrahedron's feature that contains it. If the
+ * origin is inside of the tetrahedron, the origin is returned and the simplex is left
+ * unchanged.
+ */
+template <typename T>
+vm::vec<T, 3> closestPointOfTetrahedron(GJKSimplex<T>& simplex)
+{
+  static constexpr auto faces = std::array<std::array<size_t, 4>, 4>{{
+    {0, 1, 2, 3},
+    {0, 2, 3, 1},
+    {0, 3, 1, 2},
+    {1, 3, 2, 0},
+  }};
+
+  auto result = vm::vec<T, 3>{};
+  auto resultSimplex = simplex;
+  auto bestDistance2 = std::numeric_limits<T>::max();
+
+  for (const auto& [i, j, k, opposite] : faces)
+  {
+    const auto& a = simplex.points[i];
+    const auto normal = vm::cross(simplex.points[j] - a, simplex.points[k] - a);
+    const auto originSide = vm::dot(-a, normal);
+    const auto oppositeSide = vm::dot(simplex.points[opposite] - a, normal);
+
+    // the origin is outside of this face if it's on the other side than the opposite
+    // vertex, and a flat tetrahedron is regarded as having the origin outside
+    if (originSide * oppositeSide < T(0) || oppositeSide == T(0))
+    {
+      auto faceSimplex = GJKSimplex<T>{};
+      faceSimplex.push(simplex.points[i]);
+      faceSimplex.push(simplex.points[j]);
+      faceSimplex.push(simplex.points[k]);
+
+      const auto point = closestPointOfTriangle(faceSimplex);
+      const auto distance2 = vm::dot(point, point);
+      if (distance2 < bestDistance2)
+      {
+        result = point;
+        resultSimplex = faceSimplex;
+        bestDistance2 = distance2;
+      }
+    }
+  }
+
+  simplex = resultSimplex;
+  return result;
+}
+
+template <typename T>
+vm::vec<T, 3> closestPointOfSimplex(GJKSimplex<T>& simplex)
+{
+  switch (simplex.size)
+  {
+  case 1:
+    return simplex.points[0];
+  case 2:
+    return closestPointOfSegment(simplex);
+  case 3:
+    return closestPointOfTriangle(simplex);
+  default:
+    return closestPointOfTetrahedron(simplex);
+  }
+}
+
+/**
+ * Returns an axis that separates the given disjoint bounding boxes, pointing from the
+ * right hand side to the left hand side.
+ */
+template <typename T>
+vm::vec<T, 3> separatingAxis(const vm::bbox<T, 3>& lhs, const vm::bbox<T, 3>& rhs)
+{
+  auto result = vm::vec<T, 3>{};
+  for (size_t i = 0; i < 3; ++i)
+  {
+    if (lhs.min[i] > rhs.max[i])
+    {
+      result[i] = T(1);
+      break;
+    }
+    if (lhs.max[i] < rhs.min[i])
+    {
+      result[i] = T(-1);
+      break;
+    }
+  }
+  return result;
+}
+
+template <typename T, typename P>
+vm::vec<T, 3> support(const P& polyhedron, const vm::vec<T, 3>& direction)
+{
+  auto result = vm::vec<T, 3>{};
+  auto best = -std::numeric_limits<T>::max();
+  for (const auto* vertex : polyhedron.vertices())
+  {
+    const auto& position = vertex->position();
+    if (const auto d = vm::dot(position, direction); d > best)
+    {
+      result = position;
+      best = d;
+    }
+  }
+  return result;
+}
+
+} // namespace detail
+
+/**
+ * Checks whether the convex hulls of two point sets intersect using the
+ * Gilbert-Johnson-Keerthi algorithm, which iteratively finds the point of the Minkowski
+ * difference of the hulls that is closest to the origin. Each iteration only needs the
+ * extreme points of both sets in one direction, so unlike the separating axis test, the
+ * cost is linear in the number of points.
+ *
+ * Hulls that are no further than epsilon apart are considered to intersect.
+ *
+ * The search direction is used as the initial direction of the search if it is not null.
+ * If the hulls don't intersect, it is set to a separating axis, pointing from the right
+ * hand side to the left hand side. Passing it again when checking the same pair of hulls,
+ * e.g. after one of them was moved slightly, usually finds the separating axis again in
+ * the first iteration.
+ *
+ * @param lhsSupport returns the point of the left hand side that is furthest in a given
+ * direction
+ * @param rhsSupport returns the point of the right hand side that is furthest in a given
+ * direction
+ * @param epsilon the distance up to which the hulls are considered to intersect
+ * @param searchDirection the initial search direction, updated with the last search
+ * direction
+ * @return true if the hulls intersect and false otherwise
+ */
+template <typename T, typename LhsSupport, typename RhsSupport>
+bool gjkIntersects(
+  const LhsSupport& lhsSupport,
+  const RhsSupport& rhsSupport,
+  const T epsilon,
+  vm::vec<T, 3>& searchDirection)
+{
+  constexpr auto MaxIterations = 64;
+  constexpr auto RelativeTolerance = T(1e-12);
+
+  auto v = searchDirection;
+  if (vm::is_zero(v, vm::constants<T>::almost_zero()))
+  {
+    const auto x = vm::vec<T, 3>{1, 0, 0};
+    v = lhsSupport(x) - rhsSupport(-x);
+  }
+
+  auto simplex = detail::GJKSimplex<T>{};
+  for (auto i = 0; i < MaxIterations; ++i)
+  {
+    const auto w = lhsSupport(-v) - rhsSupport(v);
+    const auto vw = vm::dot(v, w);
+    const auto vv = vm::dot(v, v);
+
+    // all points of the Minkowski difference are at least vw / |v| away from the origin
+    if (vw > T(0) && vw * vw > epsilon * epsilon * vv)
+    {
+      searchDirection = v;
+      return false;
+    }
+
+    // v is the closest point of the Minkowski difference unless w makes progress
+    if (simplex.size > 0 && (simplex.contains(w) || vv - vw <= RelativeTolerance * vv))
+    {
+      searchDirection = v;
+      return vv <= epsilon * epsilon;
+    }
+
+    simplex.push(w);
+    v = detail::closestPointOfSimplex(simplex);
+
+    if (simplex.size == 4 || vm::dot(v, v) <= epsilon * epsilon)
+    {
+      return true;
+    }
+  }
+
+  searchDirection = v;
+  return vm::dot(v, v) <= epsilon * epsilon;
+}
+
+/**
+ * Checks whether the given polyhedra intersect using the GJK algorithm, considering
+ * polyhedra that touch as intersecting.
+ *
+ * @see gjkIntersects for the meaning of the search direction
+ */
+template <typename T, typename FP, typename VP>
+bool gjkIntersects(
+  const Polyhedron<T, FP, VP>& lhs,
+  const Polyhedron<T, FP, VP>& rhs,
+  vm::vec<T, 3>& searchDirection)
+{
+  if (lhs.empty() || rhs.empty())
+  {
+    return false;
+  }
+
+  if (!lhs.bounds().intersects(rhs.bounds()))
+  {
+    searchDirection = detail::separatingAxis(lhs.bounds(), rhs.bounds());
+    return false;
+  }
+
+  return gjkIntersects(
+    [&](const auto& direction) { return detail::support(lhs, direction); },
+    [&](const auto& direction) { return detail::support(rhs, direction); },
+    vm::constants<T>::point_status_epsilon(),
+    searchDirection);
+}
+
+template <typename T, typename FP, typename VP>
+bool gjkIntersects(const Polyhedron<T, FP, VP>& lhs, const Polyhedron<T, FP, VP>& rhs)
+{
+  auto searchDirection = vm::vec<T, 3>{};
+  return gjkIntersects(lhs, rhs, searchDirection);
+}
+
+} // namespace tb::mdl
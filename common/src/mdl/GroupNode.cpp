@@ -230,6 +230,16 @@ void GroupNode::doChildWasRemoved(Node* /* node */)
   nodePhysicalBoundsDidChange();
 }
 
+void GroupNode::doAncestorWillChange()
+{
+  removeFromIndex(this, linkId());
+}
+
+void GroupNode::doAncestorDidChange()
+{
+  addToIndex(this, linkId());
+}
+
 void GroupNode::doNodePhysicalBoundsDidChange()
 {
   invalidateBounds();
@@ -294,6 +304,16 @@ GroupNode* GroupNode::doGetContainingGroup()
   return findContainingGroup(this);
 }
 
+void GroupNode::doLinkIdWillChange()
+{
+  removeFromIndex(this, linkId());
+}
+
+void GroupNode::doLinkIdDidChange()
+{
+  addToIndex(this, linkId());
+}
+
 void GroupNode::invalidateBounds()
 {
   m_boundsValid = false;
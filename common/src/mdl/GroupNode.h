@@ -110,6 +110,9 @@ private: // implement methods inherited from Node
   void doChildWasAdded(Node* node) override;
   void doChildWasRemoved(Node* node) override;
 
+  void doAncestorWillChange() override;
+  void doAncestorDidChange() override;
+
   void doNodePhysicalBoundsDidChange() override;
   void doChildPhysicalBoundsDidChange() override;
 
@@ -129,6 +132,9 @@ private: // implement methods inherited from Object
   LayerNode* doGetContainingLayer() override;
   GroupNode* doGetContainingGroup() override;
 
+  void doLinkIdWillChange() override;
+  void doLinkIdDidChange() override;
+
 private:
   void invalidateBounds();
   void validateBounds() const;
@@ -19,14 +19,51 @@
 
 #pragma once
 
+#include "mdl/BrushFaceHandle.h"
 #include "mdl/HitType.h"
 
 #include "vm/vec.h"
 
 #include <any>
+#include <type_traits>
+#include <utility>
+#include <variant>
 
 namespace tb::mdl
 {
+class EntityNode;
+class PatchNode;
+
+/**
+ * The target of a hit. The targets of the hits that are created when picking nodes in
+ * the map are stored inline, all other targets are stored in a std::any.
+ */
+using HitTarget = std::variant<
+  bool,
+  int,
+  size_t,
+  vm::vec3d,
+  BrushFaceHandle,
+  EntityNode*,
+  PatchNode*,
+  std::any>;
+
+namespace detail
+{
+template <typename T, typename Variant>
+struct IsHitTargetAlternative;
+
+template <typename T, typename... Alternatives>
+struct IsHitTargetAlternative<T, std::variant<Alternatives...>>
+  : std::disjunction<std::is_same<T, Alternatives>...>
+{
+};
+
+template <typename T>
+constexpr bool isHitTargetAlternative =
+  IsHitTargetAlternative<std::remove_cvref_t<T>, HitTarget>::value;
+} // namespace detail
+
 class Hit
 {
 public:
@@ -36,7 +73,7 @@ private:
   HitType::Type m_type;
   double m_distance;
   vm::vec3d m_hitPoint;
-  std::any m_target;
+  HitTarget m_target;
   double m_error;
 
 public:
@@ -50,7 +87,7 @@ public:
     : m_type(type)
     , m_distance(distance)
     , m_hitPoint(hitPoint)
-    , m_target(std::move(target))
+    , m_target(makeTarget(std::move(target)))
     , m_error(error)
   {
   }
@@ -65,7 +102,28 @@ public:
   template <typename T>
   T target() const
   {
-    return std::any_cast<T>(m_target);
+    if constexpr (detail::isHitTargetAlternative<T>)
+    {
+      return std::get<std::remove_cvref_t<T>>(m_target);
+    }
+    else
+    {
+      return std::any_cast<T>(std::get<std::any>(m_target));
+    }
+  }
+
+private:
+  template <typename T>
+  static HitTarget makeTarget(T target)
+  {
+    if constexpr (detail::isHitTargetAlternative<T>)
+    {
+      return HitTarget{std::in_place_type<T>, std::move(target)};
+    }
+    else
+    {
+      return HitTarget{std::in_place_type<std::any>, std::move(target)};
+    }
   }
 };
 
@@ -0,0 +1,351 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IssueList.h"
+
+#include "mdl/Issue.h"
+#include "mdl/Node.h"
+#include "mdl/NodeQueries.h"
+#include "mdl/WorldNode.h"
+
+#include "kdl/vector_utils.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <iterator>
+#include <unordered_set>
+#include <utility>
+
+namespace tb::mdl
+{
+namespace
+{
+
+/**
+ * Beyond this many separate ranges of rows, a change is announced as a reset of the
+ * whole list because updating the rows one range at a time would be slower than
+ * rebuilding the view.
+ */
+constexpr size_t MaxIncrementalRanges = 32;
+
+struct RowRange
+{
+  size_t first;
+  size_t count;
+};
+
+/**
+ * Groups the given rows, which must be sorted in descending order, into ranges of
+ * consecutive rows. The ranges are returned in descending order.
+ */
+std::vector<RowRange> toDescendingRanges(const std::vector<size_t>& rows)
+{
+  auto result = std::vector<RowRange>{};
+  for (const auto row : rows)
+  {
+    if (!result.empty() && result.back().first == row + 1)
+    {
+      result.back().first = row;
+      ++result.back().count;
+    }
+    else
+    {
+      result.push_back({row, 1});
+    }
+  }
+  return result;
+}
+
+/**
+ * Returns the given nodes and their descendants in the order in which they are visited.
+ * Unlike collectNodesAndDescendants, this does not sort the nodes by their addresses,
+ * so the issues of new nodes are created in a deterministic order.
+ */
+std::vector<Node*> collectNodesInVisitOrder(const std::vector<Node*>& nodes)
+{
+  auto result = std::vector<Node*>{};
+  Node::visitAll(nodes, [&](auto&& thisLambda, Node* node) {
+    result.push_back(node);
+    node->visitChildren(thisLambda);
+  });
+  return result;
+}
+
+bool compareSeqIds(const Issue* lhs, const Issue* rhs)
+{
+  return lhs->seqId() > rhs->seqId();
+}
+
+} // namespace
+
+const std::vector<const Issue*>& IssueList::issues() const
+{
+  return m_issues;
+}
+
+void IssueList::clear()
+{
+  listWillBeResetNotifier();
+
+  m_issues.clear();
+  m_seqIds.clear();
+  m_nodeSeqIds.clear();
+  m_pendingNodes.clear();
+  m_notifierConnection.disconnect();
+
+  listWasResetNotifier();
+}
+
+void IssueList::reset(
+  WorldNode& world, const IssueType hiddenIssueTypes, const bool showHiddenIssues)
+{
+  listWillBeResetNotifier();
+
+  m_validators = world.registeredValidators();
+  m_hiddenIssueTypes = hiddenIssueTypes;
+  m_showHiddenIssues = showHiddenIssues;
+
+  m_issues.clear();
+  m_nodeSeqIds.clear();
+  m_pendingNodes.clear();
+
+  m_notifierConnection.disconnect();
+  m_notifierConnection += world.issuesWillBeInvalidatedNotifier.connect(
+    [&](Node* node) { updateNodes({node}); });
+
+  world.accept([&](auto&& thisLambda, Node* node) {
+    for (const auto* issue : node->issues(m_validators))
+    {
+      if (isListed(*issue))
+      {
+        m_issues.push_back(issue);
+        m_nodeSeqIds[node].push_back(issue->seqId());
+      }
+    }
+    node->visitChildren(thisLambda);
+  });
+
+  std::ranges::sort(m_issues, compareSeqIds);
+  m_seqIds =
+    kdl::vec_transform(m_issues, [](const auto* issue) { return issue->seqId(); });
+
+  listWasResetNotifier();
+}
+
+void IssueList::addNodes(const std::vector<Node*>& nodes)
+{
+  m_pendingNodes =
+    kdl::vec_concat(std::move(m_pendingNodes), collectNodesInVisitOrder(nodes));
+}
+
+void IssueList::removeNodes(const std::vector<Node*>& nodes)
+{
+  const auto allNodes = collectNodesAndDescendants(nodes);
+  removeRows(takeRows(allNodes));
+
+  if (!m_pendingNodes.empty())
+  {
+    const auto removedNodes =
+      std::unordered_set<Node*>{allNodes.begin(), allNodes.end()};
+    std::erase_if(
+      m_pendingNodes, [&](auto* node) { return removedNodes.contains(node); });
+  }
+}
+
+void IssueList::updateNodes(const std::vector<Node*>& nodes)
+{
+  removeRows(takeRows(nodes));
+  m_pendingNodes = kdl::vec_concat(std::move(m_pendingNodes), nodes);
+}
+
+void IssueList::update()
+{
+  if (m_pendingNodes.empty())
+  {
+    return;
+  }
+
+  // remove duplicates, but keep the order in which the nodes were added so that their
+  // issues are created and listed in a deterministic order
+  auto nodes = std::vector<Node*>{};
+  auto addedNodes = std::unordered_set<Node*>{};
+  for (auto* node : std::exchange(m_pendingNodes, {}))
+  {
+    if (addedNodes.insert(node).second)
+    {
+      nodes.push_back(node);
+    }
+  }
+
+  // a node that was added more than once may already be listed
+  removeRows(takeRows(nodes));
+
+  auto issues = std::vector<const Issue*>{};
+  for (auto* node : nodes)
+  {
+    for (const auto* issue : node->issues(m_validators))
+    {
+      if (isListed(*issue))
+      {
+        issues.push_back(issue);
+        m_nodeSeqIds[node].push_back(issue->seqId());
+      }
+    }
+  }
+
+  insertIssues(std::move(issues));
+}
+
+bool IssueList::isListed(const Issue& issue) const
+{
+  return m_showHiddenIssues
+         || (!issue.hidden() && (issue.type() & m_hiddenIssueTypes) == 0);
+}
+
+void IssueList::removeRows(std::vector<size_t> rows)
+{
+  if (rows.empty())
+  {
+    return;
+  }
+
+  std::ranges::sort(rows, std::greater<>{});
+  const auto ranges = toDescendingRanges(rows);
+
+  if (ranges.size() > MaxIncrementalRanges)
+  {
+    listWillBeResetNotifier();
+
+    // rows are sorted in descending order, so the next row to remove is at the back
+    auto next = size_t(0);
+    for (size_t row = 0; row < m_issues.size(); ++row)
+    {
+      if (!rows.empty() && rows.back() == row)
+      {
+        rows.pop_back();
+      }
+      else
+      {
+        m_issues[next] = m_issues[row];
+        m_seqIds[next] = m_seqIds[row];
+        ++next;
+      }
+    }
+    m_issues.resize(next);
+    m_seqIds.resize(next);
+
+    listWasResetNotifier();
+    return;
+  }
+
+  for (const auto& range : ranges)
+  {
+    rowsWillBeRemovedNotifier(range.first, range.first + range.count - 1);
+
+    const auto first = std::ptrdiff_t(range.first);
+    const auto last = std::ptrdiff_t(range.first + range.count);
+    m_issues.erase(m_issues.begin() + first, m_issues.begin() + last);
+    m_seqIds.erase(m_seqIds.begin() + first, m_seqIds.begin() + last);
+
+    rowsWereRemovedNotifier();
+  }
+}
+
+void IssueList::insertIssues(std::vector<const Issue*> issues)
+{
+  if (issues.empty())
+  {
+    return;
+  }
+
+  std::ranges::sort(issues, compareSeqIds);
+
+  // issues that go to the same row of the current list form one range, and since new
+  // issues have the highest sequence ids, there is usually only one range at the top
+  auto ranges = std::vector<std::pair<size_t, RowRange>>{};
+  for (size_t i = 0; i < issues.size(); ++i)
+  {
+    const auto it =
+      std::ranges::lower_bound(m_seqIds, issues[i]->seqId(), std::greater<>{});
+    const auto row = size_t(std::distance(m_seqIds.begin(), it));
+    if (!ranges.empty() && ranges.back().first == row)
+    {
+      ++ranges.back().second.count;
+    }
+    else
+    {
+      ranges.emplace_back(row, RowRange{i, 1});
+    }
+  }
+
+  if (ranges.size() > MaxIncrementalRanges)
+  {
+    listWillBeResetNotifier();
+
+    auto merged = std::vector<const Issue*>{};
+    merged.reserve(m_issues.size() + issues.size());
+    std::ranges::merge(m_issues, issues, std::back_inserter(merged), compareSeqIds);
+    m_issues = std::move(merged);
+    m_seqIds =
+      kdl::vec_transform(m_issues, [](const auto* issue) { return issue->seqId(); });
+
+    listWasResetNotifier();
+    return;
+  }
+
+  // insert the last range first so that the rows of the other ranges remain valid
+  for (auto it = ranges.rbegin(); it != ranges.rend(); ++it)
+  {
+    const auto& [row, range] = *it;
+    rowsWillBeInsertedNotifier(row, row + range.count - 1);
+
+    const auto first = issues.begin() + std::ptrdiff_t(range.first);
+    const auto last = first + std::ptrdiff_t(range.count);
+    m_issues.insert(m_issues.begin() + std::ptrdiff_t(row), first, last);
+
+    const auto seqIds = m_seqIds.insert(
+      m_seqIds.begin() + std::ptrdiff_t(row), range.count, size_t(0));
+    std::transform(
+      first, last, seqIds, [](const auto* issue) { return issue->seqId(); });
+
+    rowsWereInsertedNotifier();
+  }
+}
+
+std::vector<size_t> IssueList::takeRows(const std::vector<Node*>& nodes)
+{
+  auto rows = std::vector<size_t>{};
+  for (const auto* node : nodes)
+  {
+    if (const auto it = m_nodeSeqIds.find(node); it != m_nodeSeqIds.end())
+    {
+      for (const auto seqId : it->second)
+      {
+        const auto rowIt = std::ranges::lower_bound(m_seqIds, seqId, std::greater<>{});
+        assert(rowIt != m_seqIds.end() && *rowIt == seqId);
+        rows.push_back(size_t(std::distance(m_seqIds.begin(), rowIt)));
+      }
+      m_nodeSeqIds.erase(it);
+    }
+  }
+  return rows;
+}
+
+} // namespace tb::mdl
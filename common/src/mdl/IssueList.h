@@ -0,0 +1,122 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Notifier.h"
+#include "NotifierConnection.h"
+#include "mdl/IssueType.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace tb::mdl
+{
+class Issue;
+class Node;
+class Validator;
+class WorldNode;
+
+/**
+ * The issues of a node tree that pass a filter, ordered by descending sequence id.
+ *
+ * The list is rebuilt from scratch by reset(), and afterwards it is maintained
+ * incrementally: removed and changed nodes lose their rows immediately, while added and
+ * changed nodes are validated and inserted when update() is called. Every change to the
+ * list is announced by the notifiers below so that a view can update only the affected
+ * rows.
+ *
+ * Issues are identified by their sequence ids when they are removed because a node
+ * destroys its issues as soon as it changes, so the issue objects of a changed node may
+ * already be gone when the list is told about the change. Nodes whose issues are
+ * destroyed as a side effect of changing another node, such as the link partners of an
+ * entity, are not necessarily reported by the document, so the list also observes the
+ * world and removes and revalidates the issues of such nodes.
+ */
+class IssueList
+{
+private:
+  std::vector<const Validator*> m_validators;
+  IssueType m_hiddenIssueTypes = 0;
+  bool m_showHiddenIssues = false;
+
+  // parallel vectors, ordered by descending sequence id
+  std::vector<const Issue*> m_issues;
+  std::vector<size_t> m_seqIds;
+
+  // the sequence ids of the listed issues of each node
+  std::unordered_map<const Node*, std::vector<size_t>> m_nodeSeqIds;
+
+  // nodes whose issues must be inserted by the next call to update()
+  std::vector<Node*> m_pendingNodes;
+
+  NotifierConnection m_notifierConnection;
+
+public:
+  Notifier<size_t, size_t> rowsWillBeInsertedNotifier;
+  Notifier<> rowsWereInsertedNotifier;
+  Notifier<size_t, size_t> rowsWillBeRemovedNotifier;
+  Notifier<> rowsWereRemovedNotifier;
+  Notifier<> listWillBeResetNotifier;
+  Notifier<> listWasResetNotifier;
+
+  const std::vector<const Issue*>& issues() const;
+
+  /**
+   * Removes all issues and forgets any pending nodes.
+   */
+  void clear();
+
+  /**
+   * Rebuilds the list from all nodes of the given world and observes the world until the
+   * list is cleared or reset again.
+   */
+  void reset(WorldNode& world, IssueType hiddenIssueTypes, bool showHiddenIssues);
+
+  /**
+   * Schedules the given nodes and their descendants to be inserted by the next call to
+   * update().
+   */
+  void addNodes(const std::vector<Node*>& nodes);
+
+  /**
+   * Removes the issues of the given nodes and their descendants.
+   */
+  void removeNodes(const std::vector<Node*>& nodes);
+
+  /**
+   * Removes the issues of the given nodes and schedules them to be validated again by the
+   * next call to update(). Descendants are not affected.
+   */
+  void updateNodes(const std::vector<Node*>& nodes);
+
+  /**
+   * Validates the pending nodes and inserts their issues.
+   */
+  void update();
+
+private:
+  bool isListed(const Issue& issue) const;
+
+  void removeRows(std::vector<size_t> rows);
+  void insertIssues(std::vector<const Issue*> issues);
+  std::vector<size_t> takeRows(const std::vector<Node*>& nodes);
+};
+
+} // namespace tb::mdl
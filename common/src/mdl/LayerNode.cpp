@@ -33,6 +33,7 @@
 
 #include <algorithm>
 #include <string>
+#include <utility>
 
 namespace tb::mdl
 {
@@ -78,6 +79,26 @@ void LayerNode::setPersistentId(const IdType persistentId)
   m_persistentId = persistentId;
 }
 
+bool LayerNode::hasDeferredContents() const
+{
+  return m_deferredContents.has_value();
+}
+
+const std::optional<DeferredLayerContents>& LayerNode::deferredContents() const
+{
+  return m_deferredContents;
+}
+
+void LayerNode::setDeferredContents(DeferredLayerContents deferredContents)
+{
+  m_deferredContents = std::move(deferredContents);
+}
+
+std::optional<DeferredLayerContents> LayerNode::takeDeferredContents()
+{
+  return std::exchange(m_deferredContents, std::nullopt);
+}
+
 const std::string& LayerNode::doGetName() const
 {
   return layer().name();
@@ -109,6 +130,7 @@ double LayerNode::doGetProjectedArea(const vm::axis::type) const
 Node* LayerNode::doClone(const vm::bbox3d&) const
 {
   auto result = std::make_unique<LayerNode>(m_layer);
+  result->m_deferredContents = m_deferredContents;
   cloneAttributes(*result);
   return result.release();
 }
@@ -26,13 +26,57 @@
 
 #include "vm/bbox.h"
 
+#include <functional>
+#include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+namespace kdl
+{
+class task_manager;
+}
+
+namespace tb
+{
+class Logger;
+}
+
 namespace tb::mdl
 {
 
+/**
+ * The contents of a layer that were read from a map file, but whose nodes have not been
+ * created yet. MapReader defers the contents of hidden layers so that loading a map does
+ * not pay for building geometry that is not shown.
+ */
+struct DeferredLayerContents
+{
+  /**
+   * Creates the nodes that belong to the layer, in file order. The returned nodes are not
+   * added to the layer.
+   */
+  std::function<std::vector<std::unique_ptr<Node>>(Logger&, kdl::task_manager&)>
+    createNodes;
+
+  /**
+   * The largest persistent ID of any group among the contents, if there is any group.
+   */
+  std::optional<IdType> maxPersistentId;
+
+  /**
+   * The number of brush faces and patches among the contents that use each material,
+   * keyed by the lower case material name.
+   */
+  std::unordered_map<std::string, size_t> materialUsageCounts;
+
+  /**
+   * The number of nodes that are added to the layer when its contents are created.
+   */
+  size_t objectCount = 0;
+};
+
 class LayerNode : public Node
 {
 private:
@@ -49,6 +93,8 @@ private:
    */
   std::optional<IdType> m_persistentId;
 
+  std::optional<DeferredLayerContents> m_deferredContents;
+
 public:
   explicit LayerNode(Layer layer);
 
@@ -65,6 +111,21 @@ public:
   const std::optional<IdType>& persistentId() const;
   void setPersistentId(IdType persistentId);
 
+  /**
+   * Indicates whether some of this layer's contents have not been created yet. Such a
+   * layer must be given its deferred nodes before its contents are shown, edited or
+   * written.
+   */
+  bool hasDeferredContents() const;
+  const std::optional<DeferredLayerContents>& deferredContents() const;
+  void setDeferredContents(DeferredLayerContents deferredContents);
+
+  /**
+   * Returns the deferred contents of this layer and forgets them. The caller is
+   * responsible for adding the created nodes to this layer.
+   */
+  std::optional<DeferredLayerContents> takeDeferredContents();
+
 private: // implement Node interface
   const std::string& doGetName() const override;
   const vm::bbox3d& doGetLogicalBounds() const override;
@@ -159,7 +159,7 @@ SelectionResult nodeSelectionWithLinkedGroupConstraints(
       for (auto* groupNode : containingGroupNodes)
       {
         // find the others and add them to the lock list
-        for (auto* otherGroup : collectGroupsWithLinkId({&world}, groupNode->linkId()))
+        for (auto* otherGroup : world.findGroupNodesWithLinkId(groupNode->linkId()))
         {
           if (otherGroup == groupNode)
           {
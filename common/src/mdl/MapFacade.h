@@ -80,8 +80,8 @@ public: // selection
 
   virtual std::vector<EntityNodeBase*> allSelectedEntityNodes() const = 0;
   virtual const NodeCollection& selectedNodes() const = 0;
-  virtual std::vector<BrushFaceHandle> allSelectedBrushFaces() const = 0;
-  virtual std::vector<BrushFaceHandle> selectedBrushFaces() const = 0;
+  virtual const std::vector<BrushFaceHandle>& allSelectedBrushFaces() const = 0;
+  virtual const std::vector<BrushFaceHandle>& selectedBrushFaces() const = 0;
 
   virtual const vm::bbox3d& referenceBounds() const = 0;
   virtual const vm::bbox3d& lastSelectionBounds() const = 0;
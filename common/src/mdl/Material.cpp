@@ -99,32 +99,9 @@ Material::Material(std::string name, std::shared_ptr<TextureResource> textureRes
 
 Material::~Material() = default;
 
-Material::Material(Material&& other)
-  : m_name{std::move(other.m_name)}
-  , m_collectionName{std::move(other.m_collectionName)}
-  , m_absolutePath{std::move(other.m_absolutePath)}
-  , m_relativePath{std::move(other.m_relativePath)}
-  , m_textureResource{std::move(other.m_textureResource)}
-  , m_usageCount{static_cast<size_t>(other.m_usageCount)}
-  , m_surfaceParms{std::move(other.m_surfaceParms)}
-  , m_culling{std::move(other.m_culling)}
-  , m_blendFunc{std::move(other.m_blendFunc)}
-{
-}
+Material::Material(Material&& other) = default;
 
-Material& Material::operator=(Material&& other)
-{
-  m_name = std::move(other.m_name);
-  m_collectionName = std::move(other.m_collectionName);
-  m_absolutePath = std::move(other.m_absolutePath);
-  m_relativePath = std::move(other.m_relativePath);
-  m_textureResource = std::move(other.m_textureResource);
-  m_usageCount = static_cast<size_t>(other.m_usageCount);
-  m_surfaceParms = std::move(other.m_surfaceParms);
-  m_culling = std::move(other.m_culling);
-  m_blendFunc = std::move(other.m_blendFunc);
-  return *this;
-}
+Material& Material::operator=(Material&& other) = default;
 
 const std::string& Material::name() const
 {
@@ -208,23 +185,6 @@ void Material::disableBlend()
   m_blendFunc.enable = MaterialBlendFunc::Enable::DisableBlend;
 }
 
-size_t Material::usageCount() const
-{
-  return static_cast<size_t>(m_usageCount);
-}
-
-void Material::incUsageCount() const
-{
-  ++m_usageCount;
-}
-
-void Material::decUsageCount() const
-{
-  const size_t previous = m_usageCount--;
-  assert(previous > 0);
-  unused(previous);
-}
-
 void Material::activate(const int minFilter, const int magFilter) const
 {
   if (const auto* texture = m_textureResource->get();
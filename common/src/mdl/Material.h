@@ -24,7 +24,6 @@
 
 #include "kdl/reflection_decl.h"
 
-#include <atomic>
 #include <filesystem>
 #include <memory>
 #include <set>
@@ -92,8 +91,6 @@ private:
 
   std::shared_ptr<TextureResource> m_textureResource;
 
-  mutable std::atomic<size_t> m_usageCount = 0;
-
   // Quake 3 surface parameters; move these to materials when we add proper support for
   // those.
   std::set<std::string> m_surfaceParms;
@@ -112,7 +109,6 @@ private:
     m_absolutePath,
     m_relativePath,
     m_textureResource,
-    m_usageCount,
     m_surfaceParms,
     m_culling,
     m_blendFunc);
@@ -159,10 +155,6 @@ public:
   void setBlendFunc(GLenum srcFactor, GLenum destFactor);
   void disableBlend();
 
-  size_t usageCount() const;
-  void incUsageCount() const;
-  void decUsageCount() const;
-
   void activate(int minFilter, int magFilter) const;
   void deactivate() const;
 };
@@ -0,0 +1,178 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MaterialIndex.h"
+
+#include "mdl/BrushFace.h"
+#include "mdl/BrushFaceHandle.h"
+#include "mdl/BrushNode.h"
+#include "mdl/EntityNode.h"
+#include "mdl/GroupNode.h"
+#include "mdl/LayerNode.h"
+#include "mdl/PatchNode.h"
+#include "mdl/WorldNode.h"
+
+#include "kdl/overload.h"
+
+#include <cassert>
+
+namespace tb::mdl
+{
+
+void MaterialIndex::addNode(Node* node)
+{
+  node->accept(kdl::overload(
+    [](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
+    [](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
+    [](auto&& thisLambda, GroupNode* group) { group->visitChildren(thisLambda); },
+    [](auto&& thisLambda, EntityNode* entity) { entity->visitChildren(thisLambda); },
+    [&](BrushNode* brushNode) {
+      for (const auto& face : brushNode->brush().faces())
+      {
+        addMaterial(brushNode, face.material());
+      }
+    },
+    [&](PatchNode* patchNode) {
+      addMaterial(patchNode, patchNode->patch().material());
+    }));
+}
+
+void MaterialIndex::removeNode(Node* node)
+{
+  node->accept(kdl::overload(
+    [](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
+    [](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
+    [](auto&& thisLambda, GroupNode* group) { group->visitChildren(thisLambda); },
+    [](auto&& thisLambda, EntityNode* entity) { entity->visitChildren(thisLambda); },
+    [&](BrushNode* brushNode) {
+      for (const auto& face : brushNode->brush().faces())
+      {
+        removeMaterial(brushNode, face.material());
+      }
+    },
+    [&](PatchNode* patchNode) {
+      removeMaterial(patchNode, patchNode->patch().material());
+    }));
+}
+
+void MaterialIndex::addMaterial(Node* node, const Material* material)
+{
+  if (material)
+  {
+    auto& usage = m_usages[material];
+    ++usage.count;
+
+    const auto [it, inserted] = usage.nodeIndices.emplace(node, usage.nodes.size());
+    if (inserted)
+    {
+      usage.nodes.push_back(NodeUsage{node, 0});
+    }
+    ++usage.nodes[it->second].count;
+  }
+}
+
+void MaterialIndex::removeMaterial(Node* node, const Material* material)
+{
+  if (material)
+  {
+    const auto usageIt = m_usages.find(material);
+    assert(usageIt != m_usages.end());
+
+    auto& usage = usageIt->second;
+    const auto indexIt = usage.nodeIndices.find(node);
+    assert(indexIt != usage.nodeIndices.end());
+
+    auto& nodeUsage = usage.nodes[indexIt->second];
+    if (--nodeUsage.count == 0)
+    {
+      // erasing the node would shift the following nodes, so it is only marked as
+      // removed and the removed nodes are erased when they make up half of the nodes
+      nodeUsage.node = nullptr;
+      usage.nodeIndices.erase(indexIt);
+      if (usage.nodeIndices.size() <= usage.nodes.size() / 2)
+      {
+        compact(usage);
+      }
+    }
+    if (--usage.count == 0)
+    {
+      m_usages.erase(usageIt);
+    }
+  }
+}
+
+size_t MaterialIndex::usageCount(const Material* material) const
+{
+  const auto it = m_usages.find(material);
+  return it != m_usages.end() ? it->second.count : 0u;
+}
+
+std::vector<Node*> MaterialIndex::findNodes(const Material* material) const
+{
+  auto result = std::vector<Node*>{};
+  if (const auto it = m_usages.find(material); it != m_usages.end())
+  {
+    result.reserve(it->second.nodeIndices.size());
+    for (const auto& nodeUsage : it->second.nodes)
+    {
+      if (nodeUsage.node)
+      {
+        result.push_back(nodeUsage.node);
+      }
+    }
+  }
+  return result;
+}
+
+std::vector<BrushFaceHandle> MaterialIndex::findBrushFaces(
+  const Material* material) const
+{
+  auto result = std::vector<BrushFaceHandle>{};
+  for (auto* node : findNodes(material))
+  {
+    node->accept(kdl::overload(
+      [](WorldNode*) {},
+      [](LayerNode*) {},
+      [](GroupNode*) {},
+      [](EntityNode*) {},
+      [&](BrushNode* brushNode) {
+        const auto& brush = brushNode->brush();
+        for (size_t i = 0; i < brush.faceCount(); ++i)
+        {
+          if (brush.face(i).material() == material)
+          {
+            result.emplace_back(brushNode, i);
+          }
+        }
+      },
+      [](PatchNode*) {}));
+  }
+  return result;
+}
+
+void MaterialIndex::compact(Usage& usage)
+{
+  std::erase_if(usage.nodes, [](const auto& nodeUsage) { return !nodeUsage.node; });
+  for (size_t i = 0; i < usage.nodes.size(); ++i)
+  {
+    usage.nodeIndices[usage.nodes[i].node] = i;
+  }
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace tb::mdl
+{
+class BrushFaceHandle;
+class Material;
+class Node;
+
+/**
+ * Maps materials to the brush and patch nodes that use them.
+ *
+ * For every material, the index stores how many faces of each node use it, so that
+ * the faces with a given material can be found without visiting every face of the
+ * map. The nodes of a material are kept in the order in which they started using it,
+ * so that queries return their results in a deterministic order.
+ */
+class MaterialIndex
+{
+private:
+  struct NodeUsage
+  {
+    // null if the node no longer uses the material
+    Node* node;
+    size_t count;
+  };
+
+  struct Usage
+  {
+    size_t count = 0;
+    std::vector<NodeUsage> nodes;
+    std::unordered_map<Node*, size_t> nodeIndices;
+  };
+
+  std::unordered_map<const Material*, Usage> m_usages;
+
+public:
+  /**
+   * Adds the materials used by the given node and its descendants.
+   */
+  void addNode(Node* node);
+
+  /**
+   * Removes the materials used by the given node and its descendants.
+   */
+  void removeNode(Node* node);
+
+  void addMaterial(Node* node, const Material* material);
+  void removeMaterial(Node* node, const Material* material);
+
+  /**
+   * Returns the number of brush faces and patches that use the given material.
+   */
+  size_t usageCount(const Material* material) const;
+
+  /**
+   * Returns the brush and patch nodes that use the given material, in the order in which
+   * they started using it.
+   */
+  std::vector<Node*> findNodes(const Material* material) const;
+
+  /**
+   * Returns the brush faces that use the given material.
+   */
+  std::vector<BrushFaceHandle> findBrushFaces(const Material* material) const;
+
+private:
+  static void compact(Usage& usage);
+};
+
+} // namespace tb::mdl
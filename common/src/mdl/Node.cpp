@@ -29,13 +29,29 @@
 #include "kdl/reflection_impl.h"
 #include "kdl/vector_utils.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iterator>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace tb::mdl
 {
+namespace
+{
+
+size_t sumFamilySizes(const std::vector<Node*>& nodes)
+{
+  auto result = size_t(0);
+  for (const auto* node : nodes)
+  {
+    result += node->familySize();
+  }
+  return result;
+}
+
+} // namespace
 
 kdl_reflect_impl(NodePath);
 
@@ -235,7 +251,8 @@ bool Node::shouldAddToSpacialIndex() const
 
 void Node::addChildren(const std::vector<Node*>& children)
 {
-  addChildren(std::begin(children), std::end(children), children.size());
+  doAddChildren(children);
+  incDescendantCount(sumFamilySizes(children));
 }
 
 Node& Node::addChild(Node* child)
@@ -281,6 +298,12 @@ std::vector<std::unique_ptr<Node>> Node::replaceChildren(
   return oldChildren;
 }
 
+void Node::removeChildren(std::vector<Node*> children)
+{
+  doRemoveChildren(children);
+  decDescendantCount(sumFamilySizes(children));
+}
+
 void Node::removeChild(Node* child)
 {
   doRemoveChild(child);
@@ -314,6 +337,30 @@ void Node::doAddChild(Node* child)
   // nodeDidChange();
 }
 
+void Node::doAddChildren(const std::vector<Node*>& children)
+{
+  for (auto* child : children)
+  {
+    ensure(child != nullptr, "child is null");
+    assert(!kdl::vec_contains(m_children, child));
+    assert(child->parent() == nullptr);
+    assert(canAddChild(child));
+  }
+
+  descendantsWillBeAdded(this, children, 1);
+  m_children.reserve(m_children.size() + children.size());
+
+  for (auto* child : children)
+  {
+    doChildWillBeAdded(child);
+    m_children.push_back(child);
+    child->setParent(this);
+    doChildWasAdded(child);
+  }
+
+  descendantsWereAdded(children, 1);
+}
+
 void Node::doRemoveChild(Node* child)
 {
   ensure(child != nullptr, "child is null");
@@ -328,6 +375,43 @@ void Node::doRemoveChild(Node* child)
   // nodeDidChange();
 }
 
+void Node::doRemoveChildren(const std::vector<Node*>& children)
+{
+  for (auto* child : children)
+  {
+    ensure(child != nullptr, "child is null");
+    assert(child->parent() == this);
+    assert(canRemoveChild(child));
+  }
+
+  descendantsWillBeRemoved(children, 1);
+
+  // move the removed children to the end in reverse order and keep the order of the
+  // remaining children, so that each child can be popped off the end when it is removed
+  const auto removedChildren =
+    std::unordered_set<Node*>{children.begin(), children.end()};
+  assert(removedChildren.size() == children.size());
+  std::stable_partition(m_children.begin(), m_children.end(), [&](auto* child) {
+    return !removedChildren.contains(child);
+  });
+  std::copy(
+    children.rbegin(),
+    children.rend(),
+    std::next(m_children.begin(), ptrdiff_t(m_children.size() - children.size())));
+
+  for (auto* child : children)
+  {
+    assert(m_children.back() == child);
+
+    doChildWillBeRemoved(child);
+    child->setParent(nullptr);
+    m_children.pop_back();
+    doChildWasRemoved(child);
+  }
+
+  descendantsWereRemoved(this, children, 1);
+}
+
 void Node::clearChildren()
 {
   kdl::vec_clear_and_delete(m_children);
@@ -395,6 +479,46 @@ void Node::descendantWasRemoved(Node* oldParent, Node* node, const size_t depth)
   invalidateIssues();
 }
 
+void Node::descendantsWillBeAdded(
+  Node* newParent, const std::vector<Node*>& nodes, const size_t depth)
+{
+  doDescendantsWillBeAdded(newParent, nodes, depth);
+  if (m_parent)
+  {
+    m_parent->descendantsWillBeAdded(newParent, nodes, depth + 1);
+  }
+}
+
+void Node::descendantsWereAdded(const std::vector<Node*>& nodes, const size_t depth)
+{
+  doDescendantsWereAdded(nodes, depth);
+  if (m_parent)
+  {
+    m_parent->descendantsWereAdded(nodes, depth + 1);
+  }
+  invalidateIssues();
+}
+
+void Node::descendantsWillBeRemoved(const std::vector<Node*>& nodes, const size_t depth)
+{
+  doDescendantsWillBeRemoved(nodes, depth);
+  if (m_parent)
+  {
+    m_parent->descendantsWillBeRemoved(nodes, depth + 1);
+  }
+}
+
+void Node::descendantsWereRemoved(
+  Node* oldParent, const std::vector<Node*>& nodes, const size_t depth)
+{
+  doDescendantsWereRemoved(oldParent, nodes, depth);
+  if (m_parent)
+  {
+    m_parent->descendantsWereRemoved(oldParent, nodes, depth + 1);
+  }
+  invalidateIssues();
+}
+
 void Node::incDescendantCount(const size_t delta)
 {
   if (delta != 0)
@@ -793,6 +917,11 @@ size_t Node::lineNumber() const
   return m_lineNumber;
 }
 
+size_t Node::lineCount() const
+{
+  return m_lineCount;
+}
+
 void Node::setFilePosition(const size_t lineNumber, const size_t lineCount) const
 {
   m_lineNumber = lineNumber;
@@ -840,12 +969,25 @@ void Node::validateIssues(const std::vector<const Validator*>& validators)
   }
 }
 
-void Node::invalidateIssues() const
+void Node::invalidateIssues()
 {
+  if (m_issuesValid)
+  {
+    issuesWillBeInvalidated(this);
+  }
   m_issues.clear();
   m_issuesValid = false;
 }
 
+void Node::issuesWillBeInvalidated(Node* node)
+{
+  doIssuesWillBeInvalidated(node);
+  if (m_parent)
+  {
+    m_parent->issuesWillBeInvalidated(node);
+  }
+}
+
 const EntityPropertyConfig& Node::entityPropertyConfig() const
 {
   return doGetEntityPropertyConfig();
@@ -879,6 +1021,36 @@ void Node::removeFromIndex(
   doRemoveFromIndex(node, key, value);
 }
 
+void Node::addToIndex(Node* node, const Material* material)
+{
+  doAddToIndex(node, material);
+}
+
+void Node::removeFromIndex(Node* node, const Material* material)
+{
+  doRemoveFromIndex(node, material);
+}
+
+void Node::addToIndex(EntityNodeBase* node, const EntityModel* model)
+{
+  doAddToIndex(node, model);
+}
+
+void Node::removeFromIndex(EntityNodeBase* node, const EntityModel* model)
+{
+  doRemoveFromIndex(node, model);
+}
+
+void Node::addToIndex(GroupNode* groupNode, const std::string& linkId)
+{
+  doAddToIndex(groupNode, linkId);
+}
+
+void Node::removeFromIndex(GroupNode* groupNode, const std::string& linkId)
+{
+  doRemoveFromIndex(groupNode, linkId);
+}
+
 Node* Node::doCloneRecursively(const vm::bbox3d& worldBounds) const
 {
   auto* clone = Node::clone(worldBounds);
@@ -902,6 +1074,41 @@ void Node::doDescendantWasRemoved(
 {
 }
 
+void Node::doDescendantsWillBeAdded(
+  Node* newParent, const std::vector<Node*>& nodes, const size_t depth)
+{
+  for (auto* node : nodes)
+  {
+    doDescendantWillBeAdded(newParent, node, depth);
+  }
+}
+
+void Node::doDescendantsWereAdded(const std::vector<Node*>& nodes, const size_t depth)
+{
+  for (auto* node : nodes)
+  {
+    doDescendantWasAdded(node, depth);
+  }
+}
+
+void Node::doDescendantsWillBeRemoved(
+  const std::vector<Node*>& nodes, const size_t depth)
+{
+  for (auto* node : nodes)
+  {
+    doDescendantWillBeRemoved(node, depth);
+  }
+}
+
+void Node::doDescendantsWereRemoved(
+  Node* oldParent, const std::vector<Node*>& nodes, const size_t depth)
+{
+  for (auto* node : nodes)
+  {
+    doDescendantWasRemoved(oldParent, node, depth);
+  }
+}
+
 void Node::doParentWillChange() {}
 void Node::doParentDidChange() {}
 void Node::doAncestorWillChange() {}
@@ -916,6 +1123,8 @@ void Node::doChildDidChange(Node* /* node */) {}
 void Node::doDescendantWillChange(Node* /* node */) {}
 void Node::doDescendantDidChange(Node* /* node */) {}
 
+void Node::doIssuesWillBeInvalidated(Node* /* node */) {}
+
 const EntityPropertyConfig& Node::doGetEntityPropertyConfig() const
 {
   if (m_parent)
@@ -967,4 +1176,52 @@ void Node::doRemoveFromIndex(
   }
 }
 
+void Node::doAddToIndex(Node* node, const Material* material)
+{
+  if (m_parent)
+  {
+    m_parent->addToIndex(node, material);
+  }
+}
+
+void Node::doRemoveFromIndex(Node* node, const Material* material)
+{
+  if (m_parent)
+  {
+    m_parent->removeFromIndex(node, material);
+  }
+}
+
+void Node::doAddToIndex(EntityNodeBase* node, const EntityModel* model)
+{
+  if (m_parent)
+  {
+    m_parent->addToIndex(node, model);
+  }
+}
+
+void Node::doRemoveFromIndex(EntityNodeBase* node, const EntityModel* model)
+{
+  if (m_parent)
+  {
+    m_parent->removeFromIndex(node, model);
+  }
+}
+
+void Node::doAddToIndex(GroupNode* groupNode, const std::string& linkId)
+{
+  if (m_parent)
+  {
+    m_parent->addToIndex(groupNode, linkId);
+  }
+}
+
+void Node::doRemoveFromIndex(GroupNode* groupNode, const std::string& linkId)
+{
+  if (m_parent)
+  {
+    m_parent->removeFromIndex(groupNode, linkId);
+  }
+}
+
 } // namespace tb::mdl
@@ -40,10 +40,13 @@ namespace tb::mdl
 {
 
 class EditorContext;
+class EntityModel;
 class EntityNodeBase;
 struct EntityPropertyConfig;
+class GroupNode;
 class ConstNodeVisitor;
 class Issue;
+class Material;
 class NodeVisitor;
 class PickResult;
 class Validator;
@@ -173,18 +176,20 @@ public: // tree management
   bool shouldAddToSpacialIndex() const;
 
 public:
+  /**
+   * Adds the given children to this node. This node and each child are notified in the
+   * same order as by addChild, but the ancestors of this node are notified once for all
+   * children.
+   */
   void addChildren(const std::vector<Node*>& children);
 
   template <typename I>
   void addChildren(I cur, I end, size_t count = 0)
   {
-    m_children.reserve(m_children.size() + count);
-    size_t descendantCountDelta = 0;
-    std::for_each(cur, end, [&](auto* child) {
-      doAddChild(child);
-      descendantCountDelta += child->descendantCount() + 1;
-    });
-    incDescendantCount(descendantCountDelta);
+    auto children = std::vector<Node*>{};
+    children.reserve(count);
+    children.insert(children.end(), cur, end);
+    addChildren(children);
   }
 
   Node& addChild(Node* child);
@@ -192,15 +197,18 @@ public:
   std::vector<std::unique_ptr<Node>> replaceChildren(
     std::vector<std::unique_ptr<Node>> newChildren);
 
+  /**
+   * Removes the given children from this node. This node and each child are notified in
+   * the same order as by removeChild, but the ancestors of this node are notified once
+   * for all children, and removing many children is linear in the number of children of
+   * this node.
+   */
+  void removeChildren(std::vector<Node*> children);
+
   template <typename I>
   void removeChildren(I cur, I end)
   {
-    size_t descendantCountDelta = 0;
-    std::for_each(cur, end, [&](auto* child) {
-      doRemoveChild(child);
-      descendantCountDelta += child->descendantCount() + 1;
-    });
-    decDescendantCount(descendantCountDelta);
+    removeChildren(std::vector<Node*>(cur, end));
   }
 
   void removeChild(Node* child);
@@ -223,7 +231,9 @@ public:
 
 private:
   void doAddChild(Node* child);
+  void doAddChildren(const std::vector<Node*>& children);
   void doRemoveChild(Node* child);
+  void doRemoveChildren(const std::vector<Node*>& children);
   void clearChildren();
 
   void childWillBeAdded(Node* node);
@@ -236,6 +246,13 @@ private:
   void descendantWillBeRemoved(Node* node, size_t depth);
   void descendantWasRemoved(Node* oldParent, Node* node, size_t depth);
 
+  void descendantsWillBeAdded(
+    Node* newParent, const std::vector<Node*>& nodes, size_t depth);
+  void descendantsWereAdded(const std::vector<Node*>& nodes, size_t depth);
+  void descendantsWillBeRemoved(const std::vector<Node*>& nodes, size_t depth);
+  void descendantsWereRemoved(
+    Node* oldParent, const std::vector<Node*>& nodes, size_t depth);
+
   void incDescendantCount(size_t delta);
   void decDescendantCount(size_t delta);
 
@@ -345,6 +362,7 @@ public: // picking
 
 public: // file position
   size_t lineNumber() const;
+  size_t lineCount() const;
   void setFilePosition(size_t lineNumber, size_t lineCount) const;
   bool containsLine(size_t lineNumber) const;
 
@@ -355,10 +373,11 @@ public: // issue management
   void setIssueHidden(IssueType type, bool hidden);
 
 public: // should only be called from this and from the world
-  void invalidateIssues() const;
+  void invalidateIssues();
 
 private:
   void validateIssues(const std::vector<const Validator*>& validators);
+  void issuesWillBeInvalidated(Node* node);
 
 public: // visitors
   /**
@@ -502,6 +521,15 @@ protected: // index management
   void removeFromIndex(
     EntityNodeBase* node, const std::string& key, const std::string& value);
 
+  void addToIndex(Node* node, const Material* material);
+  void removeFromIndex(Node* node, const Material* material);
+
+  void addToIndex(EntityNodeBase* node, const EntityModel* model);
+  void removeFromIndex(EntityNodeBase* node, const EntityModel* model);
+
+  void addToIndex(GroupNode* groupNode, const std::string& linkId);
+  void removeFromIndex(GroupNode* groupNode, const std::string& linkId);
+
 private: // subclassing interface
   virtual const std::string& doGetName() const = 0;
   virtual const vm::bbox3d& doGetLogicalBounds() const = 0;
@@ -528,6 +556,18 @@ private: // subclassing interface
   virtual void doDescendantWillBeRemoved(Node* node, size_t depth);
   virtual void doDescendantWasRemoved(Node* oldParent, Node* node, size_t depth);
 
+  /**
+   * Called once when several children of the same node are added or removed together.
+   * The default implementations call the corresponding hook for each node, so
+   * subclasses only need to override these to handle the nodes in bulk.
+   */
+  virtual void doDescendantsWillBeAdded(
+    Node* newParent, const std::vector<Node*>& nodes, size_t depth);
+  virtual void doDescendantsWereAdded(const std::vector<Node*>& nodes, size_t depth);
+  virtual void doDescendantsWillBeRemoved(const std::vector<Node*>& nodes, size_t depth);
+  virtual void doDescendantsWereRemoved(
+    Node* oldParent, const std::vector<Node*>& nodes, size_t depth);
+
   virtual void doParentWillChange();
   virtual void doParentDidChange();
   virtual void doAncestorWillChange();
@@ -542,6 +582,8 @@ private: // subclassing interface
   virtual void doDescendantWillChange(Node* node);
   virtual void doDescendantDidChange(Node* node);
 
+  virtual void doIssuesWillBeInvalidated(Node* node);
+
   virtual bool doSelectable() const = 0;
 
   virtual void doPick(
@@ -567,6 +609,15 @@ private: // subclassing interface
     EntityNodeBase* node, const std::string& key, const std::string& value);
   virtual void doRemoveFromIndex(
     EntityNodeBase* node, const std::string& key, const std::string& value);
+
+  virtual void doAddToIndex(Node* node, const Material* material);
+  virtual void doRemoveFromIndex(Node* node, const Material* material);
+
+  virtual void doAddToIndex(EntityNodeBase* node, const EntityModel* model);
+  virtual void doRemoveFromIndex(EntityNodeBase* node, const EntityModel* model);
+
+  virtual void doAddToIndex(GroupNode* groupNode, const std::string& linkId);
+  virtual void doRemoveFromIndex(GroupNode* groupNode, const std::string& linkId);
 };
 
 } // namespace tb::mdl
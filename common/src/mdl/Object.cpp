@@ -39,7 +39,9 @@ const std::string& Object::linkId() const
 
 void Object::setLinkId(std::string linkId)
 {
+  doLinkIdWillChange();
   m_linkId = std::move(linkId);
+  doLinkIdDidChange();
 }
 
 void Object::cloneLinkId(Object& object) const
@@ -88,4 +90,7 @@ bool Object::containingGroupOpened() const
   return group == nullptr || group->opened();
 }
 
+void Object::doLinkIdWillChange() {}
+void Object::doLinkIdDidChange() {}
+
 } // namespace tb::mdl
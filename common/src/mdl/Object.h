@@ -58,6 +58,9 @@ private: // subclassing interface
   virtual Node* doGetContainer() = 0;
   virtual LayerNode* doGetContainingLayer() = 0;
   virtual GroupNode* doGetContainingGroup() = 0;
+
+  virtual void doLinkIdWillChange();
+  virtual void doLinkIdDidChange();
 };
 
 } // namespace tb::mdl
@@ -123,7 +123,7 @@ ParallelUVCoordSystem::ParallelUVCoordSystem(
 {
 }
 
-std::tuple<std::unique_ptr<UVCoordSystem>, BrushFaceAttributes> ParallelUVCoordSystem::
+std::tuple<ParallelUVCoordSystem, BrushFaceAttributes> ParallelUVCoordSystem::
   fromParaxial(
     const vm::vec3d& point0,
     const vm::vec3d& point1,
@@ -131,13 +131,7 @@ std::tuple<std::unique_ptr<UVCoordSystem>, BrushFaceAttributes> ParallelUVCoordS
     const BrushFaceAttributes& attribs)
 {
   const auto tempParaxial = ParaxialUVCoordSystem{point0, point1, point2, attribs};
-  return {
-    ParallelUVCoordSystem{tempParaxial.uAxis(), tempParaxial.vAxis()}.clone(), attribs};
-}
-
-std::unique_ptr<UVCoordSystem> ParallelUVCoordSystem::clone() const
-{
-  return std::make_unique<ParallelUVCoordSystem>(uAxis(), vAxis());
+  return {ParallelUVCoordSystem{tempParaxial.uAxis(), tempParaxial.vAxis()}, attribs};
 }
 
 std::unique_ptr<UVCoordSystemSnapshot> ParallelUVCoordSystem::takeSnapshot() const
@@ -324,27 +318,6 @@ float ParallelUVCoordSystem::measureAngle(
   return currentAngle + vm::to_degrees(angleInRadians);
 }
 
-std::tuple<std::unique_ptr<UVCoordSystem>, BrushFaceAttributes> ParallelUVCoordSystem::
-  toParallel(
-    const vm::vec3d&,
-    const vm::vec3d&,
-    const vm::vec3d&,
-    const BrushFaceAttributes& attribs) const
-{
-  return {clone(), attribs};
-}
-
-std::tuple<std::unique_ptr<UVCoordSystem>, BrushFaceAttributes> ParallelUVCoordSystem::
-  toParaxial(
-    const vm::vec3d& point0,
-    const vm::vec3d& point1,
-    const vm::vec3d& point2,
-    const BrushFaceAttributes& attribs) const
-{
-  return ParaxialUVCoordSystem::fromParallel(
-    point0, point1, point2, attribs, uAxis(), vAxis());
-}
-
 bool ParallelUVCoordSystem::isRotationInverted(const vm::vec3d& /* normal */) const
 {
   return false;
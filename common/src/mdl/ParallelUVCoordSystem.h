@@ -64,13 +64,12 @@ public:
     const BrushFaceAttributes& attribs);
   ParallelUVCoordSystem(const vm::vec3d& uAxis, const vm::vec3d& vAxis);
 
-  static std::tuple<std::unique_ptr<UVCoordSystem>, BrushFaceAttributes> fromParaxial(
+  static std::tuple<ParallelUVCoordSystem, BrushFaceAttributes> fromParaxial(
     const vm::vec3d& point0,
     const vm::vec3d& point1,
     const vm::vec3d& point2,
     const BrushFaceAttributes& attribs);
 
-  std::unique_ptr<UVCoordSystem> clone() const override;
   std::unique_ptr<UVCoordSystemSnapshot> takeSnapshot() const override;
   void restoreSnapshot(const UVCoordSystemSnapshot& snapshot) override;
 
@@ -109,17 +108,6 @@ public:
   float measureAngle(
     float currentAngle, const vm::vec2f& center, const vm::vec2f& point) const override;
 
-  std::tuple<std::unique_ptr<UVCoordSystem>, BrushFaceAttributes> toParallel(
-    const vm::vec3d& point0,
-    const vm::vec3d& point1,
-    const vm::vec3d& point2,
-    const BrushFaceAttributes& attribs) const override;
-  std::tuple<std::unique_ptr<UVCoordSystem>, BrushFaceAttributes> toParaxial(
-    const vm::vec3d& point0,
-    const vm::vec3d& point1,
-    const vm::vec3d& point2,
-    const BrushFaceAttributes& attribs) const override;
-
 private:
   bool isRotationInverted(const vm::vec3d& normal) const override;
 
@@ -133,7 +121,7 @@ private:
   float computeRotationAngle(
     const vm::plane3d& oldBoundary, const vm::mat4x4d& transformation) const;
 
-  deleteCopyAndMove(ParallelUVCoordSystem);
+  defineCopyAndMove(ParallelUVCoordSystem);
 };
 
 } // namespace tb::mdl
@@ -466,7 +466,7 @@ ParaxialUVCoordSystem::ParaxialUVCoordSystem(
 {
 }
 
-std::tuple<std::unique_ptr<UVCoordSystem>, BrushFaceAttributes> ParaxialUVCoordSystem::
+std::tuple<ParaxialUVCoordSystem, BrushFaceAttributes> ParaxialUVCoordSystem::
   fromParallel(
     const vm::vec3d& point0,
     const vm::vec3d& point1,
@@ -501,7 +501,7 @@ std::tuple<std::unique_ptr<UVCoordSystem>, BrushFaceAttributes> ParaxialUVCoordS
   }
 
   return {
-    std::make_unique<ParaxialUVCoordSystem>(point0, point1, point2, newAttribs),
+    ParaxialUVCoordSystem{point0, point1, point2, newAttribs},
     newAttribs,
   };
 }
@@ -532,11 +532,6 @@ std::tuple<vm::vec3d, vm::vec3d, vm::vec3d> ParaxialUVCoordSystem::axes(
   };
 }
 
-std::unique_ptr<UVCoordSystem> ParaxialUVCoordSystem::clone() const
-{
-  return std::make_unique<ParaxialUVCoordSystem>(m_index, m_uAxis, m_vAxis);
-}
-
 std::unique_ptr<UVCoordSystemSnapshot> ParaxialUVCoordSystem::takeSnapshot() const
 {
   return nullptr;
@@ -759,27 +754,6 @@ float ParaxialUVCoordSystem::measureAngle(
   return vm::to_degrees(angleInRadians);
 }
 
-std::tuple<std::unique_ptr<UVCoordSystem>, BrushFaceAttributes> ParaxialUVCoordSystem::
-  toParallel(
-    const vm::vec3d& point0,
-    const vm::vec3d& point1,
-    const vm::vec3d& point2,
-    const BrushFaceAttributes& attribs) const
-{
-  return ParallelUVCoordSystem::fromParaxial(point0, point1, point2, attribs);
-}
-
-std::tuple<std::unique_ptr<UVCoordSystem>, BrushFaceAttributes> ParaxialUVCoordSystem::
-  toParaxial(
-    const vm::vec3d&,
-    const vm::vec3d&,
-    const vm::vec3d&,
-    const BrushFaceAttributes& attribs) const
-{
-  // Already in the requested format
-  return {clone(), attribs};
-}
-
 bool ParaxialUVCoordSystem::isRotationInverted(const vm::vec3d& normal) const
 {
   const auto index = planeNormalIndex(normal);
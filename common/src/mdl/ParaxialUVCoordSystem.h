@@ -25,6 +25,7 @@
 #include "vm/vec.h"
 
 #include <memory>
+#include <tuple>
 
 namespace tb::mdl
 {
@@ -45,7 +46,7 @@ public:
   ParaxialUVCoordSystem(const vm::vec3d& normal, const BrushFaceAttributes& attribs);
   ParaxialUVCoordSystem(size_t index, const vm::vec3d& uAxis, const vm::vec3d& vAxis);
 
-  static std::tuple<std::unique_ptr<UVCoordSystem>, BrushFaceAttributes> fromParallel(
+  static std::tuple<ParaxialUVCoordSystem, BrushFaceAttributes> fromParallel(
     const vm::vec3d& point0,
     const vm::vec3d& point1,
     const vm::vec3d& point2,
@@ -56,7 +57,6 @@ public:
   static size_t planeNormalIndex(const vm::vec3d& normal);
   static std::tuple<vm::vec3d, vm::vec3d, vm::vec3d> axes(size_t index);
 
-  std::unique_ptr<UVCoordSystem> clone() const override;
   std::unique_ptr<UVCoordSystemSnapshot> takeSnapshot() const override;
   void restoreSnapshot(const UVCoordSystemSnapshot& snapshot) override;
 
@@ -93,17 +93,6 @@ public:
   float measureAngle(
     float currentAngle, const vm::vec2f& center, const vm::vec2f& point) const override;
 
-  std::tuple<std::unique_ptr<UVCoordSystem>, BrushFaceAttributes> toParallel(
-    const vm::vec3d& point0,
-    const vm::vec3d& point1,
-    const vm::vec3d& point2,
-    const BrushFaceAttributes& attribs) const override;
-  std::tuple<std::unique_ptr<UVCoordSystem>, BrushFaceAttributes> toParaxial(
-    const vm::vec3d& point0,
-    const vm::vec3d& point1,
-    const vm::vec3d& point2,
-    const BrushFaceAttributes& attribs) const override;
-
 private:
   bool isRotationInverted(const vm::vec3d& normal) const override;
 
@@ -114,7 +103,7 @@ private:
     const vm::vec3d& newNormal,
     const BrushFaceAttributes& attribs) override;
 
-  deleteCopyAndMove(ParaxialUVCoordSystem);
+  defineCopyAndMove(ParaxialUVCoordSystem);
 };
 
 } // namespace tb::mdl
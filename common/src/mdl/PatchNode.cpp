@@ -337,12 +337,24 @@ BezierPatch PatchNode::setPatch(BezierPatch patch)
 
   auto previousPatch = std::exchange(m_patch, std::move(patch));
   m_grid = makePatchGrid(m_patch, DefaultSubdivisionsPerSurface);
+
+  if (previousPatch.material() != m_patch.material())
+  {
+    removeFromIndex(this, previousPatch.material());
+    addToIndex(this, m_patch.material());
+  }
+
   return previousPatch;
 }
 
 void PatchNode::setMaterial(Material* material)
 {
-  m_patch.setMaterial(material);
+  const auto* previousMaterial = m_patch.material();
+  if (m_patch.setMaterial(material))
+  {
+    removeFromIndex(this, previousMaterial);
+    addToIndex(this, material);
+  }
 }
 
 const PatchGrid& PatchNode::grid() const
@@ -31,6 +31,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <utility>
 
 namespace tb::mdl
 {
@@ -84,7 +85,7 @@ size_t PickResult::size() const
   return m_hits.size();
 }
 
-void PickResult::addHit(const Hit& hit)
+void PickResult::addHit(Hit hit)
 {
   assert(!vm::is_nan(hit.distance()));
   assert(!vm::is_nan(hit.hitPoint()));
@@ -92,25 +93,28 @@ void PickResult::addHit(const Hit& hit)
   if (!vm::is_nan(hit.distance()) && !vm::is_nan(hit.hitPoint()))
   {
     ensure(m_compare.get() != nullptr, "compare is null");
-    auto pos = std::upper_bound(
-      std::begin(m_hits), std::end(m_hits), hit, CompareWrapper(m_compare.get()));
-    m_hits.insert(pos, hit);
+
+    // hits are often added in order, in which case there is nothing to sort later
+    const auto compare = CompareWrapper{m_compare.get()};
+    m_sorted = m_sorted && (m_hits.empty() || !compare(hit, m_hits.back()));
+    m_hits.push_back(std::move(hit));
   }
 }
 
 const std::vector<Hit>& PickResult::all() const
 {
-  return m_hits;
+  return sortedHits();
 }
 
 const Hit& PickResult::first(const HitFilter& filter) const
 {
   const auto occluder = HitFilters::type(HitType::AnyType);
+  const auto& hits = sortedHits();
 
-  if (!m_hits.empty())
+  if (!hits.empty())
   {
-    auto it = std::begin(m_hits);
-    auto end = std::end(m_hits);
+    auto it = std::begin(hits);
+    auto end = std::end(hits);
     auto bestMatch = end;
 
     auto bestMatchError = std::numeric_limits<double>::max();
@@ -152,12 +156,29 @@ const Hit& PickResult::first(const HitFilter& filter) const
 
 std::vector<Hit> PickResult::all(const HitFilter& filter) const
 {
-  return kdl::vec_filter(m_hits, filter);
+  return kdl::vec_filter(sortedHits(), filter);
+}
+
+PickResult::HitView PickResult::view(HitFilter filter) const
+{
+  return HitView{std::ranges::ref_view{sortedHits()}, std::move(filter)};
 }
 
 void PickResult::clear()
 {
   m_hits.clear();
+  m_sorted = true;
+}
+
+const std::vector<Hit>& PickResult::sortedHits() const
+{
+  if (!m_sorted)
+  {
+    // a stable sort keeps hits that compare equal in the order in which they were added
+    std::ranges::stable_sort(m_hits, CompareWrapper{m_compare.get()});
+    m_sorted = true;
+  }
+  return m_hits;
 }
 
 } // namespace tb::mdl
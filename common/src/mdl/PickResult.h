@@ -26,16 +26,26 @@
 #include "vm/util.h"
 
 #include <memory>
+#include <ranges>
 #include <vector>
 
 namespace tb::mdl
 {
 class CompareHits;
 
+/**
+ * Collects the hits of a pick. The hits are collected unsorted and are sorted once when
+ * they are first queried after adding hits.
+ */
 class PickResult
 {
+public:
+  using HitView =
+    std::ranges::filter_view<std::ranges::ref_view<const std::vector<Hit>>, HitFilter>;
+
 private:
-  std::vector<Hit> m_hits;
+  mutable std::vector<Hit> m_hits;
+  mutable bool m_sorted = true;
   std::shared_ptr<CompareHits> m_compare;
   class CompareWrapper;
 
@@ -53,13 +63,22 @@ public:
   bool empty() const;
   size_t size() const;
 
-  void addHit(const Hit& hit);
+  void addHit(Hit hit);
 
   const std::vector<Hit>& all() const;
   const Hit& first(const HitFilter& filter) const;
   std::vector<Hit> all(const HitFilter& filter) const;
 
+  /**
+   * Returns a view of the hits that match the given filter without copying them. The
+   * view is invalidated when hits are added to or removed from this pick result.
+   */
+  HitView view(HitFilter filter) const;
+
   void clear();
+
+private:
+  const std::vector<Hit>& sortedHits() const;
 };
 
 } // namespace tb::mdl
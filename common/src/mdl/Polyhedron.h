@@ -1128,6 +1128,26 @@ template <typename T, typename FP, typename VP>
 using Polyhedron_FaceList = kdl::
   intrusive_circular_list<Polyhedron_Face<T, FP, VP>, Polyhedron_GetFaceLink<T, FP, VP>>;
 
+/**
+ * The algorithm used to compute the convex hull of a set of points when constructing a
+ * polyhedron.
+ */
+enum class ConvexHullAlgorithm
+{
+  /**
+   * Adds the points one by one, see Polyhedron::addPoints.
+   */
+  Incremental,
+
+  /**
+   * Builds an initial tetrahedron from extreme points and then only adds points that lie
+   * outside of the current hull, always choosing the farthest such point next. Points
+   * inside the hull are discarded without modifying the polyhedron. This is much faster
+   * than the incremental algorithm for dense point sets.
+   */
+  QuickHull
+};
+
 template <typename T, typename FP, typename VP>
 class Polyhedron
 {
@@ -1240,6 +1260,15 @@ public: // Constructors
    */
   explicit Polyhedron(std::vector<vm::vec<T, 3>> positions);
 
+  /**
+   * Constructs a polyhedron that corresponds to the convex hull of the given points
+   * using the given algorithm.
+   *
+   * @param positions the points from which the convex hull is computed
+   * @param algorithm the algorithm to use
+   */
+  Polyhedron(std::vector<vm::vec<T, 3>> positions, ConvexHullAlgorithm algorithm);
+
   /**
    * Copy constructor.
    */
@@ -1722,6 +1751,28 @@ private: // Convex hull; adding and removing points
    * @param points the points to add to this polyhedron
    */
   void addPoints(std::vector<vm::vec<T, 3>> points);
+
+  /**
+   * Computes the convex hull of the given points using the quickhull algorithm and adds
+   * it to this polyhedron, which must be empty.
+   *
+   * An initial tetrahedron is built from extreme points, and every remaining point is
+   * assigned to a face that it lies above. Points that do not lie above any face are
+   * discarded. Then the point that is farthest from its face is added repeatedly, and the
+   * points assigned to faces removed by adding it are redistributed to the new faces
+   * incident to the added vertex.
+   *
+   * If the given points do not span a volume, this falls back to addPoints.
+   *
+   * @param points the points to add to this polyhedron
+   */
+  void addPointsQuickHull(std::vector<vm::vec<T, 3>> points);
+
+  /**
+   * Helper function for addPointsQuickHull that adds the given points incrementally
+   * using the given plane epsilon.
+   */
+  void addPointsIncrementally(const std::vector<vm::vec<T, 3>>& points, T planeEpsilon);
   /**
    * Adds the given point to this polyhedron. The effect of adding the given point to a
    * polyhedron is that the resulting polyhedron is the convex hull of the union of the
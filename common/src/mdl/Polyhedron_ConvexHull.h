@@ -27,10 +27,15 @@
 #include "vm/bbox.h"
 #include "vm/constants.h"
 #include "vm/plane.h"
+#include "vm/scalar.h"
 #include "vm/segment.h"
 #include "vm/util.h"
 
+#include <algorithm>
+#include <array>
 #include <list>
+#include <optional>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -51,6 +56,106 @@ T computePlaneEpsilon(const std::vector<vm::vec<T, 3>>& points)
     vm::get_max_component(size) / T(10) * vm::constants<T>::point_status_epsilon();
   return std::max(computedEpsilon, defaultEpsilon);
 }
+
+/**
+ * Returns the indices of four points that span a tetrahedron of maximal extent, or
+ * nullopt if the given points do not span a volume.
+ *
+ * The first two points are the pair of axis aligned extreme points that are farthest
+ * apart. The third point is the point farthest from the line through them, and the
+ * fourth point is the point farthest from the plane through the first three points.
+ */
+template <typename T>
+std::optional<std::array<size_t, 4>> findInitialSimplex(
+  const std::vector<vm::vec<T, 3>>& points, const T minEdgeLength, const T planeEpsilon)
+{
+  if (points.size() < 4)
+  {
+    return std::nullopt;
+  }
+
+  auto extremes = std::array<size_t, 6>{0, 0, 0, 0, 0, 0};
+  for (size_t i = 1; i < points.size(); ++i)
+  {
+    for (size_t axis = 0; axis < 3; ++axis)
+    {
+      if (points[i][axis] < points[extremes[2 * axis]][axis])
+      {
+        extremes[2 * axis] = i;
+      }
+      if (points[i][axis] > points[extremes[2 * axis + 1]][axis])
+      {
+        extremes[2 * axis + 1] = i;
+      }
+    }
+  }
+
+  auto i1 = extremes[0], i2 = extremes[1];
+  for (size_t i = 0; i < extremes.size(); ++i)
+  {
+    for (size_t j = i + 1; j < extremes.size(); ++j)
+    {
+      if (
+        vm::squared_distance(points[extremes[i]], points[extremes[j]])
+        > vm::squared_distance(points[i1], points[i2]))
+      {
+        i1 = extremes[i];
+        i2 = extremes[j];
+      }
+    }
+  }
+
+  if (vm::distance(points[i1], points[i2]) < minEdgeLength)
+  {
+    return std::nullopt;
+  }
+
+  const auto& p1 = points[i1];
+  const auto& p2 = points[i2];
+  const auto lineDirection = vm::normalize(p2 - p1);
+
+  auto i3 = i1;
+  auto maxLineDistance = T(0);
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    const auto lineDistance = vm::length(vm::cross(points[i] - p1, lineDirection));
+    if (lineDistance > maxLineDistance)
+    {
+      i3 = i;
+      maxLineDistance = lineDistance;
+    }
+  }
+
+  if (maxLineDistance < minEdgeLength)
+  {
+    return std::nullopt;
+  }
+
+  const auto plane = vm::from_points(p1, p2, points[i3]);
+  if (!plane)
+  {
+    return std::nullopt;
+  }
+
+  auto i4 = i1;
+  auto maxPlaneDistance = T(0);
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    const auto planeDistance = vm::abs(plane->point_distance(points[i]));
+    if (planeDistance > maxPlaneDistance)
+    {
+      i4 = i;
+      maxPlaneDistance = planeDistance;
+    }
+  }
+
+  if (maxPlaneDistance <= planeEpsilon)
+  {
+    return std::nullopt;
+  }
+
+  return std::array<size_t, 4>{i1, i2, i3, i4};
+}
 } // namespace detail
 
 template <typename T, typename FP, typename VP>
@@ -61,10 +166,179 @@ void Polyhedron<T, FP, VP>::addPoints(std::vector<vm::vec<T, 3>> points)
     points = kdl::vec_sort_and_remove_duplicates(std::move(points));
 
     const auto planeEpsilon = detail::computePlaneEpsilon(points);
-    for (const auto& point : points)
+    addPointsIncrementally(points, planeEpsilon);
+  }
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron<T, FP, VP>::addPointsQuickHull(std::vector<vm::vec<T, 3>> points)
+{
+  assert(empty());
+
+  if (points.empty())
+  {
+    return;
+  }
+
+  points = kdl::vec_sort_and_remove_duplicates(std::move(points));
+  const auto planeEpsilon = detail::computePlaneEpsilon(points);
+
+  const auto simplex = detail::findInitialSimplex(points, MinEdgeLength, planeEpsilon);
+  if (!simplex)
+  {
+    addPointsIncrementally(points, planeEpsilon);
+    return;
+  }
+
+  for (const auto i : *simplex)
+  {
+    addPoint(points[i], planeEpsilon);
+  }
+
+  if (!polyhedron())
+  {
+    clear();
+    addPointsIncrementally(points, planeEpsilon);
+    return;
+  }
+
+  // Every point that lies outside of the current hull is assigned to exactly one face
+  // that it lies above. Faces without any such points have no entry. The entries are
+  // kept in the order in which they were created so that the hull is built in the same
+  // order every time.
+  struct Conflict
+  {
+    const Face* face;
+    std::vector<vm::vec<T, 3>> points;
+  };
+
+  auto conflicts = std::vector<Conflict>{};
+  auto conflictIndices = std::unordered_map<const Face*, size_t>{};
+
+  const auto assignToFace = [&](const auto& point, const auto& faces) {
+    for (auto* face : faces)
     {
-      addPoint(point, planeEpsilon);
+      if (face->pointStatus(point, planeEpsilon) == vm::plane_status::above)
+      {
+        const auto [it, inserted] = conflictIndices.try_emplace(face, conflicts.size());
+        if (inserted)
+        {
+          conflicts.push_back(Conflict{face, {}});
+        }
+        conflicts[it->second].points.push_back(point);
+        return;
+      }
+    }
+  };
+
+  for (const auto& point : points)
+  {
+    assignToFace(point, m_faces);
+  }
+
+  auto unchangedFaces = std::unordered_set<const Face*>{};
+  auto newFaces = std::vector<const Face*>{};
+  auto orphans = std::vector<vm::vec<T, 3>>{};
+
+  while (!conflicts.empty())
+  {
+    auto& conflict = conflicts.back();
+    const auto* eyeFace = conflict.face;
+    auto& eyeFacePoints = conflict.points;
+
+    const auto eyeIt = std::ranges::max_element(eyeFacePoints, {}, [&](const auto& p) {
+      return eyeFace->plane().point_distance(p);
+    });
+    const auto eye = *eyeIt;
+    eyeFacePoints.erase(eyeIt);
+    if (eyeFacePoints.empty())
+    {
+      conflictIndices.erase(eyeFace);
+      conflicts.pop_back();
+    }
+
+    auto* top = addPoint(eye, planeEpsilon);
+
+    if (!polyhedron())
+    {
+      // Merging coplanar faces has collapsed this polyhedron, so we start over with the
+      // incremental algorithm.
+      clear();
+      addPointsIncrementally(points, planeEpsilon);
+      return;
     }
+
+    // The faces incident to the eye point were either created or changed when adding
+    // the eye point. A created face may have the address of a face that was removed.
+    newFaces.clear();
+    if (top)
+    {
+      auto* firstLeaving = top->leaving();
+      auto* currentLeaving = firstLeaving;
+      do
+      {
+        newFaces.push_back(currentLeaving->face());
+        currentLeaving = currentLeaving->nextIncident();
+      } while (currentLeaving != firstLeaving);
+    }
+
+    unchangedFaces.clear();
+    unchangedFaces.insert(m_faces.begin(), m_faces.end());
+    for (const auto* face : newFaces)
+    {
+      unchangedFaces.erase(face);
+    }
+
+    // Collect the points assigned to faces that were removed or changed when adding the
+    // eye point.
+    orphans.clear();
+    std::erase_if(conflicts, [&](auto& entry) {
+      if (unchangedFaces.contains(entry.face))
+      {
+        return false;
+      }
+      orphans = kdl::vec_concat(std::move(orphans), std::move(entry.points));
+      return true;
+    });
+
+    if (orphans.empty())
+    {
+      continue;
+    }
+
+    conflictIndices.clear();
+    for (size_t i = 0; i < conflicts.size(); ++i)
+    {
+      conflictIndices.emplace(conflicts[i].face, i);
+    }
+
+    // An orphaned point can only lie outside of the new hull if it lies above one of the
+    // faces incident to the eye point. If the eye point was not added, we must check all
+    // faces.
+    if (top)
+    {
+      for (const auto& point : orphans)
+      {
+        assignToFace(point, newFaces);
+      }
+    }
+    else
+    {
+      for (const auto& point : orphans)
+      {
+        assignToFace(point, m_faces);
+      }
+    }
+  }
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron<T, FP, VP>::addPointsIncrementally(
+  const std::vector<vm::vec<T, 3>>& points, const T planeEpsilon)
+{
+  for (const auto& point : points)
+  {
+    addPoint(point, planeEpsilon);
   }
 }
 
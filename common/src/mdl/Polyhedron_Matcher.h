@@ -22,15 +22,241 @@
 #include "Ensure.h"
 #include "Polyhedron.h" // IWYU pragma: keep
 
-#include "kdl/binary_relation.h"
-#include "kdl/vector_set.h"
-
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <functional>
 #include <limits>
-#include <map>
+#include <optional>
+#include <utility>
 #include <vector>
 
 namespace tb::mdl
 {
+namespace detail
+{
+
+/**
+ * A relation between the vertices of two polyhedra, stored as a bit matrix with one row
+ * per left vertex and one column per right vertex. Vertices are identified by their
+ * indices in the vertex lists of their polyhedra.
+ */
+class PolyhedronVertexRelation
+{
+private:
+  using Word = std::uint64_t;
+  static constexpr size_t WordBits = std::numeric_limits<Word>::digits;
+
+  size_t m_leftCount = 0;
+  size_t m_wordsPerRow = 0;
+  std::vector<Word> m_bits;
+
+public:
+  PolyhedronVertexRelation(const size_t leftCount, const size_t rightCount)
+    : m_leftCount{leftCount}
+    , m_wordsPerRow{(rightCount + WordBits - 1) / WordBits}
+    , m_bits(leftCount * m_wordsPerRow, Word(0))
+  {
+  }
+
+  bool contains(const size_t l, const size_t r) const
+  {
+    return (m_bits[l * m_wordsPerRow + r / WordBits] & bit(r)) != 0;
+  }
+
+  /**
+   * Inserts the pair (l, r) and returns whether it was not contained before.
+   */
+  bool insert(const size_t l, const size_t r)
+  {
+    auto& word = m_bits[l * m_wordsPerRow + r / WordBits];
+    const auto previous = word;
+    word |= bit(r);
+    return word != previous;
+  }
+
+  /**
+   * Inserts the pairs of the given relation, which must have the same dimensions.
+   */
+  void insert(const PolyhedronVertexRelation& other)
+  {
+    assert(m_bits.size() == other.m_bits.size());
+    for (size_t i = 0; i < m_bits.size(); ++i)
+    {
+      m_bits[i] |= other.m_bits[i];
+    }
+  }
+
+  /**
+   * Relates the left vertex l to every right vertex that is related to the left vertex
+   * from. Returns whether any pair was inserted.
+   */
+  bool insertRow(const size_t l, const size_t from)
+  {
+    auto changed = false;
+    for (size_t i = 0; i < m_wordsPerRow; ++i)
+    {
+      auto& word = m_bits[l * m_wordsPerRow + i];
+      const auto previous = word;
+      word |= m_bits[from * m_wordsPerRow + i];
+      changed = changed || word != previous;
+    }
+    return changed;
+  }
+
+  /**
+   * Relates the right vertex r to every left vertex that is related to the right vertex
+   * from. Returns whether any pair was inserted.
+   */
+  bool insertColumn(const size_t r, const size_t from)
+  {
+    auto changed = false;
+    for (size_t l = 0; l < m_leftCount; ++l)
+    {
+      if (contains(l, from))
+      {
+        changed = insert(l, r) || changed;
+      }
+    }
+    return changed;
+  }
+
+  bool hasRight(const size_t l) const
+  {
+    const auto first = m_bits.begin() + std::ptrdiff_t(l * m_wordsPerRow);
+    return std::any_of(
+      first, first + std::ptrdiff_t(m_wordsPerRow), [](const auto w) { return w != 0; });
+  }
+
+  bool hasLeft(const size_t r) const
+  {
+    for (size_t l = 0; l < m_leftCount; ++l)
+    {
+      if (contains(l, r))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Returns a row mask with the bits of the given right vertices set.
+   */
+  std::vector<Word> rightMask(const std::vector<size_t>& rightVertices) const
+  {
+    auto result = std::vector<Word>(m_wordsPerRow, Word(0));
+    for (const auto r : rightVertices)
+    {
+      result[r / WordBits] |= bit(r);
+    }
+    return result;
+  }
+
+  /**
+   * Returns the number of right vertices in the given mask that are related to the left
+   * vertex l.
+   */
+  size_t countRight(const size_t l, const std::vector<Word>& mask) const
+  {
+    auto result = size_t(0);
+    for (size_t i = 0; i < m_wordsPerRow; ++i)
+    {
+      result += size_t(std::popcount(m_bits[l * m_wordsPerRow + i] & mask[i]));
+    }
+    return result;
+  }
+
+private:
+  static Word bit(const size_t r) { return Word(1) << (r % WordBits); }
+};
+
+/**
+ * Maps the vertices of a polyhedron to their indices in its vertex list and back using
+ * sorted arrays.
+ */
+template <typename P>
+class PolyhedronVertexIndex
+{
+private:
+  using V = vm::vec<typename P::FloatType, 3u>;
+  using Vertex = typename P::Vertex;
+
+  std::vector<Vertex*> m_vertices;
+  std::vector<std::pair<const Vertex*, size_t>> m_indicesByVertex;
+  std::vector<std::pair<V, size_t>> m_indicesByPosition;
+
+public:
+  explicit PolyhedronVertexIndex(const P& polyhedron)
+  {
+    const auto vertexCount = polyhedron.vertexCount();
+    m_vertices.reserve(vertexCount);
+    m_indicesByVertex.reserve(vertexCount);
+    m_indicesByPosition.reserve(vertexCount);
+
+    auto* firstVertex = polyhedron.vertices().front();
+    auto* currentVertex = firstVertex;
+    do
+    {
+      const auto index = m_vertices.size();
+      m_vertices.push_back(currentVertex);
+      m_indicesByVertex.emplace_back(currentVertex, index);
+      m_indicesByPosition.emplace_back(currentVertex->position(), index);
+      currentVertex = currentVertex->next();
+    } while (currentVertex != firstVertex);
+
+    std::ranges::sort(m_indicesByVertex);
+    std::ranges::sort(m_indicesByPosition);
+  }
+
+  size_t size() const { return m_vertices.size(); }
+
+  Vertex* vertex(const size_t index) const { return m_vertices[index]; }
+
+  size_t index(const Vertex* vertex) const
+  {
+    const auto it = std::ranges::lower_bound(
+      m_indicesByVertex, vertex, std::less<>{}, [](const auto& p) { return p.first; });
+    assert(it != m_indicesByVertex.end() && it->first == vertex);
+    return it->second;
+  }
+
+  /**
+   * Returns the index of the first vertex in the vertex list with exactly the given
+   * position, if any.
+   */
+  std::optional<size_t> index(const V& position) const
+  {
+    const auto it = std::ranges::lower_bound(
+      m_indicesByPosition, position, std::less<>{}, [](const auto& p) {
+        return p.first;
+      });
+    if (it != m_indicesByPosition.end() && it->first == position)
+    {
+      return it->second;
+    }
+    return std::nullopt;
+  }
+
+  /**
+   * Returns the indices of the origins of the given face's boundary.
+   */
+  template <typename Face>
+  std::vector<size_t> faceVertices(const Face* face) const
+  {
+    auto result = std::vector<size_t>{};
+    result.reserve(face->vertexCount());
+    for (const auto* halfEdge : face->boundary())
+    {
+      result.push_back(index(halfEdge->origin()));
+    }
+    return result;
+  }
+};
+
+} // namespace detail
+
 /**
  * This template is used to match the faces of two polyhedra. The two polyhedra are
  * expected to have the majority of their vertices in common as a result of a vertex move
@@ -67,23 +293,31 @@ class PolyhedronMatcher
 private:
   using V = vm::vec<typename P::FloatType, 3u>;
   using Vertex = typename P::Vertex;
-  using VertexList = typename P::VertexList;
-  using VertexSet = std::set<Vertex*>;
   using HalfEdge = typename P::HalfEdge;
   using Face = typename P::Face;
-  using VMap = std::map<V, V>;
+  using VertexIndex = detail::PolyhedronVertexIndex<P>;
+  using VertexRelation = detail::PolyhedronVertexRelation;
 
-  using VertexRelation = kdl::binary_relation<Vertex*, Vertex*>;
+public:
+  /**
+   * Pairs of corresponding vertex positions of the left and the right polyhedron.
+   */
+  using VertexMapping = std::vector<std::pair<V, V>>;
 
+private:
   const P& m_left;
   const P& m_right;
+  const VertexIndex m_leftVertices;
+  const VertexIndex m_rightVertices;
   const VertexRelation m_vertexRelation;
 
 public:
   PolyhedronMatcher(const P& left, const P& right)
     : m_left{left}
     , m_right{right}
-    , m_vertexRelation{buildVertexRelation(m_left, m_right)}
+    , m_leftVertices{m_left}
+    , m_rightVertices{m_right}
+    , m_vertexRelation{buildVertexRelation()}
   {
   }
 
@@ -91,14 +325,18 @@ public:
     const P& left, const P& right, const std::vector<V>& vertices, const V& delta)
     : m_left{left}
     , m_right{right}
-    , m_vertexRelation{buildVertexRelation(m_left, m_right, vertices, delta)}
+    , m_leftVertices{m_left}
+    , m_rightVertices{m_right}
+    , m_vertexRelation{buildVertexRelation(vertices, delta)}
   {
   }
 
-  PolyhedronMatcher(const P& left, const P& right, const VMap& vertexMap)
+  PolyhedronMatcher(const P& left, const P& right, const VertexMapping& vertexMapping)
     : m_left{left}
     , m_right{right}
-    , m_vertexRelation{buildVertexRelation(m_left, m_right, vertexMap)}
+    , m_leftVertices{m_left}
+    , m_rightVertices{m_right}
+    , m_vertexRelation{buildVertexRelation(vertexMapping)}
   {
   }
 
@@ -114,11 +352,22 @@ public:
   template <typename Callback>
   void processRightFaces(const Callback& callback) const
   {
+    // the vertex indices of every left face, in the order of the face list
+    auto leftFaceVertices = std::vector<std::vector<size_t>>{};
+    leftFaceVertices.reserve(m_left.faceCount());
+    for (const auto* leftFace : m_left.faces())
+    {
+      leftFaceVertices.push_back(m_leftVertices.faceVertices(leftFace));
+    }
+
+    auto matchingFaces = MatchingFaces{};
+
     auto* firstRightFace = m_right.faces().front();
     auto* currentRightFace = firstRightFace;
     do
     {
-      auto* matchingLeftFace = findBestMatchingLeftFace(currentRightFace);
+      findMatchingLeftFaces(currentRightFace, leftFaceVertices, matchingFaces);
+      auto* matchingLeftFace = findBestMatchingLeftFace(currentRightFace, matchingFaces);
       callback(matchingLeftFace, currentRightFace);
       currentRightFace = currentRightFace->next();
     } while (currentRightFace != firstRightFace);
@@ -128,18 +377,18 @@ public:
 
 private:
   /**
-   * Find the best matching face from the left polyhedron for the given face of the right
-   * polyhedron. The best match is determined using the matching score (see function
-   * findMatchingLeftFaces). If multiple faces of the left polyhedron have a maximal
-   * matching score with the given face of the right polyhedron, this function selects a
-   * face based upon the dot products of the face normals.
+   * Find the best matching face from the given matching faces of the left polyhedron for
+   * the given face of the right polyhedron. If multiple faces of the left polyhedron have
+   * a maximal matching score with the given face of the right polyhedron, this function
+   * selects a face based upon the dot products of the face normals.
    *
    * @param rightFace the face of the right polyhedron to find a match for
+   * @param matchingFaces the faces of the left polyhedron with a maximal matching score
    * @return a best matching face of the left polyhedron
    */
-  Face* findBestMatchingLeftFace(Face* rightFace) const
+  static Face* findBestMatchingLeftFace(
+    const Face* rightFace, const MatchingFaces& matchingFaces)
   {
-    const auto matchingFaces = findMatchingLeftFaces(rightFace);
     ensure(!matchingFaces.empty(), "No matching face found");
 
     // Among all matching faces, select one such its normal is the most similar to the
@@ -169,19 +418,34 @@ private:
    * Find all faces of the left polyhedron that have a maximal matching score with the
    * given face of the right polyhedron.
    *
+   * The matching score between a left and a right face is the number of all pairs of a
+   * vertex of the left face and a vertex of the right face which are also in the vertex
+   * relation, unless the faces are identical. In that case, the score is perfect.
+   *
    * @param rightFace the face of the right polyhedron
-   * @return the matching faces of the left polyhedron
+   * @param leftFaceVertices the vertex indices of the faces of the left polyhedron
+   * @param result the matching faces of the left polyhedron
    */
-  MatchingFaces findMatchingLeftFaces(Face* rightFace) const
+  void findMatchingLeftFaces(
+    const Face* rightFace,
+    const std::vector<std::vector<size_t>>& leftFaceVertices,
+    MatchingFaces& result) const
   {
-    auto result = MatchingFaces{};
-    std::size_t bestMatchScore = 0;
+    result.clear();
+
+    const auto rightPositions = rightFace->vertexPositions();
+    const auto rightMask =
+      m_vertexRelation.rightMask(m_rightVertices.faceVertices(rightFace));
+
+    auto bestMatchScore = size_t(0);
+    auto leftFaceIndex = size_t(0);
 
     auto* firstLeftFace = m_left.faces().front();
     auto* currentLeftFace = firstLeftFace;
     do
     {
-      const auto matchScore = computeMatchScore(currentLeftFace, rightFace);
+      const auto matchScore = computeMatchScore(
+        currentLeftFace, leftFaceVertices[leftFaceIndex++], rightPositions, rightMask);
       if (matchScore > bestMatchScore)
       {
         result.clear();
@@ -194,8 +458,6 @@ private:
       }
       currentLeftFace = currentLeftFace->next();
     } while (currentLeftFace != firstLeftFace);
-
-    return result;
   }
 
 public:
@@ -211,94 +473,77 @@ public:
   template <typename L>
   void visitMatchingVertexPairs(Face* leftFace, Face* rightFace, L&& lambda) const
   {
-    auto* firstLeftEdge = leftFace->boundary().front();
-    auto* firstRightEdge = rightFace->boundary().front();
+    const auto leftFaceVertices = m_leftVertices.faceVertices(leftFace);
+    const auto rightFaceVertices = m_rightVertices.faceVertices(rightFace);
 
-    auto* currentLeftEdge = firstLeftEdge;
-    do
+    for (const auto l : leftFaceVertices)
     {
-      auto* leftVertex = currentLeftEdge->origin();
-
-      auto* currentRightEdge = firstRightEdge;
-      do
+      for (const auto r : rightFaceVertices)
       {
-        auto* rightVertex = currentRightEdge->origin();
-
-        if (m_vertexRelation.contains(leftVertex, rightVertex))
+        if (m_vertexRelation.contains(l, r))
         {
-          lambda(leftVertex, rightVertex);
+          lambda(m_leftVertices.vertex(l), m_rightVertices.vertex(r));
         }
-
-        currentRightEdge = currentRightEdge->next();
-      } while (currentRightEdge != firstRightEdge);
-
-      currentLeftEdge = currentLeftEdge->next();
-    } while (currentLeftEdge != firstLeftEdge);
+      }
+    }
   }
 
 private:
   /**
-   * Computes the matching score between the given left and right faces the data stored in
-   * the vertex relation.
-   *
-   * The matching score between the given faces is the number of all pairs of a vertex of
-   * the given left face and a vertex of the given right face which are also in the vertex
-   * relation, unless the faces are identical. In that case, this function returns a
-   * perfect match score.
+   * Computes the matching score between the given left and right faces.
    *
    * @param leftFace a face of the left polyhedron
-   * @param rightFace a face of the right polyhedron
+   * @param leftFaceVertices the vertex indices of the left face
+   * @param rightPositions the vertex positions of the right face
+   * @param rightMask the vertex relation mask of the vertices of the right face
    * @return the matching score
    */
-  std::size_t computeMatchScore(Face* leftFace, Face* rightFace) const
+  std::size_t computeMatchScore(
+    const Face* leftFace,
+    const std::vector<size_t>& leftFaceVertices,
+    const std::vector<V>& rightPositions,
+    const std::vector<std::uint64_t>& rightMask) const
   {
     if (
-      leftFace->vertexCount() == rightFace->vertexCount()
-      && leftFace->hasVertexPositions(rightFace->vertexPositions()))
+      leftFace->vertexCount() == rightPositions.size()
+      && leftFace->hasVertexPositions(rightPositions))
     {
       return std::numeric_limits<std::size_t>::max();
     }
 
-    std::size_t result = 0;
-    visitMatchingVertexPairs(
-      leftFace, rightFace, [&result](auto* /* leftVertex */, auto* /* rightVertex */) {
-        ++result;
-      });
+    auto result = size_t(0);
+    for (const auto l : leftFaceVertices)
+    {
+      result += m_vertexRelation.countRight(l, rightMask);
+    }
     return result;
   }
 
 private:
   /**
-   * Build the vertex relation for the given left and right polyhedra.
+   * Build the vertex relation for the left and right polyhedra.
    *
    * The relation is built by inserting every pair of vertices (l,r) such that l is a
    * vertex of the left polyhedron and r is a vertex of the given right polyhedron and
    * (l,r) have identical positions. Then, the relation is expanded by calling the
    * expandVertexRelation function.
    *
-   * @param left the left polyhedron
-   * @param right the right polyhedron
    * @return the vertex relation
    */
-  static VertexRelation buildVertexRelation(const P& left, const P& right)
+  VertexRelation buildVertexRelation() const
   {
-    auto result = VertexRelation{};
+    auto result = VertexRelation{m_leftVertices.size(), m_rightVertices.size()};
 
-    auto* firstLeftVertex = left.vertices().front();
-    auto* currentLeftVertex = firstLeftVertex;
-    do
+    for (size_t l = 0; l < m_leftVertices.size(); ++l)
     {
-      const auto& position = currentLeftVertex->position();
-      auto* currentRightVertex = right.findVertexByPosition(position);
-      if (currentRightVertex)
+      const auto& position = m_leftVertices.vertex(l)->position();
+      if (const auto r = m_rightVertices.index(position))
       {
-        result.insert(currentLeftVertex, currentRightVertex);
+        result.insert(l, *r);
       }
+    }
 
-      currentLeftVertex = currentLeftVertex->next();
-    } while (currentLeftVertex != firstLeftVertex);
-
-    return expandVertexRelation(left, right, result);
+    return expandVertexRelation(std::move(result));
   }
 
   /**
@@ -310,230 +555,172 @@ private:
    * vertices, then the algorithm attempts to find it at its new position in the right
    * polyhedron.
    *
-   * @param left the left polyhedron
-   * @param right the right polyhedron
    * @param vertices the vertices that have been moved
    * @param delta the move delta
    * @return the vertex relation
    */
-  static VertexRelation buildVertexRelation(
-    const P& left, const P& right, const std::vector<V>& vertices, const V& delta)
+  VertexRelation buildVertexRelation(
+    const std::vector<V>& vertices, const V& delta) const
   {
-    auto vertexMap = VMap{};
-    const auto vertexSet = kdl::vector_set<V>::create(vertices);
+    auto sortedVertices = vertices;
+    std::ranges::sort(sortedVertices);
 
-    auto* firstVertex = left.vertices().front();
-    auto* currentVertex = firstVertex;
-    do
+    auto vertexMapping = VertexMapping{};
+    vertexMapping.reserve(m_leftVertices.size());
+
+    for (const auto* vertex : m_left.vertices())
     {
-      const auto& position = currentVertex->position();
+      const auto& position = vertex->position();
       // vertices are expected to be exact positions of vertices in left, whereas the
       // vertex positions searched for in right allow an epsilon of
       // vm::Constants<T>::almost_zero()
-      if (vertexSet.count(position) > 0u)
+      if (std::ranges::binary_search(sortedVertices, position))
       {
-        if (right.hasVertex(position))
+        if (m_right.hasVertex(position))
         {
-          vertexMap.emplace(position, position);
+          vertexMapping.emplace_back(position, position);
         }
       }
       else
       {
-        assert(right.hasVertex(position + delta));
-        vertexMap.emplace(position, position + delta);
+        assert(m_right.hasVertex(position + delta));
+        vertexMapping.emplace_back(position, position + delta);
       }
-      currentVertex = currentVertex->next();
-    } while (currentVertex != firstVertex);
+    }
 
-    return buildVertexRelation(left, right, vertexMap);
+    return buildVertexRelation(vertexMapping);
   }
 
   /**
-   * Helper function to build a vertex relation using the given set of corresponding
-   * vertices.
+   * Helper function to build a vertex relation using the given corresponding vertices.
    *
-   * @param left the left polyhedron
-   * @param right the right polyhedron
-   * @param vertexMap a set of corresponding vertices for which to build the relation
+   * @param vertexMapping pairs of corresponding vertices for which to build the relation
    * @return the vertex relation
    */
-  static VertexRelation buildVertexRelation(
-    const P& left, const P& right, const VMap& vertexMap)
+  VertexRelation buildVertexRelation(const VertexMapping& vertexMapping) const
   {
-    auto result = VertexRelation{};
+    auto result = VertexRelation{m_leftVertices.size(), m_rightVertices.size()};
 
-    for (const auto& [leftPosition, rightPosition] : vertexMap)
+    for (const auto& [leftPosition, rightPosition] : vertexMapping)
     {
-      auto* leftVertex = left.findVertexByPosition(leftPosition);
-      auto* rightVertex = right.findVertexByPosition(rightPosition);
+      const auto l = m_leftVertices.index(leftPosition);
+      const auto r = m_rightVertices.index(rightPosition);
 
-      assert(leftVertex != nullptr);
-      assert(rightVertex != nullptr);
-      result.insert(leftVertex, rightVertex);
+      assert(l != std::nullopt);
+      assert(r != std::nullopt);
+      result.insert(*l, *r);
     }
 
-    return expandVertexRelation(left, right, result);
+    return expandVertexRelation(std::move(result));
   }
 
   /**
-   * Expand the given vertex relation of vertices of the given left and right polyhedra.
+   * Expand the given vertex relation of vertices of the left and right polyhedra.
    * Expanding a vertex relation is based on the given initial relation, and expands the
    * relation by those vertices present only in the right polyhedron and by those vertices
    * present only in the left polyhedron.
    *
-   * @param left the left polyhedron
-   * @param right the right polyhedron
+   * Let r be a vertex of the right polyhedron that has no related vertices in the initial
+   * relation, i.e., an added vertex. Let r' be adjacent to r in the right polyhedron and
+   * let r' be related to l. Then the pair (l,r) is added to the relation. This is
+   * repeated until no more pairs are added.
+   *
+   * Likewise, let l be a vertex of the left polyhedron that has no related vertices in
+   * the initial relation, i.e., a removed vertex. Let l' be adjacent to l in the left
+   * polyhedron and let l' be related to r. Then the pair (l,r) is added to the relation.
+   *
+   * Both expansions start from the initial relation and are combined afterwards.
+   *
    * @param initialRelation the initial vertex relation
    * @return the expanded vertex relation
    */
-  static VertexRelation expandVertexRelation(
-    const P& left, const P& right, const VertexRelation& initialRelation)
+  VertexRelation expandVertexRelation(VertexRelation initialRelation) const
   {
-    auto result = initialRelation;
-    result.insert(addedVertexRelation(right, initialRelation));
-    result.insert(removedVertexRelation(left, initialRelation));
+    auto added = initialRelation;
+    expandAddedVertices(added, initialRelation);
+
+    auto result = std::move(initialRelation);
+    expandRemovedVertices(result);
+    result.insert(added);
     return result;
   }
 
-  /**
-   * Returns a vertex relation that includes only vertices present in the given right
-   * polyhedron, but not in the given vertex relation. Such a vertex is related to the
-   * vertices which are related to its neighbours as follows.
-   *
-   * Let r be a vertex present in the given polyhedron that has no related vertices in the
-   * given relation. Let r' be adjacent to r in the given polyhedron and let r' be related
-   * to l in the given relation. l is a vertex of the left polyhedron under treatment.
-   * Then the pair (l,r) is added to the resulting relation.
-   *
-   * Note that the resulting relation does not include the given initial relation.
-   *
-   * @param right the polyhedron with additional vertices
-   * @param initialRelation the initial vertex relation
-   * @return a vertex relation containing only the newly discovered related vertices
-   */
-  static VertexRelation addedVertexRelation(
-    const P& right, const VertexRelation& initialRelation)
+  void expandAddedVertices(
+    VertexRelation& relation, const VertexRelation& initialRelation) const
   {
-    const auto addedVertices = findAddedVertices(right, initialRelation);
-
-    auto result = initialRelation;
-    std::size_t previousSize;
-    do
+    auto addedVertices = std::vector<size_t>{};
+    for (size_t r = 0; r < m_rightVertices.size(); ++r)
     {
-      previousSize = result.size();
-      for (auto* addedVertex : addedVertices)
+      if (!initialRelation.hasLeft(r))
       {
-        // consider all adjacent vertices
-        auto* firstEdge = addedVertex->leaving();
-        auto* currentEdge = firstEdge;
-        do
-        {
-          auto* neighbour = currentEdge->destination();
-          result.insert(result.left_range(neighbour), addedVertex);
-          currentEdge = currentEdge->nextIncident();
-        } while (currentEdge != firstEdge);
+        addedVertices.push_back(r);
       }
-    } while (result.size() > previousSize);
-
-    return result;
-  }
+    }
 
-  /**
-   * Returns a vertex relation that includes only vertices present in the given left
-   * polyhedron, but not in the given vertex relation. Such a vertex is related to the
-   * vertices which are related to its neighbours as follows.
-   *
-   * Let l be a vertex present in the given polyhedron that has no related vertices in the
-   * given relation. Let l' be adjacent to l in the given polyhedron and let l' be related
-   * to r in the given relation. r is a vertex of the left polyhedron under treatment.
-   * Then the pair (l,r) is added to the resulting relation.
-   *
-   * Note that the resulting relation does not include the given initial relation.
-   *
-   * @param left the polyhedron with removed vertices
-   * @param initialRelation the initial vertex relation
-   * @return a vertex relation containing only the newly discovered related vertices
-   */
-  static VertexRelation removedVertexRelation(
-    const P& left, const VertexRelation& initialRelation)
-  {
-    const auto removedVertices = findRemovedVertices(left, initialRelation);
+    const auto neighbours = findNeighbours(m_rightVertices, addedVertices);
 
-    auto result = initialRelation;
-    std::size_t previousSize;
-    do
+    auto changed = true;
+    while (changed)
     {
-      previousSize = result.size();
-      for (auto* removedVertex : removedVertices)
+      changed = false;
+      for (size_t i = 0; i < addedVertices.size(); ++i)
       {
-        // consider all adjacent vertices
-        auto* firstEdge = removedVertex->leaving();
-        auto* currentEdge = firstEdge;
-        do
+        for (const auto neighbour : neighbours[i])
         {
-          auto* neighbour = currentEdge->destination();
-          result.insert(removedVertex, result.right_range(neighbour));
-          currentEdge = currentEdge->nextIncident();
-        } while (currentEdge != firstEdge);
+          changed = relation.insertColumn(addedVertices[i], neighbour) || changed;
+        }
       }
-    } while (result.size() > previousSize);
-
-    return result;
+    }
   }
 
-  /**
-   * Returns a set containing only those vertices of the given polyhedron for which there
-   * is no entry in the given vertex relation. These are vertices which have been added to
-   * the given polyhedron.
-   *
-   * @param right the polyhedron
-   * @param vertexRelation the vertex relation
-   * @return the added vertices
-   */
-  static VertexSet findAddedVertices(const P& right, const VertexRelation& vertexRelation)
+  void expandRemovedVertices(VertexRelation& relation) const
   {
-    auto result = VertexSet{};
-
-    const auto& rightVertices = right.vertices();
-    auto* firstVertex = rightVertices.front();
-    auto* currentVertex = firstVertex;
-    do
+    auto removedVertices = std::vector<size_t>{};
+    for (size_t l = 0; l < m_leftVertices.size(); ++l)
     {
-      if (vertexRelation.count_left(currentVertex) == 0)
+      if (!relation.hasRight(l))
       {
-        result.insert(currentVertex);
+        removedVertices.push_back(l);
       }
-      currentVertex = currentVertex->next();
-    } while (currentVertex != firstVertex);
+    }
 
-    return result;
+    const auto neighbours = findNeighbours(m_leftVertices, removedVertices);
+
+    auto changed = true;
+    while (changed)
+    {
+      changed = false;
+      for (size_t i = 0; i < removedVertices.size(); ++i)
+      {
+        for (const auto neighbour : neighbours[i])
+        {
+          changed = relation.insertRow(removedVertices[i], neighbour) || changed;
+        }
+      }
+    }
   }
 
   /**
-   * Returns a set containing only those vertices of the given polyhedron for there is no
-   * entry in the given vertex relation. These are vertices which have been removed from
-   * the given polyhedron.
-   *
-   * @param left the polyhedron
-   * @param vertexRelation the vertex relation
-   * @return the removed vertices
+   * Returns the indices of the vertices adjacent to each of the given vertices.
    */
-  static VertexSet findRemovedVertices(
-    const P& left, const VertexRelation& vertexRelation)
+  static std::vector<std::vector<size_t>> findNeighbours(
+    const VertexIndex& vertexIndex, const std::vector<size_t>& vertices)
   {
-    auto result = VertexSet{};
+    auto result = std::vector<std::vector<size_t>>{};
+    result.reserve(vertices.size());
 
-    const auto& leftVertices = left.vertices();
-    auto* firstVertex = leftVertices.front();
-    auto* currentVertex = firstVertex;
-    do
+    for (const auto index : vertices)
     {
-      if (vertexRelation.count_right(currentVertex) == 0)
+      auto& neighbours = result.emplace_back();
+
+      auto* firstEdge = vertexIndex.vertex(index)->leaving();
+      auto* currentEdge = firstEdge;
+      do
       {
-        result.insert(currentVertex);
-      }
-      currentVertex = currentVertex->next();
-    } while (currentVertex != firstVertex);
+        neighbours.push_back(vertexIndex.index(currentEdge->destination()));
+        currentEdge = currentEdge->nextIncident();
+      } while (currentEdge != firstEdge);
+    }
 
     return result;
   }
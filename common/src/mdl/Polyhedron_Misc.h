@@ -174,6 +174,21 @@ Polyhedron<T, FP, VP>::Polyhedron(std::vector<vm::vec<T, 3>> positions)
   addPoints(std::move(positions));
 }
 
+template <typename T, typename FP, typename VP>
+Polyhedron<T, FP, VP>::Polyhedron(
+  std::vector<vm::vec<T, 3>> positions, const ConvexHullAlgorithm algorithm)
+{
+  switch (algorithm)
+  {
+  case ConvexHullAlgorithm::Incremental:
+    addPoints(std::move(positions));
+    break;
+  case ConvexHullAlgorithm::QuickHull:
+    addPointsQuickHull(std::move(positions));
+    break;
+  }
+}
+
 template <typename T, typename FP, typename VP>
 Polyhedron<T, FP, VP>::Polyhedron(const Polyhedron<T, FP, VP>& other)
 {
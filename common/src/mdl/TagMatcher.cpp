@@ -158,6 +158,8 @@ void MaterialTagMatcher::appendToStream(std::ostream& str) const
 
 MaterialNameTagMatcher::MaterialNameTagMatcher(std::string pattern)
   : m_pattern{std::move(pattern)}
+  , m_matcher{kdl::ci::make_glob_matcher(m_pattern)}
+  , m_matchLastComponent{m_pattern.find('/') == std::string::npos}
 {
 }
 
@@ -191,7 +193,7 @@ bool MaterialNameTagMatcher::matchesMaterialName(std::string_view materialName)
 {
   // If the match pattern doesn't contain a slash, match against
   // only the last component of the material name.
-  if (m_pattern.find('/') == std::string::npos)
+  if (m_matchLastComponent)
   {
     const auto pos = materialName.find_last_of('/');
     if (pos != std::string::npos)
@@ -200,7 +202,7 @@ bool MaterialNameTagMatcher::matchesMaterialName(std::string_view materialName)
     }
   }
 
-  return kdl::ci::str_matches_glob(materialName, m_pattern);
+  return m_matcher.matches(materialName);
 }
 
 SurfaceParmTagMatcher::SurfaceParmTagMatcher(std::string parameter)
@@ -398,6 +400,7 @@ EntityClassNameTagMatcher::EntityClassNameTagMatcher(
   std::string pattern, std::string material)
   : m_pattern{std::move(pattern)}
   , m_material{std::move(material)}
+  , m_matcher{kdl::ci::make_glob_matcher(m_pattern)}
 {
 }
 
@@ -519,7 +522,7 @@ void EntityClassNameTagMatcher::appendToStream(std::ostream& str) const
 
 bool EntityClassNameTagMatcher::matchesClassname(const std::string& classname) const
 {
-  return kdl::ci::str_matches_glob(classname, m_pattern);
+  return m_matcher.matches(classname);
 }
 
 } // namespace tb::mdl
@@ -23,6 +23,7 @@
 #include "mdl/Tag.h"
 #include "mdl/TagVisitor.h"
 
+#include "kdl/glob_matcher.h"
 #include "kdl/vector_set.h"
 
 #include <functional>
@@ -55,6 +56,8 @@ class MaterialNameTagMatcher : public MaterialTagMatcher
 {
 private:
   std::string m_pattern;
+  kdl::glob_matcher m_matcher;
+  bool m_matchLastComponent;
 
 public:
   explicit MaterialNameTagMatcher(std::string pattern);
@@ -136,6 +139,7 @@ private:
    * The material to set when this tag is enabled.
    */
   std::string m_material;
+  kdl::glob_matcher m_matcher;
 
 public:
   EntityClassNameTagMatcher(std::string pattern, std::string material);
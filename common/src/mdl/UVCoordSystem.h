@@ -27,7 +27,6 @@
 #include "vm/vec.h"
 
 #include <memory>
-#include <tuple>
 
 namespace tb::mdl
 {
@@ -65,7 +64,6 @@ public:
   friend bool operator==(const UVCoordSystem& lhs, const UVCoordSystem& rhs);
   friend bool operator!=(const UVCoordSystem& lhs, const UVCoordSystem& rhs);
 
-  virtual std::unique_ptr<UVCoordSystem> clone() const = 0;
   virtual std::unique_ptr<UVCoordSystemSnapshot> takeSnapshot() const = 0;
   virtual void restoreSnapshot(const UVCoordSystemSnapshot& snapshot) = 0;
 
@@ -117,17 +115,6 @@ public:
   virtual float measureAngle(
     float currentAngle, const vm::vec2f& center, const vm::vec2f& point) const = 0;
 
-  virtual std::tuple<std::unique_ptr<UVCoordSystem>, BrushFaceAttributes> toParallel(
-    const vm::vec3d& point0,
-    const vm::vec3d& point1,
-    const vm::vec3d& point2,
-    const BrushFaceAttributes& attribs) const = 0;
-  virtual std::tuple<std::unique_ptr<UVCoordSystem>, BrushFaceAttributes> toParaxial(
-    const vm::vec3d& point0,
-    const vm::vec3d& point1,
-    const vm::vec3d& point2,
-    const BrushFaceAttributes& attribs) const = 0;
-
 private:
   friend class UVCoordSystemSnapshot;
 
@@ -157,7 +144,10 @@ protected:
     return axis / safeScale(T1(factor));
   }
 
-  deleteCopyAndMove(UVCoordSystem);
+  UVCoordSystem(const UVCoordSystem& other) = default;
+  UVCoordSystem(UVCoordSystem&& other) noexcept = default;
+  UVCoordSystem& operator=(const UVCoordSystem& other) = default;
+  UVCoordSystem& operator=(UVCoordSystem&& other) = default;
 };
 
 } // namespace tb::mdl
@@ -22,10 +22,13 @@
 #include "Ensure.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
+#include "mdl/EntityModelIndex.h"
 #include "mdl/EntityNode.h"
 #include "mdl/EntityNodeIndex.h"
+#include "mdl/FilePositionIndex.h"
 #include "mdl/GroupNode.h"
 #include "mdl/LayerNode.h"
+#include "mdl/MaterialIndex.h"
 #include "mdl/PatchNode.h"
 #include "mdl/TagVisitor.h"
 #include "mdl/Validator.h"
@@ -38,6 +41,7 @@
 
 #include "vm/bbox_io.h" // IWYU pragma: keep
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -51,6 +55,9 @@ WorldNode::WorldNode(
   , m_mapFormat{mapFormat}
   , m_defaultLayer{nullptr}
   , m_entityNodeIndex{std::make_unique<EntityNodeIndex>()}
+  , m_filePositionIndex{std::make_unique<FilePositionIndex>(*this)}
+  , m_materialIndex{std::make_unique<MaterialIndex>()}
+  , m_entityModelIndex{std::make_unique<EntityModelIndex>()}
   , m_validatorRegistry{std::make_unique<ValidatorRegistry>()}
   , m_nodeTree{std::make_unique<NodeTree>(256.0)}
   , m_updateNodeTree{true}
@@ -182,6 +189,35 @@ const EntityNodeIndex& WorldNode::entityNodeIndex() const
   return *m_entityNodeIndex;
 }
 
+const FilePositionIndex& WorldNode::filePositionIndex() const
+{
+  return *m_filePositionIndex;
+}
+
+void WorldNode::invalidateFilePositionIndex()
+{
+  m_filePositionIndex->invalidate();
+}
+
+const MaterialIndex& WorldNode::materialIndex() const
+{
+  return *m_materialIndex;
+}
+
+const EntityModelIndex& WorldNode::entityModelIndex() const
+{
+  return *m_entityModelIndex;
+}
+
+const std::vector<GroupNode*>& WorldNode::findGroupNodesWithLinkId(
+  const std::string& linkId) const
+{
+  static const auto noGroupNodes = std::vector<GroupNode*>{};
+
+  const auto it = m_groupNodesByLinkId.find(linkId);
+  return it != m_groupNodesByLinkId.end() ? it->second : noGroupNodes;
+}
+
 std::vector<const Validator*> WorldNode::registeredValidators() const
 {
   return m_validatorRegistry->registeredValidators();
@@ -383,6 +419,13 @@ void WorldNode::doDescendantWasAdded(Node* node, const size_t /* depth */)
       {
         updatePersistentId(layer);
       }
+      // the groups of deferred contents already have their IDs
+      if (const auto& deferredContents = layer->deferredContents();
+          deferredContents && deferredContents->maxPersistentId)
+      {
+        m_nextPersistentId =
+          std::max(m_nextPersistentId, *deferredContents->maxPersistentId + 1u);
+      }
     },
     [&](auto&& thisLambda, GroupNode* group) {
       group->visitChildren(thisLambda);
@@ -391,32 +434,55 @@ void WorldNode::doDescendantWasAdded(Node* node, const size_t /* depth */)
     [&](EntityNode*) {},
     [&](BrushNode*) {},
     [&](PatchNode*) {}));
+
+  m_filePositionIndex->addNode(node);
+  m_materialIndex->addNode(node);
+  m_entityModelIndex->addNode(node);
+}
+
+void WorldNode::doDescendantWillBeRemoved(Node* node, const size_t depth)
+{
+  doDescendantsWillBeRemoved({node}, depth);
 }
 
-void WorldNode::doDescendantWillBeRemoved(Node* node, const size_t /* depth */)
+void WorldNode::doDescendantsWillBeRemoved(
+  const std::vector<Node*>& nodes, const size_t /* depth */)
 {
+  for (auto* node : nodes)
+  {
+    m_filePositionIndex->removeNode(node);
+    m_materialIndex->removeNode(node);
+    m_entityModelIndex->removeNode(node);
+  }
+
   if (m_updateNodeTree)
   {
-    const auto doRemove = [&](auto* nodeToRemove) {
-      if (!m_nodeTree->remove(nodeToRemove))
-      {
-        auto str = std::stringstream();
-        str << "Node not found with bounds " << nodeToRemove->physicalBounds() << ": "
-            << nodeToRemove;
-        throw NodeTreeException{str.str()};
-      }
-    };
+    // remove all nodes at once so that every node of the tree is only visited once
+    auto nodesToRemove = std::vector<Node*>{};
+    Node::visitAll(
+      nodes,
+      kdl::overload(
+        [&](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
+        [&](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
+        [&](auto&& thisLambda, GroupNode* group) { group->visitChildren(thisLambda); },
+        [&](auto&& thisLambda, EntityNode* entity) {
+          nodesToRemove.push_back(entity);
+          entity->visitChildren(thisLambda);
+        },
+        [&](BrushNode* brush) { nodesToRemove.push_back(brush); },
+        [&](PatchNode* patch) { nodesToRemove.push_back(patch); }));
+
+    if (const auto iNotFound = std::ranges::find_if(
+          nodesToRemove, [&](auto* node) { return !m_nodeTree->contains(node); });
+        iNotFound != nodesToRemove.end())
+    {
+      auto str = std::stringstream();
+      str << "Node not found with bounds " << (*iNotFound)->physicalBounds() << ": "
+          << *iNotFound;
+      throw NodeTreeException{str.str()};
+    }
 
-    node->accept(kdl::overload(
-      [&](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
-      [&](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
-      [&](auto&& thisLambda, GroupNode* group) { group->visitChildren(thisLambda); },
-      [&](auto&& thisLambda, EntityNode* entity) {
-        doRemove(entity);
-        entity->visitChildren(thisLambda);
-      },
-      [&](BrushNode* brush) { doRemove(brush); },
-      [&](PatchNode* patch) { doRemove(patch); }));
+    m_nodeTree->remove(nodesToRemove);
   }
 }
 
@@ -434,6 +500,11 @@ void WorldNode::doDescendantPhysicalBoundsDidChange(Node* node)
   }
 }
 
+void WorldNode::doIssuesWillBeInvalidated(Node* node)
+{
+  issuesWillBeInvalidatedNotifier(node);
+}
+
 bool WorldNode::doSelectable() const
 {
   return false;
@@ -503,6 +574,43 @@ void WorldNode::doRemoveFromIndex(
   m_entityNodeIndex->removeProperty(node, key, value);
 }
 
+void WorldNode::doAddToIndex(Node* node, const Material* material)
+{
+  m_materialIndex->addMaterial(node, material);
+}
+
+void WorldNode::doRemoveFromIndex(Node* node, const Material* material)
+{
+  m_materialIndex->removeMaterial(node, material);
+}
+
+void WorldNode::doAddToIndex(EntityNodeBase* node, const EntityModel* model)
+{
+  m_entityModelIndex->addEntityNode(node, model);
+}
+
+void WorldNode::doRemoveFromIndex(EntityNodeBase* node, const EntityModel* model)
+{
+  m_entityModelIndex->removeEntityNode(node, model);
+}
+
+void WorldNode::doAddToIndex(GroupNode* groupNode, const std::string& linkId)
+{
+  m_groupNodesByLinkId[linkId].push_back(groupNode);
+}
+
+void WorldNode::doRemoveFromIndex(GroupNode* groupNode, const std::string& linkId)
+{
+  if (const auto it = m_groupNodesByLinkId.find(linkId); it != m_groupNodesByLinkId.end())
+  {
+    std::erase(it->second, groupNode);
+    if (it->second.empty())
+    {
+      m_groupNodesByLinkId.erase(it);
+    }
+  }
+}
+
 void WorldNode::doPropertiesDidChange(const vm::bbox3d& /* oldBounds */) {}
 
 vm::vec3d WorldNode::doGetLinkSourceAnchor() const
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Macros.h"
+#include "Notifier.h"
 #include "mdl/EntityNodeBase.h"
 #include "mdl/EntityProperties.h"
 #include "mdl/IdType.h"
@@ -29,12 +30,16 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace tb::mdl
 {
+class EntityModelIndex;
 class EntityNodeIndex;
+class FilePositionIndex;
 class IssueQuickFix;
+class MaterialIndex;
 enum class MapFormat;
 class PickResult;
 class Validator;
@@ -47,6 +52,10 @@ private:
   MapFormat m_mapFormat;
   LayerNode* m_defaultLayer;
   std::unique_ptr<EntityNodeIndex> m_entityNodeIndex;
+  std::unique_ptr<FilePositionIndex> m_filePositionIndex;
+  std::unique_ptr<MaterialIndex> m_materialIndex;
+  std::unique_ptr<EntityModelIndex> m_entityModelIndex;
+  std::unordered_map<std::string, std::vector<GroupNode*>> m_groupNodesByLinkId;
   std::unique_ptr<ValidatorRegistry> m_validatorRegistry;
 
   using NodeTree = octree<double, Node*>;
@@ -56,6 +65,12 @@ private:
   IdType m_nextPersistentId = 1;
 
 public:
+  /**
+   * Called before the issues of this node or of one of its descendants are destroyed.
+   * Observers that keep pointers to the issues must forget them.
+   */
+  Notifier<Node*> issuesWillBeInvalidatedNotifier;
+
   WorldNode(
     EntityPropertyConfig entityPropertyConfig, Entity entity, MapFormat mapFormat);
   WorldNode(
@@ -123,6 +138,22 @@ private:
 
 public: // index
   const EntityNodeIndex& entityNodeIndex() const;
+  const FilePositionIndex& filePositionIndex() const;
+
+  /**
+   * Must be called when the file positions of the nodes have changed, e.g. after the map
+   * was saved.
+   */
+  void invalidateFilePositionIndex();
+
+  const MaterialIndex& materialIndex() const;
+  const EntityModelIndex& entityModelIndex() const;
+
+  /**
+   * Returns the group nodes in this world that have the given link ID.
+   */
+  const std::vector<GroupNode*>& findGroupNodesWithLinkId(
+    const std::string& linkId) const;
 
 public: // validator registration
   std::vector<const Validator*> registeredValidators() const;
@@ -151,7 +182,9 @@ private: // implement Node interface
 
   void doDescendantWasAdded(Node* node, size_t depth) override;
   void doDescendantWillBeRemoved(Node* node, size_t depth) override;
+  void doDescendantsWillBeRemoved(const std::vector<Node*>& nodes, size_t depth) override;
   void doDescendantPhysicalBoundsDidChange(Node* node) override;
+  void doIssuesWillBeInvalidated(Node* node) override;
 
   bool doSelectable() const override;
   void doPick(
@@ -174,6 +207,12 @@ private: // implement Node interface
     EntityNodeBase* node, const std::string& key, const std::string& value) override;
   void doRemoveFromIndex(
     EntityNodeBase* node, const std::string& key, const std::string& value) override;
+  void doAddToIndex(Node* node, const Material* material) override;
+  void doRemoveFromIndex(Node* node, const Material* material) override;
+  void doAddToIndex(EntityNodeBase* node, const EntityModel* model) override;
+  void doRemoveFromIndex(EntityNodeBase* node, const EntityModel* model) override;
+  void doAddToIndex(GroupNode* groupNode, const std::string& linkId) override;
+  void doRemoveFromIndex(GroupNode* groupNode, const std::string& linkId) override;
 
 private: // implement EntityNodeBase interface
   void doPropertiesDidChange(const vm::bbox3d& oldBounds) override;
@@ -37,6 +37,7 @@
 #include <cstdint>
 #include <optional>
 #include <unordered_map>
+#include <unordered_set>
 #include <variant>
 #include <vector>
 
@@ -333,36 +334,94 @@ private:
             i.data.erase(i_data);
           }
 
-          if (!is_root(i.address))
+          simplify_inner_node(node, i);
+        },
+        [&](leaf_node& l) {
+          const auto i_data = std::find(l.data.begin(), l.data.end(), data);
+          assert(i_data != l.data.end());
+          l.data.erase(i_data);
+        }),
+      node);
+  }
+
+  /**
+   * Removes the given data from the given node and its descendants. The given addresses
+   * are the addresses of the nodes containing the data, and each node is visited only
+   * once, no matter how much data is removed from it.
+   */
+  static void remove_from_node(
+    node& node,
+    const std::vector<detail::node_address>& addresses,
+    const std::unordered_set<U>& data)
+  {
+    const auto is_removed = [&](const auto& d) { return data.count(d) > 0; };
+
+    std::visit(
+      kdl::overload(
+        [&](inner_node& i) {
+          auto child_addresses = std::vector<std::vector<detail::node_address>>(8);
+          auto remove_from_inner_node = false;
+          for (const auto& address : addresses)
           {
-            const auto is_non_empty_child = [](const auto& c) {
-              return is_inner_node(c) || !get_data(c).empty();
-            };
-            const auto num_non_empty_children =
-              std::count_if(i.children.begin(), i.children.end(), is_non_empty_child);
-            if (num_non_empty_children == 0)
+            if (const auto quadrant = get_quadrant(i.address, address))
             {
-              node = leaf_node{i.address, std::move(i.data)};
+              child_addresses[*quadrant].push_back(address);
             }
-            else if (num_non_empty_children == 1 && i.data.empty())
+            else
             {
-              const auto i_non_empty_child =
-                std::find_if(i.children.begin(), i.children.end(), is_non_empty_child);
-              assert(i_non_empty_child != i.children.end());
+              remove_from_inner_node = true;
+            }
+          }
 
-              auto child = std::move(*i_non_empty_child);
-              node = std::move(child);
+          for (size_t quadrant = 0; quadrant < 8; ++quadrant)
+          {
+            if (!child_addresses[quadrant].empty())
+            {
+              remove_from_node(i.children[quadrant], child_addresses[quadrant], data);
             }
           }
+
+          if (remove_from_inner_node)
+          {
+            std::erase_if(i.data, is_removed);
+          }
+
+          simplify_inner_node(node, i);
         },
-        [&](leaf_node& l) {
-          const auto i_data = std::find(l.data.begin(), l.data.end(), data);
-          assert(i_data != l.data.end());
-          l.data.erase(i_data);
-        }),
+        [&](leaf_node& l) { std::erase_if(l.data, is_removed); }),
       node);
   }
 
+  /**
+   * Replaces the given inner node with a leaf node if none of its children are non-empty,
+   * or with its only non-empty child if it has no data of its own. The root node is
+   * never replaced.
+   */
+  static void simplify_inner_node(node& node, inner_node& i)
+  {
+    if (!is_root(i.address))
+    {
+      const auto is_non_empty_child = [](const auto& c) {
+        return is_inner_node(c) || !get_data(c).empty();
+      };
+      const auto num_non_empty_children =
+        std::count_if(i.children.begin(), i.children.end(), is_non_empty_child);
+      if (num_non_empty_children == 0)
+      {
+        node = leaf_node{i.address, std::move(i.data)};
+      }
+      else if (num_non_empty_children == 1 && i.data.empty())
+      {
+        const auto i_non_empty_child =
+          std::find_if(i.children.begin(), i.children.end(), is_non_empty_child);
+        assert(i_non_empty_child != i.children.end());
+
+        auto child = std::move(*i_non_empty_child);
+        node = std::move(child);
+      }
+    }
+  }
+
 private:
   std::optional<node> m_root;
   T m_min_size;
@@ -476,6 +535,40 @@ public:
     return true;
   }
 
+  /**
+   * Removes the nodes with the given data from this tree. Every node of the tree is
+   * visited at most once, so this is faster than removing the data one by one.
+   *
+   * @param data the data to remove
+   * @return the number of removed nodes; data that is not in this tree is ignored
+   */
+  size_t remove(const std::vector<U>& data)
+  {
+    auto addresses = std::vector<detail::node_address>{};
+    auto removed_data = std::unordered_set<U>{};
+    addresses.reserve(data.size());
+    for (const auto& d : data)
+    {
+      const auto i_address = m_node_address_for_data.find(d);
+      if (i_address != m_node_address_for_data.end() && removed_data.insert(d).second)
+      {
+        addresses.push_back(i_address->second);
+        m_node_address_for_data.erase(i_address);
+      }
+    }
+
+    if (!addresses.empty())
+    {
+      remove_from_node(*m_root, addresses, removed_data);
+      if (m_node_address_for_data.empty())
+      {
+        m_root = std::nullopt;
+      }
+    }
+
+    return addresses.size();
+  }
+
   /**
    * Updates the node with the given data with the given new bounds.
    *
@@ -20,8 +20,10 @@
 #pragma once
 
 #include "render/ShaderProgram.h"
+#include "render/Uniform.h"
 
 #include <string>
+#include <type_traits>
 
 namespace tb::render
 {
@@ -43,6 +45,12 @@ public:
   {
     m_program.set(name, value);
   }
+
+  template <class T>
+  void set(const Uniform<T>& uniform, const std::type_identity_t<T>& value)
+  {
+    m_program.set(uniform, value);
+  }
 };
 
 } // namespace tb::render
@@ -20,7 +20,6 @@
 #include "EdgeRenderer.h"
 
 #include "PreferenceManager.h"
-#include "Preferences.h"
 #include "render/ActiveShader.h"
 #include "render/BrushRendererArrays.h"
 #include "render/PrimType.h"
@@ -94,9 +93,7 @@ void EdgeRenderer::RenderBase::renderEdges(RenderContext& renderContext)
     shader.set(
       "SoftMapBoundsColor",
       vm::vec4f{
-        pref(Preferences::SoftMapBoundsColor).r(),
-        pref(Preferences::SoftMapBoundsColor).g(),
-        pref(Preferences::SoftMapBoundsColor).b(),
+        prefSnapshot()->softMapBoundsColor.xyz(),
         0.33f}); // NOTE: heavier tint than FaceRenderer, since these are lines
     shader.set("UseUniformColor", m_params.useColor);
     shader.set("Color", m_params.color);
@@ -74,7 +74,7 @@ std::vector<Vertex> createDecalBrushFace(
 
   // copy the face properties, used to calculate the decal size and UV coords
   auto attrs = mdl::BrushFaceAttributes{materialName, face.attributes()};
-  auto uvCoordSystem = face.uvCoordSystem().clone();
+  const auto& uvCoordSystem = face.uvCoordSystem();
 
   // create the geometry for the decal
   const auto plane = face.boundary();
@@ -83,9 +83,9 @@ std::vector<Vertex> createDecalBrushFace(
 
   // re-project the vertices in case the UV axes are not on the face plane
   const auto xShift =
-    uvCoordSystem->uAxis() * double(attrs.xScale() * textureSize.x() / 2.0f);
+    uvCoordSystem.uAxis() * double(attrs.xScale() * textureSize.x() / 2.0f);
   const auto yShift =
-    uvCoordSystem->vAxis() * double(attrs.yScale() * textureSize.y() / 2.0f);
+    uvCoordSystem.vAxis() * double(attrs.yScale() * textureSize.y() / 2.0f);
 
   // we want to shift every vertex by just a little bit to avoid z-fighting
   const auto offset = plane.normal * 0.1;
@@ -113,8 +113,8 @@ std::vector<Vertex> createDecalBrushFace(
 
   // calculate the UV offset based on the first vertex location
   const auto vtx = verts[0];
-  const auto xOffs = -vm::dot(vtx, uvCoordSystem->uAxis()) / attrs.xScale();
-  const auto yOffs = -vm::dot(vtx, uvCoordSystem->vAxis()) / attrs.yScale();
+  const auto xOffs = -vm::dot(vtx, uvCoordSystem.uAxis()) / attrs.xScale();
+  const auto yOffs = -vm::dot(vtx, uvCoordSystem.vAxis()) / attrs.yScale();
   attrs.setXOffset(float(xOffs));
   attrs.setYOffset(float(yOffs));
 
@@ -138,7 +138,7 @@ std::vector<Vertex> createDecalBrushFace(
   // convert the geometry into a list of vertices
   const auto norm = vm::vec3f{plane.normal};
   return kdl::vec_transform(verts, [&](const auto& v) {
-    return Vertex{vm::vec3f{v}, norm, uvCoordSystem->uvCoords(v, attrs, textureSize)};
+    return Vertex{vm::vec3f{v}, norm, uvCoordSystem.uvCoords(v, attrs, textureSize)};
   });
 }
 
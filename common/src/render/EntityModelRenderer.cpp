@@ -21,7 +21,6 @@
 
 #include "Logger.h"
 #include "PreferenceManager.h"
-#include "Preferences.h"
 #include "mdl/AssetUtils.h"
 #include "mdl/EditorContext.h"
 #include "mdl/Entity.h"
@@ -30,19 +29,215 @@
 #include "mdl/EntityNode.h"
 #include "render/ActiveShader.h"
 #include "render/Camera.h"
+#include "render/GLVertexType.h"
 #include "render/MaterialIndexRangeRenderer.h"
 #include "render/RenderBatch.h"
 #include "render/RenderContext.h"
 #include "render/RenderUtils.h"
+#include "render/ShaderManager.h"
+#include "render/ShaderProgram.h"
 #include "render/Shaders.h"
 #include "render/Transformation.h"
+#include "render/Uniforms.h"
+#include "render/VertexArray.h"
 
 #include "vm/mat.h"
 
+#include <string>
 #include <vector>
 
 namespace tb::render
 {
+namespace
+{
+
+struct InstanceModelMatrix0
+{
+  static inline const auto name = std::string{"InstanceModelMatrix0"};
+};
+
+struct InstanceModelMatrix1
+{
+  static inline const auto name = std::string{"InstanceModelMatrix1"};
+};
+
+struct InstanceModelMatrix2
+{
+  static inline const auto name = std::string{"InstanceModelMatrix2"};
+};
+
+struct InstanceModelMatrix3
+{
+  static inline const auto name = std::string{"InstanceModelMatrix3"};
+};
+
+// one vertex per instance, holding the columns of the instance's model matrix
+using InstanceVertex = GLVertexType<
+  GLVertexAttributeUser<InstanceModelMatrix0, GL_FLOAT, 4, false>,
+  GLVertexAttributeUser<InstanceModelMatrix1, GL_FLOAT, 4, false>,
+  GLVertexAttributeUser<InstanceModelMatrix2, GL_FLOAT, 4, false>,
+  GLVertexAttributeUser<InstanceModelMatrix3, GL_FLOAT, 4, false>>::Vertex;
+
+const auto InstanceAttributeNames = std::vector<std::string>{
+  InstanceModelMatrix0::name,
+  InstanceModelMatrix1::name,
+  InstanceModelMatrix2::name,
+  InstanceModelMatrix3::name,
+};
+
+VertexArray createInstanceArray(const EntityModelInstances& instances)
+{
+  auto vertices = std::vector<InstanceVertex>{};
+  vertices.reserve(instances.modelMatrices.size());
+  for (const auto& m : instances.modelMatrices)
+  {
+    vertices.emplace_back(m.v[0], m.v[1], m.v[2], m.v[3]);
+  }
+  return VertexArray::move(std::move(vertices));
+}
+
+class GLEntityModelRenderBackend : public EntityModelRenderBackend
+{
+private:
+  RenderContext& m_renderContext;
+  ActiveShader& m_shader;
+  std::vector<VertexArray>& m_instanceArrays;
+  bool m_supportsInstancing;
+
+public:
+  GLEntityModelRenderBackend(
+    RenderContext& renderContext,
+    ActiveShader& shader,
+    std::vector<VertexArray>& instanceArrays,
+    const bool supportsInstancing)
+    : m_renderContext{renderContext}
+    , m_shader{shader}
+    , m_instanceArrays{instanceArrays}
+    , m_supportsInstancing{supportsInstancing}
+  {
+  }
+
+  bool supportsInstancing() const override { return m_supportsInstancing; }
+
+  void render(
+    MaterialRenderer& renderer,
+    const mdl::Orientation orientation,
+    const vm::mat4x4f& modelMatrix) override
+  {
+    const auto multMatrix =
+      MultiplyModelMatrix{m_renderContext.transformation(), modelMatrix};
+
+    m_shader.set(Uniforms::Instanced, false);
+    m_shader.set(Uniforms::Orientation, static_cast<int>(orientation));
+    m_shader.set(Uniforms::ModelMatrix, modelMatrix);
+
+    auto renderFunc = DefaultMaterialRenderFunc{
+      m_renderContext.minFilterMode(), m_renderContext.magFilterMode()};
+    renderer.render(renderFunc);
+  }
+
+  void renderInstanced(const size_t index, const EntityModelInstances& instances) override
+  {
+    auto& instanceArray = m_instanceArrays[index];
+    if (!instanceArray.setup())
+    {
+      return;
+    }
+
+    const auto& program = *m_renderContext.shaderManager().currentProgram();
+    for (const auto& name : InstanceAttributeNames)
+    {
+      const auto location = static_cast<GLuint>(program.findAttributeLocation(name));
+      glAssert(glVertexAttribDivisor(location, 1));
+    }
+
+    m_shader.set(Uniforms::Instanced, true);
+    m_shader.set(Uniforms::Orientation, static_cast<int>(instances.orientation));
+
+    auto renderFunc = DefaultMaterialRenderFunc{
+      m_renderContext.minFilterMode(), m_renderContext.magFilterMode()};
+    instances.renderer->renderInstanced(renderFunc, instances.modelMatrices.size());
+
+    for (const auto& name : InstanceAttributeNames)
+    {
+      const auto location = static_cast<GLuint>(program.findAttributeLocation(name));
+      glAssert(glVertexAttribDivisor(location, 0));
+    }
+    instanceArray.cleanup();
+  }
+};
+
+} // namespace
+
+std::vector<EntityModelInstances> groupEntityModelInstances(
+  const std::unordered_map<const mdl::EntityNode*, MaterialRenderer*>& entities,
+  const std::function<bool(const mdl::EntityNode*)>& isVisible)
+{
+  auto result = std::vector<EntityModelInstances>{};
+  if (entities.empty())
+  {
+    return result;
+  }
+
+  const auto& propertyConfig = entities.begin()->first->entityPropertyConfig();
+  const auto& defaultModelScaleExpression = propertyConfig.defaultModelScaleExpression;
+
+  auto groupIndices = std::unordered_map<MaterialRenderer*, size_t>{};
+  for (const auto& [entityNode, renderer] : entities)
+  {
+    if (!isVisible(entityNode))
+    {
+      continue;
+    }
+
+    const auto* model = entityNode->entity().model();
+    const auto* modelData = model ? model->data() : nullptr;
+    if (!modelData)
+    {
+      continue;
+    }
+
+    const auto [it, inserted] = groupIndices.emplace(renderer, result.size());
+    if (inserted)
+    {
+      result.push_back(EntityModelInstances{renderer, modelData->orientation(), {}});
+    }
+
+    result[it->second].modelMatrices.emplace_back(
+      entityNode->entity().modelTransformation(defaultModelScaleExpression));
+  }
+
+  return result;
+}
+
+EntityModelRenderBackend::~EntityModelRenderBackend() = default;
+
+bool shouldRenderInstanced(const EntityModelInstances& instances)
+{
+  return instances.modelMatrices.size() > 1;
+}
+
+void renderEntityModelInstances(
+  const std::vector<EntityModelInstances>& instanceGroups,
+  EntityModelRenderBackend& backend)
+{
+  const auto supportsInstancing = backend.supportsInstancing();
+  for (size_t i = 0; i < instanceGroups.size(); ++i)
+  {
+    const auto& instances = instanceGroups[i];
+    if (supportsInstancing && shouldRenderInstanced(instances))
+    {
+      backend.renderInstanced(i, instances);
+    }
+    else
+    {
+      for (const auto& modelMatrix : instances.modelMatrices)
+      {
+        backend.render(*instances.renderer, instances.orientation, modelMatrix);
+      }
+    }
+  }
+}
 
 EntityModelRenderer::EntityModelRenderer(
   Logger& logger,
@@ -67,15 +262,18 @@ void EntityModelRenderer::addEntity(const mdl::EntityNode* entityNode)
     });
 
   auto* renderer = m_entityModelManager.renderer(modelSpec);
-  if (renderer != nullptr)
+  if (renderer != nullptr && m_entities.emplace(entityNode, renderer).second)
   {
-    m_entities.emplace(entityNode, renderer);
+    invalidateInstances();
   }
 }
 
 void EntityModelRenderer::removeEntity(const mdl::EntityNode* entityNode)
 {
-  m_entities.erase(entityNode);
+  if (m_entities.erase(entityNode) > 0)
+  {
+    invalidateInstances();
+  }
 }
 
 void EntityModelRenderer::updateEntity(const mdl::EntityNode* entityNode)
@@ -93,6 +291,10 @@ void EntityModelRenderer::updateEntity(const mdl::EntityNode* entityNode)
     return;
   }
 
+  // the entity's transformation, visibility or model data may have changed even if its
+  // renderer is unchanged
+  invalidateInstances();
+
   if (it == std::end(m_entities))
   {
     m_entities.emplace(entityNode, renderer);
@@ -113,6 +315,7 @@ void EntityModelRenderer::updateEntity(const mdl::EntityNode* entityNode)
 void EntityModelRenderer::clear()
 {
   m_entities.clear();
+  invalidateInstances();
 }
 
 bool EntityModelRenderer::applyTinting() const
@@ -142,7 +345,11 @@ bool EntityModelRenderer::showHiddenEntities() const
 
 void EntityModelRenderer::setShowHiddenEntities(const bool showHiddenEntities)
 {
-  m_showHiddenEntities = showHiddenEntities;
+  if (showHiddenEntities != m_showHiddenEntities)
+  {
+    m_showHiddenEntities = showHiddenEntities;
+    invalidateInstances();
+  }
 }
 
 void EntityModelRenderer::render(RenderBatch& renderBatch)
@@ -150,73 +357,79 @@ void EntityModelRenderer::render(RenderBatch& renderBatch)
   renderBatch.add(this);
 }
 
+void EntityModelRenderer::invalidateInstances()
+{
+  m_instancesValid = false;
+}
+
+void EntityModelRenderer::validateInstances(VboManager& vboManager)
+{
+  m_instances = groupEntityModelInstances(m_entities, [&](const auto* entityNode) {
+    return m_showHiddenEntities || m_editorContext.visible(entityNode);
+  });
+
+  m_supportsInstancing = GLEW_VERSION_3_3;
+  m_instanceArrays.clear();
+  if (m_supportsInstancing)
+  {
+    m_instanceArrays.reserve(m_instances.size());
+    for (const auto& instances : m_instances)
+    {
+      auto& instanceArray = m_instanceArrays.emplace_back(
+        shouldRenderInstanced(instances) ? createInstanceArray(instances)
+                                         : VertexArray{});
+      instanceArray.prepare(vboManager);
+    }
+  }
+
+  m_instancesValid = true;
+}
+
 void EntityModelRenderer::doPrepareVertices(VboManager& vboManager)
 {
   m_entityModelManager.prepare(vboManager);
+
+  if (!m_instancesValid)
+  {
+    validateInstances(vboManager);
+  }
 }
 
 void EntityModelRenderer::doRender(RenderContext& renderContext)
 {
-  if (!m_entities.empty())
+  if (!m_instances.empty())
   {
-    auto& prefs = PreferenceManager::instance();
+    const auto prefs = prefSnapshot();
 
     glAssert(glEnable(GL_TEXTURE_2D));
     glAssert(glActiveTexture(GL_TEXTURE0));
 
     auto shader = ActiveShader{renderContext.shaderManager(), Shaders::EntityModelShader};
-    shader.set("Brightness", prefs.get(Preferences::Brightness));
-    shader.set("ApplyTinting", m_applyTinting);
-    shader.set("TintColor", m_tintColor);
-    shader.set("GrayScale", false);
-    shader.set("Material", 0);
-    shader.set("ShowSoftMapBounds", !renderContext.softMapBounds().is_empty());
-    shader.set("SoftMapBoundsMin", renderContext.softMapBounds().min);
-    shader.set("SoftMapBoundsMax", renderContext.softMapBounds().max);
+    shader.set(Uniforms::Brightness, prefs->brightness);
+    shader.set(Uniforms::ApplyTinting, m_applyTinting);
+    shader.set(Uniforms::TintColor, m_tintColor);
+    shader.set(Uniforms::GrayScale, false);
+    shader.set(Uniforms::Material, 0);
+    shader.set(Uniforms::ShowSoftMapBounds, !renderContext.softMapBounds().is_empty());
+    shader.set(Uniforms::SoftMapBoundsMin, renderContext.softMapBounds().min);
+    shader.set(Uniforms::SoftMapBoundsMax, renderContext.softMapBounds().max);
     shader.set(
-      "SoftMapBoundsColor",
+      Uniforms::SoftMapBoundsColor,
       vm::vec4f{
-        prefs.get(Preferences::SoftMapBoundsColor).r(),
-        prefs.get(Preferences::SoftMapBoundsColor).g(),
-        prefs.get(Preferences::SoftMapBoundsColor).b(),
+        prefs->softMapBoundsColor.r(),
+        prefs->softMapBoundsColor.g(),
+        prefs->softMapBoundsColor.b(),
         0.1f});
 
-    shader.set("CameraPosition", renderContext.camera().position());
-    shader.set("CameraDirection", renderContext.camera().direction());
-    shader.set("CameraRight", renderContext.camera().right());
-    shader.set("CameraUp", renderContext.camera().up());
-    shader.set("ViewMatrix", renderContext.camera().viewMatrix());
-
-    const auto& propertyConfig = m_entities.begin()->first->entityPropertyConfig();
-    const auto& defaultModelScaleExpression = propertyConfig.defaultModelScaleExpression;
+    shader.set(Uniforms::CameraPosition, renderContext.camera().position());
+    shader.set(Uniforms::CameraDirection, renderContext.camera().direction());
+    shader.set(Uniforms::CameraRight, renderContext.camera().right());
+    shader.set(Uniforms::CameraUp, renderContext.camera().up());
+    shader.set(Uniforms::ViewMatrix, renderContext.camera().viewMatrix());
 
-    for (const auto& [entityNode, renderer] : m_entities)
-    {
-      if (!m_showHiddenEntities && !m_editorContext.visible(entityNode))
-      {
-        continue;
-      }
-
-      const auto* model = entityNode->entity().model();
-      const auto* modelData = model ? model->data() : nullptr;
-      if (!modelData)
-      {
-        continue;
-      }
-
-      shader.set("Orientation", static_cast<int>(modelData->orientation()));
-
-      const auto transformation = vm::mat4x4f{
-        entityNode->entity().modelTransformation(defaultModelScaleExpression)};
-      const auto multMatrix =
-        MultiplyModelMatrix{renderContext.transformation(), transformation};
-
-      shader.set("ModelMatrix", transformation);
-
-      auto renderFunc = DefaultMaterialRenderFunc{
-        renderContext.minFilterMode(), renderContext.magFilterMode()};
-      renderer->render(renderFunc);
-    }
+    auto backend = GLEntityModelRenderBackend{
+      renderContext, shader, m_instanceArrays, m_supportsInstancing};
+    renderEntityModelInstances(m_instances, backend);
   }
 }
 
@@ -22,7 +22,11 @@
 #include "Color.h"
 #include "render/Renderable.h"
 
+#include "vm/mat.h"
+
+#include <functional>
 #include <unordered_map>
+#include <vector>
 
 namespace tb
 {
@@ -34,6 +38,7 @@ namespace tb::mdl
 class EditorContext;
 class EntityModelManager;
 class EntityNode;
+enum class Orientation;
 } // namespace tb::mdl
 
 namespace tb::render
@@ -41,6 +46,66 @@ namespace tb::render
 class RenderBatch;
 struct ShaderConfig;
 class MaterialRenderer;
+class VertexArray;
+
+/**
+ * The visible entities that share a model renderer, i.e., that show the same frame and
+ * skin of the same model.
+ */
+struct EntityModelInstances
+{
+  MaterialRenderer* renderer = nullptr;
+  mdl::Orientation orientation;
+  std::vector<vm::mat4x4f> modelMatrices;
+};
+
+/**
+ * Groups the given entities by their model renderers. Entities that are not visible or
+ * whose model is not loaded are skipped.
+ */
+std::vector<EntityModelInstances> groupEntityModelInstances(
+  const std::unordered_map<const mdl::EntityNode*, MaterialRenderer*>& entities,
+  const std::function<bool(const mdl::EntityNode*)>& isVisible);
+
+/**
+ * Issues the draw calls for entity models.
+ */
+class EntityModelRenderBackend
+{
+public:
+  virtual ~EntityModelRenderBackend();
+
+  virtual bool supportsInstancing() const = 0;
+
+  /**
+   * Renders a single instance of the given model renderer.
+   */
+  virtual void render(
+    MaterialRenderer& renderer,
+    mdl::Orientation orientation,
+    const vm::mat4x4f& modelMatrix) = 0;
+
+  /**
+   * Renders all instances of the given group with one instanced draw call per primitive
+   * range. The index is the position of the group in the list of groups being rendered.
+   */
+  virtual void renderInstanced(size_t index, const EntityModelInstances& instances) = 0;
+};
+
+/**
+ * Returns whether the given group is rendered with instancing if the backend supports
+ * it.
+ */
+bool shouldRenderInstanced(const EntityModelInstances& instances);
+
+/**
+ * Renders the given groups. A group is rendered with a single instanced draw if the
+ * backend supports instancing and shouldRenderInstanced returns true, otherwise each of
+ * its instances is rendered separately.
+ */
+void renderEntityModelInstances(
+  const std::vector<EntityModelInstances>& instanceGroups,
+  EntityModelRenderBackend& backend);
 
 class EntityModelRenderer : public DirectRenderable
 {
@@ -52,6 +117,14 @@ private:
 
   std::unordered_map<const mdl::EntityNode*, MaterialRenderer*> m_entities;
 
+  // the visible entities grouped by model renderer, rebuilt when preparing vertices after
+  // an entity was added, removed or updated
+  std::vector<EntityModelInstances> m_instances;
+  // the per instance model matrices of each group that is rendered with instancing
+  std::vector<VertexArray> m_instanceArrays;
+  bool m_supportsInstancing = false;
+  bool m_instancesValid = false;
+
   bool m_applyTinting = false;
   Color m_tintColor;
 
@@ -107,6 +180,9 @@ public:
   void render(RenderBatch& renderBatch);
 
 private:
+  void invalidateInstances();
+  void validateInstances(VboManager& vboManager);
+
   void doPrepareVertices(VboManager& vboManager) override;
   void doRender(RenderContext& renderContext) override;
 };
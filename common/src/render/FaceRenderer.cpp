@@ -20,7 +20,6 @@
 #include "FaceRenderer.h"
 
 #include "PreferenceManager.h"
-#include "Preferences.h"
 #include "mdl/Material.h"
 #include "mdl/Texture.h"
 #include "render/ActiveShader.h"
@@ -31,6 +30,7 @@
 #include "render/RenderContext.h"
 #include "render/RenderUtils.h"
 #include "render/Shaders.h"
+#include "render/Uniforms.h"
 
 namespace tb::render
 {
@@ -67,13 +67,13 @@ public:
     if (const auto* texture = getTexture(material))
     {
       material->activate(m_minFilter, m_magFilter);
-      m_shader.set("ApplyMaterial", m_applyMaterial);
-      m_shader.set("Color", texture->averageColor());
+      m_shader.set(Uniforms::ApplyMaterial, m_applyMaterial);
+      m_shader.set(Uniforms::Color, texture->averageColor());
     }
     else
     {
-      m_shader.set("ApplyMaterial", false);
-      m_shader.set("Color", m_defaultColor);
+      m_shader.set(Uniforms::ApplyMaterial, false);
+      m_shader.set(Uniforms::Color, m_defaultColor);
     }
   }
 
@@ -141,7 +141,7 @@ void FaceRenderer::doRender(RenderContext& context)
   {
     auto& shaderManager = context.shaderManager();
     auto shader = ActiveShader{shaderManager, Shaders::FaceShader};
-    auto& prefs = PreferenceManager::instance();
+    const auto prefs = prefSnapshot();
 
     const auto applyMaterial = context.showMaterials();
     const auto shadeFaces = context.shadeFaces();
@@ -149,29 +149,28 @@ void FaceRenderer::doRender(RenderContext& context)
 
     glAssert(glEnable(GL_TEXTURE_2D));
     glAssert(glActiveTexture(GL_TEXTURE0));
-    shader.set("Brightness", prefs.get(Preferences::Brightness));
-    shader.set("RenderGrid", context.showGrid());
-    shader.set("GridSize", static_cast<float>(context.gridSize()));
-    shader.set("GridAlpha", prefs.get(Preferences::GridAlpha));
-    shader.set("ApplyMaterial", applyMaterial);
-    shader.set("Material", 0);
-    shader.set("ApplyTinting", m_tint);
+    shader.set(Uniforms::Brightness, prefs->brightness);
+    shader.set(Uniforms::RenderGrid, context.showGrid());
+    shader.set(Uniforms::GridSize, static_cast<float>(context.gridSize()));
+    shader.set(Uniforms::GridAlpha, prefs->gridAlpha);
+    shader.set(Uniforms::ApplyMaterial, applyMaterial);
+    shader.set(Uniforms::Material, 0);
+    shader.set(Uniforms::ApplyTinting, m_tint);
     if (m_tint)
     {
-      shader.set("TintColor", m_tintColor);
+      shader.set(Uniforms::TintColor, m_tintColor);
     }
-    shader.set("GrayScale", m_grayscale);
-    shader.set("CameraPosition", context.camera().position());
-    shader.set("ShadeFaces", shadeFaces);
-    shader.set("ShowFog", showFog);
-    shader.set("Alpha", m_alpha);
-    shader.set("EnableMasked", false);
-    shader.set("ShowSoftMapBounds", !context.softMapBounds().is_empty());
-    shader.set("SoftMapBoundsMin", context.softMapBounds().min);
-    shader.set("SoftMapBoundsMax", context.softMapBounds().max);
+    shader.set(Uniforms::GrayScale, m_grayscale);
+    shader.set(Uniforms::CameraPosition, context.camera().position());
+    shader.set(Uniforms::ShadeFaces, shadeFaces);
+    shader.set(Uniforms::ShowFog, showFog);
+    shader.set(Uniforms::Alpha, m_alpha);
+    shader.set(Uniforms::EnableMasked, false);
+    shader.set(Uniforms::ShowSoftMapBounds, !context.softMapBounds().is_empty());
+    shader.set(Uniforms::SoftMapBoundsMin, context.softMapBounds().min);
+    shader.set(Uniforms::SoftMapBoundsMax, context.softMapBounds().max);
     shader.set(
-      "SoftMapBoundsColor",
-      vm::vec4f{prefs.get(Preferences::SoftMapBoundsColor).xyz(), 0.1f});
+      Uniforms::SoftMapBoundsColor, vm::vec4f{prefs->softMapBoundsColor.xyz(), 0.1f});
 
     auto func = RenderFunc{
       shader,
@@ -192,8 +191,8 @@ void FaceRenderer::doRender(RenderContext& context)
         const auto enableMasked = texture && texture->mask() == mdl::TextureMask::On;
 
         // set any per-material uniforms
-        shader.set("GridColor", gridColorForMaterial(material));
-        shader.set("EnableMasked", enableMasked);
+        shader.set(Uniforms::GridColor, gridColorForMaterial(material));
+        shader.set(Uniforms::EnableMasked, enableMasked);
 
         func.before(material);
         brushIndexHolderPtr->setupIndices();
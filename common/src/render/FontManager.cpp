@@ -29,7 +29,12 @@ namespace tb::render
 {
 
 FontManager::FontManager()
-  : m_factory{std::make_unique<FreeTypeFontFactory>()}
+  : FontManager{std::make_unique<FreeTypeFontFactory>()}
+{
+}
+
+FontManager::FontManager(std::unique_ptr<FontFactory> factory)
+  : m_factory{std::move(factory)}
 {
 }
 
@@ -57,15 +62,36 @@ FontDescriptor FontManager::selectFontSize(
   const float maxWidth,
   const size_t minFontSize)
 {
-  auto actualDescriptor = fontDescriptor;
-  auto actualBounds = font(actualDescriptor).measure(string);
-  while (actualBounds.x() > maxWidth && actualDescriptor.size() > minFontSize)
+  const auto fits = [&](const size_t size) {
+    const auto descriptor = FontDescriptor{
+      fontDescriptor.path(), size, fontDescriptor.minChar(), fontDescriptor.maxChar()};
+    return font(descriptor).measure(string).x() <= maxWidth;
+  };
+
+  if (fontDescriptor.size() <= minFontSize || fits(fontDescriptor.size()))
   {
-    actualDescriptor =
-      FontDescriptor(actualDescriptor.path(), actualDescriptor.size() - 1);
-    actualBounds = font(actualDescriptor).measure(string);
+    return fontDescriptor;
   }
-  return actualDescriptor;
+
+  // invariant: the string does not fit at size max, and min is either the minimum font
+  // size or a size at which the string fits
+  auto min = minFontSize;
+  auto max = fontDescriptor.size();
+  while (max - min > 1)
+  {
+    const auto mid = min + (max - min) / 2;
+    if (fits(mid))
+    {
+      min = mid;
+    }
+    else
+    {
+      max = mid;
+    }
+  }
+
+  return FontDescriptor{
+    fontDescriptor.path(), min, fontDescriptor.minChar(), fontDescriptor.maxChar()};
 }
 
 } // namespace tb::render
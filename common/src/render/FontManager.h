@@ -39,9 +39,20 @@ private:
 
 public:
   FontManager();
+  explicit FontManager(std::unique_ptr<FontFactory> factory);
   ~FontManager();
 
   TextureFont& font(const FontDescriptor& fontDescriptor);
+
+  /**
+   * Returns the largest font size between the given minimum font size and the size of
+   * the given descriptor such that the given string fits into the given width. If the
+   * string does not fit even at the minimum size, a descriptor with the minimum size is
+   * returned.
+   *
+   * Since the width of a string grows with the font size, the size is found by a binary
+   * search, so only a logarithmic number of font sizes are measured (and created).
+   */
   FontDescriptor selectFontSize(
     const FontDescriptor& fontDescriptor,
     const std::string& string,
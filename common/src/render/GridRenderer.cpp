@@ -20,7 +20,6 @@
 #include "GridRenderer.h"
 
 #include "PreferenceManager.h"
-#include "Preferences.h"
 #include "render/ActiveShader.h"
 #include "render/OrthographicCamera.h"
 #include "render/PrimType.h"
@@ -82,13 +81,14 @@ void GridRenderer::doRender(RenderContext& renderContext)
   if (renderContext.showGrid())
   {
     const auto& camera = renderContext.camera();
+    const auto prefs = prefSnapshot();
 
     auto shader = ActiveShader{renderContext.shaderManager(), Shaders::Grid2DShader};
     shader.set("Normal", -camera.direction());
     shader.set("RenderGrid", renderContext.showGrid());
     shader.set("GridSize", static_cast<float>(renderContext.gridSize()));
-    shader.set("GridAlpha", pref(Preferences::GridAlpha));
-    shader.set("GridColor", pref(Preferences::GridColor2D));
+    shader.set("GridAlpha", prefs->gridAlpha);
+    shader.set("GridColor", prefs->gridColor2D);
     shader.set("CameraZoom", camera.zoom());
 
     m_vertexArray.render(PrimType::Quads);
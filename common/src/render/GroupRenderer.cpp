@@ -23,17 +23,27 @@
 #include "Preferences.h"
 #include "mdl/EditorContext.h"
 #include "mdl/GroupNode.h"
-#include "render/GLVertexType.h"
 #include "render/PrimType.h"
 #include "render/RenderBatch.h"
 #include "render/RenderContext.h"
 #include "render/RenderService.h"
 #include "render/TextAnchor.h"
+#include "render/VertexArray.h"
 
-#include <vector>
+#include <algorithm>
 
 namespace tb::render
 {
+namespace
+{
+
+/**
+ * The number of vertices needed to render the 12 edges of a group's bounds.
+ */
+constexpr size_t BoundsVertexCount = 24;
+
+} // namespace
+
 class GroupRenderer::GroupNameAnchor : public TextAnchor3D
 {
 private:
@@ -64,35 +74,49 @@ GroupRenderer::GroupRenderer(const mdl::EditorContext& editorContext)
 
 void GroupRenderer::invalidate()
 {
-  invalidateBounds();
+  m_invalidGroups = m_allGroups;
 }
 
 void GroupRenderer::clear()
 {
-  m_groups.clear();
+  m_allGroups.clear();
+  m_invalidGroups.clear();
+  m_renderedGroups.clear();
+  m_renderedGroupIndices.clear();
+  m_boundsVertices.clear();
   m_boundsRenderer = DirectEdgeRenderer();
+  m_boundsValid = false;
 }
 
 void GroupRenderer::addGroup(const mdl::GroupNode* group)
 {
-  if (m_groups.insert(group).second)
+  // an already added group keeps its validity
+  if (m_allGroups.insert(group).second)
   {
-    invalidate();
+    m_invalidGroups.insert(group);
   }
 }
 
 void GroupRenderer::removeGroup(const mdl::GroupNode* group)
 {
-  if (auto it = m_groups.find(group); it != std::end(m_groups))
+  if (m_allGroups.erase(group) > 0u)
   {
-    m_groups.erase(it);
-    invalidate();
+    m_invalidGroups.erase(group);
+    removeRenderedGroup(*group);
   }
 }
 
-void GroupRenderer::invalidateGroup(const mdl::GroupNode*)
+void GroupRenderer::invalidateGroup(const mdl::GroupNode* group)
 {
-  invalidate();
+  if (m_allGroups.find(group) != std::end(m_allGroups))
+  {
+    m_invalidGroups.insert(group);
+  }
+}
+
+bool GroupRenderer::valid() const
+{
+  return m_invalidGroups.empty() && m_editorContext.currentGroup() == m_currentGroup;
 }
 
 void GroupRenderer::setOverrideColors(const bool overrideColors)
@@ -137,10 +161,11 @@ void GroupRenderer::setOccludedBoundsColor(const Color& occludedBoundsColor)
 
 void GroupRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch)
 {
-  if (!m_groups.empty())
+  if (!m_allGroups.empty())
   {
     if (renderContext.showGroupBounds())
     {
+      validate();
       renderBounds(renderContext, renderBatch);
       renderNames(renderContext, renderBatch);
     }
@@ -174,77 +199,128 @@ void GroupRenderer::renderNames(RenderContext& renderContext, RenderBatch& rende
       renderService.setForegroundColor(m_overlayTextColor);
     }
 
-    for (const auto* group : m_groups)
+    for (const auto& renderedGroup : m_renderedGroups)
     {
-      if (shouldRenderGroup(*group))
+      if (!m_overrideColors)
+      {
+        renderService.setForegroundColor(renderedGroup.color);
+      }
+
+      const auto anchor = GroupNameAnchor{*renderedGroup.group};
+      if (m_showOccludedOverlays)
+      {
+        renderService.setShowOccludedObjects();
+      }
+      else
       {
-        if (!m_overrideColors)
-        {
-          renderService.setForegroundColor(groupColor(*group));
-        }
-
-        const auto anchor = GroupNameAnchor{*group};
-        if (m_showOccludedOverlays)
-        {
-          renderService.setShowOccludedObjects();
-        }
-        else
-        {
-          renderService.setHideOccludedObjects();
-        }
-        renderService.renderString(groupString(*group), anchor);
+        renderService.setHideOccludedObjects();
       }
+      renderService.renderString(renderedGroup.name, anchor);
     }
   }
 }
 
-void GroupRenderer::invalidateBounds()
+void GroupRenderer::validate()
 {
-  m_boundsValid = false;
+  if (m_editorContext.currentGroup() != m_currentGroup)
+  {
+    m_currentGroup = m_editorContext.currentGroup();
+    invalidate();
+  }
+
+  for (const auto* group : m_invalidGroups)
+  {
+    validateGroup(*group);
+  }
+  m_invalidGroups.clear();
 }
 
-void GroupRenderer::validateBounds()
+std::optional<size_t> GroupRenderer::renderedGroupIndex(
+  const mdl::GroupNode* group) const
+{
+  const auto it = m_renderedGroupIndices.find(group);
+  return it != std::end(m_renderedGroupIndices) ? std::optional{it->second}
+                                                : std::nullopt;
+}
+
+vm::bbox3f GroupRenderer::renderedGroupBounds(const size_t index) const
+{
+  auto builder = vm::bbox3f::builder{};
+  for (size_t i = 0; i < BoundsVertexCount; ++i)
+  {
+    builder.add(getVertexComponent<0>(m_boundsVertices[index * BoundsVertexCount + i]));
+  }
+  return builder.bounds();
+}
+
+void GroupRenderer::validateGroup(const mdl::GroupNode& group)
 {
-  if (m_overrideColors)
+  if (!shouldRenderGroup(group))
   {
-    auto vertices = std::vector<GLVertexTypes::P3::Vertex>{};
-    vertices.reserve(24 * m_groups.size());
+    removeRenderedGroup(group);
+    return;
+  }
 
-    for (const auto* group : m_groups)
-    {
-      if (shouldRenderGroup(*group))
-      {
-        group->logicalBounds().for_each_edge([&](const auto& v1, const auto& v2) {
-          vertices.emplace_back(vm::vec3f{v1});
-          vertices.emplace_back(vm::vec3f{v2});
-        });
-      }
-    }
+  const auto [it, inserted] =
+    m_renderedGroupIndices.try_emplace(&group, m_renderedGroups.size());
+  const auto index = it->second;
+  const auto color = groupColor(group);
 
-    m_boundsRenderer =
-      DirectEdgeRenderer{VertexArray::move(std::move(vertices)), PrimType::Lines};
+  if (inserted)
+  {
+    m_renderedGroups.push_back(RenderedGroup{&group, groupString(group), color});
+    m_boundsVertices.resize(m_boundsVertices.size() + BoundsVertexCount);
   }
   else
   {
-    auto vertices = std::vector<GLVertexTypes::P3C4::Vertex>{};
-    vertices.reserve(24 * m_groups.size());
+    m_renderedGroups[index] = RenderedGroup{&group, groupString(group), color};
+  }
 
-    for (const auto* group : m_groups)
-    {
-      if (shouldRenderGroup(*group))
-      {
-        const auto color = groupColor(*group);
-        group->logicalBounds().for_each_edge([&](const auto& v1, const auto& v2) {
-          vertices.emplace_back(vm::vec3f{v1}, color);
-          vertices.emplace_back(vm::vec3f{v2}, color);
-        });
-      }
-    }
+  auto vertex = m_boundsVertices.begin() + std::ptrdiff_t(index * BoundsVertexCount);
+  group.logicalBounds().for_each_edge([&](const auto& v1, const auto& v2) {
+    *(vertex++) = BoundsVertex{vm::vec3f{v1}, color};
+    *(vertex++) = BoundsVertex{vm::vec3f{v2}, color};
+  });
 
-    m_boundsRenderer =
-      DirectEdgeRenderer{VertexArray::move(std::move(vertices)), PrimType::Lines};
+  m_boundsValid = false;
+}
+
+void GroupRenderer::removeRenderedGroup(const mdl::GroupNode& group)
+{
+  const auto it = m_renderedGroupIndices.find(&group);
+  if (it == std::end(m_renderedGroupIndices))
+  {
+    return;
   }
 
+  const auto index = it->second;
+  const auto lastIndex = m_renderedGroups.size() - 1u;
+  m_renderedGroupIndices.erase(it);
+
+  if (index != lastIndex)
+  {
+    // move the last group into the freed slot so that the groups remain densely stored
+    m_renderedGroups[index] = std::move(m_renderedGroups[lastIndex]);
+    m_renderedGroupIndices[m_renderedGroups[index].group] = index;
+
+    const auto lastVertices =
+      m_boundsVertices.begin() + std::ptrdiff_t(lastIndex * BoundsVertexCount);
+    std::copy_n(
+      lastVertices,
+      BoundsVertexCount,
+      m_boundsVertices.begin() + std::ptrdiff_t(index * BoundsVertexCount));
+  }
+
+  m_renderedGroups.pop_back();
+  m_boundsVertices.resize(lastIndex * BoundsVertexCount);
+
+  m_boundsValid = false;
+}
+
+void GroupRenderer::validateBounds()
+{
+  m_boundsRenderer =
+    DirectEdgeRenderer{VertexArray::copy(m_boundsVertices), PrimType::Lines};
   m_boundsValid = true;
 }
 
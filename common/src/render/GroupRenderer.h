@@ -22,8 +22,14 @@
 #include "AttrString.h"
 #include "Color.h"
 #include "render/EdgeRenderer.h"
+#include "render/GLVertexType.h"
 
-#include "kdl/vector_set.h"
+#include "vm/bbox.h"
+
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace tb::mdl
 {
@@ -41,8 +47,41 @@ class GroupRenderer
 private:
   class GroupNameAnchor;
 
+  using BoundsVertex = GLVertexTypes::P3C4::Vertex;
+
+  /**
+   * The cached render data of a group whose bounds and name are rendered.
+   */
+  struct RenderedGroup
+  {
+    const mdl::GroupNode* group;
+    AttrString name;
+    Color color;
+  };
+
   const mdl::EditorContext& m_editorContext;
-  kdl::vector_set<const mdl::GroupNode*> m_groups;
+
+  /**
+   * If a group is rendered, it's always valid. If a group is valid, it might not be
+   * rendered if it's hidden or if it doesn't belong to the current group.
+   */
+  std::unordered_set<const mdl::GroupNode*> m_allGroups;
+  std::unordered_set<const mdl::GroupNode*> m_invalidGroups;
+
+  /**
+   * The rendered groups are stored densely. The bounds of the group at index i occupy
+   * the 24 vertices starting at i * 24.
+   */
+  std::vector<RenderedGroup> m_renderedGroups;
+  std::unordered_map<const mdl::GroupNode*, size_t> m_renderedGroupIndices;
+  std::vector<BoundsVertex> m_boundsVertices;
+
+  /**
+   * The current group of the editor context when the groups were last validated. Since
+   * opening or closing a group changes which groups are rendered, all groups are
+   * revalidated when it changes.
+   */
+  const mdl::GroupNode* m_currentGroup = nullptr;
 
   DirectEdgeRenderer m_boundsRenderer;
   bool m_boundsValid = false;
@@ -82,6 +121,7 @@ public:
    * call).
    */
   void invalidateGroup(const mdl::GroupNode* group);
+  bool valid() const;
 
   void setOverrideColors(bool overrideColors);
 
@@ -98,11 +138,28 @@ public:
 public: // rendering
   void render(RenderContext& renderContext, RenderBatch& renderBatch);
 
+  /**
+   * Only exposed for testing.
+   */
+  void validate();
+
+  /**
+   * Returns the index at which the given group's render data are stored, or nullopt if
+   * the group is not rendered. Only exposed for testing.
+   */
+  std::optional<size_t> renderedGroupIndex(const mdl::GroupNode* group) const;
+
+  /**
+   * Returns the bounds that are stored at the given index. Only exposed for testing.
+   */
+  vm::bbox3f renderedGroupBounds(size_t index) const;
+
 private:
   void renderBounds(RenderContext& renderContext, RenderBatch& renderBatch);
   void renderNames(RenderContext& renderContext, RenderBatch& renderBatch);
 
-  void invalidateBounds();
+  void validateGroup(const mdl::GroupNode& group);
+  void removeRenderedGroup(const mdl::GroupNode& group);
   void validateBounds();
 
   bool shouldRenderGroup(const mdl::GroupNode& group) const;
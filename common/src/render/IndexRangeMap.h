@@ -156,6 +156,14 @@ public:
    */
   void render(VertexArray& vertexArray) const;
 
+  /**
+   * Like render, but renders the given number of instances of each primitive.
+   *
+   * @param vertexArray the vertex array to render with
+   * @param instanceCount the number of instances to render
+   */
+  void renderInstanced(VertexArray& vertexArray, size_t instanceCount) const;
+
   /**
    * Invokes the given function for each primitive stored in this map.
    *
@@ -628,6 +628,17 @@ void MapRenderer::invalidateRenderers(const Renderer renderers)
   }
 }
 
+/**
+ * Marks the groups that are tracked in any renderer as invalid, e.g. because their
+ * cached colors are outdated.
+ */
+void MapRenderer::invalidateGroupRenderers()
+{
+  m_defaultRenderer->invalidateGroups();
+  m_selectionRenderer->invalidateGroups();
+  m_lockedRenderer->invalidateGroups();
+}
+
 void MapRenderer::invalidateEntityDecalRenderer()
 {
   m_entityDecalRenderer->invalidate();
@@ -870,6 +881,11 @@ void MapRenderer::preferenceDidChange(const std::filesystem::path& path)
     invalidateEntityLinkRenderer();
     invalidateGroupLinkRenderer();
   }
+
+  if (path == Preferences::DefaultGroupColor.path())
+  {
+    invalidateGroupRenderers();
+  }
 }
 
 } // namespace tb::render
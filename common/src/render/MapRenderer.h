@@ -121,6 +121,7 @@ private:
   void updateAllNodes();
 
   void invalidateRenderers(Renderer renderers);
+  void invalidateGroupRenderers();
   void invalidateEntityDecalRenderer();
   void invalidateEntityLinkRenderer();
   void invalidateGroupLinkRenderer();
@@ -175,6 +175,12 @@ public:
    */
   void render(VertexArray& vertexArray, MaterialRenderFunc& func);
 
+  /**
+   * Like render, but renders the given number of instances of each primitive.
+   */
+  void renderInstanced(
+    VertexArray& vertexArray, MaterialRenderFunc& func, size_t instanceCount);
+
   /**
    * Invokes the given function for each primitive stored in this map.
    *
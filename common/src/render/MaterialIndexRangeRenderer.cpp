@@ -63,6 +63,16 @@ void MaterialIndexRangeRenderer::render(MaterialRenderFunc& func)
   }
 }
 
+void MaterialIndexRangeRenderer::renderInstanced(
+  MaterialRenderFunc& func, const size_t instanceCount)
+{
+  if (m_vertexArray.setup())
+  {
+    m_indexRange.renderInstanced(m_vertexArray, func, instanceCount);
+    m_vertexArray.cleanup();
+  }
+}
+
 MultiMaterialIndexRangeRenderer::MultiMaterialIndexRangeRenderer(
   std::vector<std::unique_ptr<MaterialIndexRangeRenderer>> renderers)
   : m_renderers{std::move(renderers)}
@@ -99,4 +109,13 @@ void MultiMaterialIndexRangeRenderer::render(MaterialRenderFunc& func)
   }
 }
 
+void MultiMaterialIndexRangeRenderer::renderInstanced(
+  MaterialRenderFunc& func, const size_t instanceCount)
+{
+  for (auto& renderer : m_renderers)
+  {
+    renderer->renderInstanced(func, instanceCount);
+  }
+}
+
 } // namespace tb::render
@@ -72,6 +72,11 @@ void ObjectRenderer::invalidateNode(mdl::Node* node)
     [&](mdl::PatchNode* patch) { m_patchRenderer.invalidatePatch(patch); }));
 }
 
+void ObjectRenderer::invalidateGroups()
+{
+  m_groupRenderer.invalidate();
+}
+
 void ObjectRenderer::invalidate()
 {
   m_groupRenderer.invalidate();
@@ -78,6 +78,7 @@ public: // object management
   void invalidateMaterials(const std::vector<const mdl::Material*>& materials);
   void invalidateEntityModels(const std::vector<const mdl::EntityModel*>& entityModels);
   void invalidateNode(mdl::Node* node);
+  void invalidateGroups();
   void invalidate();
   void clear();
   void reloadModels();
@@ -27,26 +27,27 @@
 #include "mdl/Texture.h"
 #include "render/ActiveShader.h"
 #include "render/Camera.h"
+#include "render/BrushRendererArrays.h"
 #include "render/GLVertexType.h"
-#include "render/IndexRangeMapBuilder.h"
-#include "render/MaterialIndexArrayMapBuilder.h"
-#include "render/MaterialIndexArrayRenderer.h"
+#include "render/PrimType.h"
 #include "render/RenderBatch.h"
 #include "render/RenderContext.h"
 #include "render/RenderUtils.h"
 #include "render/Shaders.h"
-#include "render/VertexArray.h"
-
-#include "kdl/vector_utils.h"
 
 #include "vm/vec.h"
 
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
 namespace tb::render
 {
 
 PatchRenderer::PatchRenderer(const mdl::EditorContext& editorContext)
   : m_editorContext{editorContext}
 {
+  clear();
 }
 
 void PatchRenderer::setDefaultColor(const Color& faceColor)
@@ -96,40 +97,66 @@ void PatchRenderer::setOccludedEdgeColor(const Color& occludedEdgeColor)
 
 void PatchRenderer::invalidate()
 {
-  m_valid = false;
+  for (const auto* patchNode : m_allPatches)
+  {
+    removePatchFromVbo(*patchNode);
+  }
+  m_invalidPatches = m_allPatches;
+
+  assert(m_patchInfo.empty());
+  assert(m_faceIndices->empty());
 }
 
 void PatchRenderer::clear()
 {
-  m_patchNodes.clear();
-  invalidate();
+  m_patchInfo.clear();
+  m_allPatches.clear();
+  m_invalidPatches.clear();
+
+  m_vertexArray = std::make_shared<BrushVertexArray>();
+  m_edgeIndices = std::make_shared<BrushIndexArray>();
+  m_faceIndices = std::make_shared<MaterialToPatchIndicesMap>();
+
+  m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
 }
 
 void PatchRenderer::addPatch(const mdl::PatchNode* patchNode)
 {
-  if (m_patchNodes.insert(patchNode).second)
+  // an already added patch keeps its validity
+  if (m_allPatches.insert(patchNode).second)
   {
-    invalidate();
+    assert(m_patchInfo.find(patchNode) == std::end(m_patchInfo));
+    m_invalidPatches.insert(patchNode);
   }
 }
 
 void PatchRenderer::removePatch(const mdl::PatchNode* patchNode)
 {
-  if (auto it = m_patchNodes.find(patchNode); it != std::end(m_patchNodes))
+  if (m_allPatches.erase(patchNode) > 0u && m_invalidPatches.erase(patchNode) == 0u)
   {
-    m_patchNodes.erase(it);
-    invalidate();
+    // invalid patches are not in the VBO
+    removePatchFromVbo(*patchNode);
   }
 }
 
-void PatchRenderer::invalidatePatch(const mdl::PatchNode*)
+void PatchRenderer::invalidatePatch(const mdl::PatchNode* patchNode)
 {
-  invalidate();
+  if (
+    m_allPatches.find(patchNode) != std::end(m_allPatches)
+    && m_invalidPatches.insert(patchNode).second)
+  {
+    removePatchFromVbo(*patchNode);
+  }
+}
+
+bool PatchRenderer::valid() const
+{
+  return m_invalidPatches.empty();
 }
 
 void PatchRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch)
 {
-  if (!m_valid)
+  if (!valid())
   {
     validate();
   }
@@ -149,167 +176,180 @@ void PatchRenderer::render(RenderContext& renderContext, RenderBatch& renderBatc
   }
 }
 
-static MaterialIndexArrayRenderer buildMeshRenderer(
-  const std::vector<const mdl::PatchNode*>& patchNodes,
-  const mdl::EditorContext& editorContext)
+void PatchRenderer::validate()
 {
-  size_t vertexCount = 0u;
-  auto indexArrayMapSize = MaterialIndexArrayMap::Size{};
-
-  for (const auto* patchNode : patchNodes)
+  for (const auto* patchNode : m_invalidPatches)
   {
-    if (editorContext.visible(patchNode))
-    {
-      vertexCount += patchNode->grid().pointRowCount * patchNode->grid().pointColumnCount;
-
-      const auto* material = patchNode->patch().material();
-      const auto quadCount =
-        patchNode->grid().quadRowCount() * patchNode->grid().quadColumnCount();
-      indexArrayMapSize.inc(material, PrimType::Triangles, 6u * quadCount);
-    }
+    validatePatch(*patchNode);
   }
+  m_invalidPatches.clear();
 
-  using Vertex = GLVertexTypes::P3NT2::Vertex;
-  auto vertices = std::vector<Vertex>{};
-  vertices.reserve(vertexCount);
-
-  auto indexArrayMapBuilder = MaterialIndexArrayMapBuilder{indexArrayMapSize};
-  using Index = MaterialIndexArrayMapBuilder::Index;
+  m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
+}
 
-  for (const auto* patchNode : patchNodes)
+std::optional<PatchRenderer::PatchRanges> PatchRenderer::patchRanges(
+  const mdl::PatchNode* patchNode) const
+{
+  const auto it = m_patchInfo.find(patchNode);
+  if (it == std::end(m_patchInfo))
   {
-    if (editorContext.visible(patchNode))
-    {
-      const auto vertexOffset = vertices.size();
-
-      const auto& grid = patchNode->grid();
-      auto gridVertices = kdl::vec_transform(grid.points, [](const auto& p) {
-        return Vertex{vm::vec3f{p.position}, vm::vec3f{p.normal}, vm::vec2f{p.uvCoords}};
-      });
-      vertices = kdl::vec_concat(std::move(vertices), std::move(gridVertices));
-
-      const auto* material = patchNode->patch().material();
-
-      const auto pointsPerRow = grid.pointColumnCount;
-      for (size_t row = 0u; row < grid.quadRowCount(); ++row)
-      {
-        for (size_t col = 0u; col < grid.quadColumnCount(); ++col)
-        {
-          const auto i0 = vertexOffset + row * pointsPerRow + col;
-          const auto i1 = vertexOffset + row * pointsPerRow + col + 1u;
-          const auto i2 = vertexOffset + (row + 1u) * pointsPerRow + col + 1u;
-          const auto i3 = vertexOffset + (row + 1u) * pointsPerRow + col;
-
-          indexArrayMapBuilder.addTriangle(
-            material,
-            static_cast<Index>(i0),
-            static_cast<Index>(i1),
-            static_cast<Index>(i2));
-          indexArrayMapBuilder.addTriangle(
-            material,
-            static_cast<Index>(i2),
-            static_cast<Index>(i3),
-            static_cast<Index>(i0));
-        }
-      }
-    }
+    return std::nullopt;
   }
 
-  auto vertexArray = VertexArray::move(std::move(vertices));
-  auto indexArray = IndexArray::move(std::move(indexArrayMapBuilder.indices()));
-  return MaterialIndexArrayRenderer{
-    std::move(vertexArray),
-    std::move(indexArray),
-    std::move(indexArrayMapBuilder.ranges())};
+  const auto toRange = [](const auto* block) {
+    return AllocationTracker::Range{block->pos, block->size};
+  };
+
+  const auto& info = it->second;
+  return PatchRanges{
+    toRange(info.vertexHolderKey),
+    toRange(info.faceIndicesKey),
+    toRange(info.edgeIndicesKey)};
 }
 
-static DirectEdgeRenderer buildEdgeRenderer(
-  const std::vector<const mdl::PatchNode*>& patchNodes,
-  const mdl::EditorContext& editorContext)
+void PatchRenderer::validatePatch(const mdl::PatchNode& patchNode)
 {
-  size_t vertexCount = 0u;
-  auto indexRangeMapSize = IndexRangeMap::Size{};
+  assert(m_patchInfo.find(&patchNode) == std::end(m_patchInfo));
 
-  for (const auto* patchNode : patchNodes)
+  if (!m_editorContext.visible(&patchNode))
   {
-    if (editorContext.visible(patchNode))
-    {
-      vertexCount +=
-        (patchNode->grid().pointRowCount + patchNode->grid().pointColumnCount - 2u) * 2u;
-      indexRangeMapSize.inc(PrimType::LineLoop, vertexCount);
-    }
+    // invisible patches are not stored in the VBO
+    return;
   }
 
-  auto indexRangeMapBuilder =
-    IndexRangeMapBuilder<GLVertexTypes::P3>{vertexCount, indexRangeMapSize};
+  using Vertex = GLVertexTypes::P3NT2::Vertex;
 
-  for (const auto* patchNode : patchNodes)
+  const auto& grid = patchNode.grid();
+  auto& info = m_patchInfo[&patchNode];
+
+  // insert the grid points into the vertex array
+  auto [vertexBlock, vertexDest] =
+    m_vertexArray->getPointerToInsertVerticesAt(grid.points.size());
+  std::ranges::transform(grid.points, vertexDest, [](const auto& p) {
+    return Vertex{vm::vec3f{p.position}, vm::vec3f{p.normal}, vm::vec2f{p.uvCoords}};
+  });
+  info.vertexHolderKey = vertexBlock;
+
+  const auto vertexOffset = static_cast<GLuint>(vertexBlock->pos);
+  const auto pointsPerRow = grid.pointColumnCount;
+  const auto index = [&](const size_t row, const size_t col) {
+    return vertexOffset + static_cast<GLuint>(row * pointsPerRow + col);
+  };
+
+  // insert two triangles per quad into the index array of the patch material
+  const auto* material = patchNode.patch().material();
+  auto& faceIndices = (*m_faceIndices)[material];
+  if (faceIndices == nullptr)
   {
-    if (editorContext.visible(patchNode))
-    {
-      const auto& grid = patchNode->grid();
+    faceIndices = std::make_shared<BrushIndexArray>();
+  }
 
-      auto edgeLoopVertices = std::vector<GLVertexTypes::P3::Vertex>{};
-      edgeLoopVertices.reserve((grid.pointRowCount + grid.pointColumnCount - 2u) * 2u);
+  const auto quadCount = grid.quadRowCount() * grid.quadColumnCount();
+  auto [faceBlock, faceDest] = faceIndices->getPointerToInsertElementsAt(6u * quadCount);
+  info.material = material;
+  info.faceIndicesKey = faceBlock;
 
-      // walk around the patch to collect the edge vertices
-      // for each side, collect the first vertex up to but not including the last vertex
+  for (size_t row = 0u; row < grid.quadRowCount(); ++row)
+  {
+    for (size_t col = 0u; col < grid.quadColumnCount(); ++col)
+    {
+      const auto i0 = index(row, col);
+      const auto i1 = index(row, col + 1u);
+      const auto i2 = index(row + 1u, col + 1u);
+      const auto i3 = index(row + 1u, col);
+
+      *(faceDest++) = i0;
+      *(faceDest++) = i1;
+      *(faceDest++) = i2;
+      *(faceDest++) = i2;
+      *(faceDest++) = i3;
+      *(faceDest++) = i0;
+    }
+  }
 
-      const auto t = 0u;
-      const auto b = grid.pointRowCount - 1u;
-      const auto l = 0u;
-      const auto r = grid.pointColumnCount - 1u;
+  // walk around the patch to collect the edge loop
+  // for each side, collect the first vertex up to but not including the last vertex
 
-      auto row = t;
-      auto col = l;
+  auto edgeLoopIndices = std::vector<GLuint>{};
+  edgeLoopIndices.reserve((grid.pointRowCount + grid.pointColumnCount - 2u) * 2u);
 
-      while (col < r)
-      {
-        edgeLoopVertices.emplace_back(vm::vec3f{grid.point(row, col++).position});
-      }
-      assert(row == t && col == r);
+  const auto t = 0u;
+  const auto b = grid.pointRowCount - 1u;
+  const auto l = 0u;
+  const auto r = grid.pointColumnCount - 1u;
 
-      while (row < b)
-      {
-        edgeLoopVertices.emplace_back(vm::vec3f{grid.point(row++, col).position});
-      }
-      assert(row == b && col == r);
+  auto row = t;
+  auto col = l;
 
-      while (col > l)
-      {
-        edgeLoopVertices.emplace_back(vm::vec3f{grid.point(row, col--).position});
-      }
-      assert(row == b && col == l);
+  while (col < r)
+  {
+    edgeLoopIndices.push_back(index(row, col++));
+  }
+  assert(row == t && col == r);
 
-      while (row > t)
-      {
-        edgeLoopVertices.emplace_back(vm::vec3f{grid.point(row--, col).position});
-      }
-      assert(row == t && col == l);
+  while (row < b)
+  {
+    edgeLoopIndices.push_back(index(row++, col));
+  }
+  assert(row == b && col == r);
 
-      indexRangeMapBuilder.addLineLoop(edgeLoopVertices);
-    }
+  while (col > l)
+  {
+    edgeLoopIndices.push_back(index(row, col--));
+  }
+  assert(row == b && col == l);
+
+  while (row > t)
+  {
+    edgeLoopIndices.push_back(index(row--, col));
   }
+  assert(row == t && col == l);
 
-  auto vertexArray = VertexArray::move(std::move(indexRangeMapBuilder.vertices()));
-  auto indexRangeMap = std::move(indexRangeMapBuilder.indices());
-  return DirectEdgeRenderer{std::move(vertexArray), std::move(indexRangeMap)};
+  // the edge renderer draws lines, so each loop segment needs both of its indices
+  auto [edgeBlock, edgeDest] =
+    m_edgeIndices->getPointerToInsertElementsAt(2u * edgeLoopIndices.size());
+  info.edgeIndicesKey = edgeBlock;
+
+  for (size_t i = 0u; i < edgeLoopIndices.size(); ++i)
+  {
+    *(edgeDest++) = edgeLoopIndices[i];
+    *(edgeDest++) = edgeLoopIndices[(i + 1u) % edgeLoopIndices.size()];
+  }
 }
 
-void PatchRenderer::validate()
+void PatchRenderer::removePatchFromVbo(const mdl::PatchNode& patchNode)
 {
-  if (!m_valid)
+  const auto it = m_patchInfo.find(&patchNode);
+  if (it == std::end(m_patchInfo))
   {
-    m_patchMeshRenderer = buildMeshRenderer(m_patchNodes.get_data(), m_editorContext);
-    m_edgeRenderer = buildEdgeRenderer(m_patchNodes.get_data(), m_editorContext);
+    // the patch was not visible when it was validated
+    return;
+  }
 
-    m_valid = true;
+  const auto& info = it->second;
+
+  m_vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
+  m_edgeIndices->zeroElementsWithKey(info.edgeIndicesKey);
+
+  const auto faceIndices = m_faceIndices->at(info.material);
+  faceIndices->zeroElementsWithKey(info.faceIndicesKey);
+  if (!faceIndices->hasValidIndices())
+  {
+    // don't keep any index arrays for materials that are no longer used
+    m_faceIndices->erase(info.material);
   }
+
+  m_patchInfo.erase(it);
 }
 
 void PatchRenderer::prepareVerticesAndIndices(VboManager& vboManager)
 {
-  m_patchMeshRenderer.prepare(vboManager);
+  m_vertexArray->prepare(vboManager);
+
+  for (const auto& [material, faceIndices] : *m_faceIndices)
+  {
+    faceIndices->prepare(vboManager);
+  }
 }
 
 namespace
@@ -415,7 +455,21 @@ void PatchRenderer::doRender(RenderContext& context)
   }
   */
 
-  m_patchMeshRenderer.render(func);
+  if (!m_faceIndices->empty() && m_vertexArray->setupVertices())
+  {
+    for (const auto& [material, faceIndices] : *m_faceIndices)
+    {
+      if (faceIndices->hasValidIndices())
+      {
+        func.before(material);
+        faceIndices->setupIndices();
+        faceIndices->render(PrimType::Triangles);
+        faceIndices->cleanupIndices();
+        func.after(material);
+      }
+    }
+    m_vertexArray->cleanupVertices();
+  }
 
   /*
   if (m_alpha < 1.0f) {
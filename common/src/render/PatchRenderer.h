@@ -20,20 +20,26 @@
 #pragma once
 
 #include "Color.h"
+#include "render/AllocationTracker.h"
 #include "render/EdgeRenderer.h"
-#include "render/MaterialIndexArrayRenderer.h"
 #include "render/Renderable.h"
 
-#include "kdl/vector_set.h"
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace tb::mdl
 {
 class EditorContext;
+class Material;
 class PatchNode;
 } // namespace tb::mdl
 
 namespace tb::render
 {
+class BrushIndexArray;
+class BrushVertexArray;
 class RenderBatch;
 class RenderContext;
 class VboManager;
@@ -43,11 +49,34 @@ class PatchRenderer : public IndexedRenderable
 private:
   const mdl::EditorContext& m_editorContext;
 
-  bool m_valid = true;
-  kdl::vector_set<const mdl::PatchNode*> m_patchNodes;
+  struct PatchInfo
+  {
+    AllocationTracker::Block* vertexHolderKey;
+    const mdl::Material* material;
+    AllocationTracker::Block* faceIndicesKey;
+    AllocationTracker::Block* edgeIndicesKey;
+  };
+  /**
+   * Tracks all patches that are stored in the VBO, with the information necessary to
+   * remove them from the VBO later.
+   */
+  std::unordered_map<const mdl::PatchNode*, PatchInfo> m_patchInfo;
+
+  /**
+   * If a patch is in the VBO, it's always valid. If a patch is valid, it might not be in
+   * the VBO if it isn't visible.
+   */
+  std::unordered_set<const mdl::PatchNode*> m_allPatches;
+  std::unordered_set<const mdl::PatchNode*> m_invalidPatches;
 
-  MaterialIndexArrayRenderer m_patchMeshRenderer;
-  DirectEdgeRenderer m_edgeRenderer;
+  std::shared_ptr<BrushVertexArray> m_vertexArray;
+  std::shared_ptr<BrushIndexArray> m_edgeIndices;
+
+  using MaterialToPatchIndicesMap =
+    std::unordered_map<const mdl::Material*, std::shared_ptr<BrushIndexArray>>;
+  std::shared_ptr<MaterialToPatchIndicesMap> m_faceIndices;
+
+  IndexedEdgeRenderer m_edgeRenderer;
 
   Color m_defaultColor;
   bool m_grayscale = false;
@@ -90,7 +119,8 @@ public:
   void setOccludedEdgeColor(const Color& occludedEdgeColor);
 
   /**
-   * Equivalent to invalidatePatch() on all added patches.
+   * Equivalent to invalidatePatch() on all added patches. Afterwards, the renderer does
+   * not hold any material pointers until it is validated again.
    */
   void invalidate();
   /**
@@ -112,12 +142,37 @@ public:
    * call).
    */
   void invalidatePatch(const mdl::PatchNode* patchNode);
+  bool valid() const;
 
   void render(RenderContext& renderContext, RenderBatch& renderBatch);
 
-private:
+  /**
+   * Only exposed for testing.
+   */
   void validate();
 
+  /**
+   * The ranges of the vertex array and of the index arrays that hold a patch.
+   */
+  struct PatchRanges
+  {
+    AllocationTracker::Range vertices;
+    AllocationTracker::Range faceIndices;
+    AllocationTracker::Range edgeIndices;
+
+    auto operator<=>(const PatchRanges& other) const = default;
+  };
+
+  /**
+   * Returns the ranges that hold the given patch, or nullopt if the patch is not stored
+   * in the VBO. Only exposed for testing.
+   */
+  std::optional<PatchRanges> patchRanges(const mdl::PatchNode* patchNode) const;
+
+private:
+  void validatePatch(const mdl::PatchNode& patchNode);
+  void removePatchFromVbo(const mdl::PatchNode& patchNode);
+
 private: // implement IndexedRenderable interface
   void prepareVerticesAndIndices(VboManager& vboManager) override;
   void doRender(RenderContext& renderContext) override;
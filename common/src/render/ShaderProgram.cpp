@@ -33,6 +33,7 @@ namespace tb::render
 ShaderProgram::ShaderProgram(std::string name, const GLuint programId)
   : m_name{std::move(name)}
   , m_programId{programId}
+  , m_uniforms{glUniformBackend(), m_programId}
 {
   assert(m_programId != 0);
 }
@@ -40,6 +41,7 @@ ShaderProgram::ShaderProgram(std::string name, const GLuint programId)
 ShaderProgram::ShaderProgram(ShaderProgram&& other) noexcept
   : m_name{std::move(other.m_name)}
   , m_programId{std::exchange(other.m_programId, 0)}
+  , m_uniforms{std::move(other.m_uniforms)}
 {
 }
 
@@ -47,6 +49,7 @@ ShaderProgram& ShaderProgram::operator=(ShaderProgram&& other) noexcept
 {
   m_name = std::move(other.m_name);
   m_programId = std::exchange(other.m_programId, 0);
+  m_uniforms = std::move(other.m_uniforms);
   return *this;
 }
 
@@ -99,6 +102,7 @@ Result<void> ShaderProgram::link()
       "Could not link shader program '" + m_name + "': " + getInfoLog(m_programId)};
   }
 
+  m_uniforms.resolve();
   return kdl::void_success;
 }
 
@@ -121,71 +125,57 @@ void ShaderProgram::deactivate(ShaderManager& shaderManager)
 
 void ShaderProgram::set(const std::string& name, const bool value)
 {
-  return set(name, int(value));
+  set(name, toUniformValue(value));
 }
 
 void ShaderProgram::set(const std::string& name, const int value)
 {
-  assert(checkActive());
-  glAssert(glUniform1i(findUniformLocation(name), value));
+  set(name, toUniformValue(value));
 }
 
 void ShaderProgram::set(const std::string& name, const size_t value)
 {
-  assert(checkActive());
-  glAssert(glUniform1i(findUniformLocation(name), int(value)));
+  set(name, toUniformValue(value));
 }
 
 void ShaderProgram::set(const std::string& name, const float value)
 {
-  assert(checkActive());
-  glAssert(glUniform1f(findUniformLocation(name), value));
+  set(name, toUniformValue(value));
 }
 
 void ShaderProgram::set(const std::string& name, const double value)
 {
-  assert(checkActive());
-  glAssert(glUniform1d(findUniformLocation(name), value));
+  set(name, toUniformValue(value));
 }
 
 void ShaderProgram::set(const std::string& name, const vm::vec2f& value)
 {
-  assert(checkActive());
-  glAssert(glUniform2f(findUniformLocation(name), value.x(), value.y()));
+  set(name, toUniformValue(value));
 }
 
 void ShaderProgram::set(const std::string& name, const vm::vec3f& value)
 {
-  assert(checkActive());
-  glAssert(glUniform3f(findUniformLocation(name), value.x(), value.y(), value.z()));
+  set(name, toUniformValue(value));
 }
 
 void ShaderProgram::set(const std::string& name, const vm::vec4f& value)
 {
-  assert(checkActive());
-  glAssert(
-    glUniform4f(findUniformLocation(name), value.x(), value.y(), value.z(), value.w()));
+  set(name, toUniformValue(value));
 }
 
 void ShaderProgram::set(const std::string& name, const vm::mat2x2f& value)
 {
-  assert(checkActive());
-  glAssert(glUniformMatrix2fv(
-    findUniformLocation(name), 1, false, reinterpret_cast<const float*>(value.v)));
+  set(name, toUniformValue(value));
 }
 
 void ShaderProgram::set(const std::string& name, const vm::mat3x3f& value)
 {
-  assert(checkActive());
-  glAssert(glUniformMatrix3fv(
-    findUniformLocation(name), 1, false, reinterpret_cast<const float*>(value.v)));
+  set(name, toUniformValue(value));
 }
 
 void ShaderProgram::set(const std::string& name, const vm::mat4x4f& value)
 {
-  assert(checkActive());
-  glAssert(glUniformMatrix4fv(
-    findUniformLocation(name), 1, false, reinterpret_cast<const float*>(value.v)));
+  set(name, toUniformValue(value));
 }
 
 GLint ShaderProgram::findAttributeLocation(const std::string& name) const
@@ -205,21 +195,10 @@ GLint ShaderProgram::findAttributeLocation(const std::string& name) const
   return it->second;
 }
 
-GLint ShaderProgram::findUniformLocation(const std::string& name) const
+void ShaderProgram::set(const std::string& name, UniformValue value)
 {
-  auto it = m_variableCache.find(name);
-  if (it == std::end(m_variableCache))
-  {
-    auto index = GLint(0);
-    glAssert(index = glGetUniformLocation(m_programId, name.c_str()));
-    ensure(index != -1, "Attribute location found in shader program");
-
-    auto inserted = false;
-    std::tie(it, inserted) = m_variableCache.emplace(name, index);
-    assert(inserted);
-  }
-
-  return it->second;
+  assert(checkActive());
+  m_uniforms.set(uniformIndex(name), std::move(value));
 }
 
 bool ShaderProgram::checkActive() const
@@ -22,11 +22,14 @@
 #include "Macros.h"
 #include "Result.h"
 #include "render/GL.h"
+#include "render/ShaderUniforms.h"
+#include "render/Uniform.h"
 
 #include "vm/mat.h"
 #include "vm/vec.h"
 
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 
 namespace tb::render
@@ -38,14 +41,13 @@ class Shader;
 class ShaderProgram
 {
 private:
-  using UniformVariableCache = std::unordered_map<std::string, GLint>;
   using AttributeLocationCache = std::unordered_map<std::string, GLint>;
 
   std::string m_name;
 
   GLuint m_programId;
 
-  mutable UniformVariableCache m_variableCache;
+  ShaderUniforms m_uniforms;
   mutable AttributeLocationCache m_attributeCache;
 
 public:
@@ -76,10 +78,17 @@ public:
   void set(const std::string& name, const vm::mat3x3f& value);
   void set(const std::string& name, const vm::mat4x4f& value);
 
+  template <typename T>
+  void set(const Uniform<T>& uniform, const std::type_identity_t<T>& value)
+  {
+    assert(checkActive());
+    m_uniforms.set(uniform.index(), toUniformValue(value));
+  }
+
   GLint findAttributeLocation(const std::string& name) const;
 
 private:
-  GLint findUniformLocation(const std::string& name) const;
+  void set(const std::string& name, UniformValue value);
   bool checkActive() const;
 };
 
@@ -0,0 +1,124 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ShaderUniforms.h"
+
+#include "Ensure.h"
+
+#include "kdl/overload.h"
+
+#include <utility>
+
+namespace tb::render
+{
+namespace
+{
+
+class GLUniformBackend : public UniformBackend
+{
+public:
+  GLint findUniformLocation(const GLuint programId, const std::string& name) override
+  {
+    auto location = GLint(0);
+    glAssert(location = glGetUniformLocation(programId, name.c_str()));
+    return location;
+  }
+
+  void uploadUniform(const GLint location, const UniformValue& value) override
+  {
+    std::visit(
+      kdl::overload(
+        [&](const int i) { glAssert(glUniform1i(location, i)); },
+        [&](const float f) { glAssert(glUniform1f(location, f)); },
+        [&](const double d) { glAssert(glUniform1d(location, d)); },
+        [&](const vm::vec2f& v) { glAssert(glUniform2f(location, v.x(), v.y())); },
+        [&](const vm::vec3f& v) {
+          glAssert(glUniform3f(location, v.x(), v.y(), v.z()));
+        },
+        [&](const vm::vec4f& v) {
+          glAssert(glUniform4f(location, v.x(), v.y(), v.z(), v.w()));
+        },
+        [&](const vm::mat2x2f& m) {
+          glAssert(glUniformMatrix2fv(
+            location, 1, false, reinterpret_cast<const float*>(m.v)));
+        },
+        [&](const vm::mat3x3f& m) {
+          glAssert(glUniformMatrix3fv(
+            location, 1, false, reinterpret_cast<const float*>(m.v)));
+        },
+        [&](const vm::mat4x4f& m) {
+          glAssert(glUniformMatrix4fv(
+            location, 1, false, reinterpret_cast<const float*>(m.v)));
+        }),
+      value);
+  }
+};
+
+} // namespace
+
+UniformBackend::~UniformBackend() = default;
+
+UniformBackend& glUniformBackend()
+{
+  static auto backend = GLUniformBackend{};
+  return backend;
+}
+
+ShaderUniforms::ShaderUniforms(UniformBackend& backend, const GLuint programId)
+  : m_backend{&backend}
+  , m_programId{programId}
+{
+}
+
+void ShaderUniforms::resolve()
+{
+  m_locations.clear();
+  m_values.clear();
+  resolveNewUniforms();
+}
+
+void ShaderUniforms::set(const size_t index, UniformValue value)
+{
+  if (index >= m_locations.size())
+  {
+    resolveNewUniforms();
+  }
+
+  const auto location = m_locations[index];
+  ensure(location != -1, "Uniform variable found in shader program");
+
+  auto& uploadedValue = m_values[index];
+  if (uploadedValue != value)
+  {
+    m_backend->uploadUniform(location, value);
+    uploadedValue = std::move(value);
+  }
+}
+
+void ShaderUniforms::resolveNewUniforms()
+{
+  for (auto index = m_locations.size(); index < uniformCount(); ++index)
+  {
+    m_locations.push_back(
+      m_backend->findUniformLocation(m_programId, uniformName(index)));
+  }
+  m_values.resize(m_locations.size());
+}
+
+} // namespace tb::render
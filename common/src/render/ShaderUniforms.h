@@ -0,0 +1,86 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "render/GL.h"
+#include "render/Uniform.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace tb::render
+{
+
+/**
+ * Resolves and uploads uniform variables. The default backend forwards to the current
+ * OpenGL context, other backends can be used to observe the uploads without a GPU.
+ */
+class UniformBackend
+{
+public:
+  virtual ~UniformBackend();
+
+  virtual GLint findUniformLocation(GLuint programId, const std::string& name) = 0;
+  virtual void uploadUniform(GLint location, const UniformValue& value) = 0;
+};
+
+/**
+ * Returns the backend that forwards to the current OpenGL context.
+ */
+UniformBackend& glUniformBackend();
+
+/**
+ * The uniform variables of a shader program.
+ *
+ * Keeps the locations of all registered uniform variables and a copy of the last value
+ * uploaded to each of them. Since uniform values are part of the program's state, an
+ * upload is skipped if the value is unchanged.
+ */
+class ShaderUniforms
+{
+private:
+  UniformBackend* m_backend;
+  GLuint m_programId;
+
+  // indexed by uniform index
+  std::vector<GLint> m_locations;
+  std::vector<std::optional<UniformValue>> m_values;
+
+public:
+  ShaderUniforms(UniformBackend& backend, GLuint programId);
+
+  /**
+   * Resolves the locations of all registered uniform variables and forgets the uploaded
+   * values. Must be called after the program was linked.
+   */
+  void resolve();
+
+  /**
+   * Uploads the given value unless it was the last value uploaded to the given uniform
+   * variable. The program must be active.
+   */
+  void set(size_t index, UniformValue value);
+
+private:
+  void resolveNewUniforms();
+};
+
+} // namespace tb::render
@@ -31,6 +31,39 @@
 
 namespace tb::render
 {
+namespace
+{
+
+constexpr size_t MaxCachedGlyphRunsPerGeneration = 2048;
+
+/**
+ * Returns the cached glyph run for the given key, creating it if necessary. A run found
+ * in the previous generation is moved to the current one without invalidating references
+ * to it.
+ */
+template <typename Cache, typename Key, typename MakeGlyphRun>
+auto& findOrCreateGlyphRun(Cache& cache, const Key& key, const MakeGlyphRun& makeGlyphRun)
+{
+  if (auto it = cache.current.find(key); it != cache.current.end())
+  {
+    return it->second;
+  }
+
+  if (cache.current.size() >= MaxCachedGlyphRunsPerGeneration)
+  {
+    cache.previous = std::move(cache.current);
+    cache.current.clear();
+  }
+
+  if (auto node = cache.previous.extract(key))
+  {
+    return cache.current.insert(std::move(node)).position->second;
+  }
+
+  return cache.current.emplace(key, makeGlyphRun()).first->second;
+}
+
+} // namespace
 
 TextureFont::TextureFont(
   std::unique_ptr<FontTexture> texture,
@@ -182,8 +215,97 @@ private:
   }
 };
 
+const std::vector<vm::vec2f>& TextureFont::quads(
+  const AttrString& string, const bool clockwise) const
+{
+  auto& run = glyphRun(string);
+  auto& cachedQuads = clockwise ? run.clockwiseQuads : run.counterClockwiseQuads;
+  if (!cachedQuads)
+  {
+    cachedQuads = layoutQuads(string, clockwise, vm::vec2f{0, 0});
+  }
+  return *cachedQuads;
+}
+
 std::vector<vm::vec2f> TextureFont::quads(
   const AttrString& string, const bool clockwise, const vm::vec2f& offset) const
+{
+  if (offset != vm::vec2f{0, 0})
+  {
+    // justified lines have fractional offsets which are rounded together with the given
+    // offset, so only layouts at the origin can be reused
+    return layoutQuads(string, clockwise, offset);
+  }
+
+  return quads(string, clockwise);
+}
+
+vm::vec2f TextureFont::measure(const AttrString& string) const
+{
+  return glyphRun(string).size;
+}
+
+const std::vector<vm::vec2f>& TextureFont::quads(
+  const std::string& string, const bool clockwise) const
+{
+  auto& run = glyphRun(string);
+  auto& cachedQuads = clockwise ? run.clockwiseQuads : run.counterClockwiseQuads;
+  if (!cachedQuads)
+  {
+    cachedQuads = layoutQuads(string, clockwise, 0, 0);
+  }
+  return *cachedQuads;
+}
+
+std::vector<vm::vec2f> TextureFont::quads(
+  const std::string& string, const bool clockwise, const vm::vec2f& offset) const
+{
+  const auto x = static_cast<int>(vm::round(offset.x()));
+  const auto y = static_cast<int>(vm::round(offset.y()));
+
+  if (string.find('\n') != std::string::npos)
+  {
+    // line breaks reset the x coordinate to 0, so the layout depends on the offset
+    return layoutQuads(string, clockwise, x, y);
+  }
+
+  auto result = quads(string, clockwise);
+  if (x != 0 || y != 0)
+  {
+    // the vertices alternate between positions and texture coordinates
+    const auto translation = vm::vec2f{static_cast<float>(x), static_cast<float>(y)};
+    for (size_t i = 0; i < result.size(); i += 2)
+    {
+      result[i] = result[i] + translation;
+    }
+  }
+  return result;
+}
+
+vm::vec2f TextureFont::measure(const std::string& string) const
+{
+  return glyphRun(string).size;
+}
+
+void TextureFont::activate()
+{
+  m_texture->activate();
+}
+
+void TextureFont::deactivate()
+{
+  m_texture->deactivate();
+}
+
+TextureFont::GlyphRun& TextureFont::glyphRun(const AttrString& string) const
+{
+  return findOrCreateGlyphRun(m_attrGlyphRuns, string, [&]() {
+    return GlyphRun{layoutSize(string), {}, {}};
+  });
+}
+
+std::vector<vm::vec2f> TextureFont::layoutQuads(
+  const AttrString& string, const bool clockwise, const vm::vec2f& offset) const
 {
   auto measureLines = MeasureLines{*this};
   string.lines(measureLines);
@@ -194,21 +316,26 @@ std::vector<vm::vec2f> TextureFont::quads(
   return makeQuads.vertices();
 }
 
-vm::vec2f TextureFont::measure(const AttrString& string) const
+vm::vec2f TextureFont::layoutSize(const AttrString& string) const
 {
   auto measureString = MeasureString{*this};
   string.lines(measureString);
   return measureString.size();
 }
 
-std::vector<vm::vec2f> TextureFont::quads(
-  const std::string& string, const bool clockwise, const vm::vec2f& offset) const
+TextureFont::GlyphRun& TextureFont::glyphRun(const std::string& string) const
+{
+  return findOrCreateGlyphRun(m_glyphRuns, string, [&]() {
+    return GlyphRun{layoutSize(string), {}, {}};
+  });
+}
+
+std::vector<vm::vec2f> TextureFont::layoutQuads(
+  const std::string& string, const bool clockwise, int x, int y) const
 {
   auto result = std::vector<vm::vec2f>{};
   result.reserve(string.length() * 4 * 2);
 
-  auto x = static_cast<int>(vm::round(offset.x()));
-  auto y = static_cast<int>(vm::round(offset.y()));
   for (size_t i = 0; i < string.length(); i++)
   {
     auto c = string[i];
@@ -235,7 +362,7 @@ std::vector<vm::vec2f> TextureFont::quads(
   return result;
 }
 
-vm::vec2f TextureFont::measure(const std::string& string) const
+vm::vec2f TextureFont::layoutSize(const std::string& string) const
 {
   auto result = vm::vec2f{};
 
@@ -266,14 +393,4 @@ vm::vec2f TextureFont::measure(const std::string& string) const
   return result;
 }
 
-void TextureFont::activate()
-{
-  m_texture->activate();
-}
-
-void TextureFont::deactivate()
-{
-  m_texture->deactivate();
-}
-
 } // namespace tb::render
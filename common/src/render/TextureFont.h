@@ -21,21 +21,36 @@
 
 #include "Macros.h"
 
+#include "render/AttrString.h"
+
 #include "vm/vec.h"
 
+#include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace tb::render
 {
-class AttrString;
 class FontGlyph;
 class FontTexture;
 
 class TextureFont
 {
 private:
+  /**
+   * The cached layout of a string. The quads are laid out at the origin and are computed
+   * on demand for each winding order.
+   */
+  struct GlyphRun
+  {
+    vm::vec2f size;
+    std::optional<std::vector<vm::vec2f>> clockwiseQuads;
+    std::optional<std::vector<vm::vec2f>> counterClockwiseQuads;
+  };
+
   std::unique_ptr<FontTexture> m_texture;
   std::vector<FontGlyph> m_glyphs;
   int m_ascend;
@@ -45,6 +60,21 @@ private:
   unsigned char m_firstChar;
   unsigned char m_charCount;
 
+  /**
+   * Caches glyph runs in two generations. Runs that are used while the current generation
+   * fills up are promoted to it, and the previous generation is discarded when the
+   * current one is full. This keeps the recently used runs and bounds the cache size.
+   */
+  template <typename Map>
+  struct GlyphRunCache
+  {
+    Map current;
+    Map previous;
+  };
+
+  mutable GlyphRunCache<std::unordered_map<std::string, GlyphRun>> m_glyphRuns;
+  mutable GlyphRunCache<std::map<AttrString, GlyphRun>> m_attrGlyphRuns;
+
 public:
   TextureFont(
     std::unique_ptr<FontTexture> texture,
@@ -62,20 +92,37 @@ public:
   int descend() const;
   int lineHeight() const;
 
+  /**
+   * Returns the cached quads of the given string laid out at the origin. The returned
+   * reference is only valid until the next call to quads or measure.
+   */
+  const std::vector<vm::vec2f>& quads(const AttrString& string, bool clockwise) const;
   std::vector<vm::vec2f> quads(
-    const AttrString& string,
-    bool clockwise,
-    const vm::vec2f& offset = vm::vec2f{0, 0}) const;
+    const AttrString& string, bool clockwise, const vm::vec2f& offset) const;
   vm::vec2f measure(const AttrString& string) const;
 
+  /**
+   * Returns the cached quads of the given string laid out at the origin. The returned
+   * reference is only valid until the next call to quads or measure.
+   */
+  const std::vector<vm::vec2f>& quads(const std::string& string, bool clockwise) const;
   std::vector<vm::vec2f> quads(
-    const std::string& string,
-    bool clockwise,
-    const vm::vec2f& offset = vm::vec2f{0, 0}) const;
+    const std::string& string, bool clockwise, const vm::vec2f& offset) const;
   vm::vec2f measure(const std::string& string) const;
 
   void activate();
   void deactivate();
+
+private:
+  GlyphRun& glyphRun(const AttrString& string) const;
+  std::vector<vm::vec2f> layoutQuads(
+    const AttrString& string, bool clockwise, const vm::vec2f& offset) const;
+  vm::vec2f layoutSize(const AttrString& string) const;
+
+  GlyphRun& glyphRun(const std::string& string) const;
+  std::vector<vm::vec2f> layoutQuads(
+    const std::string& string, bool clockwise, int x, int y) const;
+  vm::vec2f layoutSize(const std::string& string) const;
 };
 
 } // namespace tb::render
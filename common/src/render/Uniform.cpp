@@ -0,0 +1,68 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Uniform.h"
+
+#include <cassert>
+#include <unordered_map>
+#include <vector>
+
+namespace tb::render
+{
+namespace
+{
+
+struct UniformRegistry
+{
+  std::vector<std::string> names;
+  std::unordered_map<std::string, size_t> indices;
+};
+
+UniformRegistry& registry()
+{
+  static auto instance = UniformRegistry{};
+  return instance;
+}
+
+} // namespace
+
+size_t uniformIndex(const std::string& name)
+{
+  auto& uniforms = registry();
+
+  const auto [it, inserted] = uniforms.indices.try_emplace(name, uniforms.names.size());
+  if (inserted)
+  {
+    uniforms.names.push_back(name);
+  }
+  return it->second;
+}
+
+const std::string& uniformName(const size_t index)
+{
+  assert(index < uniformCount());
+  return registry().names[index];
+}
+
+size_t uniformCount()
+{
+  return registry().names.size();
+}
+
+} // namespace tb::render
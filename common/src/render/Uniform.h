@@ -0,0 +1,92 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "vm/mat.h"
+#include "vm/vec.h"
+
+#include <string>
+#include <variant>
+
+namespace tb::render
+{
+
+using UniformValue = std::variant<
+  int,
+  float,
+  double,
+  vm::vec2f,
+  vm::vec3f,
+  vm::vec4f,
+  vm::mat2x2f,
+  vm::mat3x3f,
+  vm::mat4x4f>;
+
+/**
+ * Returns the index of the uniform variable with the given name and registers the name if
+ * it is not known yet. Indices are dense and shared by all shader programs.
+ */
+size_t uniformIndex(const std::string& name);
+
+const std::string& uniformName(size_t index);
+
+/**
+ * Returns the number of registered uniform variables.
+ */
+size_t uniformCount();
+
+/**
+ * A handle to a uniform variable of type T. The name is registered when the handle is
+ * created, and every shader program resolves the locations of all registered uniform
+ * variables when it is linked, so setting a uniform variable by its handle does not
+ * need to look up its name.
+ */
+template <typename T>
+class Uniform
+{
+private:
+  size_t m_index;
+
+public:
+  explicit Uniform(const std::string& name)
+    : m_index{uniformIndex(name)}
+  {
+  }
+
+  size_t index() const { return m_index; }
+};
+
+inline UniformValue toUniformValue(const bool value)
+{
+  return int(value);
+}
+
+inline UniformValue toUniformValue(const size_t value)
+{
+  return int(value);
+}
+
+template <typename T>
+UniformValue toUniformValue(const T& value)
+{
+  return UniformValue{value};
+}
+
+} // namespace tb::render
@@ -129,6 +129,38 @@ void VertexArray::render(
   }
 }
 
+void VertexArray::renderInstanced(
+  const PrimType primType,
+  const GLIndices& indices,
+  const GLCounts& counts,
+  const GLint primCount,
+  const GLsizei instanceCount)
+{
+  assert(prepared());
+
+  const auto drawRanges = [&]() {
+    for (GLint i = 0; i < primCount; ++i)
+    {
+      const auto index = size_t(i);
+      glAssert(glDrawArraysInstanced(
+        toGL(primType), indices[index], counts[index], instanceCount));
+    }
+  };
+
+  if (!m_setup)
+  {
+    if (setup())
+    {
+      drawRanges();
+      cleanup();
+    }
+  }
+  else
+  {
+    drawRanges();
+  }
+}
+
 void VertexArray::render(
   const PrimType primType, const GLIndices& indices, const GLsizei count)
 {
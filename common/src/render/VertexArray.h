@@ -313,6 +313,23 @@ public:
   void render(
     PrimType primType, const GLIndices& indices, const GLCounts& counts, GLint primCount);
 
+  /**
+   * Like the above, but renders the given number of instances of each range. There is no
+   * instanced variant of glMultiDrawArrays, so every range is drawn separately.
+   *
+   * @param primType the primitive type to render
+   * @param indices the start indices of the ranges to render
+   * @param counts the lengths of the ranges to render
+   * @param primCount the number of ranges to render
+   * @param instanceCount the number of instances to render
+   */
+  void renderInstanced(
+    PrimType primType,
+    const GLIndices& indices,
+    const GLCounts& counts,
+    GLint primCount,
+    GLsizei instanceCount);
+
   /**
    * Renders a number of primitives of the given type, the vertices of which are indicates
    * by the given index array.
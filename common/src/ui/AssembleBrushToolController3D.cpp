@@ -135,8 +135,9 @@ private:
       vm::unswizzle(vm::vec3d{bottomLeft2, swizzledPlane.zAt(bottomLeft2)}, axis),
       vm::unswizzle(vm::vec3d{bottomRight2, swizzledPlane.zAt(bottomRight2)}, axis)};
 
-    m_tool.update(
-      mdl::Polyhedron3{kdl::vec_concat(newVertices, m_oldPolyhedron.vertexPositions())});
+    m_tool.update(mdl::Polyhedron3{
+      kdl::vec_concat(newVertices, m_oldPolyhedron.vertexPositions()),
+      mdl::ConvexHullAlgorithm::QuickHull});
   }
 };
 
@@ -225,8 +226,9 @@ public:
     const auto* face = m_oldPolyhedron.faces().front();
     const auto points = face->vertexPositions() + delta;
 
-    m_tool.update(
-      mdl::Polyhedron3{kdl::vec_concat(points, m_oldPolyhedron.vertexPositions())});
+    m_tool.update(mdl::Polyhedron3{
+      kdl::vec_concat(points, m_oldPolyhedron.vertexPositions()),
+      mdl::ConvexHullAlgorithm::QuickHull});
 
     return DragStatus::Continue;
   }
@@ -178,7 +178,7 @@ void Autosaver::autosave(Logger& logger, std::shared_ptr<MapDocument> document)
   }) | kdl::transform([&](const auto& backupFilePath) {
     m_lastSaveTime = Clock::now();
     m_lastModificationCount = document->modificationCount();
-    document->saveDocumentTo(backupFilePath);
+    document->saveBackupTo(backupFilePath);
 
     logger.info() << "Created autosave backup at " << backupFilePath;
   }) | kdl::transform_error([&](auto e) {
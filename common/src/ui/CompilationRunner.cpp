@@ -26,7 +26,6 @@
 
 #include "Exceptions.h"
 #include "io/DiskIO.h"
-#include "io/ExportOptions.h"
 #include "io/PathInfo.h"
 #include "io/PathMatcher.h"
 #include "io/PathQt.h"
@@ -44,11 +43,13 @@
 #include "kdl/range_to_vector.h"
 #include "kdl/result_fold.h"
 #include "kdl/string_utils.h"
+#include "kdl/task_manager.h"
 
 #include <fmt/format.h>
 #include <fmt/std.h>
 
 #include <ranges>
+#include <sstream>
 #include <string>
 
 namespace tb::ui
@@ -76,7 +77,14 @@ CompilationTaskRunner::CompilationTaskRunner(CompilationContext& context)
 {
 }
 
-CompilationTaskRunner::~CompilationTaskRunner() = default;
+CompilationTaskRunner::~CompilationTaskRunner()
+{
+  // the file operation posts its result to this runner
+  if (m_fileOperation.valid())
+  {
+    m_fileOperation.wait();
+  }
+}
 
 void CompilationTaskRunner::execute()
 {
@@ -101,6 +109,41 @@ Result<std::string> CompilationTaskRunner::interpolate(const std::string& spec)
   }
 }
 
+void CompilationTaskRunner::runFileOperation(
+  Result<FileOperation> fileOperation, QString failureMessage)
+{
+  std::move(fileOperation) | kdl::transform([&](auto operation) {
+    if (m_context.test())
+    {
+      emit end();
+      return;
+    }
+
+    auto& taskManager = m_context.document()->taskManager();
+    m_fileOperation = taskManager.run_task(FileOperation{
+      [this, operation = std::move(operation), failureMessage]() {
+        auto result = operation();
+        QMetaObject::invokeMethod(
+          this,
+          [this, result, failureMessage]() { fileOperationDone(result, failureMessage); },
+          Qt::QueuedConnection);
+        return result;
+      }});
+  }) | kdl::transform_error([&](auto e) {
+    fileOperationDone(Result<void>{std::move(e)}, failureMessage);
+  });
+}
+
+void CompilationTaskRunner::fileOperationDone(
+  const Result<void>& result, const QString& failureMessage)
+{
+  result | kdl::transform([&]() { emit end(); }) | kdl::transform_error([&](auto e) {
+    m_context << "#### " << failureMessage << ": " << QString::fromStdString(e.msg)
+              << "\n";
+    emit error();
+  });
+}
+
 CompilationExportMapTaskRunner::CompilationExportMapTaskRunner(
   CompilationContext& context, mdl::CompilationExportMap task)
   : CompilationTaskRunner{context}
@@ -114,25 +157,26 @@ void CompilationExportMapTaskRunner::doExecute()
 {
   emit start();
 
-  interpolate(m_task.targetSpec).and_then([&](const auto& interpolated) {
-    const auto targetPath = kdl::parse_path(interpolated);
-    m_context << "#### Exporting map file '" << io::pathAsQString(targetPath) << "'\n";
+  runFileOperation(
+    interpolate(m_task.targetSpec) | kdl::transform([&](const auto& interpolated) {
+      const auto targetPath = kdl::parse_path(interpolated);
+      m_context << "#### Exporting map file '" << io::pathAsQString(targetPath) << "'\n";
 
-    if (!m_context.test())
-    {
-      return io::Disk::createDirectory(targetPath.parent_path())
-             | kdl::and_then([&](auto) {
-                 const auto options = io::MapExportOptions{targetPath};
-                 const auto document = m_context.document();
-                 return document->exportDocumentAs(options);
-               });
-    }
-    return Result<void>{};
-  }) | kdl::transform([&]() { emit end(); })
-    | kdl::transform_error([&](auto e) {
-        m_context << "#### Export failed: " << QString::fromStdString(e.msg) << "\n";
-        emit error();
-      });
+      // the document is serialized here, only writing the file happens in the background
+      auto stream = std::ostringstream{};
+      if (!m_context.test())
+      {
+        m_context.document()->exportMapTo(stream);
+      }
+
+      return FileOperation{[targetPath, contents = std::move(stream).str()]() {
+        return io::Disk::createDirectory(targetPath.parent_path())
+               | kdl::and_then(
+                 [&](auto) { return io::Disk::writeFileIfChanged(targetPath, contents); })
+               | kdl::transform([](auto) {});
+      }};
+    }),
+    "Export failed");
 }
 
 void CompilationExportMapTaskRunner::doTerminate() {}
@@ -150,7 +194,8 @@ void CompilationCopyFilesTaskRunner::doExecute()
 {
   emit start();
 
-  interpolate(m_task.sourceSpec)
+  runFileOperation(
+    interpolate(m_task.sourceSpec)
       .join(interpolate(m_task.targetSpec))
       .and_then([&](const auto& interpolatedSource, const auto& interpolatedTarget) {
         const auto sourcePath = kdl::parse_path(interpolatedSource);
@@ -162,7 +207,7 @@ void CompilationCopyFilesTaskRunner::doExecute()
           io::makeFilenamePathMatcher(sourcePath.filename().string()));
 
         return io::Disk::find(sourceDirPath, io::TraversalMode::Flat, sourcePathMatcher)
-               | kdl::and_then([&](const auto& pathsToCopy) {
+               | kdl::transform([&](auto pathsToCopy) {
                    const auto pathStrsToCopy =
                      pathsToCopy | std::views::transform([](const auto& path) {
                        return fmt::format("{}", path);
@@ -174,26 +219,24 @@ void CompilationCopyFilesTaskRunner::doExecute()
                              << QString::fromStdString(
                                   kdl::str_join(pathStrsToCopy, ", "))
                              << "\n";
-                   if (!m_context.test())
-                   {
-                     return io::Disk::createDirectory(targetPath)
-                            | kdl::and_then([&](auto) {
-                                return pathsToCopy
-                                       | std::views::transform(
-                                         [&](const auto& pathToCopy) {
-                                           return io::Disk::copyFile(
-                                             pathToCopy, targetPath);
-                                         })
-                                       | kdl::fold;
-                              });
-                   }
-                   return Result<void>{};
+
+                   return FileOperation{
+                     [targetPath, pathsToCopy = std::move(pathsToCopy)]() {
+                       return io::Disk::createDirectory(targetPath)
+                              | kdl::and_then([&](auto) {
+                                  return pathsToCopy
+                                         | std::views::transform(
+                                           [&](const auto& pathToCopy) {
+                                             return io::Disk::copyFileIfChanged(
+                                               pathToCopy, targetPath);
+                                           })
+                                         | kdl::fold;
+                                })
+                              | kdl::transform([](auto) {});
+                     }};
                  });
-      })
-    | kdl::transform([&]() { emit end(); }) | kdl::transform_error([&](auto e) {
-        m_context << "#### Copy failed: " << QString::fromStdString(e.msg) << "\n";
-        emit error();
-      });
+      }),
+    "Copy failed");
 }
 
 void CompilationCopyFilesTaskRunner::doTerminate() {}
@@ -27,6 +27,8 @@
 #include "mdl/CompilationTask.h"
 #include "ui/CompilationContext.h"
 
+#include <functional>
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
@@ -44,8 +46,13 @@ class CompilationTaskRunner : public QObject
 {
   Q_OBJECT
 protected:
+  using FileOperation = std::function<Result<void>()>;
+
   CompilationContext& m_context;
 
+private:
+  std::future<Result<void>> m_fileOperation;
+
 protected:
   explicit CompilationTaskRunner(CompilationContext& context);
 
@@ -62,7 +69,17 @@ signals:
 protected:
   Result<std::string> interpolate(const std::string& spec) const;
 
+  /**
+   * Runs the given file operation on a worker thread and emits end() or error() on this
+   * runner's thread once it is done. The operation must not access the document because
+   * the document can change while the operation is running. In a test run, the operation
+   * is skipped.
+   */
+  void runFileOperation(Result<FileOperation> fileOperation, QString failureMessage);
+
 private:
+  void fileOperationDone(const Result<void>& result, const QString& failureMessage);
+
   virtual void doExecute() = 0;
   virtual void doTerminate() = 0;
 
@@ -674,7 +674,8 @@ void FaceAttribsEditor::updateControls()
     hideColorAttribEditor();
   }
 
-  const auto faceHandles = kdl::mem_lock(m_document)->allSelectedBrushFaces();
+  auto document = kdl::mem_lock(m_document);
+  const auto& faceHandles = document->allSelectedBrushFaces();
   if (!faceHandles.empty())
   {
     auto materialMulti = false;
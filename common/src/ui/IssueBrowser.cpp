@@ -24,6 +24,8 @@
 #include <QStringList>
 #include <QVBoxLayout>
 
+#include "mdl/BrushFaceHandle.h"
+#include "mdl/BrushNode.h"
 #include "mdl/Issue.h"
 #include "mdl/Validator.h"
 #include "mdl/WorldNode.h"
@@ -32,6 +34,7 @@
 #include "ui/MapDocument.h"
 
 #include "kdl/memory_utils.h"
+#include "kdl/vector_utils.h"
 
 #include <utility>
 
@@ -77,6 +80,8 @@ QWidget* IssueBrowser::createTabBarPage(QWidget* parent)
 void IssueBrowser::connectObservers()
 {
   auto document = kdl::mem_lock(m_document);
+  m_notifierConnection += document->documentWasClearedNotifier.connect(
+    this, &IssueBrowser::documentWasCleared);
   m_notifierConnection +=
     document->documentWasSavedNotifier.connect(this, &IssueBrowser::documentWasSaved);
   m_notifierConnection += document->documentWasNewedNotifier.connect(
@@ -93,6 +98,11 @@ void IssueBrowser::connectObservers()
     this, &IssueBrowser::brushFacesDidChange);
 }
 
+void IssueBrowser::documentWasCleared(MapDocument*)
+{
+  m_view->reload();
+}
+
 void IssueBrowser::documentWasNewedOrLoaded(MapDocument*)
 {
   updateFilterFlags();
@@ -104,24 +114,27 @@ void IssueBrowser::documentWasSaved(MapDocument*)
   m_view->update();
 }
 
-void IssueBrowser::nodesWereAdded(const std::vector<mdl::Node*>&)
+void IssueBrowser::nodesWereAdded(const std::vector<mdl::Node*>& nodes)
 {
-  m_view->reload();
+  m_view->nodesWereAdded(nodes);
 }
 
-void IssueBrowser::nodesWereRemoved(const std::vector<mdl::Node*>&)
+void IssueBrowser::nodesWereRemoved(const std::vector<mdl::Node*>& nodes)
 {
-  m_view->reload();
+  m_view->nodesWereRemoved(nodes);
 }
 
-void IssueBrowser::nodesDidChange(const std::vector<mdl::Node*>&)
+void IssueBrowser::nodesDidChange(const std::vector<mdl::Node*>& nodes)
 {
-  m_view->reload();
+  m_view->nodesDidChange(nodes);
 }
 
-void IssueBrowser::brushFacesDidChange(const std::vector<mdl::BrushFaceHandle>&)
+void IssueBrowser::brushFacesDidChange(const std::vector<mdl::BrushFaceHandle>& faces)
 {
-  m_view->reload();
+  m_view->nodesDidChange(kdl::vec_sort_and_remove_duplicates(
+    kdl::vec_transform(faces, [](const auto& handle) -> mdl::Node* {
+      return handle.node();
+    })));
 }
 
 void IssueBrowser::issueIgnoreChanged(mdl::Issue*)
@@ -65,6 +65,7 @@ public:
 
 private:
   void connectObservers();
+  void documentWasCleared(MapDocument* document);
   void documentWasNewedOrLoaded(MapDocument* document);
   void documentWasSaved(MapDocument* document);
   void nodesWereAdded(const std::vector<mdl::Node*>& nodes);
@@ -25,23 +25,17 @@
 #include <QMenu>
 #include <QTableView>
 
-#include "mdl/BrushNode.h"
-#include "mdl/EntityNode.h"
-#include "mdl/GroupNode.h"
 #include "mdl/Issue.h"
 #include "mdl/IssueQuickFix.h"
-#include "mdl/LayerNode.h"
-#include "mdl/PatchNode.h"
 #include "mdl/WorldNode.h"
 #include "ui/MapDocument.h"
-#include "ui/QtUtils.h"
 #include "ui/Transaction.h"
 
 #include "kdl/memory_utils.h"
-#include "kdl/overload.h"
 #include "kdl/vector_set.h"
 #include "kdl/vector_utils.h"
 
+#include <algorithm>
 #include <vector>
 
 namespace tb::ui
@@ -57,18 +51,18 @@ IssueBrowserView::IssueBrowserView(std::weak_ptr<MapDocument> document, QWidget*
 
 void IssueBrowserView::createGui()
 {
-  m_tableModel = new IssueBrowserModel{this};
+  m_tableModel = new IssueBrowserModel{m_issueList, this};
 
   m_tableView = new QTableView{};
   m_tableView->setModel(m_tableModel);
   m_tableView->verticalHeader()->setVisible(false);
+  // all rows have the same height, so the view doesn't need to measure every row
+  m_tableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
   m_tableView->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Fixed);
   m_tableView->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
   m_tableView->horizontalHeader()->setSectionsClickable(false);
   m_tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
 
-  autoResizeRows(m_tableView);
-
   auto* layout = new QHBoxLayout{};
   layout->setContentsMargins(0, 0, 0, 0);
   layout->addWidget(m_tableView);
@@ -105,6 +99,33 @@ void IssueBrowserView::deselectAll()
   m_tableView->clearSelection();
 }
 
+void IssueBrowserView::nodesWereAdded(const std::vector<mdl::Node*>& nodes)
+{
+  m_issueList.addNodes(nodes);
+  validateLater();
+}
+
+void IssueBrowserView::nodesWereRemoved(const std::vector<mdl::Node*>& nodes)
+{
+  m_issueList.removeNodes(nodes);
+}
+
+void IssueBrowserView::nodesDidChange(const std::vector<mdl::Node*>& nodes)
+{
+  // the world changes when entity definitions or materials are reloaded, which can
+  // change the issues of any node
+  if (std::ranges::any_of(nodes, [](const auto* node) {
+        return dynamic_cast<const mdl::WorldNode*>(node) != nullptr;
+      }))
+  {
+    invalidate();
+    return;
+  }
+
+  m_issueList.updateNodes(nodes);
+  validateLater();
+}
+
 /**
  * Updates the MapDocument selection to match the table view
  */
@@ -129,47 +150,9 @@ void IssueBrowserView::updateSelection()
 void IssueBrowserView::updateIssues()
 {
   auto document = kdl::mem_lock(m_document);
-  if (document->world() != nullptr)
+  if (auto* world = document->world())
   {
-    const auto validators = document->world()->registeredValidators();
-
-    auto issues = std::vector<const mdl::Issue*>{};
-    const auto collectIssues = [&](auto* node) {
-      for (auto* issue : node->issues(validators))
-      {
-        if (
-          m_showHiddenIssues
-          || (!issue->hidden() && (issue->type() & m_hiddenIssueTypes) == 0))
-        {
-          issues.push_back(issue);
-        }
-      }
-    };
-
-    document->world()->accept(kdl::overload(
-      [&](auto&& thisLambda, mdl::WorldNode* world) {
-        collectIssues(world);
-        world->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, mdl::LayerNode* layer) {
-        collectIssues(layer);
-        layer->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, mdl::GroupNode* group) {
-        collectIssues(group);
-        group->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, mdl::EntityNode* entity) {
-        collectIssues(entity);
-        entity->visitChildren(thisLambda);
-      },
-      [&](mdl::BrushNode* brush) { collectIssues(brush); },
-      [&](mdl::PatchNode* patch) { collectIssues(patch); }));
-
-    issues = kdl::vec_sort(std::move(issues), [](const auto* lhs, const auto* rhs) {
-      return lhs->seqId() > rhs->seqId();
-    });
-    m_tableModel->setIssues(std::move(issues));
+    m_issueList.reset(*world, m_hiddenIssueTypes, m_showHiddenIssues);
   }
 }
 
@@ -241,12 +224,16 @@ mdl::IssueType IssueBrowserView::issueTypeMask() const
 void IssueBrowserView::setIssueVisibility(const bool show)
 {
   auto document = kdl::mem_lock(m_document);
+
+  auto nodes = std::vector<mdl::Node*>{};
   for (const auto* issue : collectIssues(getSelection()))
   {
     document->setIssueHidden(*issue, !show);
+    nodes.push_back(&issue->node());
   }
 
-  invalidate();
+  m_issueList.updateNodes(kdl::vec_sort_and_remove_duplicates(std::move(nodes)));
+  validateLater();
 }
 
 QList<QModelIndex> IssueBrowserView::getSelection() const
@@ -323,8 +310,13 @@ void IssueBrowserView::hideIssues()
 void IssueBrowserView::invalidate()
 {
   m_valid = false;
-  m_tableModel->setIssues({});
+  m_issueList.clear();
+
+  validateLater();
+}
 
+void IssueBrowserView::validateLater()
+{
   QMetaObject::invokeMethod(this, "validate", Qt::QueuedConnection);
 }
 
@@ -335,30 +327,26 @@ void IssueBrowserView::validate()
     updateIssues();
     m_valid = true;
   }
+  m_issueList.update();
 }
 
 // IssueBrowserModel
 
-IssueBrowserModel::IssueBrowserModel(QObject* parent)
+IssueBrowserModel::IssueBrowserModel(mdl::IssueList& issueList, QObject* parent)
   : QAbstractTableModel{parent}
+  , m_issueList{issueList}
 {
+  connectObservers(issueList);
 }
 
-void IssueBrowserModel::setIssues(std::vector<const mdl::Issue*> issues)
-{
-  beginResetModel();
-  m_issues = std::move(issues);
-  endResetModel();
-}
-
-const std::vector<const mdl::Issue*>& IssueBrowserModel::issues()
+const std::vector<const mdl::Issue*>& IssueBrowserModel::issues() const
 {
-  return m_issues;
+  return m_issueList.issues();
 }
 
 int IssueBrowserModel::rowCount(const QModelIndex& parent) const
 {
-  return parent.isValid() ? 0 : static_cast<int>(m_issues.size());
+  return parent.isValid() ? 0 : static_cast<int>(issues().size());
 }
 
 int IssueBrowserModel::columnCount(const QModelIndex& parent) const
@@ -370,13 +358,13 @@ QVariant IssueBrowserModel::data(const QModelIndex& index, const int role) const
 {
   if (
     !index.isValid() || index.row() < 0
-    || index.row() >= static_cast<int>(m_issues.size()) || index.column() < 0
+    || index.row() >= static_cast<int>(issues().size()) || index.column() < 0
     || index.column() >= 2)
   {
     return QVariant{};
   }
 
-  const auto* issue = m_issues.at(static_cast<size_t>(index.row()));
+  const auto* issue = issues().at(static_cast<size_t>(index.row()));
 
   if (role == Qt::DisplayRole)
   {
@@ -428,4 +416,30 @@ QVariant IssueBrowserModel::headerData(
   return QVariant{};
 }
 
+void IssueBrowserModel::connectObservers(mdl::IssueList& issueList)
+{
+  m_notifierConnection += issueList.rowsWillBeInsertedNotifier.connect(
+    this, &IssueBrowserModel::rowsWillBeInserted);
+  m_notifierConnection +=
+    issueList.rowsWereInsertedNotifier.connect([&]() { endInsertRows(); });
+  m_notifierConnection += issueList.rowsWillBeRemovedNotifier.connect(
+    this, &IssueBrowserModel::rowsWillBeRemoved);
+  m_notifierConnection +=
+    issueList.rowsWereRemovedNotifier.connect([&]() { endRemoveRows(); });
+  m_notifierConnection +=
+    issueList.listWillBeResetNotifier.connect([&]() { beginResetModel(); });
+  m_notifierConnection +=
+    issueList.listWasResetNotifier.connect([&]() { endResetModel(); });
+}
+
+void IssueBrowserModel::rowsWillBeInserted(const size_t first, const size_t last)
+{
+  beginInsertRows(QModelIndex{}, static_cast<int>(first), static_cast<int>(last));
+}
+
+void IssueBrowserModel::rowsWillBeRemoved(const size_t first, const size_t last)
+{
+  beginRemoveRows(QModelIndex{}, static_cast<int>(first), static_cast<int>(last));
+}
+
 } // namespace tb::ui
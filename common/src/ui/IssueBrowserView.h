@@ -22,6 +22,8 @@
 #include <QAbstractItemModel>
 #include <QWidget>
 
+#include "NotifierConnection.h"
+#include "mdl/IssueList.h"
 #include "mdl/IssueType.h"
 
 #include <memory>
@@ -36,6 +38,7 @@ namespace mdl
 {
 class Issue;
 class IssueQuickFix;
+class Node;
 } // namespace mdl
 
 namespace ui
@@ -53,6 +56,7 @@ private:
   bool m_showHiddenIssues = false;
 
   bool m_valid = false;
+  mdl::IssueList m_issueList;
 
   QTableView* m_tableView = nullptr;
   IssueBrowserModel* m_tableModel = nullptr;
@@ -71,6 +75,10 @@ public:
   void reload();
   void deselectAll();
 
+  void nodesWereAdded(const std::vector<mdl::Node*>& nodes);
+  void nodesWereRemoved(const std::vector<mdl::Node*>& nodes);
+  void nodesDidChange(const std::vector<mdl::Node*>& nodes);
+
 private:
   void updateIssues();
 
@@ -93,31 +101,37 @@ private:
 
 private:
   void invalidate();
+  void validateLater();
 public slots:
   void validate();
 };
 
 /**
- * Trivial QAbstractTableModel subclass, when the issues list changes,
- * it just refreshes the entire list with beginResetModel()/endResetModel().
+ * Table model backed by an issue list. The list's change notifications are forwarded to
+ * the view so that only the inserted or removed rows are updated.
  */
 class IssueBrowserModel : public QAbstractTableModel
 {
   Q_OBJECT
 private:
-  std::vector<const mdl::Issue*> m_issues;
+  const mdl::IssueList& m_issueList;
+  NotifierConnection m_notifierConnection;
 
 public:
-  explicit IssueBrowserModel(QObject* parent);
+  IssueBrowserModel(mdl::IssueList& issueList, QObject* parent);
 
-  void setIssues(std::vector<const mdl::Issue*> issues);
-  const std::vector<const mdl::Issue*>& issues();
+  const std::vector<const mdl::Issue*>& issues() const;
 
 public: // QAbstractTableModel overrides
   int rowCount(const QModelIndex& parent) const override;
   int columnCount(const QModelIndex& parent) const override;
   QVariant data(const QModelIndex& index, int role) const override;
   QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
+
+private:
+  void connectObservers(mdl::IssueList& issueList);
+  void rowsWillBeInserted(size_t first, size_t last);
+  void rowsWillBeRemoved(size_t first, size_t last);
 };
 } // namespace ui
 } // namespace tb
@@ -258,27 +258,9 @@ void LayerEditor::onRemoveLayer()
   ensure(layer != nullptr, "layer is null");
 
   auto document = kdl::mem_lock(m_document);
-  auto* defaultLayer = document->world()->defaultLayer();
-
-  auto transaction = Transaction{document, "Remove Layer " + layer->name()};
-  document->deselectAll();
-  if (layer->hasChildren())
-  {
-    if (!document->reparentNodes({{defaultLayer, layer->children()}}))
-    {
-      transaction.cancel();
-      return;
-    }
-  }
-
-  if (document->currentLayer() == layer)
-  {
-    document->setCurrentLayer(defaultLayer);
-  }
 
   m_layerList->updateSelectionForRemoval();
-  document->removeNodes({layer});
-  transaction.commit();
+  document->removeLayer(layer);
 
   updateButtons();
 }
@@ -121,9 +121,11 @@ void LayerListBoxWidget::updateLayerItem()
     makeUnemphasized(m_nameText);
   }
 
-  const auto info = tr("%1 %2")
-                      .arg(m_layer->childCount())
-                      .arg(m_layer->childCount() == 1 ? "object" : "objects");
+  const auto& deferredContents = m_layer->deferredContents();
+  const auto objectCount =
+    m_layer->childCount() + (deferredContents ? deferredContents->objectCount : 0u);
+  const auto info =
+    tr("%1 %2").arg(objectCount).arg(objectCount == 1 ? "object" : "objects");
   m_infoText->setText(info);
 
   // Update buttons
@@ -54,9 +54,11 @@
 #include "mdl/EntityDefinitionFileSpec.h"
 #include "mdl/EntityDefinitionGroup.h"
 #include "mdl/EntityDefinitionManager.h"
+#include "mdl/EntityModelIndex.h"
 #include "mdl/EntityModelManager.h"
 #include "mdl/EntityNode.h"
 #include "mdl/EntityProperties.h"
+#include "mdl/FilePositionIndex.h"
 #include "mdl/Game.h"
 #include "mdl/GameFactory.h"
 #include "mdl/GroupNode.h"
@@ -69,6 +71,7 @@
 #include "mdl/LongPropertyKeyValidator.h"
 #include "mdl/LongPropertyValueValidator.h"
 #include "mdl/Material.h"
+#include "mdl/MaterialIndex.h"
 #include "mdl/MaterialManager.h"
 #include "mdl/MissingClassnameValidator.h"
 #include "mdl/MissingDefinitionValidator.h"
@@ -138,12 +141,15 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <functional>
 #include <map>
 #include <ranges>
 #include <sstream>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 
@@ -555,6 +561,52 @@ mdl::MaterialManager& MapDocument::materialManager()
   return *m_materialManager;
 }
 
+size_t MapDocument::materialUsageCount(const mdl::Material& material) const
+{
+  if (!m_world)
+  {
+    return 0u;
+  }
+
+  auto result = m_world->materialIndex().usageCount(&material);
+  for (const auto* layerNode : m_world->customLayers())
+  {
+    if (const auto& deferredContents = layerNode->deferredContents())
+    {
+      const auto& counts = deferredContents->materialUsageCounts;
+      if (const auto it = counts.find(kdl::str_to_lower(material.name()));
+          it != counts.end())
+      {
+        result += it->second;
+      }
+    }
+  }
+  return result;
+}
+
+std::vector<mdl::BrushFaceHandle> MapDocument::allBrushFacesWithMaterial(
+  const mdl::Material& material)
+{
+  if (!m_world)
+  {
+    return {};
+  }
+
+  const auto materialName = kdl::str_to_lower(material.name());
+  auto layersToCreate = std::vector<mdl::Node*>{};
+  for (auto* layerNode : m_world->customLayers())
+  {
+    if (const auto& deferredContents = layerNode->deferredContents();
+        deferredContents && deferredContents->materialUsageCounts.contains(materialName))
+    {
+      layersToCreate.push_back(layerNode);
+    }
+  }
+  createDeferredLayerContents(layersToCreate);
+
+  return m_world->materialIndex().findBrushFaces(&material);
+}
+
 Grid& MapDocument::grid() const
 {
   return *m_grid;
@@ -623,12 +675,14 @@ Result<std::unique_ptr<mdl::WorldNode>> loadMap(
                possibleFormats,
                worldBounds,
                entityPropertyConfig,
+               true,
                parserStatus,
                taskManager);
            }
 
            auto worldReader =
              io::WorldReader{fileReader.stringView(), mapFormat, entityPropertyConfig};
+           worldReader.setDeferHiddenLayers(true);
            return worldReader.read(worldBounds, parserStatus, taskManager);
          });
 }
@@ -688,6 +742,15 @@ Result<std::unique_ptr<mdl::WorldNode>> newMap(
   return worldNode;
 }
 
+std::vector<mdl::Node*> collectExportedLayers(mdl::WorldNode& world)
+{
+  return world.allLayers()
+         | std::views::filter(
+           [](const auto* layerNode) { return !layerNode->layer().omitFromExport(); })
+         | std::views::transform([](auto* layerNode) -> mdl::Node* { return layerNode; })
+         | kdl::to_vector;
+}
+
 void setWorldDefaultProperties(
   mdl::WorldNode& world, mdl::EntityDefinitionManager& entityDefinitionManager)
 {
@@ -750,15 +813,53 @@ void MapDocument::saveDocumentAs(const std::filesystem::path& path)
 
 void MapDocument::saveDocumentTo(const std::filesystem::path& path)
 {
-  ensure(m_game.get() != nullptr, "game is null");
   ensure(m_world, "world is null");
 
+  createDeferredLayerContents(kdl::vec_static_cast<mdl::Node*>(m_world->allLayers()));
+  writeDocumentTo(path, {});
+}
+
+void MapDocument::saveBackupTo(const std::filesystem::path& path)
+{
+  ensure(m_world, "world is null");
+
+  // the deferred contents are created again for every backup, so their errors are not
+  // logged here
+  auto nullLogger = NullLogger{};
+  auto deferredNodes = std::vector<std::unique_ptr<mdl::Node>>{};
+  auto additionalLayerNodes = io::NodeWriter::LayerNodesMap{};
+  for (const auto* layerNode : m_world->customLayers())
+  {
+    if (const auto& deferredContents = layerNode->deferredContents())
+    {
+      auto& layerNodes = additionalLayerNodes[layerNode];
+      for (auto& node : deferredContents->createNodes(nullLogger, m_taskManager))
+      {
+        layerNodes.push_back(node.get());
+        deferredNodes.push_back(std::move(node));
+      }
+    }
+  }
+
+  writeDocumentTo(path, std::move(additionalLayerNodes));
+}
+
+void MapDocument::writeDocumentTo(
+  const std::filesystem::path& path,
+  io::NodeWriter::LayerNodesMap additionalLayerNodes)
+{
+  ensure(m_game.get() != nullptr, "game is null");
+
   io::Disk::withOutputStream(path, [&](auto& stream) {
     io::writeMapHeader(stream, m_game->config().name, m_world->mapFormat());
 
     auto writer = io::NodeWriter{*m_world, stream};
     writer.setExporting(false);
+    writer.setAdditionalLayerNodes(std::move(additionalLayerNodes));
     writer.writeMap(m_taskManager);
+
+    // the nodes' file positions now refer to the saved file
+    m_world->invalidateFilePositionIndex();
   }) | kdl::transform_error([&](const auto& e) {
     error() << "Could not save document: " << e.msg;
   });
@@ -770,6 +871,8 @@ Result<void> MapDocument::exportDocumentAs(const io::ExportOptions& options)
     kdl::overload(
       [&](const io::ObjExportOptions& objOptions) {
         return io::Disk::withOutputStream(objOptions.exportPath, [&](auto& objStream) {
+          createDeferredLayerContents(collectExportedLayers(*m_world));
+
           const auto mtlPath = kdl::path_replace_extension(objOptions.exportPath, ".mtl");
           return io::Disk::withOutputStream(mtlPath, [&](auto& mtlStream) {
             auto writer = io::NodeWriter{
@@ -782,15 +885,22 @@ Result<void> MapDocument::exportDocumentAs(const io::ExportOptions& options)
         });
       },
       [&](const io::MapExportOptions& mapOptions) {
-        return io::Disk::withOutputStream(mapOptions.exportPath, [&](auto& stream) {
-          auto writer = io::NodeWriter{*m_world, stream};
-          writer.setExporting(true);
-          writer.writeMap(m_taskManager);
-        });
+        return io::Disk::withOutputStream(
+          mapOptions.exportPath, [&](auto& stream) { exportMapTo(stream); });
       }),
     options);
 }
 
+void MapDocument::exportMapTo(std::ostream& stream)
+{
+  createDeferredLayerContents(collectExportedLayers(*m_world));
+
+  auto writer = io::NodeWriter{*m_world, stream};
+  writer.setExporting(true);
+  writer.writeMap(m_taskManager);
+  m_world->invalidateFilePositionIndex();
+}
+
 void MapDocument::doSaveDocument(const std::filesystem::path& path)
 {
   saveDocumentTo(path);
@@ -829,6 +939,9 @@ std::string MapDocument::serializeSelectedNodes()
   std::stringstream stream;
   auto writer = io::NodeWriter{*m_world, stream};
   writer.writeNodes(selectedNodes().nodes(), m_taskManager);
+
+  // the nodes' file positions now refer to the serialized string
+  m_world->invalidateFilePositionIndex();
   return stream.str();
 }
 
@@ -1334,19 +1447,23 @@ const mdl::NodeCollection& MapDocument::selectedNodes() const
   return m_selectedNodes;
 }
 
-std::vector<mdl::BrushFaceHandle> MapDocument::allSelectedBrushFaces() const
+const std::vector<mdl::BrushFaceHandle>& MapDocument::allSelectedBrushFaces() const
 {
   if (hasSelectedBrushFaces())
   {
     return selectedBrushFaces();
   }
 
-  const auto faces = mdl::collectBrushFaces(m_selectedNodes.nodes());
-  return mdl::faceSelectionWithLinkedGroupConstraints(*m_world.get(), faces)
-    .facesToSelect;
+  if (!m_allSelectedBrushFaces)
+  {
+    const auto faces = mdl::collectBrushFaces(m_selectedNodes.nodes());
+    m_allSelectedBrushFaces =
+      mdl::faceSelectionWithLinkedGroupConstraints(*m_world.get(), faces).facesToSelect;
+  }
+  return *m_allSelectedBrushFaces;
 }
 
-std::vector<mdl::BrushFaceHandle> MapDocument::selectedBrushFaces() const
+const std::vector<mdl::BrushFaceHandle>& MapDocument::selectedBrushFaces() const
 {
   return m_selectedBrushFaces;
 }
@@ -1512,66 +1629,81 @@ void MapDocument::selectInverse()
 
 void MapDocument::selectNodesWithFilePosition(const std::vector<size_t>& positions)
 {
-  auto nodesToSelect = std::vector<mdl::Node*>{};
-  const auto hasFilePosition = [&](const auto* node) {
-    return std::any_of(positions.begin(), positions.end(), [&](const auto position) {
-      return node->containsLine(position);
-    });
+  const auto candidates = m_world->filePositionIndex().findNodes(positions);
+  const auto candidateSet =
+    std::unordered_set<const mdl::Node*>{candidates.begin(), candidates.end()};
+
+  const auto isSelectableCandidate = [&](const auto* node) {
+    return candidateSet.contains(node) && m_editorContext->selectable(node);
   };
 
-  m_world->accept(kdl::overload(
-    [&](auto&& thisLambda, mdl::WorldNode* worldNode) {
-      worldNode->visitChildren(thisLambda);
-    },
-    [&](auto&& thisLambda, mdl::LayerNode* layerNode) {
-      layerNode->visitChildren(thisLambda);
-    },
-    [&](auto&& thisLambda, mdl::GroupNode* groupNode) {
-      if (hasFilePosition(groupNode))
+  // a group or an entity is only searched if it contains a position, but cannot be
+  // selected itself
+  const auto isSearched = [&](const mdl::Node* node) {
+    for (const auto* parent = node->parent(); parent; parent = parent->parent())
+    {
+      const auto searchParent = parent->accept(kdl::overload(
+        [](const mdl::WorldNode*) { return true; },
+        [](const mdl::LayerNode*) { return true; },
+        [&](const mdl::GroupNode* groupNode) {
+          return candidateSet.contains(groupNode)
+                 && !m_editorContext->selectable(groupNode);
+        },
+        [&](const mdl::EntityNode* entityNode) {
+          return candidateSet.contains(entityNode)
+                 && !m_editorContext->selectable(entityNode);
+        },
+        [](const mdl::BrushNode*) { return false; },
+        [](const mdl::PatchNode*) { return false; }));
+      if (!searchParent)
       {
-        if (m_editorContext->selectable(groupNode))
-        {
-          nodesToSelect.push_back(groupNode);
-        }
-        else
-        {
-          groupNode->visitChildren(thisLambda);
-        }
+        return false;
       }
-    },
-    [&](auto&& thisLambda, mdl::EntityNode* entityNode) {
-      if (hasFilePosition(entityNode))
-      {
-        if (m_editorContext->selectable(entityNode))
-        {
-          nodesToSelect.push_back(entityNode);
-        }
-        else
-        {
-          const auto previousCount = nodesToSelect.size();
-          entityNode->visitChildren(thisLambda);
-          if (previousCount == nodesToSelect.size())
+    }
+    return true;
+  };
+
+  auto nodesToSelect = std::vector<mdl::Node*>{};
+  for (auto* candidate : candidates)
+  {
+    if (isSearched(candidate))
+    {
+      candidate->accept(kdl::overload(
+        [](mdl::WorldNode*) {},
+        [](mdl::LayerNode*) {},
+        [&](mdl::GroupNode* groupNode) {
+          if (m_editorContext->selectable(groupNode))
+          {
+            nodesToSelect.push_back(groupNode);
+          }
+        },
+        [&](mdl::EntityNode* entityNode) {
+          if (m_editorContext->selectable(entityNode))
+          {
+            nodesToSelect.push_back(entityNode);
+          }
+          else if (!std::ranges::any_of(entityNode->children(), isSelectableCandidate))
           {
             // no child was selected, select all children
             nodesToSelect = kdl::vec_concat(
               std::move(nodesToSelect),
               mdl::collectSelectableNodes(entityNode->children(), *m_editorContext));
           }
-        }
-      }
-    },
-    [&](mdl::BrushNode* brushNode) {
-      if (hasFilePosition(brushNode) && m_editorContext->selectable(brushNode))
-      {
-        nodesToSelect.push_back(brushNode);
-      }
-    },
-    [&](mdl::PatchNode* patchNode) {
-      if (hasFilePosition(patchNode) && m_editorContext->selectable(patchNode))
-      {
-        nodesToSelect.push_back(patchNode);
-      }
-    }));
+        },
+        [&](mdl::BrushNode* brushNode) {
+          if (m_editorContext->selectable(brushNode))
+          {
+            nodesToSelect.push_back(brushNode);
+          }
+        },
+        [&](mdl::PatchNode* patchNode) {
+          if (m_editorContext->selectable(patchNode))
+          {
+            nodesToSelect.push_back(patchNode);
+          }
+        }));
+    }
+  }
 
   auto transaction = Transaction{*this, "Select by Line Number"};
   deselectAll();
@@ -1604,9 +1736,9 @@ void MapDocument::convertToFaceSelection()
 void MapDocument::selectFacesWithMaterial(const mdl::Material* material)
 {
   const auto faces = kdl::vec_filter(
-    mdl::collectSelectableBrushFaces(
-      std::vector<mdl::Node*>{m_world.get()}, *m_editorContext),
-    [&](const auto& faceHandle) { return faceHandle.face().material() == material; });
+    m_world->materialIndex().findBrushFaces(material), [&](const auto& faceHandle) {
+      return m_editorContext->selectable(faceHandle.node(), faceHandle.face());
+    });
 
   auto transaction = Transaction{*this, "Select Faces with Material"};
   deselectAll();
@@ -1616,15 +1748,25 @@ void MapDocument::selectFacesWithMaterial(const mdl::Material* material)
 
 void MapDocument::selectBrushesWithMaterial(const mdl::Material* material)
 {
+  // the brushes with a selectable face with the material and all of their ancestors
+  auto nodesWithMaterial = std::unordered_set<const mdl::Node*>{};
+  for (const auto& faceHandle : m_world->materialIndex().findBrushFaces(material))
+  {
+    if (m_editorContext->selectable(faceHandle.node(), faceHandle.face()))
+    {
+      const auto* node = static_cast<const mdl::Node*>(faceHandle.node());
+      while (node && nodesWithMaterial.insert(node).second)
+      {
+        node = node->parent();
+      }
+    }
+  }
+
   const auto selectableNodes =
     mdl::collectSelectableNodes(std::vector<mdl::Node*>{m_world.get()}, *m_editorContext);
-  const auto brushes =
-    selectableNodes | std::views::filter([&](const auto& node) {
-      return std::ranges::any_of(
-        mdl::collectSelectableBrushFaces({node}, *m_editorContext),
-        [&](const auto& faceHandle) { return faceHandle.face().material() == material; });
-    })
-    | kdl::to_vector;
+  const auto brushes = kdl::vec_filter(selectableNodes, [&](const auto* node) {
+    return nodesWithMaterial.contains(node);
+  });
 
   auto transaction = Transaction{*this, "Select Brushes with Material"};
   deselectAll();
@@ -1718,9 +1860,10 @@ void MapDocument::updateLastSelectionBounds()
   }
 }
 
-void MapDocument::invalidateSelectionBounds()
+void MapDocument::invalidateSelectionCaches()
 {
   m_selectionBoundsValid = false;
+  m_allSelectedBrushFaces = std::nullopt;
 }
 
 void MapDocument::validateSelectionBounds() const
@@ -1733,6 +1876,7 @@ void MapDocument::clearSelection()
 {
   m_selectedNodes.clear();
   m_selectedBrushFaces.clear();
+  m_allSelectedBrushFaces = std::nullopt;
 }
 
 /**
@@ -2680,6 +2824,33 @@ void MapDocument::renameLayer(mdl::LayerNode* layerNode, const std::string& name
       [](mdl::BezierPatch&) { return true; }));
 }
 
+void MapDocument::removeLayer(mdl::LayerNode* layerNode)
+{
+  auto* defaultLayerNode = m_world->defaultLayer();
+  ensure(layerNode != defaultLayerNode, "cannot remove the default layer");
+
+  auto transaction = Transaction{*this, "Remove Layer " + layerNode->name()};
+  deselectAll();
+
+  createDeferredLayerContents({layerNode});
+  if (layerNode->hasChildren())
+  {
+    if (!reparentNodes({{defaultLayerNode, layerNode->children()}}))
+    {
+      transaction.cancel();
+      return;
+    }
+  }
+
+  if (currentLayer() == layerNode)
+  {
+    setCurrentLayer(defaultLayerNode);
+  }
+
+  removeNodes({layerNode});
+  transaction.commit();
+}
+
 bool MapDocument::moveLayerByOne(mdl::LayerNode* layerNode, MoveDirection direction)
 {
   const std::vector<mdl::LayerNode*> sorted = m_world->customLayersUserSorted();
@@ -2926,6 +3097,8 @@ void MapDocument::setOmitLayerFromExport(
 
 void MapDocument::selectAllInLayers(const std::vector<mdl::LayerNode*>& layers)
 {
+  createDeferredLayerContents(kdl::vec_static_cast<mdl::Node*>(layers));
+
   const auto nodes = mdl::collectSelectableNodes(
     kdl::vec_static_cast<mdl::Node*>(layers), editorContext());
 
@@ -2939,6 +3112,47 @@ bool MapDocument::canSelectAllInLayers(
   return editorContext().canChangeSelection();
 }
 
+void MapDocument::createDeferredLayerContents(const std::vector<mdl::Node*>& nodes)
+{
+  auto nodesToAdd = std::map<mdl::Node*, std::vector<mdl::Node*>>{};
+  for (auto* node : nodes)
+  {
+    if (auto* layerNode = dynamic_cast<mdl::LayerNode*>(node))
+    {
+      if (auto deferredContents = layerNode->takeDeferredContents())
+      {
+        auto& children = nodesToAdd[layerNode];
+        for (auto& childNode : deferredContents->createNodes(logger(), m_taskManager))
+        {
+          children.push_back(childNode.release());
+        }
+      }
+    }
+  }
+
+  if (nodesToAdd.empty())
+  {
+    return;
+  }
+
+  const auto parents = mdl::collectNodesAndAncestors(kdl::map_keys(nodesToAdd));
+  auto notifyParents = NotifyNodesWillAndDidChange{*this, parents};
+
+  auto addedNodes = std::vector<mdl::Node*>{};
+  for (const auto& [parent, children] : nodesToAdd)
+  {
+    parent->addChildren(children);
+    addedNodes = kdl::vec_concat(std::move(addedNodes), children);
+  }
+
+  setEntityDefinitions(addedNodes);
+  setEntityModels(addedNodes);
+  setMaterials(addedNodes);
+  invalidateSelectionCaches();
+
+  nodesWereAddedNotifier(addedNodes);
+}
+
 void MapDocument::hide(const std::vector<mdl::Node*> nodes)
 {
   auto transaction = Transaction{*this, "Hide Objects"};
@@ -3300,7 +3514,8 @@ bool MapDocument::csgConvexMerge()
     }
   }
 
-  auto polyhedron = mdl::Polyhedron3{std::move(points)};
+  auto polyhedron =
+    mdl::Polyhedron3{std::move(points), mdl::ConvexHullAlgorithm::QuickHull};
   if (!polyhedron.polyhedron() || !polyhedron.closed())
   {
     return false;
@@ -4404,7 +4619,9 @@ const std::string& MapDocument::redoCommandName() const
 
 void MapDocument::undoCommand()
 {
+  beginCoalescingChangeNotifications();
   doUndoCommand();
+  endCoalescingChangeNotifications();
   updateLinkedGroups();
 
   // Undo/redo in the repeat system is not supported for now, so just clear the repeat
@@ -4414,7 +4631,9 @@ void MapDocument::undoCommand()
 
 void MapDocument::redoCommand()
 {
+  beginCoalescingChangeNotifications();
   doRedoCommand();
+  endCoalescingChangeNotifications();
   updateLinkedGroups();
 
   // Undo/redo in the repeat system is not supported for now, so just clear the repeat
@@ -4440,6 +4659,7 @@ void MapDocument::clearRepeatableCommands()
 void MapDocument::startTransaction(std::string name, const TransactionScope scope)
 {
   debug("Starting transaction '" + name + "'");
+  beginCoalescingChangeNotifications();
   doStartTransaction(std::move(name), scope);
   m_repeatStack->startTransaction();
 }
@@ -4463,6 +4683,7 @@ bool MapDocument::commitTransaction()
 
   doCommitTransaction();
   m_repeatStack->commitTransaction();
+  endCoalescingChangeNotifications();
   return true;
 }
 
@@ -4473,6 +4694,124 @@ void MapDocument::cancelTransaction()
   m_repeatStack->rollbackTransaction();
   doCommitTransaction();
   m_repeatStack->commitTransaction();
+  endCoalescingChangeNotifications();
+}
+
+MapDocument::NotifyNodesWillAndDidChange::NotifyNodesWillAndDidChange(
+  MapDocument& document, std::vector<mdl::Node*> nodes)
+  : m_document{document}
+  , m_nodes{std::move(nodes)}
+{
+  m_document.notifyNodesWillChange(m_nodes);
+}
+
+MapDocument::NotifyNodesWillAndDidChange::~NotifyNodesWillAndDidChange()
+{
+  m_document.notifyNodesDidChange(m_nodes);
+}
+
+void MapDocument::setCoalesceChangeNotifications(const bool coalesceChangeNotifications)
+{
+  m_coalesceChangeNotifications = coalesceChangeNotifications;
+  if (!m_coalesceChangeNotifications)
+  {
+    flushAllChangeNotifications();
+  }
+}
+
+bool MapDocument::coalesceChangeNotifications() const
+{
+  return m_coalesceChangeNotifications;
+}
+
+void MapDocument::notifyNodesWillChange(const std::vector<mdl::Node*>& nodes)
+{
+  if (!isCoalescingChangeNotifications())
+  {
+    nodesWillChangeNotifier(nodes);
+    return;
+  }
+
+  // only notify about nodes which have not changed yet since coalescing began
+  auto newlyChangedNodes = std::vector<mdl::Node*>{};
+  for (auto* node : nodes)
+  {
+    if (m_pendingChangedNodeSet.insert(node).second)
+    {
+      m_pendingChangedNodes.push_back(node);
+      newlyChangedNodes.push_back(node);
+    }
+  }
+
+  if (!newlyChangedNodes.empty())
+  {
+    nodesWillChangeNotifier(newlyChangedNodes);
+  }
+}
+
+void MapDocument::notifyNodesDidChange(const std::vector<mdl::Node*>& nodes)
+{
+  if (!isCoalescingChangeNotifications())
+  {
+    nodesDidChangeNotifier(nodes);
+  }
+  // otherwise, the nodes were already recorded by notifyNodesWillChange
+}
+
+void MapDocument::flushChangeNotifications(const std::vector<mdl::Node*>& nodes)
+{
+  if (m_pendingChangedNodes.empty())
+  {
+    return;
+  }
+
+  const auto affectedNodes = kdl::vector_set{mdl::collectNodesAndDescendants(nodes)};
+
+  auto flushedNodes = std::vector<mdl::Node*>{};
+  std::erase_if(m_pendingChangedNodes, [&](auto* node) {
+    if (affectedNodes.count(node) != 0u)
+    {
+      m_pendingChangedNodeSet.erase(node);
+      flushedNodes.push_back(node);
+      return true;
+    }
+    return false;
+  });
+
+  if (!flushedNodes.empty())
+  {
+    nodesDidChangeNotifier(flushedNodes);
+  }
+}
+
+bool MapDocument::isCoalescingChangeNotifications() const
+{
+  return m_coalesceChangeNotifications && m_changeNotificationCoalescingDepth > 0;
+}
+
+void MapDocument::beginCoalescingChangeNotifications()
+{
+  ++m_changeNotificationCoalescingDepth;
+}
+
+void MapDocument::endCoalescingChangeNotifications()
+{
+  assert(m_changeNotificationCoalescingDepth > 0);
+  if (--m_changeNotificationCoalescingDepth == 0)
+  {
+    flushAllChangeNotifications();
+  }
+}
+
+void MapDocument::flushAllChangeNotifications()
+{
+  auto changedNodes = std::exchange(m_pendingChangedNodes, {});
+  m_pendingChangedNodeSet.clear();
+
+  if (!changedNodes.empty())
+  {
+    nodesDidChangeNotifier(changedNodes);
+  }
 }
 
 std::unique_ptr<CommandResult> MapDocument::execute(std::unique_ptr<Command>&& command)
@@ -4605,9 +4944,8 @@ void MapDocument::setEntityDefinitions(std::vector<mdl::EntityDefinition> defini
 
 void MapDocument::reloadMaterialCollections()
 {
-  const auto nodes = std::vector<mdl::Node*>{m_world.get()};
-  NotifyBeforeAndAfter notifyNodes(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+  const auto notifyNodes =
+    NotifyNodesWillAndDidChange{*this, std::vector<mdl::Node*>{m_world.get()}};
   NotifyBeforeAndAfter notifyMaterialCollections(
     materialCollectionsWillChangeNotifier, materialCollectionsDidChangeNotifier);
 
@@ -4618,9 +4956,8 @@ void MapDocument::reloadMaterialCollections()
 
 void MapDocument::reloadEntityDefinitions()
 {
-  const auto nodes = std::vector<mdl::Node*>{m_world.get()};
-  NotifyBeforeAndAfter notifyNodes(
-    nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+  const auto notifyNodes =
+    NotifyNodesWillAndDidChange{*this, std::vector<mdl::Node*>{m_world.get()}};
   NotifyBeforeAndAfter notifyEntityDefinitions(
     entityDefinitionsWillChangeNotifier, entityDefinitionsDidChangeNotifier);
 
@@ -4816,13 +5153,13 @@ static auto makeUnsetMaterialsVisitor()
 void MapDocument::setMaterials()
 {
   m_world->accept(makeSetMaterialsVisitor(*m_materialManager));
-  materialUsageCountsDidChangeNotifier();
+  materialUsageCountsDidChange();
 }
 
 void MapDocument::setMaterials(const std::vector<mdl::Node*>& nodes)
 {
   mdl::Node::visitAll(nodes, makeSetMaterialsVisitor(*m_materialManager));
-  materialUsageCountsDidChangeNotifier();
+  materialUsageCountsDidChange();
 }
 
 void MapDocument::setMaterials(const std::vector<mdl::BrushFaceHandle>& faceHandles)
@@ -4834,18 +5171,23 @@ void MapDocument::setMaterials(const std::vector<mdl::BrushFaceHandle>& faceHand
     auto* material = m_materialManager->material(face.attributes().materialName());
     node->setFaceMaterial(faceHandle.faceIndex(), material);
   }
-  materialUsageCountsDidChangeNotifier();
+  materialUsageCountsDidChange();
 }
 
 void MapDocument::unsetMaterials()
 {
   m_world->accept(makeUnsetMaterialsVisitor());
-  materialUsageCountsDidChangeNotifier();
+  materialUsageCountsDidChange();
 }
 
 void MapDocument::unsetMaterials(const std::vector<mdl::Node*>& nodes)
 {
   mdl::Node::visitAll(nodes, makeUnsetMaterialsVisitor());
+  materialUsageCountsDidChange();
+}
+
+void MapDocument::materialUsageCountsDidChange()
+{
   materialUsageCountsDidChangeNotifier();
 }
 
@@ -4918,13 +5260,21 @@ void MapDocument::clearEntityModels()
   m_entityModelManager->clear();
 }
 
-static auto makeSetEntityModelsVisitor(mdl::EntityModelManager& manager, Logger& logger)
+static auto makeSetEntityModelsVisitor(
+  mdl::EntityModelManager& manager,
+  Logger& logger,
+  const std::function<bool(const mdl::EntityNode*)>& filter)
 {
   return kdl::overload(
     [](auto&& thisLambda, mdl::WorldNode* world) { world->visitChildren(thisLambda); },
     [](auto&& thisLambda, mdl::LayerNode* layer) { layer->visitChildren(thisLambda); },
     [](auto&& thisLambda, mdl::GroupNode* group) { group->visitChildren(thisLambda); },
     [&](mdl::EntityNode* entityNode) {
+      if (!filter(entityNode))
+      {
+        return;
+      }
+
       const auto modelSpec =
         mdl::safeGetModelSpecification(logger, entityNode->entity().classname(), [&]() {
           return entityNode->entity().modelSpecification();
@@ -4949,12 +5299,28 @@ static auto makeUnsetEntityModelsVisitor()
 
 void MapDocument::setEntityModels()
 {
-  m_world->accept(makeSetEntityModelsVisitor(*m_entityModelManager, *this));
+  // Models are loaded in the order in which they are requested, so the models of visible
+  // entities are requested first.
+  const auto isVisible = [&](const mdl::EntityNode* entityNode) {
+    return m_editorContext->visible(entityNode);
+  };
+
+  m_world->accept(makeSetEntityModelsVisitor(*m_entityModelManager, *this, isVisible));
+  m_world->accept(
+    makeSetEntityModelsVisitor(*m_entityModelManager, *this, std::not_fn(isVisible)));
 }
 
 void MapDocument::setEntityModels(const std::vector<mdl::Node*>& nodes)
 {
-  mdl::Node::visitAll(nodes, makeSetEntityModelsVisitor(*m_entityModelManager, *this));
+  const auto isVisible = [&](const mdl::EntityNode* entityNode) {
+    return m_editorContext->visible(entityNode);
+  };
+
+  mdl::Node::visitAll(
+    nodes, makeSetEntityModelsVisitor(*m_entityModelManager, *this, isVisible));
+  mdl::Node::visitAll(
+    nodes,
+    makeSetEntityModelsVisitor(*m_entityModelManager, *this, std::not_fn(isVisible)));
 }
 
 void MapDocument::unsetEntityModels()
@@ -4967,6 +5333,43 @@ void MapDocument::unsetEntityModels(const std::vector<mdl::Node*>& nodes)
   mdl::Node::visitAll(nodes, makeUnsetEntityModelsVisitor());
 }
 
+void MapDocument::updateEntityModelsAfterResourcesWereProcessed(
+  const std::vector<mdl::ResourceId>& resourceIds)
+{
+  // Entities use placeholder bounds until their model data is loaded, so their bounds
+  // must be updated once the model resources have been processed.
+
+  const auto entityModels =
+    m_entityModelManager->findEntityModelsByTextureResourceId(resourceIds);
+  if (entityModels.empty())
+  {
+    return;
+  }
+
+  const auto entityNodes = m_world->entityModelIndex().findEntityNodes(entityModels);
+  if (entityNodes.empty())
+  {
+    return;
+  }
+
+  const auto nodes = kdl::vec_static_cast<mdl::Node*>(entityNodes);
+  const auto parents = mdl::collectAncestors(nodes);
+
+  auto notifyNodes = NotifyNodesWillAndDidChange{*this, nodes};
+  auto notifyParents = NotifyNodesWillAndDidChange{*this, parents};
+
+  for (auto* node : nodes)
+  {
+    node->accept(kdl::overload(
+      [](mdl::WorldNode*) {},
+      [](mdl::LayerNode*) {},
+      [](mdl::GroupNode*) {},
+      [](mdl::EntityNode* entityNode) { entityNode->modelDidLoad(); },
+      [](mdl::BrushNode*) {},
+      [](mdl::PatchNode*) {}));
+  }
+}
+
 std::vector<std::filesystem::path> MapDocument::externalSearchPaths() const
 {
   std::vector<std::filesystem::path> searchPaths;
@@ -5346,6 +5749,8 @@ void MapDocument::connectObservers()
     modsDidChangeNotifier.connect(this, &MapDocument::updateAllFaceTags);
   m_notifierConnection += resourcesWereProcessedNotifier.connect(
     this, &MapDocument::updateFaceTagsAfterResourcesWhereProcessed);
+  m_notifierConnection += resourcesWereProcessedNotifier.connect(
+    this, &MapDocument::updateEntityModelsAfterResourcesWereProcessed);
 }
 
 void MapDocument::materialCollectionsWillChange()
@@ -23,6 +23,7 @@
 #include "NotifierConnection.h"
 #include "Result.h"
 #include "io/ExportOptions.h"
+#include "io/NodeWriter.h"
 #include "mdl/ColorRange.h"
 #include "mdl/Game.h"
 #include "mdl/MapFacade.h"
@@ -39,10 +40,13 @@
 #include "vm/util.h"
 
 #include <filesystem>
+#include <iosfwd>
 #include <map>
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace kdl
@@ -156,6 +160,7 @@ protected:
   vm::bbox3d m_lastSelectionBounds = vm::bbox3d{0.0, 32.0};
   mutable vm::bbox3d m_selectionBounds;
   mutable bool m_selectionBoundsValid = true;
+  mutable std::optional<std::vector<mdl::BrushFaceHandle>> m_allSelectedBrushFaces;
 
   ViewEffectsService* m_viewEffectsService = nullptr;
 
@@ -168,6 +173,16 @@ protected:
    */
   std::unique_ptr<RepeatStack> m_repeatStack;
 
+  /*
+   * If enabled, node change notifications that are raised while a transaction, an undo
+   * or a redo is running are collected here and delivered once the outermost
+   * transaction ends. See setCoalesceChangeNotifications.
+   */
+  bool m_coalesceChangeNotifications = false;
+  size_t m_changeNotificationCoalescingDepth = 0;
+  std::vector<mdl::Node*> m_pendingChangedNodes;
+  std::unordered_set<mdl::Node*> m_pendingChangedNodeSet;
+
 public: // notification
   Notifier<Command&> commandDoNotifier;
   Notifier<Command&> commandDoneNotifier;
@@ -228,6 +243,23 @@ public: // notification
 private:
   NotifierConnection m_notifierConnection;
 
+protected:
+  /**
+   * RAII style helper that notifies the observers that the given nodes will change
+   * immediately and that they did change when it is destroyed. Respects notification
+   * coalescing.
+   */
+  class NotifyNodesWillAndDidChange
+  {
+  private:
+    MapDocument& m_document;
+    std::vector<mdl::Node*> m_nodes;
+
+  public:
+    NotifyNodesWillAndDidChange(MapDocument& document, std::vector<mdl::Node*> nodes);
+    ~NotifyNodesWillAndDidChange();
+  };
+
 protected:
   explicit MapDocument(kdl::task_manager& taskManager);
 
@@ -277,6 +309,24 @@ public:
   mdl::EntityModelManager& entityModelManager() override;
   mdl::MaterialManager& materialManager() override;
 
+  /**
+   * Returns the number of brush faces and patches in this document that use the given
+   * material.
+   *
+   * The count is taken from the world's material index, which is kept up to date as
+   * nodes are added, removed or change their materials. The deferred contents of hidden
+   * layers are added to it by material name.
+   */
+  size_t materialUsageCount(const mdl::Material& material) const;
+
+  /**
+   * Returns all brush faces in this document that use the given material. The deferred
+   * contents of hidden layers that use the material are created first so that their
+   * faces are included.
+   */
+  std::vector<mdl::BrushFaceHandle> allBrushFacesWithMaterial(
+    const mdl::Material& material);
+
   Grid& grid() const;
 
   mdl::PointTrace* pointFile();
@@ -324,10 +374,21 @@ public: // new, load, save document
   void saveDocument();
   void saveDocumentAs(const std::filesystem::path& path);
   void saveDocumentTo(const std::filesystem::path& path);
+
+  /**
+   * Saves a backup of this document to the given path. Unlike saveDocumentTo, this does
+   * not create the deferred contents of hidden layers in the document. Their nodes are
+   * created temporarily for writing them.
+   */
+  void saveBackupTo(const std::filesystem::path& path);
   Result<void> exportDocumentAs(const io::ExportOptions& options);
+  void exportMapTo(std::ostream& stream);
 
 private:
   void doSaveDocument(const std::filesystem::path& path);
+  void writeDocumentTo(
+    const std::filesystem::path& path,
+    io::NodeWriter::LayerNodesMap additionalLayerNodes);
   void clearDocument();
 
 public: // text encoding
@@ -400,9 +461,12 @@ public: // selection
    * set are selected, only return one representative face per brush, so that user actions
    * can be performed without generating conflicts. (e.g. this allows selecting 2 closed
    * linked groups in a link set and applying materials.)
+   *
+   * The result is cached until the selection or the selected nodes change, so callers
+   * must not hold on to the returned reference across document modifications.
    */
-  std::vector<mdl::BrushFaceHandle> allSelectedBrushFaces() const override;
-  std::vector<mdl::BrushFaceHandle> selectedBrushFaces() const override;
+  const std::vector<mdl::BrushFaceHandle>& allSelectedBrushFaces() const override;
+  const std::vector<mdl::BrushFaceHandle>& selectedBrushFaces() const override;
 
   VertexHandleManager& vertexHandles();
   EdgeHandleManager& edgeHandles();
@@ -433,7 +497,7 @@ public: // selection
 
 protected:
   void updateLastSelectionBounds();
-  void invalidateSelectionBounds();
+  void invalidateSelectionCaches();
 
 private:
   void validateSelectionBounds() const;
@@ -528,6 +592,12 @@ private:
 public: // layer management
   void renameLayer(mdl::LayerNode* layer, const std::string& name);
 
+  /**
+   * Moves the contents of the given layer to the default layer and removes it. The
+   * deferred contents of the layer are created first so that they are moved, too.
+   */
+  void removeLayer(mdl::LayerNode* layer);
+
 private:
   enum class MoveDirection
   {
@@ -549,6 +619,14 @@ public:
   void selectAllInLayers(const std::vector<mdl::LayerNode*>& layers);
   bool canSelectAllInLayers(const std::vector<mdl::LayerNode*>& layers) const;
 
+protected:
+  /**
+   * Creates the deferred contents of those of the given nodes that are layers and adds
+   * them to their layers (see LayerNode::deferredContents). This is not recorded in the
+   * undo history because it does not change the document.
+   */
+  void createDeferredLayerContents(const std::vector<mdl::Node*>& nodes);
+
 public: // modifying transient node attributes, declared in MapFacade interface
   void isolate();
   void hide(std::vector<mdl::Node*> nodes) override; // Don't take the nodes by reference!
@@ -675,6 +753,38 @@ public: // transactions
 
   virtual bool isCurrentDocumentStateObservable() const = 0;
 
+public: // change notification coalescing
+  /**
+   * Enables or disables the coalescing of change notifications.
+   *
+   * If enabled, the nodesWillChange and nodesDidChange notifications raised during a
+   * transaction, an undo or a redo are merged. Observers are notified that a node will
+   * change only when it changes for the first time, and the deduplicated set of changed
+   * nodes is delivered once when the outermost transaction is committed or cancelled.
+   * Pending notifications for nodes that are about to be removed are delivered before
+   * their removal.
+   *
+   * Disabled by default.
+   */
+  void setCoalesceChangeNotifications(bool coalesceChangeNotifications);
+  bool coalesceChangeNotifications() const;
+
+protected:
+  void notifyNodesWillChange(const std::vector<mdl::Node*>& nodes);
+  void notifyNodesDidChange(const std::vector<mdl::Node*>& nodes);
+
+  /**
+   * Delivers the pending change notifications for the given nodes and their
+   * descendants.
+   */
+  void flushChangeNotifications(const std::vector<mdl::Node*>& nodes);
+
+private:
+  bool isCoalescingChangeNotifications() const;
+  void beginCoalescingChangeNotifications();
+  void endCoalescingChangeNotifications();
+  void flushAllChangeNotifications();
+
 private:
   std::unique_ptr<CommandResult> execute(std::unique_ptr<Command>&& command);
   std::unique_ptr<CommandResult> executeAndStore(
@@ -751,6 +861,7 @@ protected:
   void setMaterials(const std::vector<mdl::BrushFaceHandle>& faceHandles);
   void unsetMaterials();
   void unsetMaterials(const std::vector<mdl::Node*>& nodes);
+  void materialUsageCountsDidChange();
 
   void setEntityDefinitions();
   void setEntityDefinitions(const std::vector<mdl::Node*>& nodes);
@@ -764,6 +875,8 @@ protected:
   void setEntityModels(const std::vector<mdl::Node*>& nodes);
   void unsetEntityModels();
   void unsetEntityModels(const std::vector<mdl::Node*>& nodes);
+  void updateEntityModelsAfterResourcesWereProcessed(
+    const std::vector<mdl::ResourceId>& resourceIds);
 
 protected: // search paths and mods
   std::vector<std::filesystem::path> externalSearchPaths() const;
@@ -68,6 +68,11 @@ std::vector<mdl::Node*> collectOldChildren(
   return result;
 }
 
+std::vector<mdl::Node*> collectVisibleNodes(const std::vector<mdl::Node*>& nodes)
+{
+  return kdl::vec_filter(nodes, [](const auto* node) { return node->visible(); });
+}
+
 } // namespace
 
 std::shared_ptr<MapDocument> MapDocumentCommandFacade::newMapDocument(
@@ -115,8 +120,8 @@ void MapDocumentCommandFacade::performSelect(const std::vector<mdl::Node*>& node
   auto selection = Selection{};
   selection.addSelectedNodes(selected);
 
+  invalidateSelectionCaches();
   selectionDidChangeNotifier(selection);
-  invalidateSelectionBounds();
 }
 
 void MapDocumentCommandFacade::performSelect(
@@ -153,6 +158,7 @@ void MapDocumentCommandFacade::performSelect(
   auto selection = Selection{};
   selection.addSelectedBrushFaces(selected);
 
+  invalidateSelectionCaches();
   selectionDidChangeNotifier(selection);
 }
 
@@ -202,8 +208,8 @@ void MapDocumentCommandFacade::performDeselect(const std::vector<mdl::Node*>& no
   auto selection = Selection{};
   selection.addDeselectedNodes(deselected);
 
+  invalidateSelectionCaches();
   selectionDidChangeNotifier(selection);
-  invalidateSelectionBounds();
 }
 
 void MapDocumentCommandFacade::performDeselect(
@@ -229,11 +235,15 @@ void MapDocumentCommandFacade::performDeselect(
     }
   }
 
-  m_selectedBrushFaces = kdl::vec_erase_all(std::move(m_selectedBrushFaces), deselected);
+  // The faces' selection flags tell us which handles to remove, so we don't have to
+  // search for every deselected handle.
+  std::erase_if(
+    m_selectedBrushFaces, [](const auto& handle) { return !handle.face().selected(); });
 
   auto selection = Selection{};
   selection.addDeselectedBrushFaces(deselected);
 
+  invalidateSelectionCaches();
   selectionDidChangeNotifier(selection);
 
   // Selection change is done. Next, update implicit locking of linked groups.
@@ -273,9 +283,11 @@ void MapDocumentCommandFacade::performDeselectAll()
 void MapDocumentCommandFacade::performAddNodes(
   const std::map<mdl::Node*, std::vector<mdl::Node*>>& nodes)
 {
+  // new nodes go after the deferred contents of their layer
+  createDeferredLayerContents(kdl::map_keys(nodes));
+
   const auto parents = collectNodesAndAncestors(kdl::map_keys(nodes));
-  auto notifyParents =
-    NotifyBeforeAndAfter{nodesWillChangeNotifier, nodesDidChangeNotifier, parents};
+  auto notifyParents = NotifyNodesWillAndDidChange{*this, parents};
 
   auto addedNodes = std::vector<mdl::Node*>{};
   for (const auto& [parent, children] : nodes)
@@ -288,7 +300,7 @@ void MapDocumentCommandFacade::performAddNodes(
   setEntityDefinitions(addedNodes);
   setEntityModels(addedNodes);
   setMaterials(addedNodes);
-  invalidateSelectionBounds();
+  invalidateSelectionCaches();
 
   nodesWereAddedNotifier(addedNodes);
 }
@@ -297,10 +309,10 @@ void MapDocumentCommandFacade::performRemoveNodes(
   const std::map<mdl::Node*, std::vector<mdl::Node*>>& nodes)
 {
   const auto parents = collectNodesAndAncestors(kdl::map_keys(nodes));
-  auto notifyParents =
-    NotifyBeforeAndAfter{nodesWillChangeNotifier, nodesDidChangeNotifier, parents};
+  auto notifyParents = NotifyNodesWillAndDidChange{*this, parents};
 
   const auto allChildren = kdl::vec_flatten(kdl::map_values(nodes));
+  flushChangeNotifications(allChildren);
   auto notifyChildren = NotifyBeforeAndAfter{
     nodesWillBeRemovedNotifier, nodesWereRemovedNotifier, allChildren};
 
@@ -312,7 +324,7 @@ void MapDocumentCommandFacade::performRemoveNodes(
     parent->removeChildren(std::begin(children), std::end(children));
   }
 
-  invalidateSelectionBounds();
+  invalidateSelectionCaches();
 }
 
 std::vector<std::pair<mdl::Node*, std::vector<std::unique_ptr<mdl::Node>>>>
@@ -325,10 +337,10 @@ MapDocumentCommandFacade::performReplaceChildren(
   }
 
   const auto parents = collectNodesAndAncestors(kdl::map_keys(nodes));
-  auto notifyParents =
-    NotifyBeforeAndAfter{nodesWillChangeNotifier, nodesDidChangeNotifier, parents};
+  auto notifyParents = NotifyNodesWillAndDidChange{*this, parents};
 
   const auto allOldChildren = collectOldChildren(nodes);
+  flushChangeNotifications(allOldChildren);
   auto notifyChildren = NotifyBeforeAndAfter{
     nodesWillBeRemovedNotifier, nodesWereRemovedNotifier, allOldChildren};
 
@@ -355,7 +367,7 @@ MapDocumentCommandFacade::performReplaceChildren(
   setEntityModels(allNewChildren);
   setMaterials(allNewChildren);
 
-  invalidateSelectionBounds();
+  invalidateSelectionCaches();
 
   nodesWereAddedNotifier(allNewChildren);
 
@@ -405,12 +417,9 @@ void MapDocumentCommandFacade::performSwapNodeContents(
   const auto parents = collectAncestors(nodes);
   const auto descendants = collectDescendants(nodes);
 
-  auto notifyNodes =
-    NotifyBeforeAndAfter{nodesWillChangeNotifier, nodesDidChangeNotifier, nodes};
-  auto notifyParents =
-    NotifyBeforeAndAfter{nodesWillChangeNotifier, nodesDidChangeNotifier, parents};
-  auto notifyDescendants =
-    NotifyBeforeAndAfter{nodesWillChangeNotifier, nodesDidChangeNotifier, descendants};
+  auto notifyNodes = NotifyNodesWillAndDidChange{*this, nodes};
+  auto notifyParents = NotifyNodesWillAndDidChange{*this, parents};
+  auto notifyDescendants = NotifyNodesWillAndDidChange{*this, descendants};
 
   const auto [notifyWadsChange, notifyEntityDefinitionsChange, notifyModsChange] =
     notifySpecialWorldProperties(*game(), nodesToSwap);
@@ -467,7 +476,7 @@ void MapDocumentCommandFacade::performSwapNodeContents(
     setMaterials(nodes);
   }
 
-  invalidateSelectionBounds();
+  invalidateSelectionCaches();
 }
 
 std::map<mdl::Node*, mdl::VisibilityState> MapDocumentCommandFacade::setVisibilityState(
@@ -488,6 +497,7 @@ std::map<mdl::Node*, mdl::VisibilityState> MapDocumentCommandFacade::setVisibili
     }
   }
 
+  createDeferredLayerContents(collectVisibleNodes(changedNodes));
   nodeVisibilityDidChangeNotifier(changedNodes);
   return result;
 }
@@ -510,6 +520,7 @@ std::map<mdl::Node*, mdl::VisibilityState> MapDocumentCommandFacade::setVisibili
     }
   }
 
+  createDeferredLayerContents(collectVisibleNodes(changedNodes));
   nodeVisibilityDidChangeNotifier(changedNodes);
   return result;
 }
@@ -528,6 +539,7 @@ void MapDocumentCommandFacade::restoreVisibilityState(
     }
   }
 
+  createDeferredLayerContents(collectVisibleNodes(changedNodes));
   nodeVisibilityDidChangeNotifier(changedNodes);
 }
 
@@ -1497,7 +1497,7 @@ mdl::Node* MapViewBase::findNewGroupForObjects(const std::vector<mdl::Node*>& no
 {
   using namespace mdl::HitFilters;
 
-  const auto hits = pickResult().all(type(mdl::nodeHitType()));
+  auto hits = pickResult().view(type(mdl::nodeHitType()));
   if (!hits.empty())
   {
     auto* newGroup = mdl::findOutermostClosedGroup(mdl::hitToNode(hits.front()));
@@ -1531,7 +1531,7 @@ mdl::GroupNode* MapViewBase::findGroupToMergeGroupsInto(
   }
 
   auto document = kdl::mem_lock(m_document);
-  const auto hits = pickResult().all(type(mdl::nodeHitType()));
+  auto hits = pickResult().view(type(mdl::nodeHitType()));
   if (!hits.empty())
   {
     if (auto* mergeTarget = findOutermostClosedGroup(mdl::hitToNode(hits.front())))
@@ -251,8 +251,9 @@ std::vector<const mdl::Material*> MaterialBrowserView::filterMaterials(
 {
   if (m_hideUnused)
   {
-    materials = kdl::vec_erase_if(std::move(materials), [](const auto* material) {
-      return material->usageCount() == 0;
+    auto document = kdl::mem_lock(m_document);
+    materials = kdl::vec_erase_if(std::move(materials), [&](const auto* material) {
+      return document->materialUsageCount(*material) == 0;
     });
   }
   if (!m_filterText.empty())
@@ -277,12 +278,16 @@ std::vector<const mdl::Material*> MaterialBrowserView::sortMaterials(
   {
   case MaterialSortOrder::Name:
     return kdl::vec_sort(std::move(materials), compareNames);
-  case MaterialSortOrder::Usage:
+  case MaterialSortOrder::Usage: {
+    auto document = kdl::mem_lock(m_document);
     return kdl::vec_sort(std::move(materials), [&](const auto* lhs, const auto* rhs) {
-      return lhs->usageCount() < rhs->usageCount()   ? false
-             : lhs->usageCount() > rhs->usageCount() ? true
-                                                     : compareNames(lhs, rhs);
+      const auto lhsUsageCount = document->materialUsageCount(*lhs);
+      const auto rhsUsageCount = document->materialUsageCount(*rhs);
+      return lhsUsageCount < rhsUsageCount   ? false
+             : lhsUsageCount > rhsUsageCount ? true
+                                             : compareNames(lhs, rhs);
     });
+  }
     switchDefault();
   }
 }
@@ -364,7 +369,7 @@ const Color& MaterialBrowserView::materialColor(const mdl::Material& material) c
   {
     return pref(Preferences::MaterialBrowserSelectedColor);
   }
-  if (material.usageCount() > 0)
+  if (kdl::mem_lock(m_document)->materialUsageCount(material) > 0)
   {
     return pref(Preferences::MaterialBrowserUsedColor);
   }
@@ -27,9 +27,7 @@
 #include "mdl/BrushFaceHandle.h"
 #include "mdl/ChangeBrushFaceAttributesRequest.h"
 #include "mdl/Material.h"
-#include "mdl/NodeQueries.h"
 #include "mdl/PushSelection.h"
-#include "mdl/WorldNode.h" // IWYU pragma: keep
 #include "ui/BorderLine.h"
 #include "ui/MapDocument.h"
 #include "ui/MaterialBrowser.h"
@@ -116,10 +114,10 @@ std::vector<mdl::BrushFaceHandle> ReplaceMaterialDialog::getApplicableFaces() co
   ensure(subject != nullptr, "subject is null");
 
   auto document = kdl::mem_lock(m_document);
-  auto faces = document->allSelectedBrushFaces();
+  const auto faces = document->allSelectedBrushFaces();
   if (faces.empty())
   {
-    faces = mdl::collectBrushFaces({document->world()});
+    return document->allBrushFacesWithMaterial(*subject);
   }
 
   return kdl::vec_filter(
@@ -30,6 +30,8 @@
 #include "mdl/HitFilter.h"
 #include "mdl/ModelUtils.h"
 #include "mdl/Node.h"
+#include "mdl/PickResult.h"
+#include "render/Camera.h"
 #include "render/RenderContext.h"
 #include "ui/GestureTracker.h"
 #include "ui/Grid.h"
@@ -41,6 +43,10 @@
 #include "kdl/memory_utils.h"
 #include "kdl/range_to_vector.h"
 #include "kdl/stable_remove_duplicates.h"
+#include "kdl/vector_utils.h"
+
+#include "vm/ray.h"
+#include "vm/vec.h"
 
 #include <algorithm>
 #include <unordered_set>
@@ -199,14 +205,23 @@ void drillSelection(const InputState& inputState, MapDocument& document)
   }
 }
 
+/**
+ * The distance in pixels between the points at which the paint selection picks along the
+ * path of the mouse.
+ */
+constexpr auto PaintSelectionStepSize = 4.0f;
+
 class PaintSelectionDragTracker : public GestureTracker
 {
 private:
   std::shared_ptr<MapDocument> m_document;
+  vm::vec2f m_lastMousePosition;
 
 public:
-  explicit PaintSelectionDragTracker(std::shared_ptr<MapDocument> document)
+  PaintSelectionDragTracker(
+    std::shared_ptr<MapDocument> document, const InputState& inputState)
     : m_document{std::move(document)}
+    , m_lastMousePosition{inputState.mouseX(), inputState.mouseY()}
   {
   }
 
@@ -214,34 +229,57 @@ public:
   {
     using namespace mdl::HitFilters;
 
+    // The drag events received between two frames are collated into one event that only
+    // carries the last mouse position, so the mouse may have passed over several nodes or
+    // faces since the last update. All of them are collected and selected at once, so
+    // that every update makes at most one selection change.
+
     const auto& editorContext = m_document->editorContext();
     if (m_document->hasSelectedBrushFaces())
     {
-      const auto hit = firstHit(
-        inputState,
-        type(mdl::BrushNode::BrushHitType) && isNodeSelectable(editorContext));
-      if (const auto faceHandle = mdl::hitToFaceHandle(hit))
-      {
-        const auto* brush = faceHandle->node();
-        const auto& face = faceHandle->face();
-        if (!face.selected() && editorContext.selectable(brush, face))
+      auto faceHandles = std::vector<mdl::BrushFaceHandle>{};
+      pickAlongMousePath(inputState, [&](const mdl::PickResult& pickResult) {
+        const auto& hit = pickResult.first(
+          type(mdl::BrushNode::BrushHitType) && isNodeSelectable(editorContext));
+        if (const auto faceHandle = mdl::hitToFaceHandle(hit))
         {
-          m_document->selectBrushFaces({*faceHandle});
+          const auto* brush = faceHandle->node();
+          const auto& face = faceHandle->face();
+          if (
+            !face.selected() && editorContext.selectable(brush, face)
+            && !kdl::vec_contains(faceHandles, *faceHandle))
+          {
+            faceHandles.push_back(*faceHandle);
+          }
         }
+      });
+
+      if (!faceHandles.empty())
+      {
+        m_document->selectBrushFaces(faceHandles);
       }
     }
     else
     {
       assert(m_document->hasSelectedNodes());
-      const auto hit =
-        firstHit(inputState, type(mdl::nodeHitType()) && isNodeSelectable(editorContext));
-      if (hit.isMatch())
-      {
-        auto* node = findOutermostClosedGroupOrNode(mdl::hitToNode(hit));
-        if (!node->selected() && editorContext.selectable(node))
+
+      auto nodes = std::vector<mdl::Node*>{};
+      pickAlongMousePath(inputState, [&](const mdl::PickResult& pickResult) {
+        const auto& hit = pickResult.first(
+          type(mdl::nodeHitType()) && isNodeSelectable(editorContext));
+        if (hit.isMatch())
         {
-          m_document->selectNodes({node});
+          auto* node = findOutermostClosedGroupOrNode(mdl::hitToNode(hit));
+          if (!node->selected() && editorContext.selectable(node))
+          {
+            nodes.push_back(node);
+          }
         }
+      });
+
+      if (!nodes.empty())
+      {
+        m_document->selectNodes(kdl::col_stable_remove_duplicates(std::move(nodes)));
       }
     }
     return true;
@@ -250,6 +288,33 @@ public:
   void end(const InputState&) override { m_document->commitTransaction(); }
 
   void cancel() override { m_document->cancelTransaction(); }
+
+private:
+  /**
+   * Calls the given function with the pick results of points between the previous and the
+   * current mouse position, and with the pick result of the current mouse position last.
+   */
+  template <typename F>
+  void pickAlongMousePath(const InputState& inputState, const F& f)
+  {
+    const auto mousePosition = vm::vec2f{inputState.mouseX(), inputState.mouseY()};
+    const auto delta = mousePosition - m_lastMousePosition;
+    const auto steps = size_t(vm::length(delta) / PaintSelectionStepSize);
+
+    for (size_t i = 1; i < steps; ++i)
+    {
+      const auto position = m_lastMousePosition + delta * (float(i) / float(steps));
+      const auto pickRay =
+        vm::ray3d{inputState.camera().pickRay(position.x(), position.y())};
+
+      auto pickResult = mdl::PickResult::byDistance();
+      m_document->pick(pickRay, pickResult);
+      f(pickResult);
+    }
+    f(inputState.pickResult());
+
+    m_lastMousePosition = mousePosition;
+  }
 };
 
 } // namespace
@@ -536,7 +601,8 @@ std::unique_ptr<GestureTracker> SelectionTool::acceptMouseDrag(
           document->selectBrushFaces({*faceHandle});
         }
 
-        return std::make_unique<PaintSelectionDragTracker>(std::move(document));
+        return std::make_unique<PaintSelectionDragTracker>(
+          std::move(document), inputState);
       }
     }
   }
@@ -562,7 +628,7 @@ std::unique_ptr<GestureTracker> SelectionTool::acceptMouseDrag(
         document->selectNodes({node});
       }
 
-      return std::make_unique<PaintSelectionDragTracker>(std::move(document));
+      return std::make_unique<PaintSelectionDragTracker>(std::move(document), inputState);
     }
   }
 
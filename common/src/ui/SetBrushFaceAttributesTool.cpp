@@ -423,7 +423,7 @@ bool SetBrushFaceAttributesTool::canCopyAttributesFromSelection(
 
   auto document = kdl::mem_lock(m_document);
 
-  const auto selectedFaces = document->selectedBrushFaces();
+  const auto& selectedFaces = document->selectedBrushFaces();
   if (selectedFaces.size() != 1)
   {
     return false;
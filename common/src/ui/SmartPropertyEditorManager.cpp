@@ -32,8 +32,9 @@
 #include "ui/SmartPropertyEditor.h"
 #include "ui/SmartWadEditor.h"
 
+#include "kdl/glob_matcher.h"
 #include "kdl/memory_utils.h"
-#include "kdl/string_compare.h"
+#include "kdl/vector_utils.h"
 
 namespace tb::ui
 {
@@ -70,11 +71,13 @@ SmartPropertyEditorMatcher makeSmartTypeWithSameDefinitionEditorMatcher()
 }
 
 SmartPropertyEditorMatcher makeSmartPropertyEditorKeyMatcher(
-  std::vector<std::string> patterns_)
+  const std::vector<std::string>& patterns)
 {
-  return [patterns = std::move(patterns_)](const auto& propertyKey, const auto& nodes) {
-    return !nodes.empty() && std::ranges::any_of(patterns, [&](const auto& pattern) {
-      return kdl::cs::str_matches_glob(propertyKey, pattern);
+  auto matchers_ = kdl::vec_transform(
+    patterns, [](const auto& pattern) { return kdl::cs::make_glob_matcher(pattern); });
+  return [matchers = std::move(matchers_)](const auto& propertyKey, const auto& nodes) {
+    return !nodes.empty() && std::ranges::any_of(matchers, [&](const auto& matcher) {
+      return matcher.matches(propertyKey);
     });
   };
 }
@@ -208,7 +208,7 @@ void UVView::connectObservers()
 void UVView::selectionDidChange(const Selection&)
 {
   auto document = kdl::mem_lock(m_document);
-  const auto faces = document->selectedBrushFaces();
+  const auto& faces = document->selectedBrushFaces();
   if (faces.size() != 1)
   {
     m_helper.setFaceHandle(std::nullopt);
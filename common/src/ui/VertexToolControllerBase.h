@@ -81,7 +81,7 @@ protected:
     {
       using namespace mdl::HitFilters;
 
-      const auto hits = inputState.pickResult().all(type(hitType));
+      auto hits = inputState.pickResult().view(type(hitType));
       if (!hits.empty())
       {
         for (const auto& hit : hits)
@@ -275,8 +275,7 @@ protected:
       {
         const H& firstHandle = first.template target<const H&>();
 
-        const auto matches = pickResult.all(type(m_hitType));
-        for (const auto& match : matches)
+        for (const auto& match : pickResult.view(type(m_hitType)))
         {
           const H& handle = match.template target<const H&>();
 
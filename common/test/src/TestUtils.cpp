@@ -209,7 +209,7 @@ BrushFace createParaxial(
            point1,
            point2,
            attributes,
-           std::make_unique<ParaxialUVCoordSystem>(point0, point1, point2, attributes))
+           ParaxialUVCoordSystem{point0, point1, point2, attributes})
          | kdl::value();
 }
 
@@ -96,7 +96,7 @@ TEST_CASE("convertToString")
               m_children: [],
             },
             BrushNode{
-              m_brush: Brush{m_faces: [BrushFace{m_points: [-32 -32 -32, -32 -31 -32, -32 -32 -31], m_boundary: { normal: (-1 0 0), distance: 32 }, m_attributes: BrushFaceAttributes{m_materialName: material, m_offset: 0 0, m_scale: 1 1, m_rotation: 0, m_surfaceContents: nullopt, m_surfaceFlags: nullopt, m_surfaceValue: nullopt, m_color: nullopt}, m_materialReference: AssetReference<T>{m_asset: null}}, BrushFace{m_points: [-32 -32 -32, -32 -32 -31, -31 -32 -32], m_boundary: { normal: (0 -1 0), distance: 32 }, m_attributes: BrushFaceAttributes{m_materialName: material, m_offset: 0 0, m_scale: 1 1, m_rotation: 0, m_surfaceContents: nullopt, m_surfaceFlags: nullopt, m_surfaceValue: nullopt, m_color: nullopt}, m_materialReference: AssetReference<T>{m_asset: null}}, BrushFace{m_points: [-32 -32 -32, -31 -32 -32, -32 -31 -32], m_boundary: { normal: (0 0 -1), distance: 32 }, m_attributes: BrushFaceAttributes{m_materialName: material, m_offset: 0 0, m_scale: 1 1, m_rotation: 0, m_surfaceContents: nullopt, m_surfaceFlags: nullopt, m_surfaceValue: nullopt, m_color: nullopt}, m_materialReference: AssetReference<T>{m_asset: null}}, BrushFace{m_points: [32 32 32, 32 33 32, 33 32 32], m_boundary: { normal: (0 0 1), distance: 32 }, m_attributes: BrushFaceAttributes{m_materialName: material, m_offset: 0 0, m_scale: 1 1, m_rotation: 0, m_surfaceContents: nullopt, m_surfaceFlags: nullopt, m_surfaceValue: nullopt, m_color: nullopt}, m_materialReference: AssetReference<T>{m_asset: null}}, BrushFace{m_points: [32 32 32, 33 32 32, 32 32 33], m_boundary: { normal: (0 1 0), distance: 32 }, m_attributes: BrushFaceAttributes{m_materialName: material, m_offset: 0 0, m_scale: 1 1, m_rotation: 0, m_surfaceContents: nullopt, m_surfaceFlags: nullopt, m_surfaceValue: nullopt, m_color: nullopt}, m_materialReference: AssetReference<T>{m_asset: null}}, BrushFace{m_points: [32 32 32, 32 32 33, 32 33 32], m_boundary: { normal: (1 0 0), distance: 32 }, m_attributes: BrushFaceAttributes{m_materialName: material, m_offset: 0 0, m_scale: 1 1, m_rotation: 0, m_surfaceContents: nullopt, m_surfaceFlags: nullopt, m_surfaceValue: nullopt, m_color: nullopt}, m_materialReference: AssetReference<T>{m_asset: null}}]},
+              m_brush: Brush{m_faces: [BrushFace{m_points: [-32 -32 -32, -32 -31 -32, -32 -32 -31], m_boundary: { normal: (-1 0 0), distance: 32 }, m_attributes: BrushFaceAttributes{m_materialName: material, m_offset: 0 0, m_scale: 1 1, m_rotation: 0, m_surfaceContents: nullopt, m_surfaceFlags: nullopt, m_surfaceValue: nullopt, m_color: nullopt}}, BrushFace{m_points: [-32 -32 -32, -32 -32 -31, -31 -32 -32], m_boundary: { normal: (0 -1 0), distance: 32 }, m_attributes: BrushFaceAttributes{m_materialName: material, m_offset: 0 0, m_scale: 1 1, m_rotation: 0, m_surfaceContents: nullopt, m_surfaceFlags: nullopt, m_surfaceValue: nullopt, m_color: nullopt}}, BrushFace{m_points: [-32 -32 -32, -31 -32 -32, -32 -31 -32], m_boundary: { normal: (0 0 -1), distance: 32 }, m_attributes: BrushFaceAttributes{m_materialName: material, m_offset: 0 0, m_scale: 1 1, m_rotation: 0, m_surfaceContents: nullopt, m_surfaceFlags: nullopt, m_surfaceValue: nullopt, m_color: nullopt}}, BrushFace{m_points: [32 32 32, 32 33 32, 33 32 32], m_boundary: { normal: (0 0 1), distance: 32 }, m_attributes: BrushFaceAttributes{m_materialName: material, m_offset: 0 0, m_scale: 1 1, m_rotation: 0, m_surfaceContents: nullopt, m_surfaceFlags: nullopt, m_surfaceValue: nullopt, m_color: nullopt}}, BrushFace{m_points: [32 32 32, 33 32 32, 32 32 33], m_boundary: { normal: (0 1 0), distance: 32 }, m_attributes: BrushFaceAttributes{m_materialName: material, m_offset: 0 0, m_scale: 1 1, m_rotation: 0, m_surfaceContents: nullopt, m_surfaceFlags: nullopt, m_surfaceValue: nullopt, m_color: nullopt}}, BrushFace{m_points: [32 32 32, 32 32 33, 32 33 32], m_boundary: { normal: (1 0 0), distance: 32 }, m_attributes: BrushFaceAttributes{m_materialName: material, m_offset: 0 0, m_scale: 1 1, m_rotation: 0, m_surfaceContents: nullopt, m_surfaceFlags: nullopt, m_surfaceValue: nullopt, m_color: nullopt}}]},
               m_linkId: brush_link_id,
               m_children: [],
             },
@@ -22,6 +22,7 @@
 #include "io/AssimpLoader.h"
 #include "io/DiskFileSystem.h"
 #include "mdl/EntityModel.h"
+#include "mdl/Material.h"
 
 #include "vm/approx.h"
 
@@ -93,6 +94,39 @@ TEST_CASE("AssimpLoader")
 
     CHECK(vm::approx(modelData.value().bounds(0)) == vm::bbox3f{{0, 0, 0}, {2, 1, 3}});
   }
+
+  SECTION("meshes with a shared material share its texture")
+  {
+    const auto basePath =
+      std::filesystem::current_path() / "fixture/test/io/assimp/shared_material";
+    auto fs = std::make_shared<DiskFileSystem>(basePath);
+
+    auto loader = AssimpLoader{"two_meshes.obj", *fs};
+
+    auto modelData = loader.load(logger);
+    REQUIRE(modelData.is_success());
+
+    REQUIRE(modelData.value().surfaceCount() == 2);
+    REQUIRE(modelData.value().surface(0).skinCount() == 1);
+    REQUIRE(modelData.value().surface(1).skinCount() == 1);
+
+    const auto* skin0 = modelData.value().surface(0).skin(0);
+    const auto* skin1 = modelData.value().surface(1).skin(0);
+    CHECK(&skin0->textureResource() == &skin1->textureResource());
+  }
+
+  SECTION("cancelled import")
+  {
+    const auto basePath =
+      std::filesystem::current_path() / "fixture/test/io/assimp/shared_material";
+    auto fs = std::make_shared<DiskFileSystem>(basePath);
+
+    auto loader = AssimpLoader{"two_meshes.obj", *fs, []() { return true; }};
+
+    CHECK(
+      loader.load(logger)
+      == Result<mdl::EntityModelData>{Error{"Loading cancelled"}});
+  }
 }
 
 } // namespace tb::io
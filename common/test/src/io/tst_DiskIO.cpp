@@ -29,7 +29,10 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <chrono>
 #include <filesystem>
+#include <fstream>
+#include <string>
 
 #include "Catch2.h"
 
@@ -85,6 +88,12 @@ TestEnvironment makeTestEnvironment()
   }};
 }
 
+void writeFile(const std::filesystem::path& path, const std::string& contents)
+{
+  auto stream = std::ofstream{path};
+  stream << contents;
+}
+
 const auto readAll = [](auto& stream) {
   return std::string{
     std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
@@ -447,6 +456,113 @@ TEST_CASE("DiskIO")
     }
   }
 
+  SECTION("copyFileIfChanged")
+  {
+    const auto sourcePath = env.dir() / "test.txt";
+    const auto destPath = env.dir() / "dir1/test.txt";
+    const auto pastTime =
+      std::filesystem::last_write_time(sourcePath) - std::chrono::hours{1};
+
+    SECTION("copy non existing file")
+    {
+      CHECK(Disk::copyFileIfChanged(env.dir() / "does_not_exist.txt", destPath)
+              .is_error());
+    }
+
+    SECTION("copy file to non existing file")
+    {
+      CHECK(Disk::copyFileIfChanged(sourcePath, destPath) == Result<bool>{true});
+      CHECK(Disk::withInputStream(destPath, readAll) == "some content");
+      CHECK(
+        std::filesystem::last_write_time(destPath)
+        == std::filesystem::last_write_time(sourcePath));
+
+      SECTION("copy file again")
+      {
+        CHECK(Disk::copyFileIfChanged(sourcePath, destPath) == Result<bool>{false});
+      }
+    }
+
+    SECTION("copy file into directory")
+    {
+      CHECK(
+        Disk::copyFileIfChanged(sourcePath, env.dir() / "dir1") == Result<bool>{true});
+      CHECK(Disk::withInputStream(destPath, readAll) == "some content");
+
+      CHECK(
+        Disk::copyFileIfChanged(sourcePath, env.dir() / "dir1") == Result<bool>{false});
+    }
+
+    SECTION("skip file with same size and modification time")
+    {
+      writeFile(destPath, "same length!");
+      std::filesystem::last_write_time(
+        destPath, std::filesystem::last_write_time(sourcePath));
+
+      CHECK(Disk::copyFileIfChanged(sourcePath, destPath) == Result<bool>{false});
+      CHECK(Disk::withInputStream(destPath, readAll) == "same length!");
+    }
+
+    SECTION("skip file with same contents")
+    {
+      writeFile(destPath, "some content");
+      std::filesystem::last_write_time(destPath, pastTime);
+
+      CHECK(Disk::copyFileIfChanged(sourcePath, destPath) == Result<bool>{false});
+      CHECK(std::filesystem::last_write_time(destPath) == pastTime);
+    }
+
+    SECTION("copy file with same size and different contents")
+    {
+      writeFile(destPath, "same length!");
+      std::filesystem::last_write_time(destPath, pastTime);
+
+      CHECK(Disk::copyFileIfChanged(sourcePath, destPath) == Result<bool>{true});
+      CHECK(Disk::withInputStream(destPath, readAll) == "some content");
+    }
+
+    SECTION("copy file with different size")
+    {
+      writeFile(destPath, "other content");
+      std::filesystem::last_write_time(
+        destPath, std::filesystem::last_write_time(sourcePath));
+
+      CHECK(Disk::copyFileIfChanged(sourcePath, destPath) == Result<bool>{true});
+      CHECK(Disk::withInputStream(destPath, readAll) == "some content");
+    }
+  }
+
+  SECTION("writeFileIfChanged")
+  {
+    const auto path = env.dir() / "test.txt";
+
+    SECTION("write non existing file")
+    {
+      CHECK(
+        Disk::writeFileIfChanged(env.dir() / "dir1/new.txt", "new content")
+        == Result<bool>{true});
+      CHECK(Disk::withInputStream(env.dir() / "dir1/new.txt", readAll) == "new content");
+    }
+
+    SECTION("skip unchanged file")
+    {
+      const auto pastTime =
+        std::filesystem::last_write_time(path) - std::chrono::hours{1};
+      std::filesystem::last_write_time(path, pastTime);
+
+      CHECK(Disk::writeFileIfChanged(path, "some content") == Result<bool>{false});
+      CHECK(std::filesystem::last_write_time(path) == pastTime);
+    }
+
+    SECTION("write changed file")
+    {
+      const auto contents = GENERATE("some", "some contents", "other content");
+
+      CHECK(Disk::writeFileIfChanged(path, contents) == Result<bool>{true});
+      CHECK(Disk::withInputStream(path, readAll) == contents);
+    }
+  }
+
   SECTION("moveFile")
   {
     SECTION("move non existing file")
@@ -37,6 +37,7 @@
 
 #include <fmt/format.h>
 
+#include <memory>
 #include <sstream>
 #include <vector>
 
@@ -494,6 +495,40 @@ TEST_CASE("NodeWriter")
     CHECK(actual == expected);
   }
 
+  SECTION("writeMapWithAdditionalLayerNodes")
+  {
+    const auto worldBounds = vm::bbox3d{8192.0};
+
+    auto map = mdl::WorldNode{{}, {}, mdl::MapFormat::Standard};
+
+    auto* layerNode = new mdl::LayerNode{mdl::Layer{"Custom Layer"}};
+    map.addChild(layerNode);
+
+    auto builder = mdl::BrushBuilder{map.mapFormat(), worldBounds};
+    auto brushNode = std::make_unique<mdl::BrushNode>(
+      builder.createCube(64.0, "none") | kdl::value());
+
+    auto groupNode = std::make_unique<mdl::GroupNode>(mdl::Group{"Group"});
+    groupNode->setPersistentId(7);
+    groupNode->addChild(
+      new mdl::BrushNode{builder.createCube(32.0, "some_material") | kdl::value()});
+
+    const auto writeMap = [&](NodeWriter::LayerNodesMap additionalLayerNodes) {
+      auto str = std::stringstream{};
+      auto writer = NodeWriter{map, str};
+      writer.setAdditionalLayerNodes(std::move(additionalLayerNodes));
+      writer.writeMap(taskManager);
+      return str.str();
+    };
+
+    const auto actual = writeMap({{layerNode, {brushNode.get(), groupNode.get()}}});
+
+    layerNode->addChildren({brushNode.release(), groupNode.release()});
+    const auto expected = writeMap({});
+
+    CHECK(actual == expected);
+  }
+
   SECTION("writeMapWithNestedGroupInCustomLayer")
   {
     const auto worldBounds = vm::bbox3d{8192.0};
@@ -17,8 +17,10 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "TestLogger.h"
 #include "TestUtils.h"
 #include "io/DiskIO.h"
+#include "io/NodeWriter.h"
 #include "io/TestParserStatus.h"
 #include "io/WorldReader.h"
 #include "mdl/BezierPatch.h"
@@ -32,6 +34,7 @@
 #include "mdl/PatchNode.h"
 #include "mdl/WorldNode.h"
 
+#include "kdl/result.h"
 #include "kdl/task_manager.h"
 
 #include "vm/mat.h"
@@ -41,7 +44,9 @@
 #include <fmt/format.h>
 
 #include <filesystem>
+#include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include "Catch2.h"
 
@@ -1972,6 +1977,7 @@ common/caulk
       {mdl::MapFormat::Standard, mdl::MapFormat::Valve},
       worldBounds,
       {},
+      false,
       status,
       taskManager);
     REQUIRE(worldResult.is_success());
@@ -1982,4 +1988,284 @@ common/caulk
   }
 }
 
+TEST_CASE("WorldReader.deferHiddenLayers")
+{
+  auto taskManager = kdl::task_manager{};
+  const auto worldBounds = vm::bbox3d{8192.0};
+  auto status = TestParserStatus{};
+
+  // layer 2 is hidden and contains a brush, an entity and a group with a brush and an
+  // entity, layer 4 is hidden, but contains a group that is linked to a group in the
+  // default layer
+  const auto data = R"(// entity 0
+{
+"classname" "worldspawn"
+// brush 0
+{
+( -64 -64 -16 ) ( -64 -63 -16 ) ( -64 -64 -15 ) __TB_empty 0 0 0 1 1
+( -64 -64 -16 ) ( -64 -64 -15 ) ( -63 -64 -16 ) __TB_empty 0 0 0 1 1
+( -64 -64 -16 ) ( -63 -64 -16 ) ( -64 -63 -16 ) __TB_empty 0 0 0 1 1
+( 64 64 16 ) ( 64 65 16 ) ( 65 64 16 ) __TB_empty 0 0 0 1 1
+( 64 64 16 ) ( 65 64 16 ) ( 64 64 17 ) __TB_empty 0 0 0 1 1
+( 64 64 16 ) ( 64 64 17 ) ( 64 65 16 ) __TB_empty 0 0 0 1 1
+}
+}
+// entity 1
+{
+"classname" "func_group"
+"_tb_type" "_tb_group"
+"_tb_name" "Linked Group"
+"_tb_id" "6"
+"_tb_linked_group_id" "linked_group"
+}
+// entity 2
+{
+"classname" "func_group"
+"_tb_type" "_tb_layer"
+"_tb_name" "Visible"
+"_tb_id" "1"
+"_tb_layer_sort_index" "0"
+}
+// entity 3
+{
+"classname" "func_group"
+"_tb_type" "_tb_layer"
+"_tb_name" "Hidden"
+"_tb_id" "2"
+"_tb_layer_sort_index" "1"
+"_tb_layer_hidden" "1"
+// brush 0
+{
+( -32 -32 -16 ) ( -32 -31 -16 ) ( -32 -32 -15 ) material 0 0 0 1 1
+( -32 -32 -16 ) ( -32 -32 -15 ) ( -31 -32 -16 ) material 0 0 0 1 1
+( -32 -32 -16 ) ( -31 -32 -16 ) ( -32 -31 -16 ) material 0 0 0 1 1
+( 32 32 16 ) ( 32 33 16 ) ( 33 32 16 ) material 0 0 0 1 1
+( 32 32 16 ) ( 33 32 16 ) ( 32 32 17 ) material 0 0 0 1 1
+( 32 32 16 ) ( 32 32 17 ) ( 32 33 16 ) material 0 0 0 1 1
+}
+}
+// entity 4
+{
+"classname" "func_group"
+"_tb_type" "_tb_group"
+"_tb_name" "Group"
+"_tb_id" "7"
+"_tb_linked_group_id" "unlinked_group"
+"_tb_layer" "2"
+// brush 0
+{
+( -16 -16 -16 ) ( -16 -15 -16 ) ( -16 -16 -15 ) material 0 0 0 1 1
+( -16 -16 -16 ) ( -16 -16 -15 ) ( -15 -16 -16 ) material 0 0 0 1 1
+( -16 -16 -16 ) ( -15 -16 -16 ) ( -16 -15 -16 ) material 0 0 0 1 1
+( 16 16 16 ) ( 16 17 16 ) ( 17 16 16 ) material 0 0 0 1 1
+( 16 16 16 ) ( 17 16 16 ) ( 16 16 17 ) material 0 0 0 1 1
+( 16 16 16 ) ( 16 16 17 ) ( 16 17 16 ) material 0 0 0 1 1
+}
+}
+// entity 5
+{
+"classname" "light"
+"origin" "0 0 0"
+"_tb_group" "7"
+}
+// entity 6
+{
+"classname" "info_player_start"
+"origin" "32 32 32"
+"_tb_layer" "2"
+}
+// entity 7
+{
+"classname" "func_group"
+"_tb_type" "_tb_layer"
+"_tb_name" "Hidden Linked"
+"_tb_id" "4"
+"_tb_layer_sort_index" "2"
+"_tb_layer_hidden" "1"
+}
+// entity 8
+{
+"classname" "func_group"
+"_tb_type" "_tb_group"
+"_tb_name" "Linked Group"
+"_tb_id" "5"
+"_tb_linked_group_id" "linked_group"
+"_tb_layer" "4"
+}
+)";
+
+  const auto writeMap = [&](const mdl::WorldNode& world) {
+    auto str = std::stringstream{};
+    auto writer = NodeWriter{world, str};
+    writer.writeMap(taskManager);
+    return str.str();
+  };
+
+  auto eagerReader = WorldReader{data, mdl::MapFormat::Standard, {}};
+  auto eagerWorld = eagerReader.read(worldBounds, status, taskManager) | kdl::value();
+
+  auto reader = WorldReader{data, mdl::MapFormat::Standard, {}};
+  reader.setDeferHiddenLayers(true);
+  auto world = reader.read(worldBounds, status, taskManager) | kdl::value();
+
+  const auto customLayers = world->customLayers();
+  REQUIRE(customLayers.size() == 3u);
+
+  auto* visibleLayer = customLayers[0];
+  auto* hiddenLayer = customLayers[1];
+  auto* hiddenLinkedLayer = customLayers[2];
+
+  CHECK_FALSE(visibleLayer->hasDeferredContents());
+  CHECK_FALSE(hiddenLinkedLayer->hasDeferredContents());
+  CHECK(hiddenLinkedLayer->childCount() == 1u);
+
+  REQUIRE(hiddenLayer->hasDeferredContents());
+  CHECK(hiddenLayer->hidden());
+  CHECK(hiddenLayer->childCount() == 0u);
+  CHECK(hiddenLayer->deferredContents()->maxPersistentId == 7u);
+  CHECK(
+    hiddenLayer->deferredContents()->materialUsageCounts
+    == std::unordered_map<std::string, size_t>{{"material", 12u}});
+  CHECK(hiddenLayer->deferredContents()->objectCount == 3u);
+
+  SECTION("New groups don't reuse the IDs of deferred groups")
+  {
+    auto* groupNode = new mdl::GroupNode{mdl::Group{"new"}};
+    world->defaultLayer()->addChild(groupNode);
+    CHECK(groupNode->persistentId() == 8u);
+  }
+
+  SECTION("Created nodes match the nodes of an eagerly read map")
+  {
+    auto logger = TestLogger{};
+    auto deferredContents = hiddenLayer->takeDeferredContents();
+    REQUIRE(deferredContents);
+    CHECK_FALSE(hiddenLayer->hasDeferredContents());
+
+    auto nodes = deferredContents->createNodes(logger, taskManager);
+    CHECK(logger.countMessages() == 0u);
+    REQUIRE(nodes.size() == 3u);
+
+    auto* brushNode = dynamic_cast<mdl::BrushNode*>(nodes[0].get());
+    auto* groupNode = dynamic_cast<mdl::GroupNode*>(nodes[1].get());
+    auto* entityNode = dynamic_cast<mdl::EntityNode*>(nodes[2].get());
+    REQUIRE(brushNode);
+    REQUIRE(groupNode);
+    REQUIRE(entityNode);
+
+    CHECK(brushNode->lineNumber() == 39u);
+    CHECK(groupNode->persistentId() == 7u);
+    CHECK(groupNode->childCount() == 2u);
+    CHECK(entityNode->entity().classname() == "info_player_start");
+
+    for (auto& node : nodes)
+    {
+      hiddenLayer->addChild(node.release());
+    }
+
+    // saving a map after creating its deferred contents yields the same map
+    CHECK(writeMap(*world) == writeMap(*eagerWorld));
+    CHECK(writeMap(*world) == data);
+  }
+}
+
+TEST_CASE("WorldReader.deferHiddenLayersWithEntityLinks")
+{
+  auto taskManager = kdl::task_manager{};
+  const auto worldBounds = vm::bbox3d{8192.0};
+  auto status = TestParserStatus{};
+
+  // the entities in layer 1 link to each other, the entity in layer 2 is the target of an
+  // entity in the default layer, and the entity in layer 3 kills an entity in layer 4
+  const auto data = R"(
+{
+"classname" "worldspawn"
+}
+{
+"classname" "func_group"
+"_tb_type" "_tb_layer"
+"_tb_name" "Internal Links"
+"_tb_id" "1"
+"_tb_layer_sort_index" "0"
+"_tb_layer_hidden" "1"
+}
+{
+"classname" "func_group"
+"_tb_type" "_tb_layer"
+"_tb_name" "Link Target"
+"_tb_id" "2"
+"_tb_layer_sort_index" "1"
+"_tb_layer_hidden" "1"
+}
+{
+"classname" "func_group"
+"_tb_type" "_tb_layer"
+"_tb_name" "Kill Source"
+"_tb_id" "3"
+"_tb_layer_sort_index" "2"
+"_tb_layer_hidden" "1"
+}
+{
+"classname" "func_group"
+"_tb_type" "_tb_layer"
+"_tb_name" "Kill Target"
+"_tb_id" "4"
+"_tb_layer_sort_index" "3"
+"_tb_layer_hidden" "1"
+}
+{
+"classname" "trigger_relay"
+"target" "internal"
+"_tb_layer" "1"
+}
+{
+"classname" "light"
+"targetname" "internal"
+"_tb_layer" "1"
+}
+{
+"classname" "trigger_relay"
+"target2" "door"
+}
+{
+"classname" "light"
+"targetname" "door"
+"_tb_layer" "2"
+}
+{
+"classname" "trigger_relay"
+"killtarget" "monster"
+"_tb_layer" "3"
+}
+{
+"classname" "light"
+"targetname" "monster"
+"_tb_layer" "4"
+}
+)";
+
+  auto reader = WorldReader{data, mdl::MapFormat::Standard, {}};
+  reader.setDeferHiddenLayers(true);
+  auto world = reader.read(worldBounds, status, taskManager) | kdl::value();
+
+  const auto customLayers = world->customLayers();
+  REQUIRE(customLayers.size() == 4u);
+
+  CHECK(customLayers[0]->hasDeferredContents());
+  CHECK(customLayers[0]->childCount() == 0u);
+
+  for (const auto* layerNode : {customLayers[1], customLayers[2], customLayers[3]})
+  {
+    CAPTURE(layerNode->name());
+    CHECK_FALSE(layerNode->hasDeferredContents());
+    CHECK(layerNode->childCount() == 1u);
+  }
+
+  // the links are resolved, so no link target is reported as missing
+  const auto* linkSource =
+    dynamic_cast<mdl::EntityNode*>(world->defaultLayer()->children().front());
+  REQUIRE(linkSource);
+  CHECK(linkSource->findMissingLinkTargets().empty());
+}
+
 } // namespace tb::io
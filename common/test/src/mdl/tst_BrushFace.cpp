@@ -474,8 +474,7 @@ TEST_CASE("BrushFace")
 
     const auto attribs = BrushFaceAttributes{""};
     auto face =
-      BrushFace::create(
-        p0, p1, p2, attribs, std::make_unique<ParaxialUVCoordSystem>(p0, p1, p2, attribs))
+      BrushFace::create(p0, p1, p2, attribs, ParaxialUVCoordSystem{p0, p1, p2, attribs})
       | kdl::value();
     CHECK(face.points()[0] == vm::approx{p0});
     CHECK(face.points()[1] == vm::approx{p1});
@@ -492,62 +491,10 @@ TEST_CASE("BrushFace")
 
     const auto attribs = BrushFaceAttributes{""};
     CHECK_FALSE(
-      BrushFace::create(
-        p0, p1, p2, attribs, std::make_unique<ParaxialUVCoordSystem>(p0, p1, p2, attribs))
+      BrushFace::create(p0, p1, p2, attribs, ParaxialUVCoordSystem{p0, p1, p2, attribs})
         .is_success());
   }
 
-  SECTION("materialUsageCount")
-  {
-    const auto p0 = vm::vec3d{0, 0, 4};
-    const auto p1 = vm::vec3d{1, 0, 4};
-    const auto p2 = vm::vec3d{0, -1, 4};
-    auto material = Material{"testMaterial", createTextureResource(Texture{64, 64})};
-    auto material2 = Material{"testMaterial2", createTextureResource(Texture{64, 64})};
-
-    CHECK(material.usageCount() == 0u);
-    CHECK(material2.usageCount() == 0u);
-
-    auto attribs = BrushFaceAttributes{""};
-    {
-      // test constructor
-      auto face = BrushFace::create(
-                    p0,
-                    p1,
-                    p2,
-                    attribs,
-                    std::make_unique<ParaxialUVCoordSystem>(p0, p1, p2, attribs))
-                  | kdl::value();
-      CHECK(material.usageCount() == 0u);
-
-      // test setMaterial
-      face.setMaterial(&material);
-      CHECK(material.usageCount() == 1u);
-      CHECK(material2.usageCount() == 0u);
-
-      {
-        // test copy constructor
-        const auto clone = face;
-        CHECK(material.usageCount() == 2u);
-      }
-
-      // test destructor
-      CHECK(material.usageCount() == 1u);
-
-      // test setMaterial with different material
-      face.setMaterial(&material2);
-      CHECK(material.usageCount() == 0u);
-      CHECK(material2.usageCount() == 1u);
-
-      // test setMaterial with the same material
-      face.setMaterial(&material2);
-      CHECK(material2.usageCount() == 1u);
-    }
-
-    CHECK(material.usageCount() == 0u);
-    CHECK(material2.usageCount() == 0u);
-  }
-
   SECTION("projectedArea")
   {
     const auto worldBounds = vm::bbox3d{8192.0};
@@ -34,6 +34,7 @@
 #include "vm/intersection.h"
 
 #include <filesystem>
+#include <optional>
 
 #include "Catch2.h"
 
@@ -145,4 +146,39 @@ TEST_CASE("EntityModelTest.buildRenderer.defaultSkinIndex")
   CHECK(renderer1 != nullptr);
   CHECK(renderer2 != nullptr);
 }
+
+TEST_CASE("EntityModelTest.frameIntersect")
+{
+  auto modelData = EntityModelData{PitchType::Normal, Orientation::Oriented};
+  auto& frame = modelData.addFrame("test", vm::bbox3f{0, 32});
+  auto& surface = modelData.addSurface("surface", 1);
+
+  const auto addTriangle = [&](const float x) {
+    auto size = render::IndexRangeMap::Size{};
+    size.inc(render::PrimType::Triangles, 1);
+
+    auto builder = render::IndexRangeMapBuilder<EntityModelVertex::Type>{3, size};
+    builder.addTriangle(
+      EntityModelVertex{{x, 0, 0}, {0, 0}},
+      EntityModelVertex{{x + 8, 0, 0}, {0, 0}},
+      EntityModelVertex{{x, 8, 0}, {0, 0}});
+    surface.addMesh(frame, builder.vertices(), builder.indices());
+  };
+
+  const auto ray1 = vm::ray3f{{2, 2, 16}, {0, 0, -1}};
+  const auto ray2 = vm::ray3f{{18, 2, 16}, {0, 0, -1}};
+
+  addTriangle(0);
+
+  // builds the spacial tree
+  CHECK(std::optional{16.0f} == vm::optional_approx(frame.intersect(ray1)));
+  CHECK(frame.intersect(ray2) == std::nullopt);
+
+  // adding more primitives invalidates the spacial tree
+  addTriangle(16);
+
+  CHECK(std::optional{16.0f} == vm::optional_approx(frame.intersect(ray1)));
+  CHECK(std::optional{16.0f} == vm::optional_approx(frame.intersect(ray2)));
+}
+
 } // namespace tb::mdl
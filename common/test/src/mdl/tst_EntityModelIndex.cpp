@@ -0,0 +1,113 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "mdl/Entity.h"
+#include "mdl/EntityModel.h"
+#include "mdl/EntityModelIndex.h"
+#include "mdl/EntityNode.h"
+#include "mdl/LayerNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/Resource.h"
+#include "mdl/WorldNode.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::mdl
+{
+using namespace Catch::Matchers;
+
+namespace
+{
+
+auto makeModel(const std::string& name)
+{
+  auto modelResource = std::make_shared<EntityModelDataResource>([]() {
+    auto modelData = EntityModelData{PitchType::Normal, Orientation::Oriented};
+    modelData.addFrame("frame", vm::bbox3f{{-8, -8, -8}, {8, 8, 24}});
+    return Result<EntityModelData>{std::move(modelData)};
+  });
+  return EntityModel{name, std::move(modelResource)};
+}
+
+} // namespace
+
+TEST_CASE("EntityModelIndex")
+{
+  const auto model1 = makeModel("model1");
+  const auto model2 = makeModel("model2");
+
+  auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
+  const auto& index = worldNode.entityModelIndex();
+
+  auto* entityNode1 = new EntityNode{Entity{}};
+  auto* entityNode2 = new EntityNode{Entity{}};
+  entityNode1->setModel(&model1);
+  entityNode2->setModel(&model2);
+
+  worldNode.defaultLayer()->addChildren({entityNode1, entityNode2});
+
+  CHECK_THAT(
+    index.findEntityNodes({&model1}),
+    UnorderedEquals(std::vector<EntityNodeBase*>{entityNode1}));
+  CHECK_THAT(
+    index.findEntityNodes({&model1, &model2}),
+    UnorderedEquals(std::vector<EntityNodeBase*>{entityNode1, entityNode2}));
+
+  SECTION("Setting a model updates the index")
+  {
+    entityNode1->setModel(&model2);
+    CHECK(index.findEntityNodes({&model1}).empty());
+    CHECK_THAT(
+      index.findEntityNodes({&model2}),
+      UnorderedEquals(std::vector<EntityNodeBase*>{entityNode1, entityNode2}));
+
+    entityNode2->setModel(nullptr);
+    CHECK_THAT(
+      index.findEntityNodes({&model2}),
+      UnorderedEquals(std::vector<EntityNodeBase*>{entityNode1}));
+  }
+
+  SECTION("Setting an entity updates the index")
+  {
+    auto entity = entityNode1->entity();
+    entity.setModel(&model2);
+    entityNode1->setEntity(std::move(entity));
+
+    CHECK(index.findEntityNodes({&model1}).empty());
+    CHECK_THAT(
+      index.findEntityNodes({&model2}),
+      UnorderedEquals(std::vector<EntityNodeBase*>{entityNode1, entityNode2}));
+  }
+
+  SECTION("Removing a node updates the index")
+  {
+    worldNode.defaultLayer()->removeChild(entityNode2);
+    CHECK(index.findEntityNodes({&model2}).empty());
+    delete entityNode2;
+  }
+}
+
+} // namespace tb::mdl
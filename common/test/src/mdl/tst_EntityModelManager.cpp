@@ -0,0 +1,105 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Logger.h"
+#include "TestUtils.h"
+#include "mdl/EntityModel.h"
+#include "mdl/EntityModelManager.h"
+#include "mdl/Game.h" // IWYU pragma: keep
+#include "mdl/Resource.h"
+
+#include "kdl/task_manager.h"
+
+#include <filesystem>
+#include <memory>
+#include <variant>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::mdl
+{
+
+TEST_CASE("EntityModelManager")
+{
+  auto logger = NullLogger{};
+  auto taskManager = createTestTaskManager();
+  auto [game, gameConfig] = loadGame("Quake");
+
+  auto resources = std::vector<std::shared_ptr<EntityModelDataResource>>{};
+  auto manager = EntityModelManager{
+    [&](auto resourceLoader) {
+      auto resource =
+        std::make_shared<EntityModelDataResource>(std::move(resourceLoader));
+      resources.push_back(resource);
+      return resource;
+    },
+    logger};
+  manager.setGame(game.get(), *taskManager);
+
+  const auto path = std::filesystem::path{"cube.bsp"};
+
+  SECTION("Loads requested models")
+  {
+    REQUIRE(manager.model(path) != nullptr);
+    REQUIRE(resources.size() == 1);
+
+    resources.front()->loadSync();
+    CHECK(std::holds_alternative<ResourceLoaded<EntityModelData>>(
+      resources.front()->state()));
+  }
+
+  SECTION("Cancels pending loads when cleared")
+  {
+    REQUIRE(manager.model(path) != nullptr);
+    REQUIRE(resources.size() == 1);
+
+    manager.clear();
+
+    resources.front()->loadSync();
+    CHECK(
+      resources.front()->state()
+      == ResourceState<EntityModelData>{ResourceFailed{"Loading cancelled"}});
+
+    SECTION("Models requested after clearing are loaded")
+    {
+      REQUIRE(manager.model(path) != nullptr);
+      REQUIRE(resources.size() == 2);
+
+      resources.back()->loadSync();
+      CHECK(std::holds_alternative<ResourceLoaded<EntityModelData>>(
+        resources.back()->state()));
+    }
+  }
+
+  SECTION("Cancels pending loads when the game changes")
+  {
+    REQUIRE(manager.model(path) != nullptr);
+    REQUIRE(resources.size() == 1);
+
+    manager.setGame(game.get(), *taskManager);
+
+    resources.front()->loadSync();
+    CHECK(
+      resources.front()->state()
+      == ResourceState<EntityModelData>{ResourceFailed{"Loading cancelled"}});
+  }
+}
+
+} // namespace tb::mdl
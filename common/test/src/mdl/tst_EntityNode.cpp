@@ -17,12 +17,14 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "el/Expression.h"
 #include "mdl/BezierPatch.h"
 #include "mdl/Brush.h"
 #include "mdl/BrushBuilder.h"
 #include "mdl/BrushNode.h"
 #include "mdl/Entity.h"
 #include "mdl/EntityDefinition.h"
+#include "mdl/EntityModel.h"
 #include "mdl/EntityNode.h"
 #include "mdl/EntityProperties.h"
 #include "mdl/EntityRotation.h"
@@ -32,6 +34,7 @@
 #include "mdl/LayerNode.h"
 #include "mdl/MapFormat.h"
 #include "mdl/PatchNode.h"
+#include "mdl/Resource.h"
 #include "mdl/WorldNode.h"
 
 #include "kdl/result.h"
@@ -146,6 +149,41 @@ TEST_CASE("EntityNodeTest.area")
   CHECK(entityNode.projectedArea(vm::axis::z) == 2.0);
 }
 
+TEST_CASE("EntityNodeTest.modelDidLoad")
+{
+  const auto definition = EntityDefinition{
+    "some_name",
+    Color{},
+    "",
+    {},
+    PointEntityDefinition{
+      vm::bbox3d{32.0},
+      ModelDefinition{el::ExpressionNode{el::MapExpression{{}}}},
+      {},
+    },
+  };
+
+  auto modelResource = std::make_shared<EntityModelDataResource>([]() {
+    auto modelData = EntityModelData{PitchType::Normal, Orientation::Oriented};
+    modelData.addFrame("frame", vm::bbox3f{{-8, -8, -8}, {8, 8, 24}});
+    return Result<EntityModelData>{std::move(modelData)};
+  });
+  const auto model = EntityModel{"model", modelResource};
+
+  auto entityNode = EntityNode{Entity{}};
+  entityNode.setDefinition(&definition);
+  entityNode.setModel(&model);
+
+  REQUIRE(model.data() == nullptr);
+  CHECK(entityNode.modelBounds() == EntityNode::DefaultBounds);
+
+  modelResource->loadSync();
+  REQUIRE(model.data() != nullptr);
+
+  entityNode.modelDidLoad();
+  CHECK(entityNode.modelBounds() == vm::bbox3d{{-8, -8, -8}, {8, 8, 24}});
+}
+
 static const std::string TestClassname = "something";
 
 class EntityNodeTest
@@ -0,0 +1,174 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/Entity.h"
+#include "mdl/EntityNode.h"
+#include "mdl/FilePositionIndex.h"
+#include "mdl/Group.h"
+#include "mdl/GroupNode.h"
+#include "mdl/LayerNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/WorldNode.h"
+
+#include "kdl/vector_utils.h"
+
+#include <memory>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::mdl
+{
+
+TEST_CASE("FilePositionIndex")
+{
+  /*
+  - world
+    - defaultLayer
+      - entity1                 4,  6
+      - outerGroup             10, 30
+        - entity2              12, 15
+        - innerGroup           16, 29
+          - entity3            20, 25
+      - entity4                30, 35
+      - entity5                 0,  0
+  */
+
+  auto world = WorldNode{{}, {}, MapFormat::Standard};
+  auto& layer = *world.defaultLayer();
+
+  auto* entity1 = new EntityNode{Entity{}};
+  auto* outerGroup = new GroupNode{Group{"outer"}};
+  auto* entity2 = new EntityNode{Entity{}};
+  auto* innerGroup = new GroupNode{Group{"inner"}};
+  auto* entity3 = new EntityNode{Entity{}};
+  auto* entity4 = new EntityNode{Entity{}};
+  auto* entity5 = new EntityNode{Entity{}};
+
+  entity1->setFilePosition(4, 2);
+  outerGroup->setFilePosition(10, 20);
+  entity2->setFilePosition(12, 3);
+  innerGroup->setFilePosition(16, 13);
+  entity3->setFilePosition(20, 5);
+  entity4->setFilePosition(30, 5);
+
+  innerGroup->addChild(entity3);
+  outerGroup->addChildren({entity2, innerGroup});
+  layer.addChildren({entity1, outerGroup, entity4, entity5});
+
+  const auto& index = world.filePositionIndex();
+
+  CHECK(index.findNodes({}) == std::vector<Node*>{});
+  CHECK(index.findNodes({0}) == std::vector<Node*>{});
+  CHECK(index.findNodes({4}) == std::vector<Node*>{entity1});
+  CHECK(index.findNodes({5}) == std::vector<Node*>{entity1});
+  CHECK(index.findNodes({6}) == std::vector<Node*>{});
+  CHECK(index.findNodes({10}) == std::vector<Node*>{outerGroup});
+  CHECK(index.findNodes({13}) == std::vector<Node*>{outerGroup, entity2});
+  CHECK(index.findNodes({17}) == std::vector<Node*>{outerGroup, innerGroup});
+  CHECK(
+    index.findNodes({22}) == std::vector<Node*>{outerGroup, innerGroup, entity3});
+  CHECK(index.findNodes({30}) == std::vector<Node*>{entity4});
+  CHECK(
+    index.findNodes({31, 5, 13, 14})
+    == std::vector<Node*>{entity1, outerGroup, entity2, entity4});
+
+  SECTION("Removing nodes removes their entries")
+  {
+    layer.removeChild(outerGroup);
+    const auto removedNode = std::unique_ptr<Node>{outerGroup};
+
+    CHECK(index.findNodes({13, 22}) == std::vector<Node*>{});
+    CHECK(index.findNodes({4, 30}) == std::vector<Node*>{entity1, entity4});
+  }
+
+  SECTION("Adding nodes with a file position")
+  {
+    auto* entity6 = new EntityNode{Entity{}};
+    entity6->setFilePosition(40, 3);
+    layer.addChild(entity6);
+
+    CHECK(index.findNodes({41}) == std::vector<Node*>{entity6});
+  }
+
+  SECTION("Adding nodes without a file position")
+  {
+    auto* entity6 = new EntityNode{Entity{}};
+    layer.addChild(entity6);
+
+    CHECK(index.findNodes({0, 41}) == std::vector<Node*>{});
+  }
+
+  SECTION("Re-adding removed nodes")
+  {
+    layer.removeChild(outerGroup);
+    CHECK(index.findNodes({22}) == std::vector<Node*>{});
+
+    layer.addChild(outerGroup);
+    CHECK(
+      index.findNodes({22}) == std::vector<Node*>{outerGroup, innerGroup, entity3});
+  }
+
+  SECTION("Invalidating the index")
+  {
+    entity1->setFilePosition(50, 2);
+    entity5->setFilePosition(4, 2);
+
+    // stale entries are returned until the index is invalidated
+    CHECK(index.findNodes({4}) == std::vector<Node*>{entity1});
+
+    world.invalidateFilePositionIndex();
+    CHECK(index.findNodes({4}) == std::vector<Node*>{entity5});
+    CHECK(index.findNodes({51}) == std::vector<Node*>{entity1});
+  }
+}
+
+TEST_CASE("FilePositionIndex.manyNodes")
+{
+  auto world = WorldNode{{}, {}, MapFormat::Standard};
+  auto& layer = *world.defaultLayer();
+
+  // nested groups with overlapping ranges of different lengths, in file order
+  auto nodes = std::vector<Node*>{};
+  for (size_t i = 0; i < 100; ++i)
+  {
+    auto* group = new GroupNode{Group{"group"}};
+    group->setFilePosition(i * 10, 10);
+
+    auto* entity = new EntityNode{Entity{}};
+    entity->setFilePosition(i * 10 + 1, (i % 7) * 3 + 1);
+    group->addChild(entity);
+    layer.addChild(group);
+    nodes.push_back(group);
+    nodes.push_back(entity);
+  }
+
+  const auto& index = world.filePositionIndex();
+  for (size_t lineNumber = 0; lineNumber < 1050; ++lineNumber)
+  {
+    CAPTURE(lineNumber);
+
+    const auto expected = kdl::vec_filter(
+      nodes, [&](const auto* node) { return node->containsLine(lineNumber); });
+
+    CHECK(index.findNodes({lineNumber}) == expected);
+  }
+}
+
+} // namespace tb::mdl
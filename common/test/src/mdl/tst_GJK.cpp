@@ -0,0 +1,206 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/GJK.h"
+#include "mdl/Polyhedron.h"
+#include "mdl/Polyhedron3.h"
+
+#include "kdl/vector_utils.h"
+
+#include "vm/bbox.h"
+#include "vm/vec.h"
+#include "vm/vec_io.h" // IWYU pragma: keep
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::mdl
+{
+namespace
+{
+
+Polyhedron3 makeCube(const vm::vec3d& min, const double size)
+{
+  return Polyhedron3{vm::bbox3d{min, min + vm::vec3d{size, size, size}}};
+}
+
+std::vector<vm::vec3d> randomPoints(
+  std::mt19937& rng, const size_t count, const vm::vec3d& offset)
+{
+  auto dist = std::uniform_int_distribution<int>{-16, 16};
+
+  auto result = std::vector<vm::vec3d>{};
+  result.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    result.push_back(offset + vm::vec3d(dist(rng), dist(rng), dist(rng)));
+  }
+  return result;
+}
+
+Polyhedron3 randomPolyhedron(std::mt19937& rng, const vm::vec3d& offset)
+{
+  auto countDist = std::uniform_int_distribution<size_t>{4, 16};
+  while (true)
+  {
+    auto result = Polyhedron3{randomPoints(rng, countDist(rng), offset)};
+    if (result.polyhedron())
+    {
+      return result;
+    }
+  }
+}
+
+bool separates(const vm::vec3d& axis, const Polyhedron3& lhs, const Polyhedron3& rhs)
+{
+  auto lhsMin = std::numeric_limits<double>::max();
+  for (const auto* vertex : lhs.vertices())
+  {
+    lhsMin = std::min(lhsMin, vm::dot(axis, vertex->position()));
+  }
+
+  auto rhsMax = std::numeric_limits<double>::lowest();
+  for (const auto* vertex : rhs.vertices())
+  {
+    rhsMax = std::max(rhsMax, vm::dot(axis, vertex->position()));
+  }
+
+  return lhsMin > rhsMax;
+}
+
+} // namespace
+
+TEST_CASE("gjkIntersects")
+{
+  const auto cube = makeCube({0, 0, 0}, 16);
+
+  SECTION("Empty polyhedra")
+  {
+    CHECK_FALSE(gjkIntersects(Polyhedron3{}, cube));
+    CHECK_FALSE(gjkIntersects(cube, Polyhedron3{}));
+  }
+
+  SECTION("Identical polyhedra")
+  {
+    CHECK(gjkIntersects(cube, cube));
+  }
+
+  SECTION("Contained polyhedra")
+  {
+    const auto inner = makeCube({4, 4, 4}, 8);
+    CHECK(gjkIntersects(cube, inner));
+    CHECK(gjkIntersects(inner, cube));
+  }
+
+  SECTION("Overlapping polyhedra")
+  {
+    const auto other = makeCube({8, 8, 8}, 16);
+    CHECK(gjkIntersects(cube, other));
+    CHECK(gjkIntersects(other, cube));
+  }
+
+  SECTION("Touching polyhedra")
+  {
+    const auto min = GENERATE(
+      vm::vec3d{16, 0, 0},
+      vm::vec3d{16, 8, 8},
+      vm::vec3d{16, 16, 0},
+      vm::vec3d{16, 16, 16},
+      vm::vec3d{-16, -16, -16});
+
+    const auto other = makeCube(min, 16);
+    CHECK(gjkIntersects(cube, other));
+    CHECK(gjkIntersects(other, cube));
+  }
+
+  SECTION("Touching a pyramid tip")
+  {
+    const auto pyramid = Polyhedron3{
+      vm::vec3d{8, 8, 16},
+      vm::vec3d{0, 0, 32},
+      vm::vec3d{16, 0, 32},
+      vm::vec3d{16, 16, 32},
+      vm::vec3d{0, 16, 32},
+    };
+    CHECK(gjkIntersects(cube, pyramid));
+    CHECK(gjkIntersects(pyramid, cube));
+  }
+
+  SECTION("Separate polyhedra")
+  {
+    const auto min = GENERATE(
+      vm::vec3d{17, 0, 0},
+      vm::vec3d{16.01, 16.01, 0},
+      vm::vec3d{-17, -17, -17},
+      vm::vec3d{0, 0, 32});
+
+    const auto other = makeCube(min, 16);
+
+    auto searchDirection = vm::vec3d{};
+    CHECK_FALSE(gjkIntersects(other, cube, searchDirection));
+    CHECK(separates(searchDirection, other, cube));
+
+    CHECK_FALSE(gjkIntersects(cube, other));
+  }
+
+  SECTION("Reusing the search direction")
+  {
+    auto searchDirection = vm::vec3d{};
+    CHECK_FALSE(gjkIntersects(makeCube({20, 0, 0}, 16), cube, searchDirection));
+    CHECK_FALSE(gjkIntersects(makeCube({19, 0, 0}, 16), cube, searchDirection));
+    CHECK(separates(searchDirection, makeCube({19, 0, 0}, 16), cube));
+    CHECK(gjkIntersects(makeCube({15, 0, 0}, 16), cube, searchDirection));
+  }
+
+  SECTION("Agrees with separating axis test on random polyhedra")
+  {
+    const auto seed = GENERATE(range(0u, 500u));
+    CAPTURE(seed);
+
+    auto rng = std::mt19937{seed};
+    auto offsetDist = std::uniform_int_distribution<int>{-32, 32};
+
+    const auto lhs = randomPolyhedron(rng, {0, 0, 0});
+    const auto offset = vm::vec3d(offsetDist(rng), offsetDist(rng), offsetDist(rng));
+    const auto rhs = randomPolyhedron(rng, offset);
+
+    CAPTURE(lhs.vertexPositions(), rhs.vertexPositions());
+
+    const auto expected = lhs.intersects(rhs);
+    CHECK(gjkIntersects(lhs, rhs) == expected);
+    CHECK(gjkIntersects(rhs, lhs) == expected);
+
+    auto searchDirection = vm::vec3d{};
+    if (!gjkIntersects(lhs, rhs, searchDirection))
+    {
+      CHECK(separates(searchDirection, lhs, rhs));
+
+      // a polyhedron moved towards the other one is found with the cached direction
+      const auto moved = Polyhedron3{kdl::vec_transform(
+        lhs.vertexPositions(), [&](const auto& p) { return p + offset / 2.0; })};
+      CHECK(gjkIntersects(moved, rhs, searchDirection) == moved.intersects(rhs));
+    }
+  }
+}
+
+} // namespace tb::mdl
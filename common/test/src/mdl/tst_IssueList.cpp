@@ -0,0 +1,379 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NotifierConnection.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushNode.h"
+#include "mdl/EmptyGroupValidator.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityNode.h"
+#include "mdl/EntityProperties.h"
+#include "mdl/Group.h"
+#include "mdl/GroupNode.h"
+#include "mdl/Issue.h"
+#include "mdl/IssueList.h"
+#include "mdl/LayerNode.h"
+#include "mdl/LinkSourceValidator.h"
+#include "mdl/LinkTargetValidator.h"
+#include "mdl/MapFormat.h"
+#include "mdl/MissingClassnameValidator.h"
+#include "mdl/WorldNode.h"
+
+#include "kdl/result.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::mdl
+{
+namespace
+{
+
+/**
+ * Applies the change notifications of an issue list to a copy of its rows.
+ */
+class IssueListMirror
+{
+private:
+  std::vector<const Issue*> m_rows;
+  size_t m_firstInsertedRow = 0;
+  size_t m_lastInsertedRow = 0;
+  NotifierConnection m_notifierConnection;
+
+public:
+  explicit IssueListMirror(IssueList& list)
+    : m_rows{list.issues()}
+  {
+    m_notifierConnection +=
+      list.rowsWillBeInsertedNotifier.connect([&](const size_t first, const size_t last) {
+        m_firstInsertedRow = first;
+        m_lastInsertedRow = last;
+      });
+    m_notifierConnection += list.rowsWereInsertedNotifier.connect([&]() {
+      const auto first = list.issues().begin() + std::ptrdiff_t(m_firstInsertedRow);
+      const auto last = list.issues().begin() + std::ptrdiff_t(m_lastInsertedRow + 1);
+      m_rows.insert(m_rows.begin() + std::ptrdiff_t(m_firstInsertedRow), first, last);
+    });
+    m_notifierConnection +=
+      list.rowsWillBeRemovedNotifier.connect([&](const size_t first, const size_t last) {
+        m_rows.erase(
+          m_rows.begin() + std::ptrdiff_t(first),
+          m_rows.begin() + std::ptrdiff_t(last + 1));
+      });
+    m_notifierConnection +=
+      list.listWasResetNotifier.connect([&]() { m_rows = list.issues(); });
+  }
+
+  const std::vector<const Issue*>& rows() const { return m_rows; }
+};
+
+std::vector<const Issue*> rebuildIssues(
+  WorldNode& world, const IssueType hiddenIssueTypes, const bool showHiddenIssues)
+{
+  auto list = IssueList{};
+  list.reset(world, hiddenIssueTypes, showHiddenIssues);
+  return list.issues();
+}
+
+} // namespace
+
+TEST_CASE("IssueList")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  auto brushBuilder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto world = WorldNode{{}, {}, MapFormat::Standard};
+  world.registerValidator(std::make_unique<MissingClassnameValidator>());
+  world.registerValidator(std::make_unique<EmptyGroupValidator>());
+
+  const auto missingClassnameType = world.registeredValidators()[0]->type();
+  const auto emptyGroupType = world.registeredValidators()[1]->type();
+
+  auto& layer = *world.defaultLayer();
+
+  auto* entityWithoutClassname = new EntityNode{Entity{}};
+  auto* entityWithClassname =
+    new EntityNode{Entity{{{EntityPropertyKeys::Classname, "light"}}}};
+  auto* emptyGroup = new GroupNode{Group{"empty"}};
+  auto* groupWithBrush = new GroupNode{Group{"brush"}};
+  groupWithBrush->addChild(
+    new BrushNode{brushBuilder.createCube(64.0, "material") | kdl::value()});
+  auto* groupWithEntity = new GroupNode{Group{"entity"}};
+  auto* nestedEntity = new EntityNode{Entity{}};
+  groupWithEntity->addChild(nestedEntity);
+
+  layer.addChildren({
+    entityWithoutClassname,
+    entityWithClassname,
+    emptyGroup,
+    groupWithBrush,
+    groupWithEntity,
+  });
+
+  auto hiddenIssueTypes = IssueType(0);
+  auto showHiddenIssues = false;
+
+  auto list = IssueList{};
+  list.reset(world, hiddenIssueTypes, showHiddenIssues);
+
+  auto mirror = IssueListMirror{list};
+
+  const auto checkIssues = [&]() {
+    CHECK(list.issues() == rebuildIssues(world, hiddenIssueTypes, showHiddenIssues));
+    CHECK(mirror.rows() == list.issues());
+    CHECK(std::ranges::is_sorted(list.issues(), std::greater<>{}, &Issue::seqId));
+  };
+
+  REQUIRE(list.issues().size() == 3u);
+  checkIssues();
+
+  SECTION("Adding nodes")
+  {
+    auto* newEntity = new EntityNode{Entity{}};
+    auto* newGroup = new GroupNode{Group{"new"}};
+    auto* newNestedEntity = new EntityNode{Entity{}};
+    newGroup->addChild(newNestedEntity);
+
+    layer.addChildren({newEntity, newGroup});
+    list.addNodes({newEntity, newGroup});
+
+    // issues are only inserted on update
+    CHECK(list.issues().size() == 3u);
+
+    list.update();
+    CHECK(list.issues().size() == 5u);
+    CHECK(&list.issues()[0]->node() == newNestedEntity);
+    CHECK(&list.issues()[1]->node() == newEntity);
+    checkIssues();
+  }
+
+  SECTION("Removing nodes")
+  {
+    SECTION("Removing a node without descendants")
+    {
+      layer.removeChild(emptyGroup);
+      const auto removedNode = std::unique_ptr<Node>{emptyGroup};
+
+      list.removeNodes({emptyGroup});
+      CHECK(list.issues().size() == 2u);
+      checkIssues();
+    }
+
+    SECTION("Removing a node with descendants")
+    {
+      layer.removeChild(groupWithEntity);
+      const auto removedNode = std::unique_ptr<Node>{groupWithEntity};
+
+      list.removeNodes({groupWithEntity});
+      CHECK(list.issues().size() == 2u);
+      checkIssues();
+    }
+
+    SECTION("Removing a pending node")
+    {
+      auto* newEntity = new EntityNode{Entity{}};
+      layer.addChild(newEntity);
+      list.addNodes({newEntity});
+
+      layer.removeChild(newEntity);
+      const auto removedNode = std::unique_ptr<Node>{newEntity};
+      list.removeNodes({newEntity});
+
+      list.update();
+      CHECK(list.issues().size() == 3u);
+      checkIssues();
+    }
+  }
+
+  SECTION("Changing nodes")
+  {
+    entityWithoutClassname->setEntity(
+      Entity{{{EntityPropertyKeys::Classname, "info_player_start"}}});
+    entityWithClassname->setEntity(Entity{});
+
+    list.updateNodes({entityWithoutClassname, entityWithClassname});
+    CHECK(list.issues().size() == 2u);
+
+    list.update();
+    CHECK(list.issues().size() == 3u);
+    CHECK(&list.issues()[0]->node() == entityWithClassname);
+    checkIssues();
+  }
+
+  SECTION("Updating unchanged nodes")
+  {
+    list.updateNodes({entityWithoutClassname, emptyGroup});
+    list.updateNodes({entityWithoutClassname});
+    list.addNodes({emptyGroup});
+    list.update();
+
+    CHECK(list.issues().size() == 3u);
+    checkIssues();
+  }
+
+  SECTION("Hiding issues")
+  {
+    showHiddenIssues = GENERATE(true, false);
+    list.reset(world, hiddenIssueTypes, showHiddenIssues);
+
+    entityWithoutClassname->setIssueHidden(missingClassnameType, true);
+    list.updateNodes({entityWithoutClassname});
+    list.update();
+
+    CHECK(list.issues().size() == (showHiddenIssues ? 3u : 2u));
+    checkIssues();
+  }
+
+  SECTION("Filtering issue types")
+  {
+    hiddenIssueTypes = emptyGroupType;
+    list.reset(world, hiddenIssueTypes, showHiddenIssues);
+    CHECK(list.issues().size() == 2u);
+    checkIssues();
+
+    auto* newGroup = new GroupNode{Group{"new"}};
+    layer.addChild(newGroup);
+    list.addNodes({newGroup});
+    list.update();
+
+    CHECK(list.issues().size() == 2u);
+    checkIssues();
+  }
+
+  SECTION("Changing many nodes")
+  {
+    auto entities = std::vector<EntityNode*>{};
+    for (size_t i = 0; i < 200; ++i)
+    {
+      entities.push_back(new EntityNode{Entity{}});
+    }
+    layer.addChildren({entities.begin(), entities.end()});
+    list.addNodes({entities.begin(), entities.end()});
+    list.update();
+
+    CHECK(list.issues().size() == 203u);
+    checkIssues();
+
+    auto everyOtherEntity = std::vector<Node*>{};
+    for (size_t i = 0; i < entities.size(); i += 2)
+    {
+      everyOtherEntity.push_back(entities[i]);
+    }
+
+    SECTION("Removing and adding scattered nodes")
+    {
+      for (auto* entity : everyOtherEntity)
+      {
+        layer.removeChild(entity);
+      }
+      list.removeNodes(everyOtherEntity);
+      CHECK(list.issues().size() == 103u);
+      checkIssues();
+
+      layer.addChildren(everyOtherEntity);
+      list.addNodes(everyOtherEntity);
+      list.update();
+      CHECK(list.issues().size() == 203u);
+      checkIssues();
+    }
+
+    SECTION("Changing scattered nodes")
+    {
+      for (auto* node : everyOtherEntity)
+      {
+        static_cast<EntityNode*>(node)->setEntity(
+          Entity{{{EntityPropertyKeys::Classname, "light"}}});
+      }
+      list.updateNodes(everyOtherEntity);
+      list.update();
+      CHECK(list.issues().size() == 103u);
+      checkIssues();
+    }
+  }
+
+  SECTION("Clearing")
+  {
+    list.addNodes({entityWithClassname});
+    list.clear();
+    list.update();
+
+    CHECK(list.issues().empty());
+    CHECK(mirror.rows().empty());
+  }
+}
+
+TEST_CASE("IssueList.linkedEntities")
+{
+  auto world = WorldNode{{}, {}, MapFormat::Standard};
+  world.registerValidator(std::make_unique<LinkSourceValidator>());
+  world.registerValidator(std::make_unique<LinkTargetValidator>());
+
+  auto* sourceEntity = new EntityNode{Entity{{
+    {EntityPropertyKeys::Classname, "trigger_once"},
+    {EntityPropertyKeys::Target, "door"},
+  }}};
+  auto* targetEntity = new EntityNode{Entity{{
+    {EntityPropertyKeys::Classname, "func_door"},
+    {EntityPropertyKeys::Targetname, "other"},
+  }}};
+  world.defaultLayer()->addChildren({sourceEntity, targetEntity});
+
+  auto list = IssueList{};
+  list.reset(world, IssueType(0), false);
+
+  auto mirror = IssueListMirror{list};
+
+  const auto checkIssues = [&]() {
+    CHECK(list.issues() == rebuildIssues(world, IssueType(0), false));
+    CHECK(mirror.rows() == list.issues());
+  };
+
+  const auto setTargetname = [&](const std::string& targetname) {
+    auto entity = targetEntity->entity();
+    entity.addOrUpdateProperty(EntityPropertyKeys::Targetname, targetname);
+    targetEntity->setEntity(std::move(entity));
+  };
+
+  // the source has a missing target and the target has an unused targetname
+  REQUIRE(list.issues().size() == 2u);
+  checkIssues();
+
+  // only the target is reported as changed, but linking also changes the source's issues
+  setTargetname("door");
+  list.updateNodes({targetEntity});
+  list.update();
+
+  CHECK(list.issues().empty());
+  checkIssues();
+
+  setTargetname("other");
+  list.updateNodes({targetEntity});
+  list.update();
+
+  CHECK(list.issues().size() == 2u);
+  checkIssues();
+}
+
+} // namespace tb::mdl
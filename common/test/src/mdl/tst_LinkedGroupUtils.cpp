@@ -203,6 +203,65 @@ TEST_CASE("collectLinkedGroups")
       std::vector<mdl::GroupNode*>{groupNode2, linkedGroupNode2_1, linkedGroupNode2_2}));
 }
 
+TEST_CASE("nodeSelectionWithLinkedGroupConstraints")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+
+  auto* outerGroupNode = new GroupNode{Group{"outer"}};
+  auto* innerGroupNode = new GroupNode{Group{"inner"}};
+  auto* entityNode = new EntityNode{Entity{}};
+  innerGroupNode->addChild(entityNode);
+  outerGroupNode->addChild(innerGroupNode);
+
+  setLinkId(*outerGroupNode, "outer");
+  setLinkId(*innerGroupNode, "inner");
+
+  auto* linkedOuterGroupNode =
+    static_cast<GroupNode*>(outerGroupNode->cloneRecursively(worldBounds));
+  auto* linkedInnerGroupNode =
+    static_cast<GroupNode*>(linkedOuterGroupNode->children()[0]);
+  auto* linkedEntityNode = linkedInnerGroupNode->children()[0];
+
+  auto* unlinkedEntityNode = new EntityNode{Entity{}};
+
+  worldNode.defaultLayer()->addChild(outerGroupNode);
+  worldNode.defaultLayer()->addChild(linkedOuterGroupNode);
+  worldNode.defaultLayer()->addChild(unlinkedEntityNode);
+
+  SECTION("Nodes outside of linked groups are not constrained")
+  {
+    const auto result =
+      nodeSelectionWithLinkedGroupConstraints(worldNode, {unlinkedEntityNode});
+    CHECK(result.nodesToSelect == std::vector<Node*>{unlinkedEntityNode});
+    CHECK(result.groupsToLock.empty());
+  }
+
+  SECTION("Selecting a node locks the other groups of its link sets")
+  {
+    const auto result = nodeSelectionWithLinkedGroupConstraints(
+      worldNode, {entityNode, unlinkedEntityNode});
+    CHECK(result.nodesToSelect == std::vector<Node*>{entityNode, unlinkedEntityNode});
+    CHECK_THAT(
+      result.groupsToLock,
+      Catch::Matchers::UnorderedEquals(
+        std::vector<GroupNode*>{linkedOuterGroupNode, linkedInnerGroupNode}));
+  }
+
+  SECTION("Only nodes in the first linked group are selected")
+  {
+    const auto result = nodeSelectionWithLinkedGroupConstraints(
+      worldNode, {linkedEntityNode, entityNode, innerGroupNode});
+    CHECK(result.nodesToSelect == std::vector<Node*>{linkedEntityNode});
+    CHECK_THAT(
+      result.groupsToLock,
+      Catch::Matchers::UnorderedEquals(
+        std::vector<GroupNode*>{outerGroupNode, innerGroupNode}));
+  }
+}
+
 TEST_CASE("updateLinkedGroups")
 {
   auto taskManager = kdl::task_manager{};
@@ -0,0 +1,299 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/BezierPatch.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushFaceHandle.h"
+#include "mdl/BrushNode.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityNode.h"
+#include "mdl/Group.h"
+#include "mdl/GroupNode.h"
+#include "mdl/LayerNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/Material.h"
+#include "mdl/MaterialIndex.h"
+#include "mdl/NodeQueries.h"
+#include "mdl/PatchNode.h"
+#include "mdl/Texture.h"
+#include "mdl/TextureResource.h"
+#include "mdl/WorldNode.h"
+
+#include "kdl/result.h"
+#include "kdl/vector_utils.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::mdl
+{
+namespace
+{
+
+Material createMaterial(std::string name)
+{
+  return Material{std::move(name), createTextureResource(Texture{16, 16})};
+}
+
+PatchNode* createPatchNode(Material* material)
+{
+  using P = BezierPatch::Point;
+
+  // clang-format off
+  auto* patchNode = new PatchNode{BezierPatch{3, 3, {
+    P{0, 0, 0}, P{1, 0, 1}, P{2, 0, 0},
+    P{0, 1, 1}, P{1, 1, 2}, P{2, 1, 1},
+    P{0, 2, 0}, P{1, 2, 1}, P{2, 2, 0}}, "material"}};
+  // clang-format on
+
+  patchNode->setMaterial(material);
+  return patchNode;
+}
+
+/**
+ * Checks the index of the given world against a scan of all brush faces and patches.
+ */
+void checkMaterialIndex(WorldNode& world, const std::vector<Material*>& materials)
+{
+  const auto& index = world.materialIndex();
+  const auto allFaces = collectBrushFaces({&world});
+  const auto allPatches = kdl::vec_static_cast<PatchNode*>(collectDescendants(
+    std::vector<Node*>{&world}, [](const PatchNode*) { return true; }));
+
+  for (const auto* material : materials)
+  {
+    CAPTURE(material->name());
+
+    const auto faces = kdl::vec_filter(allFaces, [&](const auto& faceHandle) {
+      return faceHandle.face().material() == material;
+    });
+    const auto patches = kdl::vec_filter(allPatches, [&](const auto* patchNode) {
+      return patchNode->patch().material() == material;
+    });
+
+    auto nodes = kdl::vec_concat(
+      kdl::vec_static_cast<Node*>(toNodes(faces)),
+      kdl::vec_static_cast<Node*>(patches));
+
+    CHECK(index.usageCount(material) == faces.size() + patches.size());
+    CHECK_THAT(index.findBrushFaces(material), Catch::Matchers::UnorderedEquals(faces));
+    CHECK_THAT(
+      index.findNodes(material),
+      Catch::Matchers::UnorderedEquals(
+        kdl::vec_sort_and_remove_duplicates(std::move(nodes))));
+  }
+}
+
+} // namespace
+
+TEST_CASE("MaterialIndex")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  auto brushBuilder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto material1 = createMaterial("material1");
+  auto material2 = createMaterial("material2");
+  auto material3 = createMaterial("material3");
+  const auto materials = std::vector<Material*>{&material1, &material2, &material3};
+
+  auto world = WorldNode{{}, {}, MapFormat::Standard};
+  auto& layer = *world.defaultLayer();
+
+  const auto createBrushNode = [&](Material* material) {
+    auto* brushNode =
+      new BrushNode{brushBuilder.createCube(64.0, "material") | kdl::value()};
+    for (size_t i = 0; i < brushNode->brush().faceCount(); ++i)
+    {
+      brushNode->setFaceMaterial(i, material);
+    }
+    return brushNode;
+  };
+
+  auto* brushNode = createBrushNode(&material1);
+  auto* patchNode = createPatchNode(&material2);
+
+  auto* entityNode = new EntityNode{Entity{}};
+  auto* brushInEntity = createBrushNode(&material2);
+  entityNode->addChild(brushInEntity);
+
+  auto* groupNode = new GroupNode{Group{"group"}};
+  auto* brushInGroup = createBrushNode(nullptr);
+  groupNode->addChild(brushInGroup);
+
+  layer.addChildren({brushNode, patchNode, entityNode, groupNode});
+
+  CHECK(world.materialIndex().usageCount(&material1) == 6u);
+  CHECK(world.materialIndex().usageCount(&material2) == 7u);
+  CHECK(world.materialIndex().usageCount(&material3) == 0u);
+  checkMaterialIndex(world, materials);
+
+  SECTION("Setting face materials")
+  {
+    brushNode->setFaceMaterial(0, &material3);
+    brushNode->setFaceMaterial(1, &material3);
+    brushInGroup->setFaceMaterial(2, &material1);
+    brushInEntity->setFaceMaterial(3, nullptr);
+
+    CHECK(world.materialIndex().usageCount(&material1) == 5u);
+    CHECK(world.materialIndex().usageCount(&material2) == 6u);
+    CHECK(world.materialIndex().usageCount(&material3) == 2u);
+    checkMaterialIndex(world, materials);
+  }
+
+  SECTION("Setting patch materials")
+  {
+    patchNode->setMaterial(&material3);
+    checkMaterialIndex(world, materials);
+
+    patchNode->setMaterial(nullptr);
+    checkMaterialIndex(world, materials);
+  }
+
+  SECTION("Swapping node contents")
+  {
+    auto brush = brushNode->brush();
+    brush.face(0).setMaterial(&material3);
+    brushNode->setBrush(std::move(brush));
+    checkMaterialIndex(world, materials);
+
+    auto patch = patchNode->patch();
+    patch.setMaterial(&material1);
+    patchNode->setPatch(std::move(patch));
+    checkMaterialIndex(world, materials);
+  }
+
+  SECTION("Removing and adding nodes")
+  {
+    layer.removeChild(entityNode);
+    CHECK(world.materialIndex().usageCount(&material2) == 1u);
+    checkMaterialIndex(world, materials);
+
+    // changes to detached nodes do not affect the index
+    brushInEntity->setFaceMaterial(0, &material3);
+    CHECK(world.materialIndex().usageCount(&material3) == 0u);
+
+    layer.addChild(entityNode);
+    CHECK(world.materialIndex().usageCount(&material3) == 1u);
+    checkMaterialIndex(world, materials);
+  }
+
+  SECTION("Nodes are returned in the order in which they started using a material")
+  {
+    auto* brushNode1 = createBrushNode(&material3);
+    auto* brushNode2 = createBrushNode(&material3);
+    auto* brushNode3 = createBrushNode(&material3);
+    layer.addChildren({brushNode1, brushNode2, brushNode3});
+
+    CHECK(
+      world.materialIndex().findNodes(&material3)
+      == std::vector<Node*>{brushNode1, brushNode2, brushNode3});
+
+    for (size_t i = 0; i < brushNode1->brush().faceCount(); ++i)
+    {
+      brushNode1->setFaceMaterial(i, &material1);
+    }
+    CHECK(
+      world.materialIndex().findNodes(&material3)
+      == std::vector<Node*>{brushNode2, brushNode3});
+
+    brushNode1->setFaceMaterial(0, &material3);
+    CHECK(
+      world.materialIndex().findNodes(&material3)
+      == std::vector<Node*>{brushNode2, brushNode3, brushNode1});
+    CHECK(
+      toNodes(world.materialIndex().findBrushFaces(&material3))
+      == std::vector<BrushNode*>{
+        brushNode2,
+        brushNode2,
+        brushNode2,
+        brushNode2,
+        brushNode2,
+        brushNode2,
+        brushNode3,
+        brushNode3,
+        brushNode3,
+        brushNode3,
+        brushNode3,
+        brushNode3,
+        brushNode1,
+      });
+  }
+
+  SECTION("Random changes")
+  {
+    auto brushNodes = std::vector<BrushNode*>{brushNode, brushInEntity, brushInGroup};
+    auto patchNodes = std::vector<PatchNode*>{patchNode};
+
+    auto rng = std::mt19937{GENERATE(1u, 2u, 3u)};
+    const auto randomIndex = [&](const size_t size) {
+      return std::uniform_int_distribution<size_t>{0, size - 1}(rng);
+    };
+    const auto randomMaterial = [&]() -> Material* {
+      const auto i = randomIndex(materials.size() + 1);
+      return i < materials.size() ? materials[i] : nullptr;
+    };
+
+    for (size_t i = 0; i < 200; ++i)
+    {
+      switch (randomIndex(5))
+      {
+      case 0: {
+        auto* node = brushNodes[randomIndex(brushNodes.size())];
+        node->setFaceMaterial(randomIndex(node->brush().faceCount()), randomMaterial());
+        break;
+      }
+      case 1:
+        patchNodes[randomIndex(patchNodes.size())]->setMaterial(randomMaterial());
+        break;
+      case 2: {
+        auto* node = createBrushNode(randomMaterial());
+        groupNode->addChild(node);
+        brushNodes.push_back(node);
+        break;
+      }
+      case 3: {
+        auto* node = createPatchNode(randomMaterial());
+        layer.addChild(node);
+        patchNodes.push_back(node);
+        break;
+      }
+      case 4: {
+        auto* node = brushNodes[randomIndex(brushNodes.size())];
+        auto brush = node->brush();
+        brush.face(randomIndex(brush.faceCount())).setMaterial(randomMaterial());
+        node->setBrush(std::move(brush));
+        break;
+      }
+      }
+    }
+
+    checkMaterialIndex(world, materials);
+
+    layer.removeChild(groupNode);
+    checkMaterialIndex(world, materials);
+    delete groupNode;
+  }
+}
+
+} // namespace tb::mdl
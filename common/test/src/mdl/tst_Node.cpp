@@ -39,6 +39,10 @@
 #include "kdl/result.h"
 #include "kdl/vector_utils.h"
 
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <string>
 #include <variant>
 #include <vector>
 
@@ -249,6 +253,69 @@ private: // implement Node interface
   void doAcceptTagVisitor(ConstTagVisitor& /* visitor */) const override {}
 };
 
+class RecordingNode : public TestNode
+{
+private:
+  std::string m_recordingName;
+  std::vector<std::string>& m_calls;
+
+public:
+  RecordingNode(std::string name, std::vector<std::string>& calls)
+    : m_recordingName{std::move(name)}
+    , m_calls{calls}
+  {
+  }
+
+private:
+  std::string nameOf(const Node* node) const
+  {
+    return static_cast<const RecordingNode*>(node)->m_recordingName;
+  }
+
+  void record(const std::string& call)
+  {
+    m_calls.push_back(m_recordingName + " " + call);
+  }
+
+  void doChildWillBeAdded(Node* node) override
+  {
+    record("child will be added " + nameOf(node));
+  }
+  void doChildWasAdded(Node* node) override { record("child was added " + nameOf(node)); }
+  void doChildWillBeRemoved(Node* node) override
+  {
+    record("child will be removed " + nameOf(node));
+  }
+  void doChildWasRemoved(Node* node) override
+  {
+    record("child was removed " + nameOf(node));
+  }
+
+  void doDescendantsWillBeAdded(
+    Node*, const std::vector<Node*>& nodes, const size_t depth) override
+  {
+    record(fmt::format("{} descendants will be added at {}", nodes.size(), depth));
+  }
+  void doDescendantsWereAdded(
+    const std::vector<Node*>& nodes, const size_t depth) override
+  {
+    record(fmt::format("{} descendants were added at {}", nodes.size(), depth));
+  }
+  void doDescendantsWillBeRemoved(
+    const std::vector<Node*>& nodes, const size_t depth) override
+  {
+    record(fmt::format("{} descendants will be removed at {}", nodes.size(), depth));
+  }
+  void doDescendantsWereRemoved(
+    Node*, const std::vector<Node*>& nodes, const size_t depth) override
+  {
+    record(fmt::format("{} descendants were removed at {}", nodes.size(), depth));
+  }
+
+  void doParentWillChange() override { record("parent will change"); }
+  void doParentDidChange() override { record("parent did change"); }
+};
+
 class DestroyableNode : public TestNode
 {
 private:
@@ -369,6 +436,135 @@ TEST_CASE("NodeTest.addRemoveChild")
   CHECK(childNode->familySize() == 3u);
 }
 
+TEST_CASE("NodeTest.addRemoveChildren")
+{
+  auto rootNode = TestNode{};
+  auto* parentNode = new TestNode{};
+  rootNode.addChild(parentNode);
+
+  auto children = std::vector<Node*>{};
+  for (size_t i = 0; i < 10; ++i)
+  {
+    auto* child = new TestNode{};
+    child->addChild(new TestNode{});
+    children.push_back(child);
+  }
+
+  parentNode->addChildren(children);
+  CHECK(parentNode->children() == children);
+  CHECK(parentNode->familySize() == 21u);
+  CHECK(rootNode.familySize() == 22u);
+  CHECK(std::ranges::all_of(
+    children, [&](const auto* child) { return child->parent() == parentNode; }));
+
+  auto removedChildren = std::vector<Node*>{};
+  auto remainingChildren = std::vector<Node*>{};
+  for (size_t i = 0; i < children.size(); ++i)
+  {
+    (i % 3 == 0 ? removedChildren : remainingChildren).push_back(children[i]);
+  }
+
+  parentNode->removeChildren(removedChildren.rbegin(), removedChildren.rend());
+  CHECK(parentNode->children() == remainingChildren);
+  CHECK(parentNode->familySize() == 13u);
+  CHECK(rootNode.familySize() == 14u);
+  CHECK(std::ranges::all_of(
+    removedChildren, [](const auto* child) { return child->parent() == nullptr; }));
+
+  parentNode->addChildren(removedChildren);
+  CHECK(parentNode->children() == kdl::vec_concat(remainingChildren, removedChildren));
+  CHECK(rootNode.familySize() == 22u);
+}
+
+TEST_CASE("NodeTest.addRemoveChildrenNotifications")
+{
+  auto calls = std::vector<std::string>{};
+
+  auto rootNode = RecordingNode{"root", calls};
+  auto* parentNode = new RecordingNode{"parent", calls};
+  rootNode.addChild(parentNode);
+
+  auto* child1 = new RecordingNode{"child1", calls};
+  auto* child2 = new RecordingNode{"child2", calls};
+
+  calls.clear();
+  parentNode->addChildren({child1, child2});
+  CHECK(
+    calls
+    == std::vector<std::string>{
+      "parent 2 descendants will be added at 1",
+      "root 2 descendants will be added at 2",
+      "parent child will be added child1",
+      "child1 parent will change",
+      "child1 parent did change",
+      "parent child was added child1",
+      "parent child will be added child2",
+      "child2 parent will change",
+      "child2 parent did change",
+      "parent child was added child2",
+      "parent 2 descendants were added at 1",
+      "root 2 descendants were added at 2",
+    });
+
+  calls.clear();
+  parentNode->removeChildren(std::vector<Node*>{child2, child1});
+  CHECK(
+    calls
+    == std::vector<std::string>{
+      "parent 2 descendants will be removed at 1",
+      "root 2 descendants will be removed at 2",
+      "parent child will be removed child2",
+      "child2 parent will change",
+      "child2 parent did change",
+      "parent child was removed child2",
+      "parent child will be removed child1",
+      "child1 parent will change",
+      "child1 parent did change",
+      "parent child was removed child1",
+      "parent 2 descendants were removed at 1",
+      "root 2 descendants were removed at 2",
+    });
+  CHECK(parentNode->children().empty());
+
+  delete child1;
+  delete child2;
+}
+
+TEST_CASE("NodeTest.removeChildrenUpdatesNodeTree")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
+  auto builder = BrushBuilder{worldNode.mapFormat(), worldBounds};
+
+  auto brushNodes = std::vector<Node*>{};
+  for (size_t i = 0; i < 16; ++i)
+  {
+    const auto min = vm::vec3d{double(i) * 32.0, 0, 0};
+    brushNodes.push_back(new BrushNode{
+      builder.createCuboid(vm::bbox3d{min, min + vm::vec3d{16, 16, 16}}, "material")
+      | kdl::value()});
+  }
+
+  auto* layerNode = worldNode.defaultLayer();
+  layerNode->addChildren(brushNodes);
+
+  auto removedNodes = std::vector<Node*>{};
+  for (size_t i = 0; i < brushNodes.size(); i += 2)
+  {
+    removedNodes.push_back(brushNodes[i]);
+  }
+  layerNode->removeChildren(removedNodes.begin(), removedNodes.end());
+
+  for (size_t i = 0; i < brushNodes.size(); ++i)
+  {
+    CHECK(worldNode.nodeTree().contains(brushNodes[i]) == (i % 2 != 0));
+  }
+  CHECK(layerNode->childCount() == brushNodes.size() / 2);
+  CHECK(worldNode.familySize() == brushNodes.size() / 2 + 2u);
+
+  kdl::vec_clear_and_delete(removedNodes);
+}
+
 TEST_CASE("NodeTest.replaceChildren")
 {
   auto rootNode = TestNode{};
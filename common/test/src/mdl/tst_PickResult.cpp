@@ -0,0 +1,142 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/Hit.h"
+#include "mdl/HitFilter.h"
+#include "mdl/PickResult.h"
+
+#include "kdl/vector_utils.h"
+
+#include "vm/vec.h"
+
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::mdl
+{
+namespace
+{
+
+const auto HitType1 = HitType::freeType();
+const auto HitType2 = HitType::freeType();
+
+Hit makeHit(const HitType::Type type, const double distance, const int target)
+{
+  return Hit{type, distance, vm::vec3d{distance, 0, 0}, target};
+}
+
+std::vector<int> targets(const std::vector<Hit>& hits)
+{
+  return kdl::vec_transform(
+    hits, [](const auto& hit) { return hit.template target<int>(); });
+}
+
+} // namespace
+
+TEST_CASE("Hit")
+{
+  SECTION("target")
+  {
+    CHECK(Hit{HitType1, 1.0, vm::vec3d{}, 7}.target<int>() == 7);
+    CHECK(Hit{HitType1, 1.0, vm::vec3d{}, size_t(7)}.target<size_t>() == 7u);
+    CHECK(
+      Hit{HitType1, 1.0, vm::vec3d{}, vm::vec3d{1, 2, 3}}.target<const vm::vec3d&>()
+      == vm::vec3d{1, 2, 3});
+    CHECK(
+      Hit{HitType1, 1.0, vm::vec3d{}, std::string{"target"}}.target<std::string>()
+      == "target");
+  }
+
+  SECTION("target types must match exactly")
+  {
+    CHECK_THROWS(Hit{HitType1, 1.0, vm::vec3d{}, 7}.target<size_t>());
+    CHECK_THROWS(Hit{HitType1, 1.0, vm::vec3d{}, 7.0f}.target<double>());
+  }
+}
+
+TEST_CASE("PickResult")
+{
+  using namespace HitFilters;
+
+  auto pickResult = PickResult{};
+
+  SECTION("Hits are sorted by distance")
+  {
+    pickResult.addHit(makeHit(HitType1, 3.0, 3));
+    pickResult.addHit(makeHit(HitType1, 1.0, 1));
+    pickResult.addHit(makeHit(HitType1, 2.0, 2));
+
+    CHECK(pickResult.size() == 3u);
+    CHECK(targets(pickResult.all()) == std::vector<int>{1, 2, 3});
+
+    pickResult.addHit(makeHit(HitType1, 0.0, 0));
+    CHECK(targets(pickResult.all()) == std::vector<int>{0, 1, 2, 3});
+  }
+
+  SECTION("Hits with equal distances remain in the order in which they were added")
+  {
+    pickResult.addHit(makeHit(HitType1, 2.0, 1));
+    pickResult.addHit(makeHit(HitType1, 1.0, 2));
+    pickResult.addHit(makeHit(HitType1, 2.0, 3));
+    pickResult.addHit(makeHit(HitType1, 1.0, 4));
+
+    CHECK(targets(pickResult.all()) == std::vector<int>{2, 4, 1, 3});
+  }
+
+  SECTION("first")
+  {
+    pickResult.addHit(makeHit(HitType2, 3.0, 3));
+    pickResult.addHit(makeHit(HitType1, 2.0, 2));
+    pickResult.addHit(makeHit(HitType2, 1.0, 1));
+
+    CHECK(pickResult.first(type(HitType1)).target<int>() == 2);
+    CHECK(pickResult.first(type(HitType2)).target<int>() == 1);
+    CHECK_FALSE(pickResult.first(type(HitType1) && minDistance(2.5)).isMatch());
+  }
+
+  SECTION("Filtering hits")
+  {
+    pickResult.addHit(makeHit(HitType2, 4.0, 4));
+    pickResult.addHit(makeHit(HitType1, 2.0, 2));
+    pickResult.addHit(makeHit(HitType2, 1.0, 1));
+    pickResult.addHit(makeHit(HitType1, 3.0, 3));
+
+    CHECK(targets(pickResult.all(type(HitType1))) == std::vector<int>{2, 3});
+    CHECK(targets(pickResult.all(type(HitType2))) == std::vector<int>{1, 4});
+
+    auto view = pickResult.view(type(HitType1));
+    CHECK(targets({view.begin(), view.end()}) == std::vector<int>{2, 3});
+  }
+
+  SECTION("clear")
+  {
+    pickResult.addHit(makeHit(HitType1, 2.0, 2));
+    pickResult.addHit(makeHit(HitType1, 1.0, 1));
+    pickResult.clear();
+
+    CHECK(pickResult.empty());
+
+    pickResult.addHit(makeHit(HitType1, 1.0, 1));
+    CHECK(targets(pickResult.all()) == std::vector<int>{1});
+  }
+}
+
+} // namespace tb::mdl
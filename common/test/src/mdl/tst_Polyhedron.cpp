@@ -22,12 +22,20 @@
 #include "mdl/Polyhedron_IO.h" // IWYU pragma: keep
 #include "mdl/Polyhedron_Instantiation.h"
 
+#include "kdl/vector_utils.h"
+
+#include "vm/scalar.h"
 #include "vm/vec.h"
 #include "vm/vec_io.h"
 
 #include <algorithm>
+#include <cmath>
 #include <iterator>
+#include <random>
 #include <set>
+#include <string>
+#include <tuple>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -351,6 +359,109 @@ TEST_CASE("PolyhedronTest.constructCube")
      {p2, p6, p8, p4}}));
 }
 
+TEST_CASE("PolyhedronTest.constructWithQuickHull")
+{
+  using T = std::tuple<std::string, std::vector<vm::vec3d>>;
+
+  const auto makeRandomPoints = [](const size_t count, const double radius) {
+    auto rng = std::mt19937{count};
+    auto dist = std::uniform_real_distribution<double>{-radius, radius};
+
+    auto points = std::vector<vm::vec3d>{};
+    points.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      points.emplace_back(dist(rng), dist(rng), dist(rng));
+    }
+    return points;
+  };
+
+  const auto makeSpherePoints = [](const size_t count, const double radius) {
+    // Fibonacci sphere
+    const auto goldenAngle = vm::Cd::pi() * (3.0 - std::sqrt(5.0));
+
+    auto points = std::vector<vm::vec3d>{};
+    points.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      const auto z = 1.0 - 2.0 * (double(i) + 0.5) / double(count);
+      const auto r = std::sqrt(1.0 - z * z);
+      const auto a = goldenAngle * double(i);
+      points.emplace_back(
+        vm::round(radius * r * std::cos(a)),
+        vm::round(radius * r * std::sin(a)),
+        vm::round(radius * z));
+    }
+    return points;
+  };
+
+  const auto makeCubeWithInteriorPoints = [&]() {
+    return kdl::vec_concat(
+      std::vector<vm::vec3d>{
+        {-8, -8, -8},
+        {-8, -8, +8},
+        {-8, +8, -8},
+        {-8, +8, +8},
+        {+8, -8, -8},
+        {+8, -8, +8},
+        {+8, +8, -8},
+        {+8, +8, +8},
+        {0, 0, 8},
+        {8, 0, 0},
+        {4, 4, 8},
+      },
+      makeRandomPoints(100, 7.0));
+  };
+
+  // clang-format off
+  const auto
+  [name,                         points] = GENERATE_COPY(values<T>({
+  {"empty",                      {}},
+  {"single point",               {{1, 2, 3}}},
+  {"colinear points",            {{0, 0, 0}, {4, 4, 4}, {2, 2, 2}, {8, 8, 8}}},
+  {"coplanar points",            {{0, 0, 0}, {8, 0, 0}, {0, 8, 0}, {8, 8, 0}, {4, 4, 0}}},
+  {"tetrahedron coplanar faces", {{0, 0, 8}, {8, 0, 0}, {-8, 0, 0}, {0, 8, 0}, {0, 0, 12}}},
+  {"cube with interior points",  makeCubeWithInteriorPoints()},
+  {"random points",              makeRandomPoints(500, 64.0)},
+  {"sphere points",              makeSpherePoints(200, 256.0)},
+  }));
+  // clang-format on
+
+  CAPTURE(name);
+
+  const auto incremental = Polyhedron3d{points, ConvexHullAlgorithm::Incremental};
+  const auto quickHull = Polyhedron3d{points, ConvexHullAlgorithm::QuickHull};
+
+  CHECK(quickHull.empty() == incremental.empty());
+  CHECK(quickHull.point() == incremental.point());
+  CHECK(quickHull.edge() == incremental.edge());
+  CHECK(quickHull.polygon() == incremental.polygon());
+  CHECK(quickHull.polyhedron() == incremental.polyhedron());
+  CHECK(quickHull.vertexCount() == incremental.vertexCount());
+  CHECK(quickHull.edgeCount() == incremental.edgeCount());
+  CHECK(quickHull.faceCount() == incremental.faceCount());
+  CHECK(quickHull.hasAllVertices(incremental.vertexPositions()));
+  CHECK(quickHull.bounds() == incremental.bounds());
+
+  // building the same hull again yields the same faces in the same order
+  const auto faceVertexPositions = [](const auto& polyhedron) {
+    return kdl::vec_transform(
+      std::vector(polyhedron.faces().begin(), polyhedron.faces().end()),
+      [](const auto* face) { return face->vertexPositions(); });
+  };
+
+  const auto quickHullAgain = Polyhedron3d{points, ConvexHullAlgorithm::QuickHull};
+  CHECK(faceVertexPositions(quickHullAgain) == faceVertexPositions(quickHull));
+
+  if (quickHull.polyhedron())
+  {
+    CHECK(quickHull.closed());
+    CHECK(std::ranges::all_of(points, [&](const auto& point) {
+      return quickHull.contains(point, 0.01);
+    }));
+  }
+}
+
 TEST_CASE("PolyhedronTest.copy")
 {
   const auto p1 = vm::vec3d{0, 0, 8};
@@ -0,0 +1,627 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/Polyhedron.h"
+#include "mdl/Polyhedron_DefaultPayload.h"
+#include "mdl/Polyhedron_Instantiation.h"
+#include "mdl/Polyhedron_Matcher.h"
+
+#include "kdl/binary_relation.h"
+
+#include "vm/vec.h"
+#include "vm/vec_io.h" // IWYU pragma: keep
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <random>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::mdl
+{
+namespace
+{
+using Polyhedron3d =
+  Polyhedron<double, DefaultPolyhedronPayload, DefaultPolyhedronPayload>;
+using PVertex = Polyhedron3d::Vertex;
+using PFace = Polyhedron3d::Face;
+using Matcher = PolyhedronMatcher<Polyhedron3d>;
+
+/**
+ * The previous implementation of PolyhedronMatcher, which stores the vertex relation in
+ * node based containers. The current implementation must produce identical matches.
+ */
+template <typename P>
+class LegacyPolyhedronMatcher
+{
+private:
+  using V = vm::vec<typename P::FloatType, 3u>;
+  using Vertex = typename P::Vertex;
+  using VertexList = typename P::VertexList;
+  using VertexSet = std::set<Vertex*>;
+  using HalfEdge = typename P::HalfEdge;
+  using Face = typename P::Face;
+  using VMap = std::map<V, V>;
+
+  using VertexRelation = kdl::binary_relation<Vertex*, Vertex*>;
+
+  const P& m_left;
+  const P& m_right;
+  const VertexRelation m_vertexRelation;
+
+public:
+  LegacyPolyhedronMatcher(const P& left, const P& right)
+    : m_left{left}
+    , m_right{right}
+    , m_vertexRelation{buildVertexRelation(m_left, m_right)}
+  {
+  }
+
+  LegacyPolyhedronMatcher(
+    const P& left, const P& right, const std::vector<V>& vertices, const V& delta)
+    : m_left{left}
+    , m_right{right}
+    , m_vertexRelation{buildVertexRelation(m_left, m_right, vertices, delta)}
+  {
+  }
+
+  LegacyPolyhedronMatcher(const P& left, const P& right, const VMap& vertexMap)
+    : m_left{left}
+    , m_right{right}
+    , m_vertexRelation{buildVertexRelation(m_left, m_right, vertexMap)}
+  {
+  }
+
+public:
+  template <typename Callback>
+  void processRightFaces(const Callback& callback) const
+  {
+    auto* firstRightFace = m_right.faces().front();
+    auto* currentRightFace = firstRightFace;
+    do
+    {
+      auto* matchingLeftFace = findBestMatchingLeftFace(currentRightFace);
+      callback(matchingLeftFace, currentRightFace);
+      currentRightFace = currentRightFace->next();
+    } while (currentRightFace != firstRightFace);
+  }
+
+  using MatchingFaces = std::vector<Face*>;
+
+private:
+  Face* findBestMatchingLeftFace(Face* rightFace) const
+  {
+    const auto matchingFaces = findMatchingLeftFaces(rightFace);
+    ensure(!matchingFaces.empty(), "No matching face found");
+
+    // Among all matching faces, select one such its normal is the most similar to the
+    // given face's normal.
+    auto it = matchingFaces.begin();
+
+    auto* result = *it++;
+    auto bestDot = vm::dot(rightFace->normal(), result->normal());
+
+    // exit early if we find a face with an identical normal
+    while (it != matchingFaces.end() && bestDot < 1.0)
+    {
+      auto* currentFace = *it;
+      const auto currentDot = dot(rightFace->normal(), currentFace->normal());
+      if (currentDot > bestDot)
+      {
+        result = currentFace;
+        bestDot = currentDot;
+      }
+      ++it;
+    }
+
+    return result;
+  }
+
+  MatchingFaces findMatchingLeftFaces(Face* rightFace) const
+  {
+    auto result = MatchingFaces{};
+    std::size_t bestMatchScore = 0;
+
+    auto* firstLeftFace = m_left.faces().front();
+    auto* currentLeftFace = firstLeftFace;
+    do
+    {
+      const auto matchScore = computeMatchScore(currentLeftFace, rightFace);
+      if (matchScore > bestMatchScore)
+      {
+        result.clear();
+        result.push_back(currentLeftFace);
+        bestMatchScore = matchScore;
+      }
+      else if (matchScore == bestMatchScore)
+      {
+        result.push_back(currentLeftFace);
+      }
+      currentLeftFace = currentLeftFace->next();
+    } while (currentLeftFace != firstLeftFace);
+
+    return result;
+  }
+
+public:
+  template <typename L>
+  void visitMatchingVertexPairs(Face* leftFace, Face* rightFace, L&& lambda) const
+  {
+    auto* firstLeftEdge = leftFace->boundary().front();
+    auto* firstRightEdge = rightFace->boundary().front();
+
+    auto* currentLeftEdge = firstLeftEdge;
+    do
+    {
+      auto* leftVertex = currentLeftEdge->origin();
+
+      auto* currentRightEdge = firstRightEdge;
+      do
+      {
+        auto* rightVertex = currentRightEdge->origin();
+
+        if (m_vertexRelation.contains(leftVertex, rightVertex))
+        {
+          lambda(leftVertex, rightVertex);
+        }
+
+        currentRightEdge = currentRightEdge->next();
+      } while (currentRightEdge != firstRightEdge);
+
+      currentLeftEdge = currentLeftEdge->next();
+    } while (currentLeftEdge != firstLeftEdge);
+  }
+
+private:
+  std::size_t computeMatchScore(Face* leftFace, Face* rightFace) const
+  {
+    if (
+      leftFace->vertexCount() == rightFace->vertexCount()
+      && leftFace->hasVertexPositions(rightFace->vertexPositions()))
+    {
+      return std::numeric_limits<std::size_t>::max();
+    }
+
+    std::size_t result = 0;
+    visitMatchingVertexPairs(
+      leftFace, rightFace, [&result](auto* /* leftVertex */, auto* /* rightVertex */) {
+        ++result;
+      });
+    return result;
+  }
+
+private:
+  static VertexRelation buildVertexRelation(const P& left, const P& right)
+  {
+    auto result = VertexRelation{};
+
+    auto* firstLeftVertex = left.vertices().front();
+    auto* currentLeftVertex = firstLeftVertex;
+    do
+    {
+      const auto& position = currentLeftVertex->position();
+      auto* currentRightVertex = right.findVertexByPosition(position);
+      if (currentRightVertex)
+      {
+        result.insert(currentLeftVertex, currentRightVertex);
+      }
+
+      currentLeftVertex = currentLeftVertex->next();
+    } while (currentLeftVertex != firstLeftVertex);
+
+    return expandVertexRelation(left, right, result);
+  }
+
+  static VertexRelation buildVertexRelation(
+    const P& left, const P& right, const std::vector<V>& vertices, const V& delta)
+  {
+    auto vertexMap = VMap{};
+    const auto vertexSet = std::set<V>{vertices.begin(), vertices.end()};
+
+    auto* firstVertex = left.vertices().front();
+    auto* currentVertex = firstVertex;
+    do
+    {
+      const auto& position = currentVertex->position();
+      // vertices are expected to be exact positions of vertices in left, whereas the
+      // vertex positions searched for in right allow an epsilon of
+      // vm::Constants<T>::almost_zero()
+      if (vertexSet.count(position) > 0u)
+      {
+        if (right.hasVertex(position))
+        {
+          vertexMap.emplace(position, position);
+        }
+      }
+      else
+      {
+        assert(right.hasVertex(position + delta));
+        vertexMap.emplace(position, position + delta);
+      }
+      currentVertex = currentVertex->next();
+    } while (currentVertex != firstVertex);
+
+    return buildVertexRelation(left, right, vertexMap);
+  }
+
+  static VertexRelation buildVertexRelation(
+    const P& left, const P& right, const VMap& vertexMap)
+  {
+    auto result = VertexRelation{};
+
+    for (const auto& [leftPosition, rightPosition] : vertexMap)
+    {
+      auto* leftVertex = left.findVertexByPosition(leftPosition);
+      auto* rightVertex = right.findVertexByPosition(rightPosition);
+
+      assert(leftVertex != nullptr);
+      assert(rightVertex != nullptr);
+      result.insert(leftVertex, rightVertex);
+    }
+
+    return expandVertexRelation(left, right, result);
+  }
+
+  static VertexRelation expandVertexRelation(
+    const P& left, const P& right, const VertexRelation& initialRelation)
+  {
+    auto result = initialRelation;
+    result.insert(addedVertexRelation(right, initialRelation));
+    result.insert(removedVertexRelation(left, initialRelation));
+    return result;
+  }
+
+  static VertexRelation addedVertexRelation(
+    const P& right, const VertexRelation& initialRelation)
+  {
+    const auto addedVertices = findAddedVertices(right, initialRelation);
+
+    auto result = initialRelation;
+    std::size_t previousSize;
+    do
+    {
+      previousSize = result.size();
+      for (auto* addedVertex : addedVertices)
+      {
+        // consider all adjacent vertices
+        auto* firstEdge = addedVertex->leaving();
+        auto* currentEdge = firstEdge;
+        do
+        {
+          auto* neighbour = currentEdge->destination();
+          result.insert(result.left_range(neighbour), addedVertex);
+          currentEdge = currentEdge->nextIncident();
+        } while (currentEdge != firstEdge);
+      }
+    } while (result.size() > previousSize);
+
+    return result;
+  }
+
+  static VertexRelation removedVertexRelation(
+    const P& left, const VertexRelation& initialRelation)
+  {
+    const auto removedVertices = findRemovedVertices(left, initialRelation);
+
+    auto result = initialRelation;
+    std::size_t previousSize;
+    do
+    {
+      previousSize = result.size();
+      for (auto* removedVertex : removedVertices)
+      {
+        // consider all adjacent vertices
+        auto* firstEdge = removedVertex->leaving();
+        auto* currentEdge = firstEdge;
+        do
+        {
+          auto* neighbour = currentEdge->destination();
+          result.insert(removedVertex, result.right_range(neighbour));
+          currentEdge = currentEdge->nextIncident();
+        } while (currentEdge != firstEdge);
+      }
+    } while (result.size() > previousSize);
+
+    return result;
+  }
+
+  static VertexSet findAddedVertices(const P& right, const VertexRelation& vertexRelation)
+  {
+    auto result = VertexSet{};
+
+    const auto& rightVertices = right.vertices();
+    auto* firstVertex = rightVertices.front();
+    auto* currentVertex = firstVertex;
+    do
+    {
+      if (vertexRelation.count_left(currentVertex) == 0)
+      {
+        result.insert(currentVertex);
+      }
+      currentVertex = currentVertex->next();
+    } while (currentVertex != firstVertex);
+
+    return result;
+  }
+
+  static VertexSet findRemovedVertices(
+    const P& left, const VertexRelation& vertexRelation)
+  {
+    auto result = VertexSet{};
+
+    const auto& leftVertices = left.vertices();
+    auto* firstVertex = leftVertices.front();
+    auto* currentVertex = firstVertex;
+    do
+    {
+      if (vertexRelation.count_right(currentVertex) == 0)
+      {
+        result.insert(currentVertex);
+      }
+      currentVertex = currentVertex->next();
+    } while (currentVertex != firstVertex);
+
+    return result;
+  }
+};
+
+using LegacyMatcher = LegacyPolyhedronMatcher<Polyhedron3d>;
+
+using VertexPairs = std::vector<std::pair<const PVertex*, const PVertex*>>;
+using FaceMatch = std::tuple<const PFace*, const PFace*, VertexPairs>;
+
+template <typename M>
+std::vector<FaceMatch> collectMatches(const M& matcher)
+{
+  auto result = std::vector<FaceMatch>{};
+  matcher.processRightFaces([&](PFace* leftFace, PFace* rightFace) {
+    auto vertexPairs = VertexPairs{};
+    matcher.visitMatchingVertexPairs(
+      leftFace, rightFace, [&](PVertex* leftVertex, PVertex* rightVertex) {
+        vertexPairs.emplace_back(leftVertex, rightVertex);
+      });
+    result.emplace_back(leftFace, rightFace, std::move(vertexPairs));
+  });
+  return result;
+}
+
+Matcher::VertexMapping toVertexMapping(const std::map<vm::vec3d, vm::vec3d>& vertexMap)
+{
+  return {vertexMap.begin(), vertexMap.end()};
+}
+
+std::vector<vm::vec3d> cubeVertices(const double size)
+{
+  const auto h = size / 2.0;
+  return {
+    {-h, -h, -h},
+    {-h, -h, +h},
+    {-h, +h, -h},
+    {-h, +h, +h},
+    {+h, -h, -h},
+    {+h, -h, +h},
+    {+h, +h, -h},
+    {+h, +h, +h},
+  };
+}
+
+std::vector<vm::vec3d> randomPoints(std::mt19937& rng, const size_t count)
+{
+  auto dist = std::uniform_int_distribution<int>{-64, 64};
+
+  auto result = std::vector<vm::vec3d>{};
+  result.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    result.emplace_back(dist(rng), dist(rng), dist(rng));
+  }
+  return result;
+}
+
+/**
+ * Maps every vertex of left to the closest vertex of right at its moved position, like
+ * Brush::transformVertices does.
+ */
+std::map<vm::vec3d, vm::vec3d> mapMovedVertices(
+  const Polyhedron3d& left,
+  const Polyhedron3d& right,
+  const std::vector<vm::vec3d>& movedVertices,
+  const vm::vec3d& delta)
+{
+  auto result = std::map<vm::vec3d, vm::vec3d>{};
+  for (const auto* vertex : left.vertices())
+  {
+    const auto& position = vertex->position();
+    const auto moved = std::ranges::find(movedVertices, position) != movedVertices.end();
+    if (const auto* rightVertex =
+          right.findClosestVertex(moved ? position + delta : position, 0.01))
+    {
+      result.emplace(position, rightVertex->position());
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("PolyhedronMatcher")
+{
+  SECTION("Unchanged polyhedron")
+  {
+    const auto left = Polyhedron3d{cubeVertices(64.0)};
+    const auto right = Polyhedron3d{cubeVertices(64.0)};
+
+    const auto matches = collectMatches(Matcher{left, right});
+    CHECK(matches == collectMatches(LegacyMatcher{left, right}));
+    CHECK(matches.size() == 6u);
+    for (const auto& [leftFace, rightFace, vertexPairs] : matches)
+    {
+      CHECK(leftFace->hasVertexPositions(rightFace->vertexPositions()));
+      CHECK(vertexPairs.size() == 4u);
+    }
+  }
+
+  SECTION("Translated polyhedron")
+  {
+    const auto delta = vm::vec3d{8, 16, -4};
+
+    auto movedVertices = cubeVertices(64.0);
+    for (auto& vertex : movedVertices)
+    {
+      vertex = vertex + delta;
+    }
+
+    const auto left = Polyhedron3d{cubeVertices(64.0)};
+    const auto right = Polyhedron3d{movedVertices};
+
+    CHECK(
+      collectMatches(Matcher{left, right, {}, delta})
+      == collectMatches(LegacyMatcher{left, right, {}, delta}));
+  }
+
+  SECTION("Added vertex")
+  {
+    auto vertices = cubeVertices(64.0);
+    const auto left = Polyhedron3d{vertices};
+
+    vertices.emplace_back(0, 0, 64);
+    const auto right = Polyhedron3d{vertices};
+
+    CHECK(
+      collectMatches(Matcher{left, right})
+      == collectMatches(LegacyMatcher{left, right}));
+  }
+
+  SECTION("Removed vertex")
+  {
+    auto vertices = cubeVertices(64.0);
+    const auto left = Polyhedron3d{vertices};
+
+    vertices.pop_back();
+    const auto right = Polyhedron3d{vertices};
+
+    CHECK(
+      collectMatches(Matcher{left, right})
+      == collectMatches(LegacyMatcher{left, right}));
+  }
+
+  SECTION("Snapped vertices")
+  {
+    const auto left = Polyhedron3d{{
+      {-31.3, -32.7, -30.2},
+      {-32.1, -33.4, 32.9},
+      {-30.8, 31.6, -32.4},
+      {-32.2, 32.3, 31.1},
+      {31.7, -32.2, -33.3},
+      {32.6, -31.4, 32.2},
+      {33.4, 32.9, -31.8},
+      {32.1, 31.2, 32.8},
+      {0.4, 0.3, 40.1},
+    }};
+
+    const auto snap = [](const auto& position) {
+      return 16.0 * vm::round(position / 16.0);
+    };
+
+    auto snappedVertices = std::vector<vm::vec3d>{};
+    for (const auto* vertex : left.vertices())
+    {
+      snappedVertices.push_back(snap(vertex->position()));
+    }
+    const auto right = Polyhedron3d{snappedVertices};
+
+    auto vertexMap = std::map<vm::vec3d, vm::vec3d>{};
+    for (const auto* vertex : left.vertices())
+    {
+      if (right.hasVertex(snap(vertex->position())))
+      {
+        vertexMap.emplace(vertex->position(), snap(vertex->position()));
+      }
+    }
+
+    CHECK(
+      collectMatches(Matcher{left, right, toVertexMapping(vertexMap)})
+      == collectMatches(LegacyMatcher{left, right, vertexMap}));
+  }
+
+  SECTION("Random vertex moves")
+  {
+    const auto seed = GENERATE(range(0u, 50u));
+    CAPTURE(seed);
+
+    auto rng = std::mt19937{seed};
+    const auto left = Polyhedron3d{randomPoints(rng, 24)};
+    REQUIRE(left.polyhedron());
+
+    auto leftVertices = std::vector<vm::vec3d>{};
+    for (const auto* vertex : left.vertices())
+    {
+      leftVertices.push_back(vertex->position());
+    }
+
+    auto movedVertices = std::vector<vm::vec3d>{};
+    std::ranges::sample(
+      leftVertices,
+      std::back_inserter(movedVertices),
+      std::uniform_int_distribution<size_t>{1, 4}(rng),
+      rng);
+
+    auto deltaDist = std::uniform_int_distribution<int>{-32, 32};
+    const auto delta = vm::vec3d(deltaDist(rng), deltaDist(rng), deltaDist(rng));
+
+    auto rightVertices = leftVertices;
+    for (auto& vertex : rightVertices)
+    {
+      if (std::ranges::find(movedVertices, vertex) != movedVertices.end())
+      {
+        vertex = vertex + delta;
+      }
+    }
+
+    const auto right = Polyhedron3d{rightVertices};
+    if (!right.polyhedron())
+    {
+      return;
+    }
+
+    SECTION("Matching by position")
+    {
+      CHECK(
+        collectMatches(Matcher{left, right})
+        == collectMatches(LegacyMatcher{left, right}));
+    }
+
+    SECTION("Matching by vertex mapping")
+    {
+      const auto vertexMap = mapMovedVertices(left, right, movedVertices, delta);
+      CHECK(
+        collectMatches(Matcher{left, right, toVertexMapping(vertexMap)})
+        == collectMatches(LegacyMatcher{left, right, vertexMap}));
+    }
+  }
+}
+
+} // namespace tb::mdl
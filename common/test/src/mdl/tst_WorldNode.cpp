@@ -34,6 +34,8 @@
 
 #include "kdl/result.h"
 
+#include <vector>
+
 #include "Catch2.h"
 
 namespace tb::mdl
@@ -423,4 +425,59 @@ TEST_CASE("WorldNodeTest.setPersistentIdsWhenAddingLayersAndGroups")
   CHECK(groupNode->persistentId() == 2u);
 }
 
+TEST_CASE("WorldNodeTest.findGroupNodesWithLinkId")
+{
+  auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
+
+  auto* outerGroupNode = new GroupNode{Group{"outer"}};
+  auto* innerGroupNode = new GroupNode{Group{"inner"}};
+  auto* linkedInnerGroupNode = new GroupNode{Group{"inner"}};
+  outerGroupNode->addChild(innerGroupNode);
+  linkedInnerGroupNode->setLinkId(innerGroupNode->linkId());
+
+  const auto outerLinkId = outerGroupNode->linkId();
+  const auto innerLinkId = innerGroupNode->linkId();
+
+  CHECK(worldNode.findGroupNodesWithLinkId(outerLinkId).empty());
+  CHECK(worldNode.findGroupNodesWithLinkId(innerLinkId).empty());
+
+  SECTION("Adding group nodes adds them to the index")
+  {
+    worldNode.defaultLayer()->addChildren({outerGroupNode, linkedInnerGroupNode});
+
+    CHECK(
+      worldNode.findGroupNodesWithLinkId(outerLinkId)
+      == std::vector<GroupNode*>{outerGroupNode});
+    CHECK_THAT(
+      worldNode.findGroupNodesWithLinkId(innerLinkId),
+      Catch::UnorderedEquals(
+        std::vector<GroupNode*>{innerGroupNode, linkedInnerGroupNode}));
+
+    SECTION("Removing group nodes removes them from the index")
+    {
+      worldNode.defaultLayer()->removeChild(outerGroupNode);
+
+      CHECK(worldNode.findGroupNodesWithLinkId(outerLinkId).empty());
+      CHECK(
+        worldNode.findGroupNodesWithLinkId(innerLinkId)
+        == std::vector<GroupNode*>{linkedInnerGroupNode});
+
+      delete outerGroupNode;
+    }
+
+    SECTION("Changing the link ID of a group node updates the index")
+    {
+      linkedInnerGroupNode->setLinkId(outerLinkId);
+
+      CHECK_THAT(
+        worldNode.findGroupNodesWithLinkId(outerLinkId),
+        Catch::UnorderedEquals(
+          std::vector<GroupNode*>{outerGroupNode, linkedInnerGroupNode}));
+      CHECK(
+        worldNode.findGroupNodesWithLinkId(innerLinkId)
+        == std::vector<GroupNode*>{innerGroupNode});
+    }
+  }
+}
+
 } // namespace tb::mdl
@@ -0,0 +1,67 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FontTestUtils.h"
+
+#include "render/FontDescriptor.h"
+#include "render/FontGlyph.h"
+#include "render/FontTexture.h"
+#include "render/TextureFont.h"
+
+namespace tb::render
+{
+namespace
+{
+
+constexpr unsigned char FirstChar = ' ';
+constexpr unsigned char CharCount = '~' - ' ' + 1;
+
+} // namespace
+
+std::unique_ptr<TextureFont> makeTestFont(const size_t size)
+{
+  auto glyphs = std::vector<FontGlyph>{};
+  for (size_t i = 0; i < CharCount; ++i)
+  {
+    glyphs.emplace_back(i * size, 0, size / 2, size, size / 2);
+  }
+
+  return std::make_unique<TextureFont>(
+    std::make_unique<FontTexture>(CharCount, size, 1),
+    glyphs,
+    int(size),
+    0,
+    int(size),
+    FirstChar,
+    CharCount);
+}
+
+const std::vector<size_t>& TestFontFactory::createdSizes() const
+{
+  return m_createdSizes;
+}
+
+std::unique_ptr<TextureFont> TestFontFactory::doCreateFont(
+  const FontDescriptor& fontDescriptor)
+{
+  m_createdSizes.push_back(fontDescriptor.size());
+  return makeTestFont(fontDescriptor.size());
+}
+
+} // namespace tb::render
@@ -0,0 +1,54 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "render/FontFactory.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace tb::render
+{
+class FontDescriptor;
+class TextureFont;
+
+/**
+ * Creates a font where every glyph is size / 2 wide and size high.
+ */
+std::unique_ptr<TextureFont> makeTestFont(size_t size);
+
+/**
+ * Creates test fonts and records the sizes of the created fonts.
+ */
+class TestFontFactory : public FontFactory
+{
+private:
+  std::vector<size_t> m_createdSizes;
+
+public:
+  const std::vector<size_t>& createdSizes() const;
+
+private:
+  std::unique_ptr<TextureFont> doCreateFont(
+    const FontDescriptor& fontDescriptor) override;
+};
+
+} // namespace tb::render
@@ -0,0 +1,179 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/Entity.h"
+#include "mdl/EntityModel.h"
+#include "mdl/EntityNode.h"
+#include "mdl/EntityProperties.h"
+#include "render/EntityModelRenderer.h"
+#include "render/MaterialIndexRangeRenderer.h"
+
+#include "vm/mat.h"
+#include "vm/mat_io.h" // IWYU pragma: keep
+
+#include <algorithm>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::render
+{
+namespace
+{
+
+class TestMaterialRenderer : public MaterialRenderer
+{
+public:
+  bool empty() const override { return false; }
+  void prepare(VboManager&) override {}
+  void render(MaterialRenderFunc&) override {}
+  void renderInstanced(MaterialRenderFunc&, size_t) override {}
+};
+
+class RecordingRenderBackend : public EntityModelRenderBackend
+{
+private:
+  bool m_supportsInstancing;
+
+public:
+  std::vector<std::tuple<MaterialRenderer*, vm::mat4x4f>> renderCalls;
+  std::vector<std::tuple<size_t, MaterialRenderer*, size_t>> instancedRenderCalls;
+
+  explicit RecordingRenderBackend(const bool supportsInstancing)
+    : m_supportsInstancing{supportsInstancing}
+  {
+  }
+
+  bool supportsInstancing() const override { return m_supportsInstancing; }
+
+  void render(
+    MaterialRenderer& renderer,
+    const mdl::Orientation,
+    const vm::mat4x4f& modelMatrix) override
+  {
+    renderCalls.emplace_back(&renderer, modelMatrix);
+  }
+
+  void renderInstanced(const size_t index, const EntityModelInstances& instances) override
+  {
+    instancedRenderCalls.emplace_back(
+      index, instances.renderer, instances.modelMatrices.size());
+  }
+};
+
+vm::mat4x4f modelMatrix(const mdl::EntityNode& entityNode)
+{
+  return vm::mat4x4f{entityNode.entity().modelTransformation(std::nullopt)};
+}
+
+} // namespace
+
+TEST_CASE("EntityModelRenderer")
+{
+  using namespace mdl;
+
+  auto model = EntityModel{
+    "model",
+    createEntityModelDataResource(
+      EntityModelData{PitchType::Normal, Orientation::Oriented})};
+
+  auto rendererA = TestMaterialRenderer{};
+  auto rendererB = TestMaterialRenderer{};
+
+  auto entityNodeA1 = EntityNode{Entity{{{EntityPropertyKeys::Origin, "0 0 0"}}}};
+  auto entityNodeA2 = EntityNode{Entity{{{EntityPropertyKeys::Origin, "64 0 0"}}}};
+  auto entityNodeA3 = EntityNode{Entity{{{EntityPropertyKeys::Origin, "0 64 0"}}}};
+  auto entityNodeB = EntityNode{Entity{{{EntityPropertyKeys::Origin, "0 0 64"}}}};
+  auto entityNodeWithoutModel = EntityNode{Entity{}};
+
+  entityNodeA1.setModel(&model);
+  entityNodeA2.setModel(&model);
+  entityNodeA3.setModel(&model);
+  entityNodeB.setModel(&model);
+
+  const auto entities = std::unordered_map<const EntityNode*, MaterialRenderer*>{
+    {&entityNodeA1, &rendererA},
+    {&entityNodeA2, &rendererA},
+    {&entityNodeA3, &rendererA},
+    {&entityNodeB, &rendererB},
+    {&entityNodeWithoutModel, &rendererB},
+  };
+
+  const auto isVisible = [&](const EntityNode* entityNode) {
+    return entityNode != &entityNodeA3;
+  };
+
+  const auto groups = groupEntityModelInstances(entities, isVisible);
+  REQUIRE(groups.size() == 2u);
+
+  const auto& groupA = groups[0].renderer == &rendererA ? groups[0] : groups[1];
+  const auto& groupB = groups[0].renderer == &rendererB ? groups[0] : groups[1];
+
+  SECTION("Groups visible entities by model renderer")
+  {
+    CHECK(groupA.renderer == &rendererA);
+    CHECK(groupA.orientation == Orientation::Oriented);
+    CHECK_THAT(
+      groupA.modelMatrices,
+      Catch::UnorderedEquals(std::vector<vm::mat4x4f>{
+        modelMatrix(entityNodeA1),
+        modelMatrix(entityNodeA2),
+      }));
+
+    CHECK(groupB.renderer == &rendererB);
+    CHECK(groupB.modelMatrices == std::vector<vm::mat4x4f>{modelMatrix(entityNodeB)});
+  }
+
+  SECTION("Renders groups with more than one instance with a single instanced call")
+  {
+    auto backend = RecordingRenderBackend{true};
+    renderEntityModelInstances(groups, backend);
+
+    const auto indexA = size_t(&groupA == &groups[0] ? 0 : 1);
+    CHECK(
+      backend.instancedRenderCalls
+      == std::vector<std::tuple<size_t, MaterialRenderer*, size_t>>{
+        {indexA, &rendererA, 2u},
+      });
+    CHECK(
+      backend.renderCalls
+      == std::vector<std::tuple<MaterialRenderer*, vm::mat4x4f>>{
+        {&rendererB, modelMatrix(entityNodeB)},
+      });
+  }
+
+  SECTION("Renders every instance separately without instancing support")
+  {
+    auto backend = RecordingRenderBackend{false};
+    renderEntityModelInstances(groups, backend);
+
+    CHECK(backend.instancedRenderCalls.empty());
+    CHECK(backend.renderCalls.size() == 3u);
+    CHECK(
+      std::ranges::count(backend.renderCalls, &rendererA, [](const auto& call) {
+        return std::get<0>(call);
+      })
+      == 2);
+  }
+}
+
+} // namespace tb::render
@@ -0,0 +1,176 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render/AttrString.h"
+#include "render/FontDescriptor.h"
+#include "render/FontManager.h"
+#include "render/FontTestUtils.h"
+#include "render/TextureFont.h"
+
+#include "vm/approx.h"
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::render
+{
+namespace
+{
+
+std::vector<vm::vec2f> translatePositions(
+  std::vector<vm::vec2f> vertices, const vm::vec2f& translation)
+{
+  for (size_t i = 0; i < vertices.size(); i += 2)
+  {
+    vertices[i] = vertices[i] + translation;
+  }
+  return vertices;
+}
+
+} // namespace
+
+TEST_CASE("TextureFontTest.measure")
+{
+  const auto font = makeTestFont(8);
+
+  CHECK(font->measure("") == vm::vec2f{0, 8});
+  CHECK(font->measure("abc") == vm::vec2f{12, 8});
+  CHECK(font->measure("abc") == vm::vec2f{12, 8});
+  CHECK(font->measure("abc\nab") == vm::vec2f{12, 16});
+}
+
+TEST_CASE("TextureFontTest.quads")
+{
+  const auto font = makeTestFont(8);
+
+  SECTION("Quads are laid out at the given offset")
+  {
+    const auto quads = font->quads("ab", false, vm::vec2f{10, 20});
+    REQUIRE(quads.size() == 16u);
+
+    CHECK(quads[0] == vm::vec2f{10, 20});
+    CHECK(quads[2] == vm::vec2f{14, 20});
+    CHECK(quads[4] == vm::vec2f{14, 28});
+    CHECK(quads[6] == vm::vec2f{10, 28});
+    CHECK(quads[8] == vm::vec2f{14, 20});
+    CHECK(quads[10] == vm::vec2f{18, 20});
+    CHECK(quads[12] == vm::vec2f{18, 28});
+    CHECK(quads[14] == vm::vec2f{14, 28});
+  }
+
+  SECTION("Spaces don't produce quads")
+  {
+    CHECK(font->quads(" a ", true).size() == 8u);
+    CHECK(font->quads(" a ", true)[0] == vm::vec2f{4, 0});
+  }
+
+  SECTION("Repeated layouts are translated by the rounded offset")
+  {
+    const auto clockwise = GENERATE(true, false);
+
+    const auto atOrigin = font->quads("some text", clockwise);
+    CHECK(font->quads("some text", clockwise) == atOrigin);
+    CHECK(
+      font->quads("some text", clockwise, vm::vec2f{3.4f, -7.6f})
+      == translatePositions(atOrigin, vm::vec2f{3, -8}));
+    CHECK(
+      font->quads("some text", !clockwise) != font->quads("some text", clockwise));
+  }
+
+  SECTION("Line breaks reset the x coordinate")
+  {
+    const auto quads = font->quads("a\nb", false, vm::vec2f{10, 20});
+    REQUIRE(quads.size() == 16u);
+    CHECK(quads[0] == vm::vec2f{10, 20});
+    CHECK(quads[8] == vm::vec2f{0, 28});
+  }
+
+  SECTION("Recently used layouts are kept when the cache is full")
+  {
+    const auto* quads = &font->quads("some text", true);
+    for (size_t i = 0; i < 10'000; ++i)
+    {
+      font->quads(fmt::format("text {}", i), true);
+      REQUIRE(&font->quads("some text", true) == quads);
+    }
+  }
+}
+
+TEST_CASE("TextureFontTest.attrStringQuads")
+{
+  const auto font = makeTestFont(8);
+
+  auto string = AttrString{};
+  string.appendLeftJustified("ab");
+  string.appendRightJustified("a");
+
+  CHECK(font->measure(string) == vm::vec2f{8, 16});
+
+  const auto quads = font->quads(string, false);
+  REQUIRE(quads.size() == 24u);
+
+  // the first line is on top
+  CHECK(quads[0] == vm::vec2f{0, 8});
+  CHECK(quads[8] == vm::vec2f{4, 8});
+  CHECK(quads[16] == vm::vec2f{4, 0});
+
+  CHECK(font->quads(string, false) == quads);
+  CHECK(
+    font->quads(string, false, vm::vec2f{2, 3})
+    == translatePositions(quads, vm::vec2f{2, 3}));
+}
+
+TEST_CASE("FontManagerTest.selectFontSize")
+{
+  auto fontFactory = std::make_unique<TestFontFactory>();
+  const auto& createdSizes = fontFactory->createdSizes();
+  auto fontManager = FontManager{std::move(fontFactory)};
+
+  const auto string = std::string{"0123456789"};
+  const auto minFontSize = size_t(4);
+  const auto defaultFont = FontDescriptor{"font.ttf", 32};
+
+  // the string is 5 * size wide for even sizes
+  const auto maxWidth =
+    GENERATE(0.0f, 19.0f, 20.0f, 21.0f, 60.0f, 159.0f, 160.0f, 500.0f);
+
+  auto expectedSize = defaultFont.size();
+  while (expectedSize > minFontSize && float(10 * (expectedSize / 2)) > maxWidth)
+  {
+    --expectedSize;
+  }
+
+  CAPTURE(maxWidth);
+
+  const auto actualFont =
+    fontManager.selectFontSize(defaultFont, string, maxWidth, minFontSize);
+  CHECK(actualFont.path() == defaultFont.path());
+  CHECK(actualFont.size() == expectedSize);
+
+  // the default size plus a binary search over [4, 32]
+  CHECK(createdSizes.size() <= 6u);
+}
+
+} // namespace tb::render
@@ -0,0 +1,199 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/EditorContext.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityNode.h"
+#include "mdl/Group.h"
+#include "mdl/GroupNode.h"
+#include "mdl/VisibilityState.h"
+#include "render/GroupRenderer.h"
+
+#include "vm/bbox.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "Catch2.h"
+
+namespace tb::render
+{
+namespace
+{
+
+std::unique_ptr<mdl::GroupNode> makeGroupNode(std::string name, std::string origin)
+{
+  auto groupNode = std::make_unique<mdl::GroupNode>(mdl::Group{std::move(name)});
+  groupNode->addChild(new mdl::EntityNode{mdl::Entity{{
+    {"classname", "info_player_start"},
+    {"origin", std::move(origin)},
+  }}});
+  return groupNode;
+}
+
+} // namespace
+
+TEST_CASE("GroupRenderer")
+{
+  auto editorContext = mdl::EditorContext{};
+  auto groupRenderer = GroupRenderer{editorContext};
+
+  auto groupNode1 = makeGroupNode("group1", "0 0 0");
+  auto groupNode2 = makeGroupNode("group2", "64 0 0");
+  auto groupNode3 = makeGroupNode("group3", "0 64 0");
+
+  groupRenderer.addGroup(groupNode1.get());
+  groupRenderer.addGroup(groupNode2.get());
+  groupRenderer.addGroup(groupNode3.get());
+  CHECK_FALSE(groupRenderer.valid());
+  CHECK(groupRenderer.renderedGroupIndex(groupNode1.get()) == std::nullopt);
+
+  groupRenderer.validate();
+  CHECK(groupRenderer.valid());
+
+  const auto index1 = groupRenderer.renderedGroupIndex(groupNode1.get());
+  const auto index2 = groupRenderer.renderedGroupIndex(groupNode2.get());
+  const auto index3 = groupRenderer.renderedGroupIndex(groupNode3.get());
+  REQUIRE(index1);
+  REQUIRE(index2);
+  REQUIRE(index3);
+
+  // the groups are stored densely
+  CHECK(*index1 + *index2 + *index3 == 3u);
+  CHECK(*index1 != *index2);
+  CHECK(*index1 != *index3);
+  CHECK(*index2 != *index3);
+
+  const auto boundsOf = [](const auto& groupNode) {
+    return vm::bbox3f{groupNode->logicalBounds()};
+  };
+
+  CHECK(groupRenderer.renderedGroupBounds(*index1) == boundsOf(groupNode1));
+  CHECK(groupRenderer.renderedGroupBounds(*index2) == boundsOf(groupNode2));
+  CHECK(groupRenderer.renderedGroupBounds(*index3) == boundsOf(groupNode3));
+
+  SECTION("Adding a group twice doesn't invalidate it")
+  {
+    groupRenderer.addGroup(groupNode1.get());
+    CHECK(groupRenderer.valid());
+  }
+
+  SECTION("Invalidating a group keeps its index")
+  {
+    groupRenderer.invalidateGroup(groupNode1.get());
+    CHECK_FALSE(groupRenderer.valid());
+
+    groupRenderer.validate();
+    CHECK(groupRenderer.valid());
+    CHECK(groupRenderer.renderedGroupIndex(groupNode1.get()) == index1);
+    CHECK(groupRenderer.renderedGroupIndex(groupNode2.get()) == index2);
+    CHECK(groupRenderer.renderedGroupIndex(groupNode3.get()) == index3);
+  }
+
+  SECTION("Removing a group moves the last group into its slot")
+  {
+    const auto groupAt = [&](const size_t index) {
+      return index == *index1   ? groupNode1.get()
+             : index == *index2 ? groupNode2.get()
+                                : groupNode3.get();
+    };
+
+    auto* firstGroupNode = groupAt(0);
+    auto* middleGroupNode = groupAt(1);
+    auto* lastGroupNode = groupAt(2);
+
+    groupRenderer.removeGroup(firstGroupNode);
+    CHECK(groupRenderer.valid());
+    CHECK(groupRenderer.renderedGroupIndex(firstGroupNode) == std::nullopt);
+    CHECK(groupRenderer.renderedGroupIndex(middleGroupNode) == 1u);
+    CHECK(groupRenderer.renderedGroupIndex(lastGroupNode) == 0u);
+    CHECK(
+      groupRenderer.renderedGroupBounds(0)
+      == vm::bbox3f{lastGroupNode->logicalBounds()});
+    CHECK(
+      groupRenderer.renderedGroupBounds(1)
+      == vm::bbox3f{middleGroupNode->logicalBounds()});
+
+    // removing the last group doesn't move any group
+    groupRenderer.removeGroup(middleGroupNode);
+    CHECK(groupRenderer.renderedGroupIndex(lastGroupNode) == 0u);
+
+    // removing an unknown group is ignored
+    groupRenderer.removeGroup(firstGroupNode);
+    CHECK(groupRenderer.renderedGroupIndex(lastGroupNode) == 0u);
+  }
+
+  SECTION("Hidden groups are not rendered")
+  {
+    groupNode1->setVisibilityState(mdl::VisibilityState::Hidden);
+    groupRenderer.invalidateGroup(groupNode1.get());
+    groupRenderer.validate();
+    CHECK(groupRenderer.renderedGroupIndex(groupNode1.get()) == std::nullopt);
+    CHECK(groupRenderer.renderedGroupIndex(groupNode2.get()));
+    CHECK(groupRenderer.renderedGroupIndex(groupNode3.get()));
+
+    groupNode1->setVisibilityState(mdl::VisibilityState::Inherited);
+    groupRenderer.invalidateGroup(groupNode1.get());
+    groupRenderer.validate();
+    CHECK(groupRenderer.renderedGroupIndex(groupNode1.get()) == 2u);
+  }
+
+  SECTION("Changing the current group invalidates all groups")
+  {
+    editorContext.pushGroup(groupNode1.get());
+    CHECK_FALSE(groupRenderer.valid());
+
+    // only groups that belong to the current group are rendered
+    groupRenderer.validate();
+    CHECK(groupRenderer.valid());
+    CHECK(groupRenderer.renderedGroupIndex(groupNode1.get()) == std::nullopt);
+    CHECK(groupRenderer.renderedGroupIndex(groupNode2.get()) == std::nullopt);
+    CHECK(groupRenderer.renderedGroupIndex(groupNode3.get()) == std::nullopt);
+
+    editorContext.popGroup();
+    groupRenderer.validate();
+    CHECK(groupRenderer.renderedGroupIndex(groupNode1.get()));
+    CHECK(groupRenderer.renderedGroupIndex(groupNode2.get()));
+    CHECK(groupRenderer.renderedGroupIndex(groupNode3.get()));
+  }
+
+  SECTION("Invalidating all groups")
+  {
+    groupRenderer.invalidate();
+    CHECK_FALSE(groupRenderer.valid());
+
+    groupRenderer.validate();
+    CHECK(groupRenderer.valid());
+    CHECK(groupRenderer.renderedGroupIndex(groupNode1.get()) == index1);
+    CHECK(groupRenderer.renderedGroupIndex(groupNode2.get()) == index2);
+    CHECK(groupRenderer.renderedGroupIndex(groupNode3.get()) == index3);
+  }
+
+  SECTION("Clearing")
+  {
+    groupRenderer.clear();
+    CHECK(groupRenderer.valid());
+    CHECK(groupRenderer.renderedGroupIndex(groupNode1.get()) == std::nullopt);
+    CHECK(groupRenderer.renderedGroupIndex(groupNode2.get()) == std::nullopt);
+    CHECK(groupRenderer.renderedGroupIndex(groupNode3.get()) == std::nullopt);
+  }
+}
+
+} // namespace tb::render
@@ -0,0 +1,188 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/BezierPatch.h"
+#include "mdl/EditorContext.h"
+#include "mdl/PatchNode.h"
+#include "render/PatchRenderer.h"
+
+#include <optional>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::render
+{
+namespace
+{
+
+mdl::BezierPatch makePatch(const size_t rowCount, const size_t columnCount)
+{
+  auto controlPoints = std::vector<mdl::BezierPatch::Point>{};
+  for (size_t row = 0; row < rowCount; ++row)
+  {
+    for (size_t col = 0; col < columnCount; ++col)
+    {
+      controlPoints.emplace_back(double(col), double(row), 0.0, 0.0, 0.0);
+    }
+  }
+  return mdl::BezierPatch{rowCount, columnCount, std::move(controlPoints), "material"};
+}
+
+size_t faceIndexCount(const mdl::PatchNode& patchNode)
+{
+  return 6u * patchNode.grid().quadRowCount() * patchNode.grid().quadColumnCount();
+}
+
+size_t edgeIndexCount(const mdl::PatchNode& patchNode)
+{
+  return 4u * (patchNode.grid().pointRowCount + patchNode.grid().pointColumnCount - 2u);
+}
+
+bool overlap(const AllocationTracker::Range& lhs, const AllocationTracker::Range& rhs)
+{
+  return lhs.pos < rhs.pos + rhs.size && rhs.pos < lhs.pos + lhs.size;
+}
+
+} // namespace
+
+TEST_CASE("PatchRenderer")
+{
+  const auto editorContext = mdl::EditorContext{};
+  auto patchRenderer = PatchRenderer{editorContext};
+
+  auto patchNode1 = mdl::PatchNode{makePatch(3, 3)};
+  auto patchNode2 = mdl::PatchNode{makePatch(3, 5)};
+
+  patchRenderer.addPatch(&patchNode1);
+  patchRenderer.addPatch(&patchNode2);
+  CHECK_FALSE(patchRenderer.valid());
+  CHECK(patchRenderer.patchRanges(&patchNode1) == std::nullopt);
+
+  patchRenderer.validate();
+  CHECK(patchRenderer.valid());
+
+  const auto ranges1 = patchRenderer.patchRanges(&patchNode1);
+  const auto ranges2 = patchRenderer.patchRanges(&patchNode2);
+  REQUIRE(ranges1);
+  REQUIRE(ranges2);
+
+  CHECK(ranges1->vertices.size == patchNode1.grid().points.size());
+  CHECK(ranges1->faceIndices.size == faceIndexCount(patchNode1));
+  CHECK(ranges1->edgeIndices.size == edgeIndexCount(patchNode1));
+  CHECK(ranges2->vertices.size == patchNode2.grid().points.size());
+  CHECK(ranges2->faceIndices.size == faceIndexCount(patchNode2));
+  CHECK(ranges2->edgeIndices.size == edgeIndexCount(patchNode2));
+
+  // both patches use the same material and therefore share all arrays
+  CHECK_FALSE(overlap(ranges1->vertices, ranges2->vertices));
+  CHECK_FALSE(overlap(ranges1->faceIndices, ranges2->faceIndices));
+  CHECK_FALSE(overlap(ranges1->edgeIndices, ranges2->edgeIndices));
+
+  SECTION("Adding a patch twice doesn't invalidate it")
+  {
+    patchRenderer.addPatch(&patchNode1);
+    CHECK(patchRenderer.valid());
+    CHECK(patchRenderer.patchRanges(&patchNode1) == ranges1);
+  }
+
+  SECTION("Invalidating a patch only removes that patch")
+  {
+    patchRenderer.invalidatePatch(&patchNode1);
+    CHECK_FALSE(patchRenderer.valid());
+    CHECK(patchRenderer.patchRanges(&patchNode1) == std::nullopt);
+    CHECK(patchRenderer.patchRanges(&patchNode2) == ranges2);
+
+    patchRenderer.validate();
+    CHECK(patchRenderer.patchRanges(&patchNode1) == ranges1);
+    CHECK(patchRenderer.patchRanges(&patchNode2) == ranges2);
+  }
+
+  SECTION("Changing a patch only moves that patch")
+  {
+    patchNode1.setPatch(makePatch(5, 5));
+    patchRenderer.invalidatePatch(&patchNode1);
+    patchRenderer.validate();
+
+    const auto newRanges1 = patchRenderer.patchRanges(&patchNode1);
+    REQUIRE(newRanges1);
+    CHECK(newRanges1->vertices.size == patchNode1.grid().points.size());
+    CHECK(newRanges1->faceIndices.size == faceIndexCount(patchNode1));
+    CHECK(newRanges1->edgeIndices.size == edgeIndexCount(patchNode1));
+
+    CHECK(patchRenderer.patchRanges(&patchNode2) == ranges2);
+    CHECK_FALSE(overlap(newRanges1->vertices, ranges2->vertices));
+    CHECK_FALSE(overlap(newRanges1->faceIndices, ranges2->faceIndices));
+    CHECK_FALSE(overlap(newRanges1->edgeIndices, ranges2->edgeIndices));
+  }
+
+  SECTION("Removing a patch frees its ranges")
+  {
+    patchRenderer.removePatch(&patchNode1);
+    CHECK(patchRenderer.valid());
+    CHECK(patchRenderer.patchRanges(&patchNode1) == std::nullopt);
+    CHECK(patchRenderer.patchRanges(&patchNode2) == ranges2);
+
+    // a patch of the same size reuses the freed ranges
+    auto patchNode3 = mdl::PatchNode{makePatch(3, 3)};
+    patchRenderer.addPatch(&patchNode3);
+    patchRenderer.validate();
+    CHECK(patchRenderer.patchRanges(&patchNode3) == ranges1);
+    CHECK(patchRenderer.patchRanges(&patchNode2) == ranges2);
+
+    // invalid patches are not stored and can be removed, too
+    patchRenderer.invalidatePatch(&patchNode3);
+    patchRenderer.removePatch(&patchNode3);
+    CHECK(patchRenderer.valid());
+  }
+
+  SECTION("Hidden patches are not stored")
+  {
+    patchNode1.setVisibilityState(mdl::VisibilityState::Hidden);
+    patchRenderer.invalidatePatch(&patchNode1);
+    patchRenderer.validate();
+    CHECK(patchRenderer.patchRanges(&patchNode1) == std::nullopt);
+    CHECK(patchRenderer.patchRanges(&patchNode2) == ranges2);
+
+    patchRenderer.removePatch(&patchNode1);
+    CHECK(patchRenderer.valid());
+  }
+
+  SECTION("Invalidating all patches")
+  {
+    patchRenderer.invalidate();
+    CHECK_FALSE(patchRenderer.valid());
+    CHECK(patchRenderer.patchRanges(&patchNode1) == std::nullopt);
+    CHECK(patchRenderer.patchRanges(&patchNode2) == std::nullopt);
+
+    patchRenderer.validate();
+    CHECK(patchRenderer.patchRanges(&patchNode1));
+    CHECK(patchRenderer.patchRanges(&patchNode2));
+  }
+
+  SECTION("Clearing")
+  {
+    patchRenderer.clear();
+    CHECK(patchRenderer.valid());
+    CHECK(patchRenderer.patchRanges(&patchNode1) == std::nullopt);
+    CHECK(patchRenderer.patchRanges(&patchNode2) == std::nullopt);
+  }
+}
+
+} // namespace tb::render
@@ -0,0 +1,136 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render/ShaderUniforms.h"
+#include "render/Uniform.h"
+
+#include "vm/mat.h"
+#include "vm/vec.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::render
+{
+namespace
+{
+
+/**
+ * Records the uniform variables that are resolved and uploaded instead of calling into
+ * OpenGL. Every uniform variable is located at its uniform index.
+ */
+class RecordingUniformBackend : public UniformBackend
+{
+public:
+  std::vector<std::string> resolvedNames;
+  std::vector<std::pair<GLint, UniformValue>> uploads;
+
+  GLint findUniformLocation(const GLuint, const std::string& name) override
+  {
+    resolvedNames.push_back(name);
+    return GLint(uniformIndex(name));
+  }
+
+  void uploadUniform(const GLint location, const UniformValue& value) override
+  {
+    uploads.emplace_back(location, value);
+  }
+};
+
+} // namespace
+
+TEST_CASE("ShaderUniforms")
+{
+  const auto floatUniform = Uniform<float>{"ShaderUniformsTest.Float"};
+  const auto vecUniform = Uniform<vm::vec3f>{"ShaderUniformsTest.Vec"};
+  const auto matUniform = Uniform<vm::mat4x4f>{"ShaderUniformsTest.Mat"};
+
+  auto backend = RecordingUniformBackend{};
+  auto uniforms = ShaderUniforms{backend, 1};
+  uniforms.resolve();
+
+  SECTION("Resolves all registered uniform variables")
+  {
+    CHECK(backend.resolvedNames.size() == uniformCount());
+
+    backend.resolvedNames.clear();
+    uniforms.set(floatUniform.index(), toUniformValue(1.0f));
+    uniforms.set(vecUniform.index(), toUniformValue(vm::vec3f{1, 2, 3}));
+    CHECK(backend.resolvedNames.empty());
+  }
+
+  SECTION("Resolves uniform variables registered after linking")
+  {
+    const auto lateUniform = Uniform<int>{"ShaderUniformsTest.Late"};
+
+    backend.resolvedNames.clear();
+    uniforms.set(lateUniform.index(), toUniformValue(1));
+    CHECK(backend.resolvedNames == std::vector<std::string>{"ShaderUniformsTest.Late"});
+  }
+
+  SECTION("Skips uploads of unchanged values")
+  {
+    uniforms.set(floatUniform.index(), toUniformValue(1.0f));
+    uniforms.set(vecUniform.index(), toUniformValue(vm::vec3f{1, 2, 3}));
+    uniforms.set(matUniform.index(), toUniformValue(vm::mat4x4f::identity()));
+    CHECK(backend.uploads.size() == 3u);
+
+    uniforms.set(floatUniform.index(), toUniformValue(1.0f));
+    uniforms.set(vecUniform.index(), toUniformValue(vm::vec3f{1, 2, 3}));
+    uniforms.set(matUniform.index(), toUniformValue(vm::mat4x4f::identity()));
+    CHECK(backend.uploads.size() == 3u);
+
+    uniforms.set(floatUniform.index(), toUniformValue(2.0f));
+    uniforms.set(vecUniform.index(), toUniformValue(vm::vec3f{1, 2, 3}));
+    CHECK(backend.uploads.size() == 4u);
+    CHECK(
+      backend.uploads.back()
+      == std::pair{GLint(floatUniform.index()), toUniformValue(2.0f)});
+  }
+
+  SECTION("Converts values to their uniform types")
+  {
+    const auto boolUniform = Uniform<bool>{"ShaderUniformsTest.Bool"};
+
+    uniforms.set(boolUniform.index(), toUniformValue(true));
+    uniforms.set(boolUniform.index(), toUniformValue(1));
+    uniforms.set(boolUniform.index(), toUniformValue(size_t(1)));
+    CHECK(backend.uploads.size() == 1u);
+    CHECK(backend.uploads.back().second == UniformValue{1});
+  }
+
+  SECTION("Uploads all values again after linking")
+  {
+    uniforms.set(floatUniform.index(), toUniformValue(1.0f));
+    uniforms.resolve();
+    uniforms.set(floatUniform.index(), toUniformValue(1.0f));
+    CHECK(backend.uploads.size() == 2u);
+  }
+
+  SECTION("Uniform variables with the same name share an index")
+  {
+    CHECK(Uniform<float>{"ShaderUniformsTest.Float"}.index() == floatUniform.index());
+    CHECK(uniformName(floatUniform.index()) == "ShaderUniformsTest.Float");
+  }
+}
+
+} // namespace tb::render
@@ -23,6 +23,7 @@
 #include <QTextStream>
 
 #include "PreferenceManager.h"
+#include "Preferences.h"
 #include "io/PathQt.h"
 
 #include <kdl/path_utils.h>
@@ -30,7 +31,9 @@
 #include "vm/approx.h"
 
 #include <filesystem>
+#include <future>
 #include <iostream>
+#include <memory>
 #include <optional>
 #include <string>
 
@@ -304,4 +307,56 @@ TEST_CASE("Preferences")
   }
 }
 
+TEST_CASE("PreferenceSnapshot")
+{
+  const auto initialSnapshot = prefSnapshot();
+  const auto initialBrightness = pref(Preferences::Brightness);
+
+  CHECK(initialSnapshot->brightness == initialBrightness);
+  CHECK(initialSnapshot->gridAlpha == pref(Preferences::GridAlpha));
+  CHECK(initialSnapshot->gridColor2D == pref(Preferences::GridColor2D));
+  CHECK(initialSnapshot->softMapBoundsColor == pref(Preferences::SoftMapBoundsColor));
+
+  SECTION("Changing another preference keeps the snapshot")
+  {
+    const auto tempPref = TemporarilySetPref{Preferences::TransparentFaceAlpha, 0.123f};
+    CHECK(prefSnapshot() == initialSnapshot);
+  }
+
+  SECTION("Changing a preference publishes a new snapshot")
+  {
+    const auto tempPref =
+      TemporarilySetPref{Preferences::Brightness, initialBrightness + 1.0f};
+
+    const auto snapshot = prefSnapshot();
+    CHECK(snapshot->version > initialSnapshot->version);
+    CHECK(snapshot->brightness == initialBrightness + 1.0f);
+
+    // published snapshots are immutable
+    CHECK(initialSnapshot->brightness == initialBrightness);
+  }
+
+  SECTION("Replaced snapshots are freed when they are no longer used")
+  {
+    auto replacedSnapshot = std::weak_ptr<const PreferenceSnapshot>{};
+    {
+      const auto tempPref =
+        TemporarilySetPref{Preferences::Brightness, initialBrightness + 1.0f};
+      replacedSnapshot = prefSnapshot();
+      CHECK_FALSE(replacedSnapshot.expired());
+    }
+
+    CHECK(replacedSnapshot.expired());
+  }
+
+  SECTION("Snapshots can be read on other threads")
+  {
+    const auto tempPref = TemporarilySetPref{Preferences::GridAlpha, 0.125f};
+
+    auto gridAlpha =
+      std::async(std::launch::async, []() { return prefSnapshot()->gridAlpha; });
+    CHECK(gridAlpha.get() == 0.125f);
+  }
+}
+
 } // namespace tb
@@ -19,6 +19,8 @@
 
 #include "octree.h"
 
+#include <vector>
+
 #include "Catch2.h"
 
 namespace tb
@@ -537,6 +539,36 @@ TEST_CASE("octree.remove")
     tree.remove(1);
     CHECK(tree == octree<double, int>{32.0});
   }
+
+  SECTION("remove several at once")
+  {
+    CHECK(tree.remove(std::vector<int>{3, 1}) == 2u);
+    CHECK(
+      tree
+      == octree<double, int>{
+        32.0,
+        inner_node{
+          {-2, -2, -2, 2},
+          {},
+          kdl::vec_from(
+            node{leaf_node{{-2, -2, -2, 1}, {}}},
+            node{leaf_node{{0, -2, -2, 1}, {}}},
+            node{leaf_node{{-2, 0, -2, 1}, {}}},
+            node{leaf_node{{0, 0, -2, 1}, {}}},
+            node{leaf_node{{-2, -2, 0, 1}, {}}},
+            node{leaf_node{{0, -2, 0, 1}, {}}},
+            node{leaf_node{{-2, 0, 0, 1}, {}}},
+            node{leaf_node{{0, 0, 0, 0}, {2}}})}});
+
+    CHECK(tree.remove(std::vector<int>{2, 4}) == 1u);
+    CHECK(tree == octree<double, int>{32.0});
+  }
+
+  SECTION("remove all at once")
+  {
+    CHECK(tree.remove(std::vector<int>{1, 2, 3, 1}) == 3u);
+    CHECK(tree == octree<double, int>{32.0});
+  }
 }
 
 TEST_CASE("octree.insert_duplicate")
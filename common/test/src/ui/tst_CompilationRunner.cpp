@@ -308,11 +308,59 @@ TEST_CASE("CompilationExportMapTaskRunner")
     auto task = mdl::CompilationExportMap{true, exportPath};
 
     auto runner = CompilationExportMapTaskRunner{context, task};
-    REQUIRE_NOTHROW(runner.execute());
+    auto exec = ExecuteTask{runner};
+    REQUIRE(exec.executeAndWait(5000ms));
 
+    CHECK(exec.ended);
     CHECK(testEnvironment.fileExists("exported.map"));
   }
 
+  SECTION("exportMap doesn't rewrite unchanged file")
+  {
+    auto node = new mdl::EntityNode{mdl::Entity{}};
+    document->addNodes({{document->parentForNodes(), {node}}});
+
+    auto task = mdl::CompilationExportMap{true, "${WORK_DIR_PATH}/exported.map"};
+    const auto exportedPath = testEnvironment.dir() / "exported.map";
+
+    {
+      auto runner = CompilationExportMapTaskRunner{context, task};
+      auto exec = ExecuteTask{runner};
+      REQUIRE(exec.executeAndWait(5000ms));
+      REQUIRE(exec.ended);
+    }
+
+    const auto exportedContents = testEnvironment.loadFile("exported.map");
+    const auto pastTime =
+      std::filesystem::last_write_time(exportedPath) - std::chrono::hours{1};
+    std::filesystem::last_write_time(exportedPath, pastTime);
+
+    SECTION("unchanged document")
+    {
+      auto runner = CompilationExportMapTaskRunner{context, task};
+      auto exec = ExecuteTask{runner};
+      REQUIRE(exec.executeAndWait(5000ms));
+
+      CHECK(exec.ended);
+      CHECK(std::filesystem::last_write_time(exportedPath) == pastTime);
+      CHECK(testEnvironment.loadFile("exported.map") == exportedContents);
+    }
+
+    SECTION("changed document")
+    {
+      document->addNodes(
+        {{document->parentForNodes(), {new mdl::EntityNode{mdl::Entity{}}}}});
+
+      auto runner = CompilationExportMapTaskRunner{context, task};
+      auto exec = ExecuteTask{runner};
+      REQUIRE(exec.executeAndWait(5000ms));
+
+      CHECK(exec.ended);
+      CHECK(std::filesystem::last_write_time(exportedPath) != pastTime);
+      CHECK(testEnvironment.loadFile("exported.map") != exportedContents);
+    }
+  }
+
   SECTION("variable interpolation error")
   {
     auto node = new mdl::EntityNode{mdl::Entity{}};
@@ -353,12 +401,49 @@ TEST_CASE_METHOD(MapDocumentTest, "CompilationCopyFilesTaskRunner")
       (testEnvironment.dir() / targetPath).string()};
     auto runner = CompilationCopyFilesTaskRunner{context, task};
 
-    REQUIRE_NOTHROW(runner.execute());
+    auto exec = ExecuteTask{runner};
+    REQUIRE(exec.executeAndWait(5000ms));
 
+    CHECK(exec.ended);
     CHECK(testEnvironment.directoryExists(kdl::parse_path(targetPath)));
     CHECK(testEnvironment.loadFile(kdl::parse_path(targetPath) / sourcePath) == "{}");
   }
 
+  SECTION("skip unchanged files")
+  {
+    testEnvironment.createFile("unchanged.map", "{}");
+    testEnvironment.createFile("changed.map", "{}");
+    testEnvironment.createDirectory("target");
+
+    auto task = mdl::CompilationCopyFiles{
+      true,
+      (testEnvironment.dir() / "*.map").string(),
+      (testEnvironment.dir() / "target").string()};
+
+    {
+      auto runner = CompilationCopyFilesTaskRunner{context, task};
+      auto exec = ExecuteTask{runner};
+      REQUIRE(exec.executeAndWait(5000ms));
+      REQUIRE(exec.ended);
+    }
+
+    const auto unchangedTargetPath = testEnvironment.dir() / "target/unchanged.map";
+    const auto pastTime =
+      std::filesystem::last_write_time(unchangedTargetPath) - std::chrono::hours{1};
+    std::filesystem::last_write_time(unchangedTargetPath, pastTime);
+
+    testEnvironment.createFile("changed.map", "{...}");
+
+    auto runner = CompilationCopyFilesTaskRunner{context, task};
+    auto exec = ExecuteTask{runner};
+    REQUIRE(exec.executeAndWait(5000ms));
+
+    CHECK(exec.ended);
+    CHECK(std::filesystem::last_write_time(unchangedTargetPath) == pastTime);
+    CHECK(testEnvironment.loadFile("target/unchanged.map") == "{}");
+    CHECK(testEnvironment.loadFile("target/changed.map") == "{...}");
+  }
+
   SECTION("variable interpolation errors")
   {
     const auto sourcePath =
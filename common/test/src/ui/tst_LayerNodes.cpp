@@ -20,13 +20,18 @@
 
 #include "MapDocumentTest.h"
 #include "TestUtils.h"
+#include "io/TestEnvironment.h"
 #include "mdl/BrushNode.h"
+#include "mdl/Entity.h"
 #include "mdl/EntityNode.h"
 #include "mdl/GroupNode.h"
 #include "mdl/LayerNode.h"
 #include "mdl/LockState.h"
+#include "mdl/Material.h"
 #include "mdl/ModelUtils.h"
 #include "mdl/PatchNode.h"
+#include "mdl/Texture.h"
+#include "mdl/TextureResource.h"
 #include "mdl/VisibilityState.h"
 #include "mdl/WorldNode.h"
 
@@ -534,4 +539,109 @@ TEST_CASE_METHOD(MapDocumentTest, "LayerNodeTest.setCurrentLayerCollation")
   CHECK(document->currentLayer() == layerNode2);
 }
 
+TEST_CASE("LayerNodeTest.deferredLayerContents")
+{
+  const auto mapPath =
+    std::filesystem::path{"fixture/test/ui/LayerNodeTest/hiddenLayer.map"};
+  auto [document, game, gameConfig, taskManager] =
+    loadMapDocument(mapPath, "Quake", mdl::MapFormat::Standard);
+
+  const auto customLayers = document->world()->customLayers();
+  REQUIRE(customLayers.size() == 1u);
+
+  auto* layerNode = customLayers.front();
+  REQUIRE(layerNode->hidden());
+  REQUIRE(layerNode->hasDeferredContents());
+  CHECK(layerNode->childCount() == 0u);
+  CHECK(layerNode->deferredContents()->objectCount == 2u);
+
+  SECTION("Showing the layer creates its contents")
+  {
+    document->show({layerNode});
+    CHECK_FALSE(layerNode->hasDeferredContents());
+    CHECK(layerNode->childCount() == 2u);
+
+    document->undoCommand();
+    CHECK(layerNode->hidden());
+    CHECK(layerNode->childCount() == 2u);
+  }
+
+  SECTION("Adding nodes to the layer creates its contents first")
+  {
+    auto* entityNode = new mdl::EntityNode{mdl::Entity{}};
+    document->addNodes({{layerNode, {entityNode}}});
+    CHECK_FALSE(layerNode->hasDeferredContents());
+    CHECK(layerNode->childCount() == 3u);
+    CHECK(layerNode->children().back() == entityNode);
+  }
+
+  SECTION("Selecting all in the layer creates its contents")
+  {
+    document->selectAllInLayers({layerNode});
+    CHECK_FALSE(layerNode->hasDeferredContents());
+    CHECK(layerNode->childCount() == 2u);
+  }
+
+  SECTION("Removing the layer moves its contents to the default layer")
+  {
+    auto* defaultLayerNode = document->world()->defaultLayer();
+    REQUIRE(defaultLayerNode->childCount() == 1u);
+
+    document->removeLayer(layerNode);
+    CHECK(document->world()->customLayers().empty());
+    CHECK(defaultLayerNode->childCount() == 3u);
+
+    document->undoCommand();
+    REQUIRE(document->world()->customLayers() == std::vector{layerNode});
+    CHECK(layerNode->childCount() == 2u);
+    CHECK(defaultLayerNode->childCount() == 1u);
+  }
+
+  SECTION("Material usage counts include the deferred contents")
+  {
+    const auto material =
+      mdl::Material{"__TB_empty", mdl::createTextureResource(mdl::Texture{16, 16})};
+    CHECK(document->materialUsageCount(material) == 6u);
+    CHECK(layerNode->hasDeferredContents());
+  }
+
+  SECTION("Finding faces by material creates the contents that use it")
+  {
+    const auto otherMaterial =
+      mdl::Material{"other", mdl::createTextureResource(mdl::Texture{16, 16})};
+    document->allBrushFacesWithMaterial(otherMaterial);
+    CHECK(layerNode->hasDeferredContents());
+
+    const auto material =
+      mdl::Material{"__TB_empty", mdl::createTextureResource(mdl::Texture{16, 16})};
+    document->allBrushFacesWithMaterial(material);
+    CHECK_FALSE(layerNode->hasDeferredContents());
+    CHECK(layerNode->childCount() == 2u);
+  }
+
+  SECTION("Saving the document creates the contents and writes the same map")
+  {
+    auto env = io::TestEnvironment{};
+
+    const auto newDocumentPath = std::filesystem::path{"test.map"};
+    document->saveDocumentTo(env.dir() / newDocumentPath);
+    CHECK_FALSE(layerNode->hasDeferredContents());
+    CHECK(layerNode->childCount() == 2u);
+
+    CHECK(env.loadFile(newDocumentPath) == io::readTextFile(mapPath));
+  }
+
+  SECTION("Saving a backup writes the same map without creating the contents")
+  {
+    auto env = io::TestEnvironment{};
+
+    const auto backupPath = std::filesystem::path{"test-1.map"};
+    document->saveBackupTo(env.dir() / backupPath);
+    CHECK(layerNode->hasDeferredContents());
+    CHECK(layerNode->childCount() == 0u);
+
+    CHECK(env.loadFile(backupPath) == io::readTextFile(mapPath));
+  }
+}
+
 } // namespace tb::ui
@@ -20,6 +20,7 @@
 #include "Exceptions.h"
 #include "MapDocumentTest.h"
 #include "TestUtils.h"
+#include "io/ELParser.h"
 #include "io/MapHeader.h"
 #include "io/TestEnvironment.h"
 #include "io/WorldReader.h"
@@ -28,20 +29,28 @@
 #include "mdl/Entity.h"
 #include "mdl/EntityDefinition.h"
 #include "mdl/EntityDefinitionManager.h"
+#include "mdl/EntityModel.h"
+#include "mdl/EntityModelManager.h"
 #include "mdl/EntityNode.h"
 #include "mdl/Group.h"
 #include "mdl/GroupNode.h"
 #include "mdl/LayerNode.h"
+#include "mdl/ModelDefinition.h"
 #include "mdl/PatchNode.h"
 #include "mdl/PropertyDefinition.h"
+#include "mdl/Resource.h"
 #include "mdl/WorldNode.h"
 
 #include "kdl/map_utils.h"
 #include "kdl/result.h"
 #include "kdl/vector_utils.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -286,6 +295,19 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTestFixture")
         mapNodeNames(document->selectedNodes().nodes()),
         Catch::Matchers::UnorderedEquals(expectedNodeNames));
     }
+
+    SECTION("copying nodes updates their file positions")
+    {
+      document->selectNodesWithFilePosition({12});
+      REQUIRE(document->selectedNodes().nodes() == std::vector<mdl::Node*>{pointEntity});
+
+      document->serializeSelectedNodes();
+      REQUIRE(pointEntity->lineNumber() != 10);
+
+      document->deselectAll();
+      document->selectNodesWithFilePosition({pointEntity->lineNumber()});
+      CHECK(document->selectedNodes().nodes() == std::vector<mdl::Node*>{pointEntity});
+    }
   }
 
   SECTION("canUpdateLinkedGroups")
@@ -842,4 +864,81 @@ TEST_CASE("MapDocumentTest")
   }
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.loadEntityModels")
+{
+  document->setEntityDefinitions({
+    {"model_entity",
+     Color{},
+     "this is a point entity with a model",
+     {},
+     mdl::PointEntityDefinition{
+       vm::bbox3d{16.0},
+       mdl::ModelDefinition{io::ELParser::parseStrict("{ path: model }").value()},
+       {}}},
+  });
+
+  auto* hiddenEntityNode = new mdl::EntityNode{
+    mdl::Entity{{{"classname", "model_entity"}, {"model", "hidden.mdl"}}}};
+  auto* visibleEntityNode = new mdl::EntityNode{
+    mdl::Entity{{{"classname", "model_entity"}, {"model", "visible.mdl"}}}};
+
+  document->addNodes(
+    {{document->parentForNodes(), {hiddenEntityNode, visibleEntityNode}}});
+  document->hide({hiddenEntityNode});
+
+  auto& entityModelManager = document->entityModelManager();
+
+  // keep the pending models alive so that their resources are processed
+  const auto oldHiddenModel = *entityModelManager.model("hidden.mdl");
+  const auto oldVisibleModel = *entityModelManager.model("visible.mdl");
+
+  auto errors = std::vector<std::pair<mdl::ResourceId, std::string>>{};
+  const auto processContext =
+    mdl::ProcessContext{false, [&](const auto& resourceId, const auto& error) {
+                          errors.emplace_back(resourceId, error);
+                        }};
+
+  const auto findError = [&](const mdl::EntityModel& model) {
+    return std::ranges::find_if(errors, [&](const auto& resourceIdAndError) {
+      return resourceIdAndError.first == model.dataResource().id();
+    });
+  };
+
+  const auto errorFor = [&](const mdl::EntityModel& model) {
+    const auto it = findError(model);
+    REQUIRE(it != errors.end());
+    return it->second;
+  };
+
+  SECTION("Changing the mods cancels pending loads and loads visible models first")
+  {
+    document->setMods({"mod"});
+
+    const auto& newHiddenModel = *entityModelManager.model("hidden.mdl");
+    const auto& newVisibleModel = *entityModelManager.model("visible.mdl");
+
+    document->processResourcesSync(processContext);
+
+    CHECK(errorFor(oldHiddenModel) == "Loading cancelled");
+    CHECK(errorFor(oldVisibleModel) == "Loading cancelled");
+
+    // the model files don't exist, but the loaders were run
+    CHECK(errorFor(newHiddenModel) != "Loading cancelled");
+    CHECK(errorFor(newVisibleModel) != "Loading cancelled");
+
+    CHECK(findError(newVisibleModel) < findError(newHiddenModel));
+  }
+
+  SECTION("Closing the document cancels pending loads")
+  {
+    document->newDocument(mdl::MapFormat::Standard, vm::bbox3d{8192.0}, game)
+      | kdl::transform_error([](auto e) { throw std::runtime_error{e.msg}; });
+
+    document->processResourcesSync(processContext);
+
+    CHECK(errorFor(oldHiddenModel) == "Loading cancelled");
+    CHECK(errorFor(oldVisibleModel) == "Loading cancelled");
+  }
+}
+
 } // namespace tb::ui
@@ -19,6 +19,7 @@
 
 #include "TestUtils.h"
 #include "mdl/BrushBuilder.h"
+#include "mdl/BrushFaceHandle.h"
 #include "mdl/BrushNode.h"
 #include "mdl/EntityNode.h"
 #include "mdl/GroupNode.h"
@@ -30,6 +31,7 @@
 #include "ui/MapDocumentTest.h"
 
 #include "kdl/result.h"
+#include "kdl/vector_utils.h"
 
 #include "Catch2.h"
 
@@ -561,6 +563,102 @@ TEST_CASE_METHOD(MapDocumentTest, "SelectionTest.selectSiblings")
   }
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "SelectionTest.allSelectedBrushFaces")
+{
+  auto* brushNode1 = createBrushNode();
+  auto* brushNode2 = createBrushNode();
+  document->addNodes({{document->parentForNodes(), {brushNode1, brushNode2}}});
+
+  SECTION("Nothing selected")
+  {
+    CHECK(document->allSelectedBrushFaces().empty());
+  }
+
+  SECTION("Selected brushes")
+  {
+    document->selectNodes({brushNode1});
+    CHECK_THAT(
+      document->allSelectedBrushFaces(),
+      Catch::UnorderedEquals(mdl::toHandles(brushNode1)));
+
+    document->selectNodes({brushNode2});
+    CHECK_THAT(
+      document->allSelectedBrushFaces(),
+      Catch::UnorderedEquals(
+        kdl::vec_concat(mdl::toHandles(brushNode1), mdl::toHandles(brushNode2))));
+
+    document->deselectNodes({brushNode1});
+    CHECK_THAT(
+      document->allSelectedBrushFaces(),
+      Catch::UnorderedEquals(mdl::toHandles(brushNode2)));
+
+    document->deselectAll();
+    CHECK(document->allSelectedBrushFaces().empty());
+  }
+
+  SECTION("Selection observers see the selected faces")
+  {
+    // cache the faces before the selection changes
+    REQUIRE(document->allSelectedBrushFaces().empty());
+
+    auto observedFaces = std::vector<mdl::BrushFaceHandle>{};
+    const auto connection = document->selectionDidChangeNotifier.connect(
+      [&](const auto&) { observedFaces = document->allSelectedBrushFaces(); });
+
+    document->selectNodes({brushNode1});
+    CHECK_THAT(observedFaces, Catch::UnorderedEquals(mdl::toHandles(brushNode1)));
+
+    document->deselectNodes({brushNode1});
+    CHECK(observedFaces.empty());
+  }
+
+  SECTION("Selected linked groups")
+  {
+    document->selectNodes({brushNode1});
+    auto* groupNode = document->groupSelection("test");
+    document->deselectAll();
+
+    document->selectNodes({groupNode});
+    auto* linkedGroupNode = document->createLinkedDuplicate();
+    document->deselectAll();
+
+    document->selectNodes({groupNode, linkedGroupNode});
+    CHECK(document->allSelectedBrushFaces().size() == brushNode1->brush().faceCount());
+
+    // adding a brush to the selected group must be reflected
+    document->deselectAll();
+    auto* brushNode3 = createBrushNode();
+    document->addNodes({{groupNode, {brushNode3}}});
+    document->selectNodes({groupNode});
+    CHECK_THAT(
+      document->allSelectedBrushFaces(),
+      Catch::UnorderedEquals(
+        kdl::vec_concat(mdl::toHandles(brushNode1), mdl::toHandles(brushNode3))));
+  }
+
+  SECTION("Selected faces")
+  {
+    document->selectBrushFaces({{brushNode1, 0}, {brushNode1, 1}, {brushNode2, 2}});
+    CHECK_THAT(
+      document->allSelectedBrushFaces(),
+      Catch::Equals(std::vector<mdl::BrushFaceHandle>{
+        {brushNode1, 0}, {brushNode1, 1}, {brushNode2, 2}}));
+
+    document->deselectBrushFaces({{brushNode1, 1}});
+    CHECK_THAT(
+      document->selectedBrushFaces(),
+      Catch::Equals(
+        std::vector<mdl::BrushFaceHandle>{{brushNode1, 0}, {brushNode2, 2}}));
+    CHECK(!brushNode1->brush().face(1).selected());
+
+    document->undoCommand();
+    CHECK_THAT(
+      document->selectedBrushFaces(),
+      Catch::UnorderedEquals(std::vector<mdl::BrushFaceHandle>{
+        {brushNode1, 0}, {brushNode1, 1}, {brushNode2, 2}}));
+  }
+}
+
 TEST_CASE_METHOD(MapDocumentTest, "SelectionTest.updateLastSelectionBounds")
 {
   auto* entityNode = new mdl::EntityNode{mdl::Entity{{{"classname", "point_entity"}}}};
@@ -104,13 +104,13 @@ TEST_CASE_METHOD(MapDocumentTest, "SwapNodeContentsTest.materialUsageCount")
   auto nodesToSwap = std::vector<std::pair<mdl::Node*, mdl::NodeContents>>{};
   nodesToSwap.emplace_back(brushNode, std::move(modifiedBrush));
 
-  REQUIRE(material->usageCount() == 6u);
+  REQUIRE(document->materialUsageCount(*material) == 6u);
 
   document->swapNodeContents("Swap Nodes", std::move(nodesToSwap), {});
-  CHECK(material->usageCount() == 6u);
+  CHECK(document->materialUsageCount(*material) == 6u);
 
   document->undoCommand();
-  CHECK(material->usageCount() == 6u);
+  CHECK(document->materialUsageCount(*material) == 6u);
 }
 
 TEST_CASE_METHOD(MapDocumentTest, "SwapNodeContentsTest.entityDefinitionUsageCount")
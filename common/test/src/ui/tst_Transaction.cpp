@@ -18,12 +18,20 @@
  */
 
 #include "MapDocumentTest.h"
+#include "NotifierConnection.h"
+#include "mdl/BrushNode.h"
 #include "mdl/Entity.h"
 #include "mdl/EntityNode.h"
 #include "ui/Transaction.h"
 
+#include "kdl/vector_utils.h"
+
 #include "vm/mat_ext.h"
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include "Catch2.h"
 
 namespace tb::ui
@@ -86,4 +94,144 @@ TEST_CASE_METHOD(MapDocumentTest, "Transaction")
   }
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "Transaction.coalesceChangeNotifications")
+{
+  auto* brushNode = createBrushNode();
+  document->addNodes({{document->parentForNodes(), {brushNode}}});
+  document->selectNodes({brushNode});
+
+  auto events = std::vector<std::pair<std::string, std::vector<mdl::Node*>>>{};
+  auto observedBounds = std::vector<vm::bbox3d>{};
+
+  auto notifierConnection = NotifierConnection{};
+  notifierConnection += document->nodesWillChangeNotifier.connect(
+    [&](const auto& nodes) { events.emplace_back("willChange", nodes); });
+  notifierConnection +=
+    document->nodesDidChangeNotifier.connect([&](const auto& nodes) {
+      events.emplace_back("didChange", nodes);
+      if (kdl::vec_contains(nodes, brushNode))
+      {
+        observedBounds.push_back(brushNode->logicalBounds());
+      }
+    });
+  notifierConnection += document->nodesWereRemovedNotifier.connect(
+    [&](const auto& nodes) { events.emplace_back("wereRemoved", nodes); });
+
+  const auto countEvents = [&](const std::string& name) {
+    return std::count_if(events.begin(), events.end(), [&](const auto& event) {
+      return event.first == name;
+    });
+  };
+
+  const auto collectNodes = [&](const std::string& name) {
+    auto result = std::vector<mdl::Node*>{};
+    for (const auto& [eventName, nodes] : events)
+    {
+      if (eventName == name)
+      {
+        result = kdl::vec_concat(std::move(result), nodes);
+      }
+    }
+    return kdl::vec_sort_and_remove_duplicates(std::move(result));
+  };
+
+  const auto translateTwice = [&]() {
+    auto transaction = Transaction{document, "Translate Twice"};
+    document->translate(vm::vec3d{16, 0, 0});
+    document->translate(vm::vec3d{0, 16, 0});
+    transaction.commit();
+  };
+
+  SECTION("Notifications are delivered immediately by default")
+  {
+    REQUIRE_FALSE(document->coalesceChangeNotifications());
+
+    translateTwice();
+
+    CHECK(countEvents("didChange") > 1);
+    CHECK(observedBounds.size() == 2u);
+  }
+
+  SECTION("Notifications are coalesced until the transaction is committed")
+  {
+    translateTwice();
+    const auto uncoalescedWillChange = collectNodes("willChange");
+    const auto uncoalescedDidChange = collectNodes("didChange");
+    document->undoCommand();
+
+    events.clear();
+    observedBounds.clear();
+
+    document->setCoalesceChangeNotifications(true);
+    translateTwice();
+
+    CHECK(countEvents("didChange") == 1);
+    CHECK(events.back().first == "didChange");
+
+    // every node is reported only once
+    auto willChangeNodes = std::vector<mdl::Node*>{};
+    for (const auto& [eventName, nodes] : events)
+    {
+      if (eventName == "willChange")
+      {
+        willChangeNodes = kdl::vec_concat(std::move(willChangeNodes), nodes);
+      }
+    }
+    CHECK(
+      willChangeNodes.size()
+      == kdl::vec_sort_and_remove_duplicates(willChangeNodes).size());
+    CHECK(events.back().second.size() == uncoalescedDidChange.size());
+
+    // the observers see the same nodes and the same final state
+    CHECK(collectNodes("willChange") == uncoalescedWillChange);
+    CHECK(collectNodes("didChange") == uncoalescedDidChange);
+    CHECK(observedBounds == std::vector<vm::bbox3d>{brushNode->logicalBounds()});
+  }
+
+  SECTION("Undo and redo are coalesced")
+  {
+    document->setCoalesceChangeNotifications(true);
+    translateTwice();
+
+    events.clear();
+    document->undoCommand();
+    CHECK(countEvents("didChange") == 1);
+
+    events.clear();
+    document->redoCommand();
+    CHECK(countEvents("didChange") == 1);
+  }
+
+  SECTION("Pending notifications are delivered before nodes are removed")
+  {
+    document->setCoalesceChangeNotifications(true);
+
+    auto* entityNode = new mdl::EntityNode{mdl::Entity{}};
+
+    auto transaction = Transaction{document};
+    document->addNodes({{document->parentForNodes(), {entityNode}}});
+    document->deselectAll();
+    document->selectNodes({entityNode});
+    document->translate(vm::vec3d{16, 0, 0});
+
+    REQUIRE(countEvents("didChange") == 0);
+
+    transaction.cancel();
+
+    const auto didChangeEntity = std::find_if(
+      events.begin(), events.end(), [&](const auto& event) {
+        return event.first == "didChange" && kdl::vec_contains(event.second, entityNode);
+      });
+    const auto wasRemoved = std::find_if(
+      events.begin(), events.end(), [&](const auto& event) {
+        return event.first == "wereRemoved"
+               && kdl::vec_contains(event.second, entityNode);
+      });
+
+    REQUIRE(didChangeEntity != events.end());
+    REQUIRE(wasRemoved != events.end());
+    CHECK(didChangeEntity < wasRemoved);
+  }
+}
+
 } // namespace tb::ui
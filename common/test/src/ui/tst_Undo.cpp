@@ -45,7 +45,7 @@ TEST_CASE_METHOD(MapDocumentTest, "UndoTest.setMaterialsAfterRestore")
 
   const auto* material = document->materialManager().material("coffin1");
   CHECK(material != nullptr);
-  CHECK(material->usageCount() == 6u);
+  CHECK(document->materialUsageCount(*material) == 6u);
 
   for (const auto& face : brushNode->brush().faces())
   {
@@ -56,20 +56,42 @@ TEST_CASE_METHOD(MapDocumentTest, "UndoTest.setMaterialsAfterRestore")
   {
     document->selectNodes({brushNode});
     document->translate(vm::vec3d(1, 1, 1));
-    CHECK(material->usageCount() == 6u);
+    CHECK(document->materialUsageCount(*material) == 6u);
 
     document->undoCommand();
-    CHECK(material->usageCount() == 6u);
+    CHECK(document->materialUsageCount(*material) == 6u);
   }
 
   SECTION("delete brush")
   {
     document->selectNodes({brushNode});
     document->remove();
-    CHECK(material->usageCount() == 0u);
+    CHECK(document->materialUsageCount(*material) == 0u);
 
     document->undoCommand();
-    CHECK(material->usageCount() == 6u);
+    CHECK(document->materialUsageCount(*material) == 6u);
+  }
+
+  SECTION("set material of top face")
+  {
+    const auto* otherMaterial = document->materialManager().material("coffin2");
+    REQUIRE(otherMaterial != nullptr);
+    CHECK(document->materialUsageCount(*otherMaterial) == 0u);
+
+    auto topFaceIndex = brushNode->brush().findFace(vm::vec3d{0, 0, 1});
+    REQUIRE(topFaceIndex.has_value());
+
+    document->selectBrushFaces({{brushNode, *topFaceIndex}});
+
+    auto request = mdl::ChangeBrushFaceAttributesRequest{};
+    request.setMaterialName("coffin2");
+    REQUIRE(document->setFaceAttributes(request));
+    CHECK(document->materialUsageCount(*material) == 5u);
+    CHECK(document->materialUsageCount(*otherMaterial) == 1u);
+
+    document->undoCommand();
+    CHECK(document->materialUsageCount(*material) == 6u);
+    CHECK(document->materialUsageCount(*otherMaterial) == 0u);
   }
 
   SECTION("select top face, translate UV")
@@ -84,11 +106,11 @@ TEST_CASE_METHOD(MapDocumentTest, "UndoTest.setMaterialsAfterRestore")
     REQUIRE(document->setFaceAttributes(request));
 
     document->undoCommand(); // undo move
-    CHECK(material->usageCount() == 6u);
+    CHECK(document->materialUsageCount(*material) == 6u);
     REQUIRE(document->hasSelectedBrushFaces());
 
     document->undoCommand(); // undo select
-    CHECK(material->usageCount() == 6u);
+    CHECK(document->materialUsageCount(*material) == 6u);
     REQUIRE(!document->hasSelectedBrushFaces());
   }
 
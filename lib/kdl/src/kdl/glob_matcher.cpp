@@ -0,0 +1,294 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/glob_matcher.h"
+
+#include "kdl/string_compare.h"
+
+#include <algorithm>
+#include <array>
+#include <optional>
+
+namespace kdl
+{
+namespace
+{
+
+enum class glob_token_type
+{
+  // a character that is compared using the character predicate
+  literal,
+  // an escaped character that is compared exactly
+  escaped,
+  // '?'
+  any_char,
+  // '%'
+  digit,
+  // '*'
+  any_chars,
+  // '%*'
+  digits,
+};
+
+struct glob_token
+{
+  glob_token_type type;
+  char c = 0;
+};
+
+bool is_star(const glob_token& token)
+{
+  return token.type == glob_token_type::any_chars
+         || token.type == glob_token_type::digits;
+}
+
+bool is_digit(const char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+bool accepts(
+  const glob_token& token,
+  const char c,
+  const std::function<bool(char, char)>& char_equal)
+{
+  switch (token.type)
+  {
+  case glob_token_type::literal:
+    return char_equal(token.c, c);
+  case glob_token_type::escaped:
+    return token.c == c;
+  case glob_token_type::any_char:
+  case glob_token_type::any_chars:
+    return true;
+  case glob_token_type::digit:
+  case glob_token_type::digits:
+    return is_digit(c);
+  }
+  return false;
+}
+
+std::optional<std::vector<glob_token>> parse_glob(const std::string_view pattern)
+{
+  auto result = std::vector<glob_token>{};
+
+  const auto push_star = [&](const glob_token_type type) {
+    if (!result.empty() && is_star(result.back()))
+    {
+      // collapse consecutive stars into one, '*' subsumes '%*'
+      if (type == glob_token_type::any_chars)
+      {
+        result.back().type = type;
+      }
+    }
+    else
+    {
+      result.push_back({type});
+    }
+  };
+
+  for (std::size_t i = 0; i < pattern.length(); ++i)
+  {
+    const auto c = pattern[i];
+    if (c == '\\' && i < pattern.length() - 1u)
+    {
+      const auto n = pattern[++i];
+      if (n != '*' && n != '?' && n != '%' && n != '\\')
+      {
+        // invalid escape sequence
+        return std::nullopt;
+      }
+      result.push_back({glob_token_type::escaped, n});
+    }
+    else if (c == '*')
+    {
+      push_star(glob_token_type::any_chars);
+    }
+    else if (c == '?')
+    {
+      result.push_back({glob_token_type::any_char});
+    }
+    else if (c == '%' && i < pattern.length() - 1u && pattern[i + 1u] == '*')
+    {
+      push_star(glob_token_type::digits);
+      ++i;
+    }
+    else if (c == '%')
+    {
+      result.push_back({glob_token_type::digit});
+    }
+    else
+    {
+      result.push_back({glob_token_type::literal, c});
+    }
+  }
+
+  return result;
+}
+
+void set_bit(std::uint64_t* words, const std::size_t index)
+{
+  words[index / 64u] |= std::uint64_t(1) << (index % 64u);
+}
+
+bool test_bit(const std::uint64_t* words, const std::size_t index)
+{
+  return (words[index / 64u] & (std::uint64_t(1) << (index % 64u))) != 0u;
+}
+
+/**
+ * Adds the states that are reachable from the given states without consuming a
+ * character. Since consecutive stars are collapsed when parsing, these are exactly the
+ * states following an active star.
+ */
+void add_epsilon_states(
+  std::uint64_t* states, const std::uint64_t* star_mask, const std::size_t word_count)
+{
+  auto carry = std::uint64_t(0);
+  for (std::size_t w = 0; w < word_count; ++w)
+  {
+    const auto stars = states[w] & star_mask[w];
+    states[w] |= (stars << 1u) | carry;
+    carry = stars >> 63u;
+  }
+}
+
+} // namespace
+
+glob_matcher::glob_matcher(
+  const std::string_view pattern, const std::function<bool(char, char)>& char_equal)
+  : m_pattern{pattern}
+{
+  const auto tokens = parse_glob(pattern);
+  if (!tokens)
+  {
+    m_valid = false;
+    return;
+  }
+
+  // state i means that the first i tokens have been matched
+  const auto state_count = tokens->size() + 1u;
+  m_word_count = (state_count + 63u) / 64u;
+  m_accept_state = tokens->size();
+
+  m_char_masks.resize(256u * m_word_count, 0u);
+  m_star_mask.resize(m_word_count, 0u);
+  m_initial_states.resize(m_word_count, 0u);
+
+  for (std::size_t i = 0; i < tokens->size(); ++i)
+  {
+    const auto& token = (*tokens)[i];
+    if (is_star(token))
+    {
+      set_bit(m_star_mask.data(), i);
+    }
+
+    for (std::size_t c = 0; c < 256u; ++c)
+    {
+      if (accepts(token, static_cast<char>(c), char_equal))
+      {
+        set_bit(m_char_masks.data() + c * m_word_count, i);
+      }
+    }
+  }
+
+  set_bit(m_initial_states.data(), 0);
+  add_epsilon_states(m_initial_states.data(), m_star_mask.data(), m_word_count);
+}
+
+const std::string& glob_matcher::pattern() const
+{
+  return m_pattern;
+}
+
+bool glob_matcher::matches(const std::string_view str) const
+{
+  if (!m_valid)
+  {
+    return false;
+  }
+
+  if (m_word_count <= max_inline_words)
+  {
+    auto current = std::array<std::uint64_t, max_inline_words>{};
+    auto next = std::array<std::uint64_t, max_inline_words>{};
+    return matches(str, current.data(), next.data());
+  }
+
+  auto current = std::vector<std::uint64_t>(m_word_count);
+  auto next = std::vector<std::uint64_t>(m_word_count);
+  return matches(str, current.data(), next.data());
+}
+
+bool glob_matcher::operator()(const std::string_view str) const
+{
+  return matches(str);
+}
+
+bool glob_matcher::matches(
+  const std::string_view str, std::uint64_t* current, std::uint64_t* next) const
+{
+  std::copy(m_initial_states.begin(), m_initial_states.end(), current);
+
+  for (const auto c : str)
+  {
+    const auto* char_mask =
+      m_char_masks.data() + static_cast<unsigned char>(c) * m_word_count;
+
+    auto carry = std::uint64_t(0);
+    auto any_active = std::uint64_t(0);
+    for (std::size_t w = 0; w < m_word_count; ++w)
+    {
+      const auto active = current[w] & char_mask[w];
+      const auto advance = active & ~m_star_mask[w];
+      next[w] = (active & m_star_mask[w]) | (advance << 1u) | carry;
+      carry = advance >> 63u;
+      any_active |= next[w];
+    }
+
+    if (any_active == 0u)
+    {
+      return false;
+    }
+
+    add_epsilon_states(next, m_star_mask.data(), m_word_count);
+    std::swap(current, next);
+  }
+
+  return test_bit(current, m_accept_state);
+}
+
+namespace cs
+{
+glob_matcher make_glob_matcher(const std::string_view pattern)
+{
+  return glob_matcher{pattern, char_equal{}};
+}
+} // namespace cs
+
+namespace ci
+{
+glob_matcher make_glob_matcher(const std::string_view pattern)
+{
+  return glob_matcher{pattern, char_equal{}};
+}
+} // namespace ci
+
+} // namespace kdl
@@ -0,0 +1,98 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kdl
+{
+
+/**
+ * A glob pattern that is compiled once and can then be matched against many strings.
+ *
+ * The pattern syntax is the same as for kdl::str_matches_glob.
+ *
+ * The pattern is compiled into a nondeterministic automaton with one state per pattern
+ * element. Matching simulates all states at once using bit sets, so a match runs in time
+ * linear in the length of the string regardless of how many '*' the pattern contains.
+ * Matching does not allocate unless the pattern has more than 255 elements.
+ */
+class glob_matcher
+{
+private:
+  static constexpr std::size_t max_inline_words = 4u;
+
+  std::string m_pattern;
+  bool m_valid = true;
+  std::size_t m_word_count = 0;
+  std::size_t m_accept_state = 0;
+  // for each character, the states that can consume it, m_word_count words per character
+  std::vector<std::uint64_t> m_char_masks;
+  // the states that loop back onto themselves when consuming a character ('*' and '%*')
+  std::vector<std::uint64_t> m_star_mask;
+  // the states that are active before consuming any character
+  std::vector<std::uint64_t> m_initial_states;
+
+public:
+  /**
+   * Compiles the given pattern. Characters are compared for equality using the given
+   * binary predicate.
+   *
+   * A pattern containing an invalid escape sequence does not match any string.
+   */
+  glob_matcher(
+    std::string_view pattern, const std::function<bool(char, char)>& char_equal);
+
+  const std::string& pattern() const;
+
+  /**
+   * Checks whether the given string matches this pattern.
+   */
+  bool matches(std::string_view str) const;
+
+  bool operator()(std::string_view str) const;
+
+private:
+  bool matches(
+    std::string_view str, std::uint64_t* current, std::uint64_t* next) const;
+};
+
+namespace cs
+{
+/**
+ * Compiles the given glob pattern for matching with case sensitivity.
+ */
+glob_matcher make_glob_matcher(std::string_view pattern);
+} // namespace cs
+
+namespace ci
+{
+/**
+ * Compiles the given glob pattern for matching without case sensitivity.
+ */
+glob_matcher make_glob_matcher(std::string_view pattern);
+} // namespace ci
+
+} // namespace kdl
@@ -0,0 +1,163 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/glob_matcher.h"
+#include "kdl/string_compare.h"
+
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "catch2.h"
+
+namespace kdl
+{
+namespace
+{
+
+std::string random_string(
+  std::mt19937& rng, const std::string_view alphabet, const std::size_t max_length)
+{
+  auto length_dist = std::uniform_int_distribution<std::size_t>{0, max_length};
+  auto char_dist = std::uniform_int_distribution<std::size_t>{0, alphabet.size() - 1u};
+
+  auto result = std::string{};
+  const auto length = length_dist(rng);
+  for (std::size_t i = 0; i < length; ++i)
+  {
+    result.push_back(alphabet[char_dist(rng)]);
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("glob_matcher.cs")
+{
+  using namespace std::string_literals;
+
+  const auto matches = [](const std::string_view str, const std::string_view pattern) {
+    return cs::make_glob_matcher(pattern).matches(str);
+  };
+
+  CHECK(matches("", ""));
+  CHECK(matches("", "*"));
+  CHECK_FALSE(matches("", "?"));
+  CHECK_FALSE(matches("a", ""));
+  CHECK(matches("asdf", "asdf"));
+  CHECK(matches("asdf", "*"));
+  CHECK(matches("asdf", "a??f"));
+  CHECK_FALSE(matches("asdf", "a?f"));
+  CHECK(matches("asdf", "*f"));
+  CHECK(matches("asdf", "a*f"));
+  CHECK(matches("asdf", "?s?f"));
+  CHECK(matches("asdfjkl", "a*f*l"));
+  CHECK(matches("asdfjkl", "*a*f*l*"));
+  CHECK(matches("asd*fjkl", "*a*f*l*"));
+  CHECK(matches("asd*fjkl", "asd\\*fjkl"));
+  CHECK(matches("asd*?fj\\kl", "asd\\*\\?fj\\\\kl"));
+  CHECK_FALSE(matches("asdf", "*F"));
+  CHECK_FALSE(matches("asdF", "a*f"));
+  CHECK_FALSE(matches("ASDF", "?S?f"));
+  CHECK_FALSE(matches("classname", "*_color"));
+
+  CHECK_FALSE(matches("", "%"));
+  CHECK(matches("", "%*"));
+  CHECK(matches("0", "%"));
+  CHECK(matches("9", "%"));
+  CHECK_FALSE(matches("99", "%"));
+  CHECK_FALSE(matches("a", "%"));
+  CHECK_FALSE(matches("3Z", "%*"));
+  CHECK_FALSE(matches("Zasdf", "*%"));
+  CHECK(matches("Zasdf33", "Z*%%"));
+  CHECK(matches("Zasdf3376bdc", "Z*%*"));
+  CHECK_FALSE(matches("Zasdf3376bdc", "Zasdf%*"));
+  CHECK(matches("Zasdf3376bdc", "Z*%*bdc"));
+  CHECK(matches("78777Zasdf3376bdc", "%*Z*%**"));
+  CHECK(matches("34dkadj%773", "*\\%%*"));
+
+  // trailing backslash is a literal
+  CHECK(matches("a\\", "a\\"));
+
+  // invalid escape sequences never match
+  CHECK_FALSE(matches("ab", "a\\b"));
+  CHECK_FALSE(matches("", "\\b"));
+
+  // non-ASCII characters
+  CHECK(matches("\xe4\xf6\xfc", "?\xf6*"));
+  CHECK_FALSE(matches("\xe4\xf6\xfc", "\xf6*"));
+
+  // patterns with more states than fit into the inline storage
+  const auto long_str = std::string(300, 'a') + "b";
+  CHECK(matches(long_str, std::string(300, '?') + "*b"));
+  CHECK_FALSE(matches(long_str, std::string(302, '?') + "*"));
+
+  // many stars do not lead to exponential run time
+  CHECK_FALSE(matches(std::string(200, 'a'), "*a*a*a*a*a*a*a*a*a*a*a*a*a*a*a*a*b"));
+
+  CHECK(cs::make_glob_matcher("a*").pattern() == "a*");
+}
+
+TEST_CASE("glob_matcher.ci")
+{
+  const auto matches = [](const std::string_view str, const std::string_view pattern) {
+    return ci::make_glob_matcher(pattern)(str);
+  };
+
+  CHECK(matches("ASdf", "asdf"));
+  CHECK(matches("AsdF", "*"));
+  CHECK(matches("ASdf", "a??f"));
+  CHECK_FALSE(matches("AsDF", "a?f"));
+  CHECK(matches("asdF", "*f"));
+  CHECK(matches("aSDF", "a*f"));
+  CHECK(matches("ASDF", "?s?f"));
+  CHECK(matches("AsDfjkl", "a*f*l"));
+  CHECK(matches("AsDfjkl", "*a*f*l*"));
+  CHECK(matches("ASd*fjKl", "*a*f*l*"));
+  CHECK(matches("ASd*fjKl", "asd\\*fjkl"));
+  CHECK(matches("aSD*?fJ\\kL", "asd\\*\\?fj\\\\kl"));
+}
+
+TEST_CASE("glob_matcher.matches_str_matches_glob")
+{
+  // compare against the interpreting matcher on random patterns and strings
+  auto rng = std::mt19937{12345u};
+
+  constexpr auto pattern_alphabet = std::string_view{"aAb1*?%\\"};
+  constexpr auto string_alphabet = std::string_view{"aAb12*?%\\"};
+
+  for (std::size_t i = 0; i < 2000u; ++i)
+  {
+    const auto pattern = random_string(rng, pattern_alphabet, 8u);
+    const auto cs_matcher = cs::make_glob_matcher(pattern);
+    const auto ci_matcher = ci::make_glob_matcher(pattern);
+
+    for (std::size_t j = 0; j < 20u; ++j)
+    {
+      const auto str = random_string(rng, string_alphabet, 10u);
+
+      CAPTURE(pattern, str);
+      CHECK(cs_matcher.matches(str) == cs::str_matches_glob(str, pattern));
+      CHECK(ci_matcher.matches(str) == ci::str_matches_glob(str, pattern));
+    }
+  }
+}
+
+} // namespace kdl